@@ -0,0 +1,59 @@
+#include "ClusterLabeling.h"
+
+#include <numeric>
+
+ClusterLabeling::ClusterLabeling(int numVertices)
+    : _parents(numVertices)
+{
+    std::iota(_parents.begin(), _parents.end(), 0);
+}
+
+void ClusterLabeling::connect(int vertex1, int vertex2)
+{
+    auto numVertices = toInt(_parents.size());
+    if (vertex1 < 0 || vertex1 >= numVertices || vertex2 < 0 || vertex2 >= numVertices) {
+        return;
+    }
+    auto root1 = findRoot(vertex1);
+    auto root2 = findRoot(vertex2);
+    if (root1 != root2) {
+        _parents[std::max(root1, root2)] = std::min(root1, root2);
+    }
+}
+
+int ClusterLabeling::findRoot(int vertex)
+{
+    while (_parents[vertex] != vertex) {
+        _parents[vertex] = _parents[_parents[vertex]];
+        vertex = _parents[vertex];
+    }
+    return vertex;
+}
+
+int ClusterLabeling::calcLabels(std::vector<int>& labels)
+{
+    //the root of each tree is its smallest vertex and is therefore visited first
+    auto numVertices = toInt(_parents.size());
+    labels.resize(numVertices);
+    auto result = 0;
+    for (int i = 0; i < numVertices; ++i) {
+        auto root = findRoot(i);
+        labels[i] = root == i ? result++ : labels[root];
+    }
+    return result;
+}
+
+void ClusterLabeling::groupByLabel(std::vector<int> const& labels, int numLabels, std::vector<int>& sortedVertices, std::vector<int>& offsets)
+{
+    offsets.assign(numLabels + 1, 0);
+    for (auto const& label : labels) {
+        ++offsets[label + 1];
+    }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+    sortedVertices.resize(labels.size());
+    std::vector<int> positions(offsets.begin(), offsets.end() - 1);
+    for (int i = 0; i < toInt(labels.size()); ++i) {
+        sortedVertices[positions[labels[i]]++] = i;
+    }
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <vector>
+
+#include "Definitions.h"
+
+/**
+ * Labels the connected components of an undirected graph with the vertices 0, ..., numVertices - 1 by a union-find pass
+ * on a flat parent array. Clusters are numbered in the order of their smallest vertex.
+ */
+class ClusterLabeling
+{
+public:
+    ClusterLabeling(int numVertices);
+
+    void connect(int vertex1, int vertex2);  //ignores vertices out of range (e.g. -1 for absent connections)
+    int findRoot(int vertex);
+
+    //returns the number of clusters, labels contains the cluster index of each vertex
+    int calcLabels(std::vector<int>& labels);
+
+    //vertices of cluster i are stored in sortedVertices[offsets[i]], ..., sortedVertices[offsets[i + 1] - 1] in ascending order
+    static void groupByLabel(std::vector<int> const& labels, int numLabels, std::vector<int>& sortedVertices, std::vector<int>& offsets);
+
+private:
+    std::vector<int> _parents;
+};
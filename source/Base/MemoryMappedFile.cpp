@@ -0,0 +1,99 @@
+#include "MemoryMappedFile.h"
+
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+_MemoryMappedFile::_MemoryMappedFile(std::string const& filename)
+{
+    _fileHandle = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (_fileHandle == INVALID_HANDLE_VALUE) {
+        _fileHandle = nullptr;
+        throw std::runtime_error("Could not open " + filename + ".");
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(_fileHandle, &size)) {
+        CloseHandle(_fileHandle);
+        throw std::runtime_error("Could not determine size of " + filename + ".");
+    }
+    _size = static_cast<uint64_t>(size.QuadPart);
+    if (_size == 0) {
+        return;
+    }
+    _mappingHandle = CreateFileMappingA(_fileHandle, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+    if (!_mappingHandle) {
+        CloseHandle(_fileHandle);
+        throw std::runtime_error("Could not map " + filename + ".");
+    }
+    _data = static_cast<uint8_t*>(MapViewOfFile(_mappingHandle, FILE_MAP_COPY, 0, 0, 0));
+    if (!_data) {
+        CloseHandle(_mappingHandle);
+        CloseHandle(_fileHandle);
+        throw std::runtime_error("Could not map " + filename + ".");
+    }
+}
+
+_MemoryMappedFile::~_MemoryMappedFile()
+{
+    if (_data) {
+        UnmapViewOfFile(_data);
+    }
+    if (_mappingHandle) {
+        CloseHandle(_mappingHandle);
+    }
+    if (_fileHandle) {
+        CloseHandle(_fileHandle);
+    }
+}
+#else
+_MemoryMappedFile::_MemoryMappedFile(std::string const& filename)
+{
+    _fileDescriptor = open(filename.c_str(), O_RDONLY);
+    if (_fileDescriptor == -1) {
+        throw std::runtime_error("Could not open " + filename + ".");
+    }
+    struct stat fileStat;
+    if (fstat(_fileDescriptor, &fileStat) == -1) {
+        close(_fileDescriptor);
+        throw std::runtime_error("Could not determine size of " + filename + ".");
+    }
+    _size = static_cast<uint64_t>(fileStat.st_size);
+    if (_size == 0) {
+        return;
+    }
+    auto data = mmap(nullptr, _size, PROT_READ | PROT_WRITE, MAP_PRIVATE, _fileDescriptor, 0);
+    if (data == MAP_FAILED) {
+        close(_fileDescriptor);
+        throw std::runtime_error("Could not map " + filename + ".");
+    }
+    _data = static_cast<uint8_t*>(data);
+}
+
+_MemoryMappedFile::~_MemoryMappedFile()
+{
+    if (_data) {
+        munmap(_data, _size);
+    }
+    if (_fileDescriptor != -1) {
+        close(_fileDescriptor);
+    }
+}
+#endif
+
+uint8_t* _MemoryMappedFile::getData() const
+{
+    return _data;
+}
+
+uint64_t _MemoryMappedFile::getSize() const
+{
+    return _size;
+}
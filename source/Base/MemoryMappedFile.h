@@ -0,0 +1,30 @@
+#pragma once
+
+#include <string>
+
+#include "Definitions.h"
+
+//maps a file copy-on-write into memory: changes to the mapped data are private and not written back to the file
+class _MemoryMappedFile
+{
+public:
+    _MemoryMappedFile(std::string const& filename);  //throws std::runtime_error if the file cannot be mapped
+    ~_MemoryMappedFile();
+
+    _MemoryMappedFile(_MemoryMappedFile const&) = delete;
+    void operator=(_MemoryMappedFile const&) = delete;
+
+    uint8_t* getData() const;
+    uint64_t getSize() const;
+
+private:
+    uint8_t* _data = nullptr;
+    uint64_t _size = 0;
+
+#ifdef _WIN32
+    void* _fileHandle = nullptr;
+    void* _mappingHandle = nullptr;
+#else
+    int _fileDescriptor = -1;
+#endif
+};
@@ -8,13 +8,8 @@ NumberGenerator::NumberGenerator()
 {
     _arrayOfRandomNumbers.reserve(1323781);
     _runningNumber = 0;
-    std::random_device rd;   //Will be used to obtain a seed for the random number engine
-    std::mt19937 gen(rd());  //Standard mersenne_twister_engine seeded with rd()
-    std::uniform_int_distribution<> distrib(0);
-
-    for (uint32_t i = 0; i < 1323781; ++i) {
-        _arrayOfRandomNumbers.emplace_back(distrib(gen));
-    }
+    std::random_device rd;  //Will be used to obtain a seed until a simulation sets its own
+    setSeed(rd());
 }
 
 NumberGenerator::~NumberGenerator()
@@ -27,6 +22,19 @@ NumberGenerator& NumberGenerator::getInstance()
     return instance;
 }
 
+void NumberGenerator::setSeed(uint64_t seed)
+{
+    //the output of mt19937 is fully specified by the standard in contrast to the distributions
+    std::seed_seq seedSequence{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)};
+    std::mt19937 gen(seedSequence);
+
+    _arrayOfRandomNumbers.clear();
+    for (uint32_t i = 0; i < 1323781; ++i) {
+        _arrayOfRandomNumbers.emplace_back(gen() >> 1);  //same range [0, 2^31 - 1] as before
+    }
+    _index = 0;
+}
+
 uint32_t NumberGenerator::getRandomInt()
 {
 	return getNumberFromArray();
@@ -68,6 +76,16 @@ uint64_t NumberGenerator::getId()
     return (static_cast<uint64_t>(1) << 48) | ++_runningNumber; //first term is to avoid collisions with GPU-generated ids
 }
 
+uint64_t NumberGenerator::getIds(uint64_t count)
+{
+    if (count == 0) {
+        return (static_cast<uint64_t>(1) << 48) | (_runningNumber + 1);
+    }
+    auto result = getId();
+    _runningNumber += count - 1;
+    return result;
+}
+
 uint32_t NumberGenerator::getNumberFromArray()
 {
 	_index = (_index + 1) % _arrayOfRandomNumbers.size();
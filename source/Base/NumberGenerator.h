@@ -7,6 +7,8 @@ class NumberGenerator
 public:
     static NumberGenerator& getInstance();
 
+    void setSeed(uint64_t seed);  //the same seed yields the same sequence of random numbers (ids are not affected)
+
 	uint32_t getRandomInt();
     uint32_t getRandomInt(uint32_t range);
     uint32_t getRandomInt(uint32_t min, uint32_t max);
@@ -15,6 +17,7 @@ public:
     float getRandomFloat(float min, float max);
 
 	uint64_t getId();
+    uint64_t getIds(uint64_t count);  //reserves count consecutive ids and returns the first one, reserves nothing for count == 0
 
 public:
     NumberGenerator(NumberGenerator const&) = delete;
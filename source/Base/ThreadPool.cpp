@@ -0,0 +1,57 @@
+#include "ThreadPool.h"
+
+ThreadPool& ThreadPool::getInstance()
+{
+    static ThreadPool instance(std::max(1, toInt(std::thread::hardware_concurrency())));
+    return instance;
+}
+
+ThreadPool::ThreadPool(int numThreads)
+{
+    for (int i = 0; i < numThreads; ++i) {
+        _threads.emplace_back([this] { runWorker(); });
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::unique_lock lock(_mutex);
+        _shutdown = true;
+    }
+    _condition.notify_all();
+    for (auto& thread : _threads) {
+        thread.join();
+    }
+}
+
+int ThreadPool::getNumThreads() const
+{
+    return toInt(_threads.size());
+}
+
+void ThreadPool::enqueue(std::function<void()>&& job)
+{
+    {
+        std::unique_lock lock(_mutex);
+        _jobs.emplace_back(std::move(job));
+    }
+    _condition.notify_one();
+}
+
+void ThreadPool::runWorker()
+{
+    while (true) {
+        std::function<void()> job;
+        {
+            std::unique_lock lock(_mutex);
+            _condition.wait(lock, [this] { return _shutdown || !_jobs.empty(); });
+            if (_shutdown && _jobs.empty()) {
+                return;
+            }
+            job = std::move(_jobs.front());
+            _jobs.pop_front();
+        }
+        job();
+    }
+}
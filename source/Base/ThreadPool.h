@@ -0,0 +1,102 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+
+#include "Definitions.h"
+
+class ThreadPool
+{
+public:
+    static ThreadPool& getInstance();
+
+    ThreadPool(int numThreads);
+    ~ThreadPool();
+
+    ThreadPool(ThreadPool const&) = delete;
+    void operator=(ThreadPool const&) = delete;
+
+    int getNumThreads() const;
+
+    template <typename Func>
+    auto submit(Func&& func) -> std::future<decltype(func())>;
+
+    //calls func(index) for all indices in [begin, end) and blocks until all calls are finished
+    //should not be called from a job of the same pool
+    template <typename Func>
+    void parallelFor(size_t begin, size_t end, Func const& func);
+
+private:
+    void enqueue(std::function<void()>&& job);
+    void runWorker();
+
+    std::vector<std::thread> _threads;
+    std::deque<std::function<void()>> _jobs;
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    bool _shutdown = false;
+};
+
+/************************************************************************/
+/* Implementation                                                       */
+/************************************************************************/
+template <typename Func>
+auto ThreadPool::submit(Func&& func) -> std::future<decltype(func())>
+{
+    using Result = decltype(func());
+    auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<Func>(func));
+    auto result = task->get_future();
+    enqueue([task] { (*task)(); });
+    return result;
+}
+
+template <typename Func>
+void ThreadPool::parallelFor(size_t begin, size_t end, Func const& func)
+{
+    if (begin >= end) {
+        return;
+    }
+    auto numChunks = std::min(end - begin, static_cast<size_t>(getNumThreads()));
+    auto chunkSize = (end - begin + numChunks - 1) / numChunks;
+
+    //the calling thread processes the first chunk itself
+    std::vector<std::future<void>> futures;
+    futures.reserve(numChunks - 1);
+    for (size_t chunk = 1; chunk < numChunks; ++chunk) {
+        auto chunkBegin = begin + chunk * chunkSize;
+        auto chunkEnd = std::min(chunkBegin + chunkSize, end);
+        futures.emplace_back(submit([&func, chunkBegin, chunkEnd] {
+            for (auto index = chunkBegin; index < chunkEnd; ++index) {
+                func(index);
+            }
+        }));
+    }
+
+    //all chunks must be finished before returning because the jobs reference func
+    std::exception_ptr exception;
+    try {
+        for (auto index = begin; index < std::min(begin + chunkSize, end); ++index) {
+            func(index);
+        }
+    } catch (...) {
+        exception = std::current_exception();
+    }
+    for (auto& future : futures) {
+        try {
+            future.get();
+        } catch (...) {
+            if (!exception) {
+                exception = std::current_exception();
+            }
+        }
+    }
+    if (exception) {
+        std::rethrow_exception(exception);
+    }
+}
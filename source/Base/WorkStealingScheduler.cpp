@@ -0,0 +1,85 @@
+#include "WorkStealingScheduler.h"
+
+WorkStealingScheduler::WorkStealingScheduler(ThreadPool& threadPool, int grainSize)
+    : _threadPool(threadPool)
+    , _grainSize(std::max(1, grainSize))
+    , _numWorkers(threadPool.getNumThreads())
+    , _ranges(std::make_unique<WorkerRange[]>(threadPool.getNumThreads()))
+{}
+
+int WorkStealingScheduler::getNumStealsOfLastRun() const
+{
+    return _numSteals;
+}
+
+int WorkStealingScheduler::initRanges(int numTasks)
+{
+    auto result = std::min(_numWorkers, (numTasks + _grainSize - 1) / _grainSize);
+    for (int worker = 0; worker < _numWorkers; ++worker) {
+        std::lock_guard lock(_ranges[worker].mutex);
+        if (worker < result) {
+            _ranges[worker].begin = toInt(static_cast<int64_t>(numTasks) * worker / result);
+            _ranges[worker].end = toInt(static_cast<int64_t>(numTasks) * (worker + 1) / result);
+        } else {
+            _ranges[worker].begin = 0;
+            _ranges[worker].end = 0;
+        }
+    }
+    return result;
+}
+
+bool WorkStealingScheduler::takeChunk(int worker, int& begin, int& end)
+{
+    auto& range = _ranges[worker];
+    std::lock_guard lock(range.mutex);
+    if (range.begin >= range.end) {
+        return false;
+    }
+    begin = range.begin;
+    end = std::min(range.begin + _grainSize, range.end);
+    range.begin = end;
+    return true;
+}
+
+bool WorkStealingScheduler::steal(int worker)
+{
+    //tasks are only moved between the ranges, hence the work is done when all ranges are empty
+    while (true) {
+        int victim = -1;
+        int maxRemaining = 0;
+        for (int i = 1; i < _numWorkers; ++i) {
+            auto candidate = (worker + i) % _numWorkers;
+            auto& range = _ranges[candidate];
+            std::lock_guard lock(range.mutex);
+            if (range.end - range.begin > maxRemaining) {
+                maxRemaining = range.end - range.begin;
+                victim = candidate;
+            }
+        }
+        if (victim == -1) {
+            return false;
+        }
+
+        int begin;
+        int end;
+        {
+            auto& range = _ranges[victim];
+            std::lock_guard lock(range.mutex);
+            if (range.begin >= range.end) {
+                continue;  //victim has finished in the meantime
+            }
+            auto mid = range.begin + (range.end - range.begin) / 2;
+            begin = mid;
+            end = range.end;
+            range.end = mid;
+        }
+        {
+            auto& ownRange = _ranges[worker];
+            std::lock_guard lock(ownRange.mutex);
+            ownRange.begin = begin;
+            ownRange.end = end;
+        }
+        ++_numSteals;
+        return true;
+    }
+}
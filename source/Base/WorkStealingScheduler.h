@@ -0,0 +1,104 @@
+#pragma once
+
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <mutex>
+
+#include "Definitions.h"
+#include "ThreadPool.h"
+
+/**
+ * Processes tasks of strongly varying cost on the threads of a ThreadPool. Each participating thread owns a range of task
+ * indices and takes small chunks from its front. An idle thread steals the back half of the largest remaining range of
+ * another thread, so that a few expensive tasks do not leave the other threads waiting.
+ *
+ * run should not be called concurrently on the same scheduler or from a job of the same pool.
+ */
+class WorkStealingScheduler
+{
+public:
+    WorkStealingScheduler(ThreadPool& threadPool = ThreadPool::getInstance(), int grainSize = 8);
+
+    //calls func(taskIndex) for all task indices in [0, numTasks) and blocks until all calls are finished
+    template <typename Func>
+    void run(int numTasks, Func const& func);
+
+    int getNumStealsOfLastRun() const;
+
+private:
+    struct alignas(64) WorkerRange
+    {
+        std::mutex mutex;
+        int begin = 0;
+        int end = 0;
+    };
+
+    int initRanges(int numTasks);
+    bool takeChunk(int worker, int& begin, int& end);
+    bool steal(int worker);
+
+    template <typename Func>
+    void runWorker(int worker, Func const& func);
+
+    ThreadPool& _threadPool;
+    int _grainSize;
+    int _numWorkers = 0;
+    std::unique_ptr<WorkerRange[]> _ranges;
+    std::atomic<int> _numSteals = 0;
+};
+
+/************************************************************************/
+/* Implementation                                                       */
+/************************************************************************/
+
+template <typename Func>
+void WorkStealingScheduler::run(int numTasks, Func const& func)
+{
+    _numSteals = 0;
+    if (numTasks <= 0) {
+        return;
+    }
+    auto numWorkers = initRanges(numTasks);
+
+    //the calling thread works as worker 0
+    std::vector<std::future<void>> futures;
+    futures.reserve(numWorkers - 1);
+    for (int worker = 1; worker < numWorkers; ++worker) {
+        futures.emplace_back(_threadPool.submit([this, worker, &func] { runWorker(worker, func); }));
+    }
+
+    //all workers must be finished before returning because the jobs reference func
+    std::exception_ptr exception;
+    try {
+        runWorker(0, func);
+    } catch (...) {
+        exception = std::current_exception();
+    }
+    for (auto& future : futures) {
+        try {
+            future.get();
+        } catch (...) {
+            if (!exception) {
+                exception = std::current_exception();
+            }
+        }
+    }
+    if (exception) {
+        std::rethrow_exception(exception);
+    }
+}
+
+template <typename Func>
+void WorkStealingScheduler::runWorker(int worker, Func const& func)
+{
+    int begin;
+    int end;
+    do {
+        while (takeChunk(worker, begin, end)) {
+            for (int task = begin; task < end; ++task) {
+                func(task);
+            }
+        }
+    } while (steal(worker));
+}
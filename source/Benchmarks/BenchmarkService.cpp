@@ -0,0 +1,443 @@
+#include "BenchmarkService.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+
+#include <cuda_runtime.h>
+
+#include "Base/Resources.h"
+#include "EngineGpuKernels/StatisticsService.cuh"
+#include "EngineImpl/AccessDataTOCache.h"
+#include "EngineImpl/DescriptionConverter.h"
+#include "EngineImpl/SimulationControllerImpl.h"
+#include "EngineInterface/DescriptionEditService.h"
+#include "EngineInterface/GeneralSettings.h"
+#include "EngineInterface/GenomeDescriptionService.h"
+#include "EngineInterface/SerializerService.h"
+#include "EngineInterface/SimulationParameters.h"
+#include "EngineInterface/SpatialHashGrid.h"
+#include "EngineInterface/StatisticsConverterService.h"
+
+namespace
+{
+    auto constexpr BlockDistance = 25.0f;
+    auto constexpr NumStatisticsUpdates = 100000;
+    auto constexpr NumGenomeCodings = 10000;
+    auto constexpr NumSpatialEntries = 1000000;
+    auto constexpr NumSpatialQueries = 200000;
+    auto constexpr SpatialQueryRadius = 2.0f;
+    IntVector2D const SpatialWorldSize{1000, 1000};
+
+    std::vector<std::pair<std::string, int>> const SizeScales = {{"small", 1}, {"medium", 4}, {"large", 16}};
+
+    class Stopwatch
+    {
+    public:
+        Stopwatch()
+            : _start(std::chrono::steady_clock::now())
+        {}
+
+        double getSeconds() const { return std::chrono::duration<double>(std::chrono::steady_clock::now() - _start).count(); }
+
+    private:
+        std::chrono::steady_clock::time_point _start;
+    };
+
+    DataDescription multiplyOnGrid(DataDescription const& block, int number)
+    {
+        return DescriptionEditService::gridMultiply(
+            block,
+            DescriptionEditService::GridMultiplyParameters()
+                .horizontalNumber(number)
+                .horizontalDistance(BlockDistance)
+                .verticalNumber(number)
+                .verticalDistance(BlockDistance));
+    }
+
+    //fixed seed for reproducible measurements
+    std::vector<RealVector2D> createRandomPositions(int number, IntVector2D const& worldSize, std::mt19937& randomEngine)
+    {
+        std::uniform_real_distribution<float> distributionX(0, toFloat(worldSize.x));
+        std::uniform_real_distribution<float> distributionY(0, toFloat(worldSize.y));
+        std::vector<RealVector2D> result;
+        result.reserve(number);
+        for (int i = 0; i < number; ++i) {
+            result.emplace_back(distributionX(randomEngine), distributionY(randomEngine));
+        }
+        return result;
+    }
+
+    double getRate(double number, double seconds) { return seconds > 0 ? number / seconds : 0; }
+    double toMegabytes(size_t bytes) { return toDouble(bytes) / (1024.0 * 1024.0); }
+}
+
+std::vector<std::string> BenchmarkService::getSizeNames()
+{
+    std::vector<std::string> result;
+    for (auto const& [name, scale] : SizeScales) {
+        result.emplace_back(name);
+    }
+    return result;
+}
+
+std::vector<BenchmarkWorld> BenchmarkService::createWorlds(std::string const& sizeName)
+{
+    auto findResult = std::find_if(SizeScales.begin(), SizeScales.end(), [&](auto const& sizeScale) { return sizeScale.first == sizeName; });
+    if (findResult == SizeScales.end()) {
+        throw std::runtime_error("Unknown benchmark size \"" + sizeName + "\".");
+    }
+
+    //blocks of about 100 cells on a grid, 10 x 10 blocks for the small size
+    auto numBlocks = toInt(10.0 * std::sqrt(toDouble(findResult->second)));
+    auto worldLength = toInt(toFloat(numBlocks) * BlockDistance);
+    IntVector2D worldSize{worldLength, worldLength};
+    RealVector2D blockCenter{BlockDistance / 2, BlockDistance / 2};
+
+    std::vector<BenchmarkWorld> result;
+    auto rect = DescriptionEditService::createRect(DescriptionEditService::CreateRectParameters().width(10).height(10).center(blockCenter));
+    result.emplace_back(BenchmarkWorld{"rect-" + sizeName, worldSize, multiplyOnGrid(rect, numBlocks)});
+
+    auto hex = DescriptionEditService::createHex(DescriptionEditService::CreateHexParameters().layers(6).center(blockCenter));
+    result.emplace_back(BenchmarkWorld{"hex-" + sizeName, worldSize, multiplyOnGrid(hex, numBlocks)});
+
+    DataDescription replicator;
+    replicator.addCell(CellDescription()
+                           .setPos(blockCenter)
+                           .setEnergy(300.0f)
+                           .setMaxConnections(2)
+                           .setExecutionOrderNumber(0)
+                           .setCellFunction(ConstructorDescription().setGenome(GenomeDescriptionService::convertDescriptionToBytes(createReplicatorGenome()))));
+    bool overlappingCheckSuccessful = true;
+    auto replicators = DescriptionEditService::randomMultiply(
+        replicator,
+        DescriptionEditService::RandomMultiplyParameters().number(numBlocks * numBlocks * 4),
+        worldSize,
+        DataDescription(),
+        overlappingCheckSuccessful);
+    result.emplace_back(BenchmarkWorld{"replicators-" + sizeName, worldSize, replicators});
+
+    return result;
+}
+
+GenomeDescription BenchmarkService::createReplicatorGenome()
+{
+    return GenomeDescription().setCells({
+        CellGenomeDescription().setCellFunction(ConstructorGenomeDescription().setMode(0).setConstructionActivationTime(100).setMakeSelfCopy()),
+        CellGenomeDescription().setCellFunction(NerveGenomeDescription().setPulseMode(6)),
+        CellGenomeDescription().setCellFunction(NeuronGenomeDescription()),
+        CellGenomeDescription().setCellFunction(SensorGenomeDescription()),
+        CellGenomeDescription().setCellFunction(MuscleGenomeDescription()),
+        CellGenomeDescription().setCellFunction(AttackerGenomeDescription()),
+        CellGenomeDescription(),
+        CellGenomeDescription(),
+    });
+}
+
+BenchmarkResult BenchmarkService::measureTimesteps(BenchmarkWorld const& world, BenchmarkSettings const& settings)
+{
+    auto simController = std::make_shared<_SimulationControllerImpl>();
+    simController->newSimulation(0, GeneralSettings{world.worldSize.x, world.worldSize.y}, SimulationParameters(), settings._backend);
+    simController->setSimulationData(world.data);
+    simController->calcTimesteps(settings._numWarmupTimesteps);
+
+    std::vector<double> latencies;
+    latencies.reserve(settings._numTimesteps);
+    for (int i = 0; i < settings._numTimesteps; ++i) {
+        Stopwatch stopwatch;
+        simController->calcTimesteps(1);
+        latencies.emplace_back(stopwatch.getSeconds() * 1000);
+    }
+    auto numCells = simController->getSimulationData().cells.size();
+    simController->closeSimulation();
+
+    auto totalMilliseconds = std::accumulate(latencies.begin(), latencies.end(), 0.0);
+    std::sort(latencies.begin(), latencies.end());
+    auto getPercentile = [&latencies](int percent) { return latencies.at(std::min(latencies.size() - 1, latencies.size() * percent / 100)); };
+    return BenchmarkResult{
+        "time step",
+        world.name,
+        {{"cells at start", toDouble(world.data.cells.size())},
+         {"cells at end", toDouble(numCells)},
+         {"TPS", getRate(toDouble(latencies.size()), totalMilliseconds / 1000)},
+         {"latency mean [ms]", totalMilliseconds / toDouble(latencies.size())},
+         {"latency p50 [ms]", getPercentile(50)},
+         {"latency p99 [ms]", getPercentile(99)},
+         {"latency max [ms]", latencies.back()}}};
+}
+
+BenchmarkResult BenchmarkService::measureConversion(BenchmarkWorld const& world, BenchmarkSettings const& settings)
+{
+    DescriptionConverter converter{SimulationParameters()};
+    _AccessDataTOCache dataTOCache;
+    auto arraySizes = converter.getArraySizes(world.data);
+
+    double toTOSeconds = 0;
+    double toDescriptionSeconds = 0;
+    double toClusteredDescriptionSeconds = 0;
+    for (int i = 0; i < settings._numRepetitions; ++i) {
+        auto dataTO = dataTOCache.getDataTO(arraySizes);
+        {
+            Stopwatch stopwatch;
+            converter.convertDescriptionToTO(dataTO, world.data);
+            toTOSeconds += stopwatch.getSeconds();
+        }
+        {
+            Stopwatch stopwatch;
+            auto description = converter.convertTOtoDataDescription(dataTO);
+            toDescriptionSeconds += stopwatch.getSeconds();
+        }
+        {
+            Stopwatch stopwatch;
+            auto description = converter.convertTOtoClusteredDataDescription(dataTO);
+            toClusteredDescriptionSeconds += stopwatch.getSeconds();
+        }
+    }
+    auto numCells = toDouble(world.data.cells.size()) * settings._numRepetitions;
+    return BenchmarkResult{
+        "description conversion",
+        world.name,
+        {{"description to TO [cells/s]", getRate(numCells, toTOSeconds)},
+         {"TO to description [cells/s]", getRate(numCells, toDescriptionSeconds)},
+         {"TO to clustered description [cells/s]", getRate(numCells, toClusteredDescriptionSeconds)}}};
+}
+
+std::vector<BenchmarkResult> BenchmarkService::measureSerialization(BenchmarkWorld const& world, BenchmarkSettings const& settings)
+{
+    DeserializedSimulation simulation;
+    simulation.mainData = ClusteredDataDescription(world.data);
+    simulation.auxiliaryData.generalSettings = GeneralSettings{world.worldSize.x, world.worldSize.y};
+
+    std::vector<std::pair<std::string, SerializationSettings>> const formats = {
+        {"portable binary", SerializationSettings()},
+        {"columnar", SerializationSettings().format(SerializationFormat::Columnar)},
+        {"columnar parallel", SerializationSettings().format(SerializationFormat::Columnar).parallelCompression(true).codec(CompressionCodec::DeflateFast)},
+    };
+
+    std::vector<BenchmarkResult> result;
+    for (auto const& [formatName, serializationSettings] : formats) {
+        double saveSeconds = 0;
+        double loadSeconds = 0;
+        size_t numBytes = 0;
+        for (int i = 0; i < settings._numRepetitions; ++i) {
+            SerializedSimulation serializedSimulation;
+            {
+                Stopwatch stopwatch;
+                if (!SerializerService::serializeSimulationToStrings(serializedSimulation, simulation, serializationSettings)) {
+                    throw std::runtime_error("Serialization failed.");
+                }
+                saveSeconds += stopwatch.getSeconds();
+            }
+            numBytes = serializedSimulation.mainData.size();
+            {
+                Stopwatch stopwatch;
+                DeserializedSimulation deserializedSimulation;
+                if (!SerializerService::deserializeSimulationFromStrings(deserializedSimulation, serializedSimulation)) {
+                    throw std::runtime_error("Deserialization failed.");
+                }
+                loadSeconds += stopwatch.getSeconds();
+            }
+        }
+        auto numCells = toDouble(world.data.cells.size()) * settings._numRepetitions;
+        auto numMegabytes = toMegabytes(numBytes) * settings._numRepetitions;
+        result.emplace_back(BenchmarkResult{
+            "serialization (" + formatName + ")",
+            world.name,
+            {{"size [MB]", toMegabytes(numBytes)},
+             {"save [MB/s]", getRate(numMegabytes, saveSeconds)},
+             {"load [MB/s]", getRate(numMegabytes, loadSeconds)},
+             {"save [cells/s]", getRate(numCells, saveSeconds)},
+             {"load [cells/s]", getRate(numCells, loadSeconds)}}});
+    }
+    return result;
+}
+
+BenchmarkResult BenchmarkService::measureStatistics(BenchmarkSettings const& settings)
+{
+    TimelineStatistics rawStatistics;
+    for (int i = 0; i < MAX_COLORS; ++i) {
+        rawStatistics.timestep.numCells[i] = 1000 * (i + 1);
+        rawStatistics.timestep.totalEnergy[i] = 100000.0f * toFloat(i + 1);
+    }
+
+    double convertSeconds = 0;
+    {
+        std::optional<TimelineStatistics> lastRawStatistics;
+        std::optional<uint64_t> lastTimestep;
+        Stopwatch stopwatch;
+        for (int i = 0; i < NumStatisticsUpdates; ++i) {
+            auto timestep = static_cast<uint64_t>(i) * 10;
+            ++rawStatistics.accumulated.numCreatedCells[i % MAX_COLORS];
+            auto dataPoints = StatisticsConverterService::convert(rawStatistics, timestep, toDouble(timestep), lastRawStatistics, lastTimestep);
+            lastRawStatistics = rawStatistics;
+            lastTimestep = timestep;
+        }
+        convertSeconds = stopwatch.getSeconds();
+    }
+
+    double historySeconds = 0;
+    {
+        _StatisticsService statisticsService;
+        StatisticsHistory history;
+        Stopwatch stopwatch;
+        for (int i = 0; i < NumStatisticsUpdates; ++i) {
+            ++rawStatistics.accumulated.numCreatedCells[i % MAX_COLORS];
+            statisticsService.addDataPoint(history, rawStatistics, static_cast<uint64_t>(i) * 10);
+        }
+        historySeconds = stopwatch.getSeconds();
+    }
+
+    return BenchmarkResult{
+        "statistics",
+        "",
+        {{"raw statistics conversion [updates/s]", getRate(NumStatisticsUpdates, convertSeconds)},
+         {"history update [updates/s]", getRate(NumStatisticsUpdates, historySeconds)}}};
+}
+
+BenchmarkResult BenchmarkService::measureGenomeCoding(BenchmarkSettings const& settings)
+{
+    auto genome = createReplicatorGenome();
+    auto bytes = GenomeDescriptionService::convertDescriptionToBytes(genome);
+
+    double encodeSeconds = 0;
+    {
+        Stopwatch stopwatch;
+        for (int i = 0; i < NumGenomeCodings; ++i) {
+            bytes = GenomeDescriptionService::convertDescriptionToBytes(genome);
+        }
+        encodeSeconds = stopwatch.getSeconds();
+    }
+    double decodeSeconds = 0;
+    {
+        Stopwatch stopwatch;
+        for (int i = 0; i < NumGenomeCodings; ++i) {
+            genome = GenomeDescriptionService::convertBytesToDescription(bytes);
+        }
+        decodeSeconds = stopwatch.getSeconds();
+    }
+
+    double nodeIterationSeconds = 0;
+    {
+        Stopwatch stopwatch;
+        for (int i = 0; i < NumGenomeCodings; ++i) {
+            GenomeDescriptionService::getNumNodesRecursively(bytes, true);
+        }
+        nodeIterationSeconds = stopwatch.getSeconds();
+    }
+
+    std::vector<GenomeDescription> genomes(NumGenomeCodings, genome);
+    std::vector<std::vector<uint8_t>> genomeBytes;
+    double parallelEncodeSeconds = 0;
+    {
+        Stopwatch stopwatch;
+        genomeBytes = GenomeDescriptionService::convertDescriptionsToBytes(genomes);
+        parallelEncodeSeconds = stopwatch.getSeconds();
+    }
+    double parallelDecodeSeconds = 0;
+    {
+        Stopwatch stopwatch;
+        genomes = GenomeDescriptionService::convertBytesToDescriptions(genomeBytes);
+        parallelDecodeSeconds = stopwatch.getSeconds();
+    }
+
+    auto numMegabytes = toMegabytes(bytes.size()) * NumGenomeCodings;
+    return BenchmarkResult{
+        "genome coding",
+        "",
+        {{"genome size [bytes]", toDouble(bytes.size())},
+         {"encode [genomes/s]", getRate(NumGenomeCodings, encodeSeconds)},
+         {"decode [genomes/s]", getRate(NumGenomeCodings, decodeSeconds)},
+         {"encode [MB/s]", getRate(numMegabytes, encodeSeconds)},
+         {"decode [MB/s]", getRate(numMegabytes, decodeSeconds)},
+         {"node iteration [genomes/s]", getRate(NumGenomeCodings, nodeIterationSeconds)},
+         {"parallel encode [genomes/s]", getRate(NumGenomeCodings, parallelEncodeSeconds)},
+         {"parallel decode [genomes/s]", getRate(NumGenomeCodings, parallelDecodeSeconds)}}};
+}
+
+BenchmarkResult BenchmarkService::measureSpatialQueries(BenchmarkSettings const& settings)
+{
+    std::mt19937 randomEngine(0);
+    auto positions = createRandomPositions(NumSpatialEntries, SpatialWorldSize, randomEngine);
+    auto queryPositions = createRandomPositions(NumSpatialQueries, SpatialWorldSize, randomEngine);
+
+    SpatialHashGrid grid(SpatialWorldSize);
+    std::vector<bool> occupied;
+    std::vector<int> indices;
+    std::vector<int> offsets;
+    double buildSeconds = 0;
+    double occupancySeconds = 0;
+    double neighborSeconds = 0;
+    for (int i = 0; i < settings._numRepetitions; ++i) {
+        {
+            Stopwatch stopwatch;
+            grid.build(positions);
+            buildSeconds += stopwatch.getSeconds();
+        }
+        {
+            Stopwatch stopwatch;
+            grid.areOccupied(queryPositions, SpatialQueryRadius, occupied);
+            occupancySeconds += stopwatch.getSeconds();
+        }
+        {
+            Stopwatch stopwatch;
+            grid.getIndicesInRadius(queryPositions, SpatialQueryRadius, indices, offsets);
+            neighborSeconds += stopwatch.getSeconds();
+        }
+    }
+
+    auto numEntries = toDouble(NumSpatialEntries) * settings._numRepetitions;
+    auto numQueries = toDouble(NumSpatialQueries) * settings._numRepetitions;
+    return BenchmarkResult{
+        "spatial queries",
+        "",
+        {{"entries", toDouble(NumSpatialEntries)},
+         {"build [entries/s]", getRate(numEntries, buildSeconds)},
+         {"occupancy [queries/s]", getRate(numQueries, occupancySeconds)},
+         {"neighbors [queries/s]", getRate(numQueries, neighborSeconds)}}};
+}
+
+std::string BenchmarkService::getDeviceName(EngineBackend backend)
+{
+    auto simController = std::make_shared<_SimulationControllerImpl>();
+    simController->newSimulation(0, GeneralSettings{100, 100}, SimulationParameters(), backend);
+    auto result = simController->getGpuName();
+    simController->closeSimulation();
+    return result;
+}
+
+void BenchmarkService::writeResultsAsJson(std::vector<BenchmarkResult> const& results, std::string const& deviceName, std::ostream& stream)
+{
+    auto quoted = [](std::string const& value) {
+        std::string result = "\"";
+        for (auto const& c : value) {
+            if (c == '"' || c == '\\') {
+                result += '\\';
+            }
+            result += c;
+        }
+        return result + "\"";
+    };
+
+    stream << std::setprecision(8);
+    stream << "{" << std::endl;
+    stream << "  " << quoted("program version") << ": " << quoted(Const::ProgramVersion) << "," << std::endl;
+    stream << "  " << quoted("device") << ": " << quoted(deviceName) << "," << std::endl;
+    stream << "  " << quoted("results") << ": [" << std::endl;
+    for (size_t i = 0; i < results.size(); ++i) {
+        auto const& result = results.at(i);
+        stream << "    {" << quoted("benchmark") << ": " << quoted(result.benchmark);
+        if (!result.world.empty()) {
+            stream << ", " << quoted("world") << ": " << quoted(result.world);
+        }
+        for (auto const& [name, value] : result.values) {
+            stream << ", " << quoted(name) << ": " << (std::isfinite(value) ? value : 0.0);
+        }
+        stream << "}" << (i + 1 < results.size() ? "," : "") << std::endl;
+    }
+    stream << "  ]" << std::endl;
+    stream << "}" << std::endl;
+}
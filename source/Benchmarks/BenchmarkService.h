@@ -0,0 +1,57 @@
+#pragma once
+
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Base/Definitions.h"
+#include "EngineInterface/Descriptions.h"
+#include "EngineInterface/EngineBackend.h"
+#include "EngineInterface/GenomeDescriptions.h"
+
+struct BenchmarkWorld
+{
+    std::string name;  //e.g. "rect-small"
+    IntVector2D worldSize;
+    DataDescription data;
+};
+
+struct BenchmarkResult
+{
+    std::string benchmark;
+    std::string world;  //empty for benchmarks without world
+    std::vector<std::pair<std::string, double>> values;  //name (containing the unit) and value
+};
+
+struct BenchmarkSettings
+{
+    MEMBER_DECLARATION(BenchmarkSettings, EngineBackend, backend, EngineBackend_Gpu);
+    MEMBER_DECLARATION(BenchmarkSettings, int, numWarmupTimesteps, 20);
+    MEMBER_DECLARATION(BenchmarkSettings, int, numTimesteps, 200);  //time steps measured individually for the latency
+    MEMBER_DECLARATION(BenchmarkSettings, int, numRepetitions, 5);  //for conversion and serialization
+};
+
+/**
+ * Reproducible measurements for tracking the performance across releases. Standard worlds are generated procedurally in the
+ * sizes small, medium and large (4 and 16 times the number of objects of small):
+ *   rect: connected rectangles, hex: connected hexagons, replicators: self-replicating constructors randomly placed
+ */
+class BenchmarkService
+{
+public:
+    static std::vector<std::string> getSizeNames();
+    static std::vector<BenchmarkWorld> createWorlds(std::string const& sizeName);  //throws std::runtime_error for unknown sizes
+    static GenomeDescription createReplicatorGenome();
+
+    static BenchmarkResult measureTimesteps(BenchmarkWorld const& world, BenchmarkSettings const& settings);
+    static BenchmarkResult measureConversion(BenchmarkWorld const& world, BenchmarkSettings const& settings);
+    static std::vector<BenchmarkResult> measureSerialization(BenchmarkWorld const& world, BenchmarkSettings const& settings);
+    static BenchmarkResult measureStatistics(BenchmarkSettings const& settings);
+    static BenchmarkResult measureGenomeCoding(BenchmarkSettings const& settings);
+    static BenchmarkResult measureSpatialQueries(BenchmarkSettings const& settings);
+
+    static std::string getDeviceName(EngineBackend backend);
+
+    static void writeResultsAsJson(std::vector<BenchmarkResult> const& results, std::string const& deviceName, std::ostream& stream);
+};
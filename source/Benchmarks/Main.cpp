@@ -0,0 +1,70 @@
+#include <fstream>
+#include <iostream>
+
+#include "CLI/CLI.hpp"
+
+#include "Base/LoggingService.h"
+#include "Base/Resources.h"
+#include "Base/FileLogger.h"
+
+#include "BenchmarkService.h"
+
+int main(int argc, char** argv)
+{
+    try {
+        FileLogger fileLogger = std::make_shared<_FileLogger>();
+
+        CLI::App app{"Benchmark suite for ALIEN v" + Const::ProgramVersion};
+
+        //parse command line arguments
+        std::vector<std::string> sizeNames = {"small", "medium"};
+        std::string outputFilename;
+        bool cpu = false;
+        BenchmarkSettings settings;
+        app.add_option("--sizes", sizeNames, "The sizes of the standard worlds to be measured: small, medium and/or large.")
+            ->check(CLI::IsMember(BenchmarkService::getSizeNames()));
+        app.add_option("-o", outputFilename, "Specifies the name of the JSON file for the results (default: standard output).");
+        app.add_flag("--cpu", cpu, "Measures the time steps on the CPU instead of the GPU (physics, nerves and neurons only).");
+        app.add_option("--timesteps", settings._numTimesteps, "The number of measured time steps per world.")->check(CLI::PositiveNumber);
+        app.add_option("--repetitions", settings._numRepetitions, "The number of repetitions of the conversion and serialization measurements.")
+            ->check(CLI::PositiveNumber);
+        CLI11_PARSE(app, argc, argv);
+        settings._backend = cpu ? EngineBackend_Cpu : EngineBackend_Gpu;
+
+        //run benchmarks
+        std::vector<BenchmarkResult> results;
+        for (auto const& sizeName : sizeNames) {
+            for (auto const& world : BenchmarkService::createWorlds(sizeName)) {
+                std::cerr << "Measuring " << world.name << " (" << world.data.cells.size() << " cells)" << std::endl;
+                results.emplace_back(BenchmarkService::measureTimesteps(world, settings));
+                results.emplace_back(BenchmarkService::measureConversion(world, settings));
+                auto serializationResults = BenchmarkService::measureSerialization(world, settings);
+                results.insert(results.end(), serializationResults.begin(), serializationResults.end());
+            }
+        }
+        std::cerr << "Measuring statistics, genome coding and spatial queries" << std::endl;
+        results.emplace_back(BenchmarkService::measureStatistics(settings));
+        results.emplace_back(BenchmarkService::measureGenomeCoding(settings));
+        results.emplace_back(BenchmarkService::measureSpatialQueries(settings));
+
+        //write results
+        auto deviceName = BenchmarkService::getDeviceName(settings._backend);
+        if (outputFilename.empty()) {
+            BenchmarkService::writeResultsAsJson(results, deviceName, std::cout);
+        } else {
+            std::ofstream stream(outputFilename);
+            BenchmarkService::writeResultsAsJson(results, deviceName, stream);
+            if (!stream) {
+                std::cerr << "Could not write to output file." << std::endl;
+                return 1;
+            }
+        }
+    } catch (std::exception const& e) {
+        std::cerr << "An uncaught exception occurred: " << e.what() << std::endl;
+        return 1;
+    } catch (...) {
+        std::cerr << "An unknown exception occurred." << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <filesystem>
 #include <iostream>
 
 #include "CLI/CLI.hpp"
@@ -8,9 +9,15 @@
 #include "Base/Resources.h"
 #include "Base/StringHelper.h"
 #include "Base/FileLogger.h"
+#include "EngineInterface/CheckpointService.h"
+#include "EngineInterface/ProfilingService.h"
 #include "EngineInterface/SerializerService.h"
+#include "EngineInterface/StatisticsConverterService.h"
+#include "EngineImpl/DataTOSnapshot.h"
 #include "EngineImpl/SimulationControllerImpl.h"
 
+#include "ParameterSweepService.h"
+
 int main(int argc, char** argv)
 {
     try {
@@ -23,6 +30,19 @@ int main(int argc, char** argv)
         std::string outputFilename;
         std::string statisticsFilename;
         int timesteps = 0;
+        bool columnar = false;
+        bool rawSnapshot = false;
+        bool delta = false;
+        uint64_t seed = 0;
+        uint64_t checkpointInterval = 0;
+        double checkpointMinutes = 0;
+        int numCheckpointFiles = 3;
+        uint64_t statisticsInterval = 1000;
+        double reportSeconds = 60;
+        bool resume = false;
+        std::string sweepFilename;
+        std::string profileFilename;
+        std::string compression = "gzip";
         app.add_option(
             "-i", inputFilename, "Specifies the name of the input file for the simulation to run. The corresponding *.settings.json should also be available.");
         app.add_option(
@@ -30,8 +50,63 @@ int main(int argc, char** argv)
             outputFilename,
             "Specifies the name of the output file for the simulation. The *.settings.json and *.statistics.csv file will also be saved.");
         app.add_option("-t", timesteps, "The number of time steps to be calculated.");
+        app.add_flag("--columnar", columnar, "Saves the output file in the column-oriented format (faster for large simulations).");
+        app.add_flag(
+            "--raw-snapshot",
+            rawSnapshot,
+            "Saves the output file as an uncompressed memory dump (fastest, but only readable by the same program version).");
+        app.add_flag(
+            "--delta",
+            delta,
+            "Saves only the changes to the input simulation as a delta checkpoint next to it (output file must equal the input file). "
+            "A save without this flag folds all delta checkpoints into the output file.");
+        app.add_option(
+            "--compression",
+            compression,
+            "Compression of the output file: gzip (single-threaded), deflate, deflate-fast or none (multi-threaded block compression).")
+            ->check(CLI::IsMember({"gzip", "deflate", "deflate-fast", "none"}));
+        auto seedOption = app.add_option("--seed", seed, "Seed of the random number generators (overrides the seed stored in the input file).");
+        app.add_option(
+            "--checkpoint-interval",
+            checkpointInterval,
+            "Saves a checkpoint of the simulation every given number of time steps (e.g. output.checkpoint0.sim).");
+        app.add_option("--checkpoint-minutes", checkpointMinutes, "Saves a checkpoint of the simulation every given number of minutes.");
+        app.add_option("--checkpoint-files", numCheckpointFiles, "The number of rotating checkpoint files.")->check(CLI::Range(2, 1000));
+        app.add_option(
+            "--statistics-interval",
+            statisticsInterval,
+            "With checkpoints, a row is appended to the statistics file of the output every given number of time steps.")
+            ->check(CLI::PositiveNumber);
+        app.add_option("--report-seconds", reportSeconds, "With checkpoints, the progress and TPS are reported every given number of seconds.");
+        app.add_flag(
+            "--resume",
+            resume,
+            "Continues from the latest checkpoint of the output file if there is one (-t still refers to the time step of the input).");
+        app.add_option(
+               "--sweep",
+               sweepFilename,
+               "Runs the parameter variants of the given JSON file on the input. Outputs are saved next to the output file (e.g. output.<variant>.sim) "
+               "together with a summary (output.sweep.csv).")
+            ->check(CLI::ExistingFile);
+        app.add_option(
+            "--profile",
+            profileFilename,
+            "Measures the phases of the last time steps and saves them as Chrome trace JSON (viewable in chrome://tracing or ui.perfetto.dev). "
+            "Slows down the simulation.");
         CLI11_PARSE(app, argc, argv);
 
+        //batch mode: checkpoints and statistics are written while the simulation runs
+        auto batchMode = checkpointInterval > 0 || checkpointMinutes > 0 || resume;
+        if (batchMode && (outputFilename.empty() || delta || rawSnapshot)) {
+            std::cout << "Checkpoints require an output file in the simulation file format." << std::endl;
+            return 1;
+        }
+        if (!sweepFilename.empty() && (batchMode || delta || rawSnapshot)) {
+            std::cout << "A parameter sweep cannot be combined with checkpoints, delta checkpoints or raw snapshots." << std::endl;
+            return 1;
+        }
+        statisticsFilename = std::filesystem::path(outputFilename).replace_extension(std::filesystem::path(".statistics.csv")).string();
+
         //read input
         std::cout << "Reading input" << std::endl;
         if (inputFilename.empty()) {
@@ -39,42 +114,230 @@ int main(int argc, char** argv)
             return 1;
         }
         DeserializedSimulation simData;
-        if (!SerializerService::deserializeSimulationFromFiles(simData, inputFilename)) {
+        ColumnarDataReader mainDataReader;
+        auto inputIsRawSnapshot = _DataTOSnapshot::isSnapshotFile(inputFilename);
+        if (delta && (inputIsRawSnapshot || rawSnapshot || outputFilename != inputFilename)) {
+            std::cout << "Delta checkpoints require equal input and output files in the simulation file format." << std::endl;
+            return 1;
+        }
+
+        //the target time step is determined by the input, also when resuming from a checkpoint
+        auto resumed = false;
+        uint64_t targetTimestep = 0;
+        auto checkpoints = resume ? CheckpointService::getCheckpoints(outputFilename) : std::vector<std::string>();
+        if (!checkpoints.empty()) {
+            DeserializedSimulation inputAuxiliaryData;
+            if (!SerializerService::deserializeAuxiliaryDataAndStatisticsFromFiles(inputAuxiliaryData, inputFilename)) {
+                std::cout << "Could not read from input files." << std::endl;
+                return 1;
+            }
+            targetTimestep = inputAuxiliaryData.auxiliaryData.timestep + timesteps;
+            for (auto const& checkpoint : checkpoints) {
+                if (SerializerService::deserializeSimulationFromFiles(simData, mainDataReader, checkpoint)) {
+                    std::cout << "Resuming from " << checkpoint << std::endl;
+                    inputIsRawSnapshot = false;
+                    resumed = true;
+                    break;
+                }
+                std::cout << "Could not read checkpoint " << checkpoint << std::endl;
+            }
+        }
+
+        auto inputRead = resumed;
+        if (!resumed) {
+            if (inputIsRawSnapshot) {
+                inputRead = SerializerService::deserializeAuxiliaryDataAndStatisticsFromFiles(simData, inputFilename);
+            } else if (delta || !sweepFilename.empty()) {
+                inputRead = SerializerService::deserializeSimulationFromFiles(simData, inputFilename);
+            } else {
+                inputRead = SerializerService::deserializeSimulationFromFiles(simData, mainDataReader, inputFilename);
+            }
+            targetTimestep = simData.auxiliaryData.timestep + timesteps;
+        }
+        if (!inputRead) {
             std::cout << "Could not read from input files." << std::endl;
             return 1;
         }
 
+        if (seedOption->count() > 0) {
+            simData.auxiliaryData.generalSettings.seed = seed;
+        }
+
+        auto serializationSettings = SerializationSettings().format(columnar ? SerializationFormat::Columnar : SerializationFormat::PortableBinary);
+        if (compression != "gzip") {
+            serializationSettings.parallelCompression(true);
+            serializationSettings.codec(
+                compression == "deflate-fast" ? CompressionCodec::DeflateFast
+                                              : (compression == "none" ? CompressionCodec::None : CompressionCodec::Deflate));
+        }
+
+        //parameter sweep: the input is shared by all variants
+        if (!sweepFilename.empty()) {
+            if (inputIsRawSnapshot) {
+                std::cout << "A parameter sweep requires an input in the simulation file format." << std::endl;
+                return 1;
+            }
+            auto variants = ParameterSweepService::readVariants(sweepFilename, simData.auxiliaryData);
+            std::cout << "Start parameter sweep with " << variants.size() << " variants" << std::endl;
+            auto results = ParameterSweepService::run(
+                simData,
+                variants,
+                ParameterSweepSettings()
+                    .outputFilename(outputFilename)
+                    .timesteps(timesteps)
+                    .serializationSettings(serializationSettings));
+            ParameterSweepService::printSummary(results, std::cout);
+            if (!outputFilename.empty()) {
+                auto summaryFilename = std::filesystem::path(outputFilename).replace_extension(std::filesystem::path(".sweep.csv")).string();
+                if (!ParameterSweepService::writeSummaryToFile(summaryFilename, results)) {
+                    std::cout << "Could not write to output files." << std::endl;
+                    return 1;
+                }
+            }
+            auto allSucceeded = std::all_of(results.begin(), results.end(), [](auto const& result) { return result.success; });
+            std::cout << (allSucceeded ? "Finished" : "Finished with failed variants") << std::endl;
+            return allSucceeded ? 0 : 1;
+        }
+
+        //statistics file of the output is continued from the time step of the checkpoint or from the statistics of the input
+        if (batchMode) {
+            if (resumed) {
+                SerializerService::deserializeStatisticsFromFile(simData.statistics, statisticsFilename);
+                std::erase_if(simData.statistics, [&](auto const& dataPoints) { return dataPoints.time > toDouble(simData.auxiliaryData.timestep); });
+            } else if (!resume) {
+                CheckpointService::removeCheckpoints(outputFilename);
+            }
+            if (!SerializerService::serializeStatisticsToFile(statisticsFilename, simData.statistics)) {
+                std::cout << "Could not write to output files." << std::endl;
+                return 1;
+            }
+        }
+
         //run simulation
         auto startTimepoint = std::chrono::steady_clock::now();
 
-        auto simController = std::make_shared<_SimulationControllerImpl>();
-        simController->newSimulation(simData.auxiliaryData.timestep, simData.auxiliaryData.generalSettings, simData.auxiliaryData.simulationParameters);
-        simController->setClusteredSimulationData(simData.mainData);
+        SimulationController simController = std::make_shared<_SimulationControllerImpl>();
+        simController->newSimulation(
+            simData.auxiliaryData.timestep,
+            simData.auxiliaryData.generalSettings,
+            simData.auxiliaryData.simulationParameters);
+        if (inputIsRawSnapshot) {
+            simController->loadRawSnapshot(inputFilename);
+        } else if (mainDataReader) {
+            simController->setColumnarSimulationData(mainDataReader);
+        } else {
+            simController->setClusteredSimulationData(simData.mainData);
+        }
         simController->setStatisticsHistory(simData.statistics);
         simController->setRealTime(simData.auxiliaryData.realTime);
         std::cout << "Device: " << simController->getGpuName() << std::endl;
         std::cout << "Start simulation" << std::endl;
+        if (!profileFilename.empty()) {
+            simController->setProfilingEnabled(true);
+        }
+
+        auto updateAuxiliaryData = [&] {
+            simData.auxiliaryData.timestep = simController->getCurrentTimestep();
+            simData.auxiliaryData.simulationParameters = simController->getSimulationParameters();
+            simData.auxiliaryData.realTime = simController->getRealTime();
+        };
+
+        auto startTimestep = simData.auxiliaryData.timestep;
+        auto numTimesteps = targetTimestep > startTimestep ? targetTimestep - startTimestep : 0;
+        if (!batchMode) {
+            simController->calcTimesteps(numTimesteps);
+        } else {
+            //the time steps are calculated in chunks ending at the statistics and checkpoint intervals
+            std::optional<TimelineStatistics> lastRawStatistics;
+            std::optional<uint64_t> lastStatisticsTimestep;
+            auto lastCheckpointTimepoint = std::chrono::steady_clock::now();
+            auto lastReportTimepoint = lastCheckpointTimepoint;
+            auto lastReportTimestep = startTimestep;
+            auto timestep = startTimestep;
+            while (timestep < targetTimestep) {
+                auto chunk = std::min(targetTimestep - timestep, statisticsInterval - timestep % statisticsInterval);
+                if (checkpointInterval > 0) {
+                    chunk = std::min(chunk, checkpointInterval - timestep % checkpointInterval);
+                }
+                simController->calcTimesteps(chunk);
+                timestep += chunk;
 
-        simController->calcTimesteps(timesteps);
+                if (timestep % statisticsInterval == 0 || timestep == targetTimestep) {
+                    auto rawStatistics = simController->getRawStatistics().timeline;
+                    auto dataPoints =
+                        StatisticsConverterService::convert(rawStatistics, timestep, toDouble(timestep), lastRawStatistics, lastStatisticsTimestep);
+                    lastRawStatistics = rawStatistics;
+                    lastStatisticsTimestep = timestep;
+                    if (!SerializerService::appendStatisticsToFile(statisticsFilename, {dataPoints})) {
+                        std::cout << "Could not write to output files." << std::endl;
+                        return 1;
+                    }
+                }
+
+                auto now = std::chrono::steady_clock::now();
+                auto checkpointDue = (checkpointInterval > 0 && timestep % checkpointInterval == 0)
+                    || (checkpointMinutes > 0 && std::chrono::duration<double, std::ratio<60>>(now - lastCheckpointTimepoint).count() >= checkpointMinutes);
+                if (checkpointDue && timestep < targetTimestep) {
+                    updateAuxiliaryData();
+                    simData.mainData = simController->getClusteredSimulationData();
+                    if (!CheckpointService::saveCheckpoint(
+                            outputFilename, numCheckpointFiles, simData, SerializationSettings(serializationSettings).statistics(false))) {
+                        std::cout << "Could not write checkpoint." << std::endl;
+                        return 1;
+                    }
+                    std::cout << "Checkpoint saved at time step " << StringHelper::format(timestep) << std::endl;
+                    lastCheckpointTimepoint = std::chrono::steady_clock::now();
+                }
+
+                auto secondsSinceReport = std::chrono::duration<double>(now - lastReportTimepoint).count();
+                if (secondsSinceReport >= reportSeconds) {
+                    auto tps = toDouble(timestep - lastReportTimestep) / secondsSinceReport;
+                    std::cout << "Time step " << StringHelper::format(timestep) << " of " << StringHelper::format(targetTimestep) << ", "
+                              << StringHelper::format(toFloat(tps), 1) << " TPS" << std::endl;
+                    lastReportTimepoint = now;
+                    lastReportTimestep = timestep;
+                }
+            }
+        }
 
         auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTimepoint).count();
-        auto tps = ms != 0 ? 1000.0f * toFloat(timesteps) / toFloat(ms) : 0.0f; 
-        std::cout << "Simulation finished: " << StringHelper::format(timesteps) << " time steps, " << StringHelper::format(ms) << " ms, "
+        auto tps = ms != 0 ? 1000.0f * toFloat(numTimesteps) / toFloat(ms) : 0.0f; 
+        std::cout << "Simulation finished: " << StringHelper::format(numTimesteps) << " time steps, " << StringHelper::format(ms) << " ms, "
                   << StringHelper::format(tps, 1) << " TPS" << std::endl;
-        
+        if (!profileFilename.empty()) {
+            simController->setProfilingEnabled(false);
+            if (!ProfilingService::writeChromeTraceToFile(profileFilename, simController->getProfilingData())) {
+                std::cout << "Could not write to profile file." << std::endl;
+                return 1;
+            }
+        }
+
 
         //write output simulation file
         std::cout << "Writing output" << std::endl;
-        simData.auxiliaryData.timestep = static_cast<uint32_t>(simController->getCurrentTimestep());
-        simData.mainData = simController->getClusteredSimulationData();
-        simData.auxiliaryData.simulationParameters = simController->getSimulationParameters();
+        updateAuxiliaryData();
         simData.statistics = simController->getStatisticsHistory().getCopiedData();
-        simData.auxiliaryData.realTime = simController->getRealTime();
         if (outputFilename.empty()) {
             std::cout << "No output file given." << std::endl;
             return 1;
         }
-        if (!SerializerService::serializeSimulationToFiles(outputFilename, simData)) {
+        if (rawSnapshot) {
+            simController->saveRawSnapshot(outputFilename);
+            if (!SerializerService::serializeAuxiliaryDataAndStatisticsToFiles(outputFilename, simData)) {
+                std::cout << "Could not write to output files." << std::endl;
+                return 1;
+            }
+            std::cout << "Finished" << std::endl;
+            return 0;
+        }
+        auto inputMainData = std::move(simData.mainData);
+        simData.mainData = simController->getClusteredSimulationData();
+        if (batchMode) {
+            serializationSettings.statistics(false);  //the statistics file has been appended during the run
+        }
+        auto outputWritten = delta ? SerializerService::serializeDeltaCheckpointToFiles(outputFilename, simData, inputMainData, serializationSettings)
+                                   : SerializerService::serializeSimulationToFiles(outputFilename, simData, serializationSettings);
+        if (!outputWritten) {
             std::cout << "Could not write to output files." << std::endl;
             return 1;
         }
@@ -0,0 +1,191 @@
+#include "ParameterSweepService.h"
+
+#include <cctype>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <ostream>
+#include <set>
+#include <stdexcept>
+
+#include <boost/property_tree/json_parser.hpp>
+
+#include "EngineInterface/AuxiliaryDataParserService.h"
+#include "EngineInterface/StatisticsConverterService.h"
+#include "EngineImpl/SimulationControllerImpl.h"
+
+namespace
+{
+    struct SummaryColumn
+    {
+        std::string title;
+        DataPoint DataPointCollection::*dataPoint;
+    };
+    std::vector<SummaryColumn> const SummaryColumns = {
+        {"Cells", &DataPointCollection::numCells},
+        {"Self-replicators", &DataPointCollection::numSelfReplicators},
+        {"Colonies", &DataPointCollection::numColonies},
+        {"Energy particles", &DataPointCollection::numParticles},
+        {"Total energy", &DataPointCollection::totalEnergy},
+        {"Average genome complexity", &DataPointCollection::averageGenomeComplexity},
+    };
+}
+
+std::vector<ParameterSweepVariant> ParameterSweepService::readVariants(std::string const& filename, AuxiliaryData const& baseData)
+{
+    boost::property_tree::ptree tree;
+    boost::property_tree::read_json(filename, tree);
+    auto variantsTree = tree.get_child_optional("variants");
+    if (!variantsTree || variantsTree->empty()) {
+        throw std::runtime_error("The sweep file contains no variants.");
+    }
+
+    std::vector<ParameterSweepVariant> result;
+    std::set<std::string> names;
+    for (auto const& [key, variantTree] : *variantsTree) {
+        ParameterSweepVariant variant;
+        variant.name = variantTree.get<std::string>("name", "variant" + std::to_string(result.size()));
+        if (!names.insert(variant.name).second) {
+            throw std::runtime_error("The sweep file contains the variant \"" + variant.name + "\" more than once.");
+        }
+        if (auto patch = variantTree.get_child_optional("parameters")) {
+            variant.auxiliaryData = AuxiliaryDataParserService::applyPatch(baseData, *patch);
+        } else {
+            variant.auxiliaryData = baseData;
+        }
+        result.emplace_back(variant);
+    }
+    return result;
+}
+
+std::vector<ParameterSweepResult> ParameterSweepService::run(
+    DeserializedSimulation const& baseSimulation,
+    std::vector<ParameterSweepVariant> const& variants,
+    ParameterSweepSettings const& settings)
+{
+    std::vector<ParameterSweepResult> result;
+    result.reserve(variants.size());
+    for (auto const& variant : variants) {
+        result.emplace_back(runVariant(baseSimulation, variant, settings));
+    }
+    return result;
+}
+
+std::string ParameterSweepService::getVariantFilename(std::string const& outputFilename, std::string const& variantName)
+{
+    auto sanitizedName = variantName;
+    for (auto& c : sanitizedName) {
+        if (!std::isalnum(static_cast<unsigned char>(c)) && c != '-' && c != '_') {
+            c = '_';
+        }
+    }
+    std::filesystem::path result(outputFilename);
+    result.replace_extension(std::filesystem::path("." + sanitizedName + std::filesystem::path(outputFilename).extension().string()));
+    return result.string();
+}
+
+void ParameterSweepService::printSummary(std::vector<ParameterSweepResult> const& results, std::ostream& stream)
+{
+    size_t nameWidth = 7;
+    for (auto const& result : results) {
+        nameWidth = std::max(nameWidth, result.name.size());
+    }
+    stream << std::left << std::setw(nameWidth) << "Variant" << std::right << std::setw(12) << "TPS";
+    for (auto const& column : SummaryColumns) {
+        stream << std::setw(column.title.size() + 2) << column.title;
+    }
+    stream << std::endl;
+
+    for (auto const& result : results) {
+        stream << std::left << std::setw(nameWidth) << result.name << std::right;
+        if (!result.success) {
+            stream << "  failed: " << result.errorMessage << std::endl;
+            continue;
+        }
+        stream << std::setw(12) << std::fixed << std::setprecision(1) << result.tps;
+        for (auto const& column : SummaryColumns) {
+            stream << std::setw(column.title.size() + 2) << std::setprecision(2) << (result.statistics.*column.dataPoint).summedValues;
+        }
+        stream << std::endl;
+    }
+}
+
+bool ParameterSweepService::writeSummaryToFile(std::string const& filename, std::vector<ParameterSweepResult> const& results)
+{
+    try {
+        std::ofstream stream(filename, std::ios::binary);
+        if (!stream) {
+            return false;
+        }
+        stream << "Variant, Output, Time steps, TPS";
+        for (auto const& column : SummaryColumns) {
+            stream << ", " << column.title;
+        }
+        stream << std::endl;
+
+        for (auto const& result : results) {
+            if (!result.success) {
+                continue;
+            }
+            stream << result.name << "," << result.outputFilename << "," << result.timesteps << "," << result.tps;
+            for (auto const& column : SummaryColumns) {
+                stream << "," << (result.statistics.*column.dataPoint).summedValues;
+            }
+            stream << std::endl;
+        }
+        stream.close();
+        return !stream.fail();
+    } catch (...) {
+        return false;
+    }
+}
+
+ParameterSweepResult ParameterSweepService::runVariant(
+    DeserializedSimulation const& baseSimulation,
+    ParameterSweepVariant const& variant,
+    ParameterSweepSettings const& settings)
+{
+    ParameterSweepResult result;
+    result.name = variant.name;
+    if (!settings._outputFilename.empty()) {
+        result.outputFilename = getVariantFilename(settings._outputFilename, variant.name);
+    }
+
+    try {
+        auto const& auxiliaryData = variant.auxiliaryData;
+        SimulationController simController = std::make_shared<_SimulationControllerImpl>();
+        simController->newSimulation(auxiliaryData.timestep, auxiliaryData.generalSettings, auxiliaryData.simulationParameters);
+        simController->setClusteredSimulationData(baseSimulation.mainData);
+        simController->setStatisticsHistory(baseSimulation.statistics);
+        simController->setRealTime(auxiliaryData.realTime);
+
+        auto startTimepoint = std::chrono::steady_clock::now();
+        simController->calcTimesteps(settings._timesteps);
+        auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTimepoint).count();
+        result.timesteps = settings._timesteps;
+        result.tps = seconds > 0 ? toDouble(settings._timesteps) / seconds : 0;
+
+        auto timestep = simController->getCurrentTimestep();
+        result.statistics =
+            StatisticsConverterService::convert(simController->getRawStatistics().timeline, timestep, toDouble(timestep), std::nullopt, std::nullopt);
+
+        if (!result.outputFilename.empty()) {
+            DeserializedSimulation simulation;
+            simulation.auxiliaryData = auxiliaryData;
+            simulation.auxiliaryData.timestep = timestep;
+            simulation.auxiliaryData.simulationParameters = simController->getSimulationParameters();
+            simulation.auxiliaryData.realTime = simController->getRealTime();
+            simulation.statistics = simController->getStatisticsHistory().getCopiedData();
+            simulation.mainData = simController->getClusteredSimulationData();
+            if (!SerializerService::serializeSimulationToFiles(result.outputFilename, simulation, settings._serializationSettings)) {
+                throw std::runtime_error("Could not write to output files.");
+            }
+        }
+        simController->closeSimulation();
+        result.success = true;
+    } catch (std::exception const& e) {
+        result.errorMessage = e.what();
+    }
+    return result;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "Base/Definitions.h"
+#include "EngineInterface/DataPointCollection.h"
+#include "EngineInterface/SerializerService.h"
+
+struct ParameterSweepVariant
+{
+    std::string name;
+    AuxiliaryData auxiliaryData;
+};
+
+struct ParameterSweepSettings
+{
+    MEMBER_DECLARATION(ParameterSweepSettings, std::string, outputFilename, "");  //variant outputs are stored next to it, e.g. output.<name>.sim
+    MEMBER_DECLARATION(ParameterSweepSettings, uint64_t, timesteps, 0);
+    MEMBER_DECLARATION(ParameterSweepSettings, SerializationSettings, serializationSettings, SerializationSettings());
+};
+
+struct ParameterSweepResult
+{
+    std::string name;
+    std::string outputFilename;
+    bool success = false;
+    std::string errorMessage;
+    uint64_t timesteps = 0;
+    double tps = 0;
+    DataPointCollection statistics;  //at the end of the run
+};
+
+/**
+ * Runs variants of the simulation parameters on the same world, which is read only once.
+ *
+ * A sweep file has the form
+ *   {"variants": [{"name": "low friction", "parameters": {"simulation parameters.friction": 0.0005}}, ...]}
+ * where "parameters" overrides entries of the settings file (see AuxiliaryDataParserService::applyPatch).
+ *
+ * The GPU engine holds the simulation parameters in constant memory, hence there is only one GPU engine per process and the
+ * variants run one after another.
+ */
+class ParameterSweepService
+{
+public:
+    static std::vector<ParameterSweepVariant> readVariants(std::string const& filename, AuxiliaryData const& baseData);  //throws std::runtime_error
+
+    static std::vector<ParameterSweepResult> run(
+        DeserializedSimulation const& baseSimulation,
+        std::vector<ParameterSweepVariant> const& variants,
+        ParameterSweepSettings const& settings);
+
+    static std::string getVariantFilename(std::string const& outputFilename, std::string const& variantName);
+
+    static void printSummary(std::vector<ParameterSweepResult> const& results, std::ostream& stream);
+    static bool writeSummaryToFile(std::string const& filename, std::vector<ParameterSweepResult> const& results);  //CSV
+
+private:
+    static ParameterSweepResult runVariant(
+        DeserializedSimulation const& baseSimulation,
+        ParameterSweepVariant const& variant,
+        ParameterSweepSettings const& settings);
+};
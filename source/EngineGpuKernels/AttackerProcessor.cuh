@@ -224,10 +224,11 @@ __device__ __inline__ void AttackerProcessor::radiate(SimulationData& data, Cell
             return;
         }
 
+        PhiloxRandom numberGen(data.seed, data.timestep, cell->id, RandomPurpose_CellFunction);
         float2 particleVel = (cell->vel * cudaSimulationParameters.radiationVelocityMultiplier)
             + float2{
-                (data.numberGen1.random() - 0.5f) * cudaSimulationParameters.radiationVelocityPerturbation,
-                (data.numberGen1.random() - 0.5f) * cudaSimulationParameters.radiationVelocityPerturbation};
+                (numberGen.random() - 0.5f) * cudaSimulationParameters.radiationVelocityPerturbation,
+                (numberGen.random() - 0.5f) * cudaSimulationParameters.radiationVelocityPerturbation};
         float2 particlePos = cell->pos + Math::normalized(particleVel) * 1.5f - particleVel;
         data.cellMap.correctPosition(particlePos);
 
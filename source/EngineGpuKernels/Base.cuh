@@ -11,32 +11,9 @@
 #include "CudaMemoryManager.cuh"
 #include "Definitions.cuh"
 #include "HashSet.cuh"
+#include "HostDevice.cuh"
 #include "Util.cuh"
 
-template<typename T>
-__device__ __host__ inline float toFloat(T value)
-{
-    return static_cast<float>(value);
-}
-
-template <typename T>
-__device__ __host__ inline double toDouble(T value)
-{
-    return static_cast<double>(value);
-}
-
-template <typename T>
-__device__ __host__ inline int toInt(T value)
-{
-    return static_cast<int>(value);
-}
-
-template <typename T>
-__device__ __host__ inline uint64_t toUInt64(T value)
-{
-    return static_cast<uint64_t>(value);
-}
-
 struct PartitionData
 {
     int startIndex;
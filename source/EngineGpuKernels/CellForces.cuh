@@ -0,0 +1,208 @@
+#pragma once
+
+#include "EngineInterface/Motion.h"
+
+#include "HostDevice.cuh"
+#include "Math.cuh"
+
+/**
+ * Force calculations of the physics part of a time step, shared between CellProcessor (device) and _SimulationCpuFacade (host).
+ *
+ * Cells are accessed via a CellAccess type which hides the memory layout of the backend:
+ *   using Handle = ...;
+ *   int getNumConnections(Handle cell) const;
+ *   Handle getConnectedCell(Handle cell, int connectionIndex) const;
+ *   float getBondDistance(Handle cell, int connectionIndex) const;
+ *   float getAngleFromPrevious(Handle cell, int connectionIndex) const;
+ *   float2 getPos(Handle cell) const;
+ *   float getStiffness(Handle cell) const;
+ *   bool isBarrier(Handle cell) const;
+ *   float2* getForce(Handle cell) const;
+ *   void correctDirection(float2& direction) const;
+ */
+class CellForces
+{
+public:
+    //cubic spline kernel for smoothed particle hydrodynamics and its derivative
+    __inline__ __host__ __device__ static float calcKernel(float q);
+    __inline__ __host__ __device__ static float calcKernel_d(float q);
+
+    //force on a cell from a non-connected cell in collision mode; the other cell receives the negated force
+    __inline__ __host__ __device__ static float2
+    calcCollisionForce(float2 const& posDelta, float2 const& vel, float2 const& otherVel, bool barrier, CollisionMotion const& motion);
+
+    //pressure and viscosity contributions of a non-connected neighbor in fluid mode (pressure = density from last time step)
+    __inline__ __host__ __device__ static void calcFluidForces(
+        float2 const& posDelta,
+        float distance,
+        float2 const& velDelta,
+        float density,
+        float otherDensity,
+        float smoothingLength,
+        float2& pressureForce,
+        float2& viscosityForce);
+
+    //reflection at the closest barrier cell, r: normal of the barrier surface
+    __inline__ __host__ __device__ static float2 calcBarrierReflectionForce(float2 const& vel, float2 const& barrierVel, float2 const& r, float distance);
+
+    //bond and angle forces of a cell; angle forces are also added to the connected cells
+    template <typename Execution, typename CellAccess>
+    __inline__ __host__ __device__ static void
+    calcConnectionForces(CellAccess const& access, typename CellAccess::Handle cell, bool considerAngles, float cellMinDistance);
+};
+
+/************************************************************************/
+/* Implementation                                                       */
+/************************************************************************/
+
+__inline__ __host__ __device__ float CellForces::calcKernel(float q)
+{
+    float result;
+    if (q < 1) {
+        result = 2.0f / 3.0f - q * q + 0.5f * q * q * q;
+    } else if (q < 2) {
+        result = 2.0f - q;
+        result = result * result * result / 6;
+    } else {
+        result = 0;
+    }
+    result *= 3.0f / (2.0f * Const::PI);
+    return result;
+}
+
+__inline__ __host__ __device__ float CellForces::calcKernel_d(float q)
+{
+    float result;
+    if (q < 1) {
+        result = -2 * q + 3.0f / 2.0f * q * q;
+    } else if (q < 2) {
+        result = -0.5f * (2.0f - q) * (2.0f - q);
+    } else {
+        result = 0;
+    }
+    result *= 3.0f / (2.0f * Const::PI);
+    return result;
+}
+
+__inline__ __host__ __device__ float2
+CellForces::calcCollisionForce(float2 const& posDelta, float2 const& vel, float2 const& otherVel, bool barrier, CollisionMotion const& motion)
+{
+    auto velDelta = vel - otherVel;
+    auto isApproaching = Math::dot(posDelta, velDelta) < 0;
+    auto barrierFactor = barrier ? 2.0f : 1.0f;
+
+    if (Math::length(vel) > 0.5f && isApproaching) {
+        auto distanceSquared = Math::lengthSquared(posDelta) + 0.25f;
+        return posDelta * Math::dot(velDelta, posDelta) / (-2 * distanceSquared) * barrierFactor;
+    } else {
+        return Math::normalized(posDelta) * (motion.cellMaxCollisionDistance - Math::length(posDelta)) * motion.cellRepulsionStrength * barrierFactor;
+    }
+}
+
+__inline__ __host__ __device__ void CellForces::calcFluidForces(
+    float2 const& posDelta,
+    float distance,
+    float2 const& velDelta,
+    float density,
+    float otherDensity,
+    float smoothingLength,
+    float2& pressureForce,
+    float2& viscosityForce)
+{
+    if (fabsf(distance) <= NEAR_ZERO) {
+        pressureForce = {0, 0};
+        viscosityForce = {0, 0};
+        return;
+    }
+    auto factor = density / (density * density) + otherDensity / (otherDensity * otherDensity);
+    auto kernel_d = calcKernel_d(distance / smoothingLength) / (smoothingLength * smoothingLength * smoothingLength);
+
+    pressureForce = posDelta / (-distance) * factor * kernel_d;
+    viscosityForce = velDelta / otherDensity * distance * kernel_d / (distance * distance + 0.25f);
+}
+
+__inline__ __host__ __device__ float2 CellForces::calcBarrierReflectionForce(float2 const& vel, float2 const& barrierVel, float2 const& r, float distance)
+{
+    auto vr = vel - barrierVel;
+    auto dot_vr_r = Math::dot(vr, r);
+    if (dot_vr_r >= 0) {
+        return {0, 0};
+    }
+    auto truncated_r_squared = fmaxf(0.05f, Math::lengthSquared(r));
+    auto truncated_distance = fmaxf(0.05f, distance);
+    return (vr - r * 2 * dot_vr_r / truncated_r_squared + barrierVel - vel) / truncated_distance;
+}
+
+HOST_DEVICE_EXEC_CHECK_DISABLE
+template <typename Execution, typename CellAccess>
+__inline__ __host__ __device__ void
+CellForces::calcConnectionForces(CellAccess const& access, typename CellAccess::Handle cell, bool considerAngles, float cellMinDistance)
+{
+    auto numConnections = access.getNumConnections(cell);
+    float2 force{0, 0};
+    float2 prevDisplacement = access.getPos(access.getConnectedCell(cell, numConnections - 1)) - access.getPos(cell);
+    access.correctDirection(prevDisplacement);
+    auto cellStiffnessSquared = access.getStiffness(cell) * access.getStiffness(cell);
+
+    for (int i = 0; i < numConnections; ++i) {
+        auto connectedCell = access.getConnectedCell(cell, i);
+        auto connectedCellStiffnessSquared = access.getStiffness(connectedCell) * access.getStiffness(connectedCell);
+
+        auto displacement = access.getPos(connectedCell) - access.getPos(cell);
+        access.correctDirection(displacement);
+
+        auto actualDistance = Math::length(displacement);
+        auto bondDistance = access.getBondDistance(cell, i);
+        auto deviation = actualDistance - bondDistance;
+        force = force + Math::normalized(displacement) * deviation * (cellStiffnessSquared + connectedCellStiffnessSquared) / 6;
+
+        if (considerAngles && (numConnections > 2 || (numConnections == 2 && i == 0))) {
+
+            auto lastIndex = (i + numConnections - 1) % numConnections;
+            auto lastConnectedCell = access.getConnectedCell(cell, lastIndex);
+
+            //check if there is a triangular connection
+            bool triangularConnection = false;
+            for (int j = 0; j < access.getNumConnections(connectedCell); ++j) {
+                if (access.getConnectedCell(connectedCell, j) == lastConnectedCell) {
+                    triangularConnection = true;
+                    break;
+                }
+            }
+
+            //angle forces in case of no triangular connections
+            if (!triangularConnection) {
+                auto angle = Math::angleOfVector(displacement);
+                auto prevAngle = Math::angleOfVector(prevDisplacement);
+                auto actualAngleFromPrevious = Math::subtractAngle(angle, prevAngle);
+                if (actualAngleFromPrevious < 0) {
+                    continue;
+                }
+                auto referenceAngleFromPrevious = access.getAngleFromPrevious(cell, i);
+
+                auto strength = fabsf(referenceAngleFromPrevious - actualAngleFromPrevious) / 2000 * cellStiffnessSquared;
+
+                auto force1 = Math::normalized(displacement) / fmaxf(Math::length(displacement), cellMinDistance) * strength;
+                Math::rotateQuarterClockwise(force1);
+
+                auto force2 = Math::normalized(prevDisplacement) / fmaxf(Math::length(prevDisplacement), cellMinDistance) * strength;
+                Math::rotateQuarterCounterClockwise(force2);
+
+                if (referenceAngleFromPrevious < actualAngleFromPrevious) {
+                    force1 = force1 * (-1);
+                    force2 = force2 * (-1);
+                }
+                if (!access.isBarrier(connectedCell)) {
+                    Execution::atomicAdd(access.getForce(connectedCell), force1);
+                }
+                if (!access.isBarrier(lastConnectedCell)) {
+                    Execution::atomicAdd(access.getForce(lastConnectedCell), force2);
+                }
+                force -= force1 + force2;
+            }
+        }
+
+        prevDisplacement = displacement;
+    }
+    Execution::atomicAdd(access.getForce(cell), force);
+}
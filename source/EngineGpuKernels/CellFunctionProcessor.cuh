@@ -22,7 +22,8 @@ public:
         float referenceAngle;
         float actualAngle;
     };
-    __inline__ __device__ static ReferenceAndActualAngle calcLargestGapReferenceAndActualAngle(SimulationData& data, Cell* cell, float angleDeviation);
+    __inline__ __device__ static ReferenceAndActualAngle
+    calcLargestGapReferenceAndActualAngle(SimulationData& data, PhiloxRandom& numberGen, Cell* cell, float angleDeviation);
 
     __inline__ __device__ static float2 calcSignalDirection(SimulationData& data, Cell* cell);
 
@@ -177,10 +178,10 @@ __inline__ __device__ void CellFunctionProcessor::updateInvocationState(Cell* ce
 }
 
 __inline__ __device__ CellFunctionProcessor::ReferenceAndActualAngle
-CellFunctionProcessor::calcLargestGapReferenceAndActualAngle(SimulationData& data, Cell* cell, float angleDeviation)
+CellFunctionProcessor::calcLargestGapReferenceAndActualAngle(SimulationData& data, PhiloxRandom& numberGen, Cell* cell, float angleDeviation)
 {
     if (0 == cell->numConnections) {
-        return ReferenceAndActualAngle{0, data.numberGen1.random()*360};
+        return ReferenceAndActualAngle{0, numberGen.random()*360};
     }
     auto displacement = cell->connections[0].cell->pos - cell->pos;
     data.cellMap.correctDirection(displacement);
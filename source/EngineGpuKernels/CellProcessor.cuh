@@ -7,6 +7,8 @@
 
 #include "TOs.cuh"
 #include "Base.cuh"
+#include "CellForces.cuh"
+#include "DeviceExecution.cuh"
 #include "ObjectFactory.cuh"
 #include "Map.cuh"
 #include "Physics.cuh"
@@ -89,34 +91,25 @@ __inline__ __device__ void CellProcessor::fillDensityMap(SimulationData& data)
 
 namespace
 {
-    __inline__ __device__ float calcKernel(float q)
+    struct DeviceCellAccess
     {
-        float result;
-        if (q < 1) {
-            result = 2.0f / 3.0f - q * q + 0.5f * q * q * q;
-        } else if (q < 2) {
-            result = 2.0f - q;
-            result = result * result * result / 6;
-        } else {
-            result = 0;
-        }
-        result *= 3.0f / (2.0f * Const::PI);
-        return result;
-    }
-
-    __inline__ __device__ float calcKernel_d(float q)
-    {
-        float result;
-        if (q < 1) {
-            result = -2 * q + 3.0f / 2.0f * q * q;
-        } else if (q < 2) {
-            result = -0.5f * (2.0f - q) * (2.0f - q);
-        } else {
-            result = 0;
-        }
-        result *= 3.0f / (2.0f * Const::PI);
-        return result;
-    }
+        using Handle = Cell*;
+
+        CellMap const& cellMap;
+
+        __inline__ __device__ int getNumConnections(Cell* cell) const { return cell->numConnections; }
+        __inline__ __device__ Cell* getConnectedCell(Cell* cell, int connectionIndex) const { return cell->connections[connectionIndex].cell; }
+        __inline__ __device__ float getBondDistance(Cell* cell, int connectionIndex) const { return cell->connections[connectionIndex].distance; }
+        __inline__ __device__ float getAngleFromPrevious(Cell* cell, int connectionIndex) const
+        {
+            return cell->connections[connectionIndex].angleFromPrevious;
+        }
+        __inline__ __device__ float2 getPos(Cell* cell) const { return cell->pos; }
+        __inline__ __device__ float getStiffness(Cell* cell) const { return cell->stiffness; }
+        __inline__ __device__ bool isBarrier(Cell* cell) const { return cell->barrier; }
+        __inline__ __device__ float2* getForce(Cell* cell) const { return &cell->shared1; }
+        __inline__ __device__ void correctDirection(float2& direction) const { cellMap.correctDirection(direction); }
+    };
 }
 
 __inline__ __device__ void CellProcessor::calcFluidForces_reconnectCells_correctOverlap(SimulationData& data)
@@ -180,7 +173,7 @@ __inline__ __device__ void CellProcessor::calcFluidForces_reconnectCells_correct
             if (!otherCell->barrier && distance <= smoothingLength * 2 && cell->detached + otherCell->detached != 1) {
 
                 //calc density
-                atomicAdd_block(&density, calcKernel(distance / smoothingLength) / (smoothingLength * smoothingLength));
+                atomicAdd_block(&density, CellForces::calcKernel(distance / smoothingLength) / (smoothingLength * smoothingLength));
 
                 if (cell != otherCell) {
 
@@ -201,21 +194,14 @@ __inline__ __device__ void CellProcessor::calcFluidForces_reconnectCells_correct
 
                         //calc forces: for simplicity pressure = density
                         auto velDelta = cell->vel - otherCell->vel;
-                        auto const& cellPressure = cell->density;            //optimization: using the density from last time step
-                        auto const& otherCellPressure = otherCell->density;  //optimization: using the density from last time step
-                        auto factor = (cellPressure / (cell->density * cell->density) + otherCellPressure / (otherCell->density * otherCell->density));
-
-                        if (abs(distance) > NEAR_ZERO) {
-                            float kernel_d = calcKernel_d(distance / smoothingLength) / (smoothingLength * smoothingLength * smoothingLength);
-
-                            auto F_pressureDelta = posDelta / (-distance) * factor * kernel_d;
-                            atomicAdd_block(&F_pressure.x, F_pressureDelta.x);
-                            atomicAdd_block(&F_pressure.y, F_pressureDelta.y);
-
-                            auto F_viscosityDelta = velDelta / otherCell->density * distance * kernel_d / (distance * distance + 0.25f);
-                            atomicAdd_block(&F_viscosity.x, F_viscosityDelta.x);
-                            atomicAdd_block(&F_viscosity.y, F_viscosityDelta.y);
-                        }
+                        float2 F_pressureDelta;
+                        float2 F_viscosityDelta;
+                        CellForces::calcFluidForces(
+                            posDelta, distance, velDelta, cell->density, otherCell->density, smoothingLength, F_pressureDelta, F_viscosityDelta);
+                        atomicAdd_block(&F_pressure.x, F_pressureDelta.x);
+                        atomicAdd_block(&F_pressure.y, F_pressureDelta.y);
+                        atomicAdd_block(&F_viscosity.x, F_viscosityDelta.x);
+                        atomicAdd_block(&F_viscosity.y, F_viscosityDelta.y);
 
                         //fusion
                         if (Math::length(velDelta) >= cellFusionVelocity && cell->numConnections < cell->maxConnections
@@ -263,14 +249,7 @@ __inline__ __device__ void CellProcessor::calcFluidForces_reconnectCells_correct
                         }
                     }
                 }
-                auto vr = cell->vel - closestBarrierCell->vel;
-                auto dot_vr_r = Math::dot(vr, r);
-
-                if (dot_vr_r < 0) {
-                    auto truncated_r_squared = max(0.05f, Math::lengthSquared(r));
-                    auto truncated_distance = max(0.05f, closestBarrierCellDistance);
-                    cell->shared1 += (vr - r * 2 * dot_vr_r / truncated_r_squared + closestBarrierCell->vel - cell->vel) / truncated_distance;
-                }
+                cell->shared1 += CellForces::calcBarrierReflectionForce(cell->vel, closestBarrierCell->vel, r, closestBarrierCellDistance);
             }
 
             cell->pos += cellPosDelta;
@@ -321,24 +300,10 @@ __inline__ __device__ void CellProcessor::calcCollisions_reconnectCells_correctO
                     //collision algorithm
                     auto velDelta = cell->vel - otherCell->vel;
                     auto isApproaching = Math::dot(posDelta, velDelta) < 0;
-                    auto barrierFactor = cell->barrier ? 2 : 1;
-
-                    if (Math::length(cell->vel) > 0.5f && isApproaching) {
-                        auto distanceSquared = distance * distance + 0.25f;
-                        auto force = posDelta * Math::dot(velDelta, posDelta) / (-2 * distanceSquared) * barrierFactor;
-                        atomicAdd(&cell->shared1.x, force.x);
-                        atomicAdd(&cell->shared1.y, force.y);
-                        atomicAdd(&otherCell->shared1.x, -force.x);
-                        atomicAdd(&otherCell->shared1.y, -force.y);
-                    } else {
-                        auto force = Math::normalized(posDelta)
-                            * (cudaSimulationParameters.motionData.collisionMotion.cellMaxCollisionDistance - Math::length(posDelta))
-                            * cudaSimulationParameters.motionData.collisionMotion.cellRepulsionStrength * barrierFactor;
-                        atomicAdd(&cell->shared1.x, force.x);
-                        atomicAdd(&cell->shared1.y, force.y);
-                        atomicAdd(&otherCell->shared1.x, -force.x);
-                        atomicAdd(&otherCell->shared1.y, -force.y);
-                    }
+                    auto force = CellForces::calcCollisionForce(
+                        posDelta, cell->vel, otherCell->vel, cell->barrier, cudaSimulationParameters.motionData.collisionMotion);
+                    DeviceExecution::atomicAdd(&cell->shared1, force);
+                    DeviceExecution::atomicAdd(&otherCell->shared1, force * (-1));
 
                     //fusion
                     auto cellMaxBindingEnergy = SpotCalculator::calcParameter(
@@ -408,86 +373,15 @@ __inline__ __device__ void CellProcessor::applyForces(SimulationData& data)
 __inline__ __device__ void CellProcessor::calcConnectionForces(SimulationData& data, bool considerAngles)
 {
     auto& cells = data.objects.cellPointers;
-    auto const partition = calcAllThreadsPartition(cells.getNumEntries());
+    DeviceCellAccess access{data.cellMap};
 
-    for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+    DeviceExecution::forEach(cells.getNumEntries(), [&](int index) {
         auto& cell = cells.at(index);
         if (0 == cell->numConnections || cell->barrier) {
-            continue;
-        }
-        float2 force{0, 0};
-        float2 prevDisplacement = cell->connections[cell->numConnections - 1].cell->pos - cell->pos;
-        data.cellMap.correctDirection(prevDisplacement);
-        auto cellStiffnessSquared = cell->stiffness * cell->stiffness;
-
-        auto numConnections = cell->numConnections;
-        for (int i = 0; i < numConnections; ++i) {
-            auto connectedCell = cell->connections[i].cell;
-            auto connectedCellStiffnessSquared = connectedCell->stiffness * connectedCell->stiffness;
-
-            auto displacement = connectedCell->pos - cell->pos;
-            data.cellMap.correctDirection(displacement);
-
-            auto actualDistance = Math::length(displacement);
-            auto bondDistance = cell->connections[i].distance;
-            auto deviation = actualDistance - bondDistance;
-            force = force + Math::normalized(displacement) * deviation * (cellStiffnessSquared + connectedCellStiffnessSquared) / 6;
-
-            if (considerAngles && (numConnections > 2 || (numConnections == 2 && i == 0))) {
-
-                auto lastIndex = (i + numConnections - 1) % numConnections;
-                auto lastConnectedCell = cell->connections[lastIndex].cell;
-
-                //check if there is a triangular connection
-                bool triangularConnection = false;
-                for (int j = 0; j < connectedCell->numConnections; ++j) {
-                    if (connectedCell->connections[j].cell == lastConnectedCell) {
-                        triangularConnection = true;
-                        break;
-                    }
-                }
-
-                //angle forces in case of no triangular connections
-                if (!triangularConnection) {
-                    auto angle = Math::angleOfVector(displacement);
-                    auto prevAngle = Math::angleOfVector(prevDisplacement);
-                    auto actualAngleFromPrevious = Math::subtractAngle(angle, prevAngle);
-                    if (actualAngleFromPrevious < 0) {
-                        continue;
-                    }
-                    auto referenceAngleFromPrevious = cell->connections[i].angleFromPrevious;
-
-                    auto strength = abs(referenceAngleFromPrevious - actualAngleFromPrevious) / 2000 * cellStiffnessSquared;
-
-                    auto force1 = Math::normalized(displacement) / max(Math::length(displacement), cudaSimulationParameters.cellMinDistance) * strength;
-                    Math::rotateQuarterClockwise(force1);
-
-                    auto force2 =
-                        Math::normalized(prevDisplacement) / max(Math::length(prevDisplacement), cudaSimulationParameters.cellMinDistance) * strength;
-                    Math::rotateQuarterCounterClockwise(force2);
-
-                    if (referenceAngleFromPrevious < actualAngleFromPrevious) {
-                        force1 = force1 * (-1);
-                        force2 = force2 * (-1);
-                    }
-                    if (!connectedCell->barrier) {
-                        atomicAdd(&connectedCell->shared1.x, force1.x);
-                        atomicAdd(&connectedCell->shared1.y, force1.y);
-                    }
-                    auto otherConnectedCell = cell->connections[lastIndex].cell;
-                    if (!otherConnectedCell->barrier) {
-                        atomicAdd(&otherConnectedCell->shared1.x, force2.x);
-                        atomicAdd(&otherConnectedCell->shared1.y, force2.y);
-                    }
-                    force -= force1 + force2;
-                }
-            }
-
-            prevDisplacement = displacement;
+            return;
         }
-        atomicAdd(&cell->shared1.x, force.x);
-        atomicAdd(&cell->shared1.y, force.y);
-    }
+        CellForces::calcConnectionForces<DeviceExecution>(access, cell, considerAngles, cudaSimulationParameters.cellMinDistance);
+    });
 }
 
 __inline__ __device__ void CellProcessor::checkConnections(SimulationData& data)
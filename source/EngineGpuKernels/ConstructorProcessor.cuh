@@ -342,7 +342,8 @@ ConstructorProcessor::startNewConstruction(SimulationData& data, SimulationStati
     if (!isConnectable(hostCell->numConnections, hostCell->maxConnections, true)) {
         return nullptr;
     }
-    auto anglesForNewConnection = CellFunctionProcessor::calcLargestGapReferenceAndActualAngle(data, hostCell, constructionData.angle);
+    PhiloxRandom numberGen(data.seed, data.timestep, hostCell->id, RandomPurpose_CellFunction);
+    auto anglesForNewConnection = CellFunctionProcessor::calcLargestGapReferenceAndActualAngle(data, numberGen, hostCell, constructionData.angle);
 
     auto newCellDirection = Math::unitVectorOfAngle(anglesForNewConnection.actualAngle);
     float2 newCellPos = hostCell->pos + newCellDirection;
@@ -360,7 +361,7 @@ ConstructorProcessor::startNewConstruction(SimulationData& data, SimulationStati
     }
 
     if (GenomeDecoder::containsSelfReplication(constructor)) {
-        constructor.offspringCreatureId = 1 + data.numberGen1.random(65535);
+        constructor.offspringCreatureId = 1 + numberGen.random(65535);
 
         hostCell->genomeComplexity = calcGenomeComplexity(hostCell->color, constructor.genome, constructor.genomeSize);
     } else {
@@ -11,6 +11,7 @@
 #include "CudaMemoryManager.cuh"
 #include "Base.cuh"
 #include "Definitions.cuh"
+#include "PhiloxRandom.cuh"
 
 class CudaNumberGenerator
 {
@@ -23,7 +24,8 @@ private:
     unsigned int* _currentSmallId;
 
 public:
-    void init(int size)
+    //the pool of random numbers is determined by seed and timestep
+    void init(int size, uint64_t seed, uint64_t timestep, RandomPurpose purpose)
     {
         _size = size;
 
@@ -38,9 +40,10 @@ public:
         unsigned int hostCurrentSmallId = 1;
         CHECK_FOR_CUDA_ERROR(cudaMemcpy(_currentSmallId, &hostCurrentSmallId, sizeof(unsigned int), cudaMemcpyHostToDevice));
 
+        PhiloxRandom generator(seed, timestep, 0, purpose);
         std::vector<int> randomNumbers(size);
         for (int i = 0; i < size; ++i) {
-            randomNumbers[i] = rand();
+            randomNumbers[i] = static_cast<int>(generator.randomUInt32() % (static_cast<uint32_t>(RAND_MAX) + 1));
         }
         CHECK_FOR_CUDA_ERROR(cudaMemcpy(_array, randomNumbers.data(), sizeof(int) * size, cudaMemcpyHostToDevice));
     }
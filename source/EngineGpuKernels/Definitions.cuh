@@ -46,6 +46,9 @@ using MaxAgeBalancer = std::shared_ptr<_MaxAgeBalancer>;
 class _StatisticsService;
 using StatisticsService = std::shared_ptr<_StatisticsService>;
 
+class _SimulationProfiler;
+using SimulationProfiler = std::shared_ptr<_SimulationProfiler>;
+
 struct ApplyForceData
 {
     float2 startPos;
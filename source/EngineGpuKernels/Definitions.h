@@ -2,5 +2,8 @@
 
 #include <memory>
 
+class _SimulationFacade;
+using SimulationFacade = std::shared_ptr<_SimulationFacade>;
+
 class _SimulationCudaFacade;
 using CudaSimulationFacade = std::shared_ptr<_SimulationCudaFacade>;
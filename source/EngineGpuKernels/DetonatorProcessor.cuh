@@ -48,6 +48,7 @@ __device__ __inline__ void DetonatorProcessor::processCell(SimulationData& data,
         if (detonator.countdown == -1) {
             detonator.countdown = 0;
             statistics.incNumDetonations(cell->color);
+            PhiloxRandom numberGen(data.seed, data.timestep, cell->id, RandomPurpose_CellFunction);
             data.cellMap.executeForEach(
                 cell->pos, cudaSimulationParameters.cellFunctionDetonatorRadius[cell->color], cell->detached, [&](Cell* const& otherCell) {
                     if (otherCell == cell) {
@@ -63,7 +64,7 @@ __device__ __inline__ void DetonatorProcessor::processCell(SimulationData& data,
                         otherCell->vel += force;
                     }
                     if (otherCell->cellFunction == CellFunction_Detonator && otherCell->cellFunctionData.detonator.state != DetonatorState_Exploded) {
-                        if (data.numberGen1.random() < cudaSimulationParameters.cellFunctionDetonatorChainExplosionProbability[cell->color]) {
+                        if (numberGen.random() < cudaSimulationParameters.cellFunctionDetonatorChainExplosionProbability[cell->color]) {
                             otherCell->cellFunctionData.detonator.state = DetonatorState_Activated;
                             otherCell->cellFunctionData.detonator.countdown = 1;
                         }
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "Base.cuh"
+
+/**
+ * Execution policy for shared host/device code on the device, see HostDevice.cuh.
+ */
+struct DeviceExecution
+{
+    __inline__ __device__ static void atomicAdd(float* address, float value) { ::atomicAdd(address, value); }
+
+    __inline__ __device__ static void atomicAdd(float2* address, float2 const& value)
+    {
+        ::atomicAdd(&address->x, value.x);
+        ::atomicAdd(&address->y, value.y);
+    }
+
+    template <typename Func>
+    __inline__ __device__ static void forEach(int numEntities, Func const& func)
+    {
+        auto const partition = calcAllThreadsPartition(numEntities);
+        for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+            func(index);
+        }
+    }
+};
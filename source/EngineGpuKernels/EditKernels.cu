@@ -623,23 +623,23 @@ __global__ void cudaApplyCataclysm(SimulationData data)
         if (cell->cellFunction == CellFunction_Constructor) {
             if (data.numberGen1.random() < 0.3f) {
                 for (int j = 0; j < 100; ++j) {
-                    MutationProcessor::neuronDataMutation(data, cell);
+                    MutationProcessor::neuronDataMutation(data, cell, data.numberGen1);
                 }
                 for (int j = 0; j < 50; ++j) {
-                    MutationProcessor::propertiesMutation(data, cell);
+                    MutationProcessor::propertiesMutation(data, cell, data.numberGen1);
                 }
-                MutationProcessor::geometryMutation(data, cell);
-                MutationProcessor::customGeometryMutation(data, cell);
-                MutationProcessor::cellFunctionMutation(data, cell);
+                MutationProcessor::geometryMutation(data, cell, data.numberGen1);
+                MutationProcessor::customGeometryMutation(data, cell, data.numberGen1);
+                MutationProcessor::cellFunctionMutation(data, cell, data.numberGen1);
                 int num = data.numberGen1.random(5);
                 for (int i = 0; i < num; ++i) {
-                    MutationProcessor::insertMutation(data, cell);
+                    MutationProcessor::insertMutation(data, cell, data.numberGen1);
                 }
-                //                MutationProcessor::translateMutation(data, cell);
+                //                MutationProcessor::translateMutation(data, cell, data.numberGen1);
                 for (int i = 0; i < 2; ++i) {
-                    MutationProcessor::duplicateMutation(data, cell);
+                    MutationProcessor::duplicateMutation(data, cell, data.numberGen1);
                 }
-                //                MutationProcessor::deleteMutation(data, cell);
+                //                MutationProcessor::deleteMutation(data, cell, data.numberGen1);
             }
         }
     }
@@ -14,11 +14,13 @@ void _GarbageCollectorKernelsLauncher::cleanupAfterTimestep(GpuSettings const& g
 {
     KERNEL_CALL(cudaCleanupCellMap, data);
     KERNEL_CALL(cudaCleanupParticleMap, data);
+    endPhase(GpuPhase_CleanupMaps);
 
     KERNEL_CALL_1_1(cudaPreparePointerArraysForCleanup, data);
     KERNEL_CALL(cudaCleanupPointerArray<Particle*>, data.objects.particlePointers, data.tempObjects.particlePointers);
     KERNEL_CALL(cudaCleanupPointerArray<Cell*>, data.objects.cellPointers, data.tempObjects.cellPointers);
     KERNEL_CALL_1_1(cudaSwapPointerArrays, data);
+    endPhase(GpuPhase_CleanupPointerArrays);
 
     KERNEL_CALL_1_1(cudaCheckIfCleanupIsNecessary, data, _cudaBool);
     cudaDeviceSynchronize();
@@ -29,6 +31,7 @@ void _GarbageCollectorKernelsLauncher::cleanupAfterTimestep(GpuSettings const& g
         KERNEL_CALL(cudaCleanupCellsStep2, data.tempObjects.cells);
         KERNEL_CALL(cudaCleanupAuxiliaryData, data.objects.cellPointers, data.tempObjects.auxiliaryData);
         KERNEL_CALL_1_1(cudaSwapArrays, data);
+        endPhase(GpuPhase_CleanupArrays);
     }
 }
 
@@ -65,3 +68,15 @@ void _GarbageCollectorKernelsLauncher::swapArrays(GpuSettings const& gpuSettings
     KERNEL_CALL_1_1(cudaSwapPointerArrays, data);
     KERNEL_CALL_1_1(cudaSwapArrays, data);
 }
+
+void _GarbageCollectorKernelsLauncher::setProfiler(SimulationProfiler const& profiler)
+{
+    _profiler = profiler;
+}
+
+void _GarbageCollectorKernelsLauncher::endPhase(GpuPhase phase)
+{
+    if (_profiler) {
+        _profiler->endPhase(phase);
+    }
+}
@@ -6,6 +6,7 @@
 #include "Macros.cuh"
 #include "Base.cuh"
 #include "GarbageCollectorKernels.cuh"
+#include "SimulationProfiler.cuh"
 
 class _GarbageCollectorKernelsLauncher
 {
@@ -18,7 +19,13 @@ public:
     void copyArrays(GpuSettings const& gpuSettings, SimulationData const& simulationData);
     void swapArrays(GpuSettings const& gpuSettings, SimulationData const& simulationData);
 
+    void setProfiler(SimulationProfiler const& profiler);  //measures cleanupAfterTimestep, nullptr = profiling disabled
+
 private:
+    void endPhase(GpuPhase phase);
+
+    SimulationProfiler _profiler;
+
     //gpu memory
     bool* _cudaBool;
 };
@@ -1,108 +1,150 @@
 #pragma once
 
-#include <nppdefs.h>
+#include <limits.h>
 
 #include "EngineInterface/CellFunctionConstants.h"
+#include "EngineInterface/EngineConstants.h"
 #include "EngineInterface/GenomeConstants.h"
-#include "Base.cuh"
-#include "Object.cuh"
 
+#include "HostDevice.cuh"
+
+struct GenomeHeader
+{
+    ConstructionShape shape;
+    int numBranches;
+    bool separateConstruction;
+    ConstructorAngleAlignment angleAlignment;
+    float stiffness;
+    float connectionDistance;
+    int numRepetitions;
+    float concatenationAngle1;
+    float concatenationAngle2;
+
+    __inline__ __host__ __device__ bool hasInfiniteRepetitions() const { return numRepetitions == INT_MAX; }
+};
+
+/**
+ * Decodes and edits genomes in place. The methods are shared by the device and the host, except copyGenome which allocates
+ * from the device heap. Random choices are drawn from a generator passed as argument (CudaNumberGenerator or PhiloxRandom).
+ */
 class GenomeDecoder
 {
 public:
     //genome-wide methods
     template <typename Func>
-    __inline__ __device__ static void executeForEachNode(uint8_t* genome, int genomeSize, Func func);
+    __inline__ __host__ __device__ static void executeForEachNode(uint8_t* genome, int genomeSize, Func func);
     template <typename Func>
-    __inline__ __device__ static void executeForEachNodeRecursively(uint8_t* genome, int genomeSize, bool includedSeparatedParts, bool countBranches, Func func);
-    __inline__ __device__ static GenomeHeader readGenomeHeader(ConstructorFunction const& constructor);
-    __inline__ __device__ static int getGenomeDepth(uint8_t* genome, int genomeSize);
-    __inline__ __device__ static int getNumNodesRecursively(uint8_t* genome, int genomeSize, bool includeRepetitions, bool includedSeparatedParts);
-    __inline__ __device__ static int getRandomGenomeNodeAddress(
-        SimulationData& data,
+    __inline__ __host__ __device__ static void executeForEachNodeRecursively(uint8_t* genome, int genomeSize, bool includedSeparatedParts, bool countBranches, Func func);
+    template <typename ConstructorOrInjector>
+    __inline__ __host__ __device__ static GenomeHeader readGenomeHeader(ConstructorOrInjector const& constructor);
+    __inline__ __host__ __device__ static int getGenomeDepth(uint8_t* genome, int genomeSize);
+    __inline__ __host__ __device__ static int getNumNodesRecursively(uint8_t* genome, int genomeSize, bool includeRepetitions, bool includedSeparatedParts);
+    template <typename RandomGenerator>
+    __inline__ __host__ __device__ static int getRandomGenomeNodeAddress(
+        RandomGenerator& numberGen,
         uint8_t* genome,
         int genomeSize,
         bool considerZeroSubGenomes,
         int* subGenomesSizeIndices = nullptr,
         int* numSubGenomesSizeIndices = nullptr,
         int randomRefIndex = 0);
-    __inline__ __device__ static int getNumNodes(uint8_t* genome, int genomeSize);
-    __inline__ __device__ static int getNodeAddress(uint8_t* genome, int genomeSize, int nodeIndex);
-    __inline__ __device__ static bool isFirstNode(ConstructorFunction const& constructor);
-    __inline__ __device__ static bool isFirstRepetition(ConstructorFunction const& constructor);
-    __inline__ __device__ static bool isLastNode(ConstructorFunction const& constructor);
-    __inline__ __device__ static bool isLastRepetition(ConstructorFunction const& constructor);
-    __inline__ __device__ static bool hasInfiniteRepetitions(ConstructorFunction const& constructor);
-    __inline__ __device__
-        static bool hasEmptyGenome(ConstructorFunction const& constructor);
-    __inline__ __device__ static bool isFinished(ConstructorFunction const& constructor);
+    __inline__ __host__ __device__ static int getNumNodes(uint8_t* genome, int genomeSize);
+    __inline__ __host__ __device__ static int getNodeAddress(uint8_t* genome, int genomeSize, int nodeIndex);
+    template <typename ConstructorOrInjector>
+    __inline__ __host__ __device__ static bool isFirstNode(ConstructorOrInjector const& constructor);
+    template <typename ConstructorOrInjector>
+    __inline__ __host__ __device__ static bool isFirstRepetition(ConstructorOrInjector const& constructor);
+    template <typename ConstructorOrInjector>
+    __inline__ __host__ __device__ static bool isLastNode(ConstructorOrInjector const& constructor);
+    template <typename ConstructorOrInjector>
+    __inline__ __host__ __device__ static bool isLastRepetition(ConstructorOrInjector const& constructor);
     template <typename ConstructorOrInjector>
-    __inline__ __device__ static bool containsSelfReplication(ConstructorOrInjector const& cellFunction);
-    template <typename CellFunctionSource, typename CellFunctionTarget>
-    __inline__ __device__ static void copyGenome(SimulationData& data, CellFunctionSource& source, int genomeBytePosition, CellFunctionTarget& target);
-    __inline__ __device__ static bool isSeparating(uint8_t* genome);
-    __inline__ __device__ static int getNumRepetitions(uint8_t* genome, bool countInfinityAsOne = false);
-    __inline__ __device__ static int getNumBranches(uint8_t* genome);
+    __inline__ __host__ __device__ static bool hasInfiniteRepetitions(ConstructorOrInjector const& constructor);
+    template <typename ConstructorOrInjector>
+    __inline__ __host__ __device__ static bool hasEmptyGenome(ConstructorOrInjector const& constructor);
+    template <typename ConstructorOrInjector>
+    __inline__ __host__ __device__ static bool isFinished(ConstructorOrInjector const& constructor);
+    template <typename ConstructorOrInjector>
+    __inline__ __host__ __device__ static bool containsSelfReplication(ConstructorOrInjector const& cellFunction);
+    template <typename Data, typename CellFunctionSource, typename CellFunctionTarget>
+    __inline__ __device__ static void copyGenome(Data& data, CellFunctionSource& source, int genomeBytePosition, CellFunctionTarget& target);
+    __inline__ __host__ __device__ static bool isSeparating(uint8_t* genome);
+    __inline__ __host__ __device__ static int getNumRepetitions(uint8_t* genome, bool countInfinityAsOne = false);
+    __inline__ __host__ __device__ static int getNumBranches(uint8_t* genome);
 
     //node-wide methods
-    __inline__ __device__ static int getNextCellFunctionDataSize(uint8_t* genome, int genomeSize, int nodeAddress, bool withSubgenome = true);
-    __inline__ __device__ static CellFunction getNextCellFunctionType(uint8_t* genome, int nodeAddress);
-    __inline__ __device__ static bool isNextCellSelfReplication(uint8_t* genome, int nodeAddress);
-    __inline__ __device__ static int getNextCellColor(uint8_t* genome, int nodeAddress);
-    __inline__ __device__ static int getNextExecutionNumber(uint8_t* genome, int nodeAddress);
-    __inline__ __device__ static int getNextInputExecutionNumber(uint8_t* genome, int nodeAddress);
-    __inline__ __device__ static void setNextCellFunctionType(uint8_t* genome, int nodeAddress, CellFunction cellFunction);
-    __inline__ __device__ static void setNextCellColor(uint8_t* genome, int nodeAddress, int color);
-    __inline__ __device__ static void setNextInputExecutionNumber(uint8_t* genome, int nodeAddress, int value);
-    __inline__ __device__ static void setNextOutputBlocked(uint8_t* genome, int nodeAddress, bool value);
-    __inline__ __device__ static void setNextAngle(uint8_t* genome, int nodeAddress, uint8_t angle);
-    __inline__ __device__ static void setNextRequiredConnections(uint8_t* genome, int nodeAddress, uint8_t angle);
-    __inline__ __device__ static void setNextConstructionAngle1(uint8_t* genome, int nodeAddress, uint8_t angle);
-    __inline__ __device__ static void setNextConstructionAngle2(uint8_t* genome, int nodeAddress, uint8_t angle);
-    __inline__ __device__ static void setNextConstructorSeparation(uint8_t* genome, int nodeAddress, bool separation);
-    __inline__ __device__ static void setNextConstructorNumBranches(uint8_t* genome, int nodeAddress, int numBranches);
-    __inline__ __device__ static bool containsSectionSelfReplication(uint8_t* genome, int genomeSize);
-    __inline__ __device__ static void
-    setRandomCellFunctionData(SimulationData& data, uint8_t* genome, int nodeAddress, CellFunction const& cellFunction, bool makeSelfCopy, int subGenomeSize);
-    __inline__ __device__ static int getCellFunctionDataSize(
+    __inline__ __host__ __device__ static int getNextCellFunctionDataSize(uint8_t* genome, int genomeSize, int nodeAddress, bool withSubgenome = true);
+    __inline__ __host__ __device__ static CellFunction getNextCellFunctionType(uint8_t* genome, int nodeAddress);
+    __inline__ __host__ __device__ static bool isNextCellSelfReplication(uint8_t* genome, int nodeAddress);
+    __inline__ __host__ __device__ static int getNextCellColor(uint8_t* genome, int nodeAddress);
+    __inline__ __host__ __device__ static int getNextExecutionNumber(uint8_t* genome, int nodeAddress);
+    __inline__ __host__ __device__ static int getNextInputExecutionNumber(uint8_t* genome, int nodeAddress);
+    __inline__ __host__ __device__ static void setNextCellFunctionType(uint8_t* genome, int nodeAddress, CellFunction cellFunction);
+    __inline__ __host__ __device__ static void setNextCellColor(uint8_t* genome, int nodeAddress, int color);
+    __inline__ __host__ __device__ static void setNextInputExecutionNumber(uint8_t* genome, int nodeAddress, int value);
+    __inline__ __host__ __device__ static void setNextOutputBlocked(uint8_t* genome, int nodeAddress, bool value);
+    __inline__ __host__ __device__ static void setNextAngle(uint8_t* genome, int nodeAddress, uint8_t angle);
+    __inline__ __host__ __device__ static void setNextRequiredConnections(uint8_t* genome, int nodeAddress, uint8_t angle);
+    __inline__ __host__ __device__ static void setNextConstructionAngle1(uint8_t* genome, int nodeAddress, uint8_t angle);
+    __inline__ __host__ __device__ static void setNextConstructionAngle2(uint8_t* genome, int nodeAddress, uint8_t angle);
+    __inline__ __host__ __device__ static void setNextConstructorSeparation(uint8_t* genome, int nodeAddress, bool separation);
+    __inline__ __host__ __device__ static void setNextConstructorNumBranches(uint8_t* genome, int nodeAddress, int numBranches);
+    __inline__ __host__ __device__ static bool containsSectionSelfReplication(uint8_t* genome, int genomeSize);
+    template <typename RandomGenerator>
+    __inline__ __host__ __device__ static void setRandomCellFunctionData(
+        RandomGenerator& numberGen,
+        uint8_t* genome,
+        int nodeAddress,
+        CellFunction const& cellFunction,
+        bool makeSelfCopy,
+        int subGenomeSize);
+    __inline__ __host__ __device__ static int getCellFunctionDataSize(
         CellFunction cellFunction,
         bool makeSelfCopy,
         int genomeSize);  //genomeSize only relevant for cellFunction = constructor or injector
-    __inline__ __device__ static int
+    __inline__ __host__ __device__ static int
     getNextSubGenomeSize(uint8_t* genome, int genomeSize, int nodeAddress);  //prerequisites: (constructor or injector) and !makeSelfCopy
 
     //low level read-write methods
-    __inline__ __device__ static bool readBool(ConstructorFunction& constructor, int& genomeBytePosition);
-    __inline__ __device__ static uint8_t readByte(ConstructorFunction& constructor, int& genomeBytePosition);
-    __inline__ __device__ static int readOptionalByte(ConstructorFunction& constructor, int& genomeBytePosition);
-    __inline__ __device__ static int readOptionalByte(ConstructorFunction& constructor, int& genomeBytePosition, int moduloValue);
-    __inline__ __device__ static int readWord(ConstructorFunction& constructor, int& genomeBytePosition);
-    __inline__ __device__ static float readFloat(ConstructorFunction& constructor, int& genomeBytePosition);  //return values from -1 to 1
-    __inline__ __device__ static float readEnergy(ConstructorFunction& constructor, int& genomeBytePosition);  //return values from 36 to 1060
-    __inline__ __device__ static float readAngle(ConstructorFunction& constructor, int& genomeBytePosition);
-    __inline__ __device__ static int readWord(uint8_t* genome, int nodeAddress);
-    __inline__ __device__ static void writeWord(uint8_t* genome, int address, int word);
+    template <typename ConstructorOrInjector>
+    __inline__ __host__ __device__ static bool readBool(ConstructorOrInjector& constructor, int& genomeBytePosition);
+    template <typename ConstructorOrInjector>
+    __inline__ __host__ __device__ static uint8_t readByte(ConstructorOrInjector& constructor, int& genomeBytePosition);
+    template <typename ConstructorOrInjector>
+    __inline__ __host__ __device__ static int readOptionalByte(ConstructorOrInjector& constructor, int& genomeBytePosition);
+    template <typename ConstructorOrInjector>
+    __inline__ __host__ __device__ static int readOptionalByte(ConstructorOrInjector& constructor, int& genomeBytePosition, int moduloValue);
+    template <typename ConstructorOrInjector>
+    __inline__ __host__ __device__ static int readWord(ConstructorOrInjector& constructor, int& genomeBytePosition);
+    template <typename ConstructorOrInjector>
+    __inline__ __host__ __device__ static float readFloat(ConstructorOrInjector& constructor, int& genomeBytePosition);  //return values from -1 to 1
+    template <typename ConstructorOrInjector>
+    __inline__ __host__ __device__ static float readEnergy(ConstructorOrInjector& constructor, int& genomeBytePosition);  //return values from 36 to 1060
+    template <typename ConstructorOrInjector>
+    __inline__ __host__ __device__ static float readAngle(ConstructorOrInjector& constructor, int& genomeBytePosition);
+    __inline__ __host__ __device__ static int readWord(uint8_t* genome, int nodeAddress);
+    __inline__ __host__ __device__ static void writeWord(uint8_t* genome, int address, int word);
 
     //conversion methods
-    __inline__ __device__ static bool convertByteToBool(uint8_t b);
-    __inline__ __device__ static uint8_t convertBoolToByte(bool value);
-    __inline__ __device__ static int convertBytesToWord(uint8_t b1, uint8_t b2);
-    __inline__ __device__ static void convertWordToBytes(int word, uint8_t& b1, uint8_t& b2);
-    __inline__ __device__ static uint8_t convertAngleToByte(float angle);
-    __inline__ __device__ static float convertByteToAngle(uint8_t b);
-    __inline__ __device__ static uint8_t convertOptionalByteToByte(int value);
+    __inline__ __host__ __device__ static bool convertByteToBool(uint8_t b);
+    __inline__ __host__ __device__ static uint8_t convertBoolToByte(bool value);
+    __inline__ __host__ __device__ static int convertBytesToWord(uint8_t b1, uint8_t b2);
+    __inline__ __host__ __device__ static void convertWordToBytes(int word, uint8_t& b1, uint8_t& b2);
+    __inline__ __host__ __device__ static uint8_t convertAngleToByte(float angle);
+    __inline__ __host__ __device__ static float convertByteToAngle(uint8_t b);
+    __inline__ __host__ __device__ static uint8_t convertOptionalByteToByte(int value);
 
     static auto constexpr MAX_SUBGENOME_RECURSION_DEPTH = 15;
 
 private:
-    __inline__ __device__ static int findStartNodeAddress(uint8_t* genome, int genomeSize, int refIndex);
+    __inline__ __host__ __device__ static int findStartNodeAddress(uint8_t* genome, int genomeSize, int refIndex);
 };
 
 /************************************************************************/
 /* Implementation                                                       */
 /************************************************************************/
 template <typename Func>
-__inline__ __device__ void GenomeDecoder::executeForEachNode(uint8_t* genome, int genomeSize, Func func)
+__inline__ __host__ __device__ void GenomeDecoder::executeForEachNode(uint8_t* genome, int genomeSize, Func func)
 {
     for (int currentNodeAddress = Const::GenomeHeaderSize; currentNodeAddress < genomeSize;) {
         currentNodeAddress += Const::CellBasicBytes + GenomeDecoder::getNextCellFunctionDataSize(genome, genomeSize, currentNodeAddress);
@@ -112,7 +154,7 @@ __inline__ __device__ void GenomeDecoder::executeForEachNode(uint8_t* genome, in
 }
 
 template <typename Func>
-__inline__ __device__ void GenomeDecoder::executeForEachNodeRecursively(uint8_t* genome, int genomeSize, bool includedSeparatedParts, bool countBranches, Func func)
+__inline__ __host__ __device__ void GenomeDecoder::executeForEachNodeRecursively(uint8_t* genome, int genomeSize, bool includedSeparatedParts, bool countBranches, Func func)
 {
     CHECK(genomeSize >= Const::GenomeHeaderSize)
 
@@ -160,14 +202,14 @@ __inline__ __device__ void GenomeDecoder::executeForEachNodeRecursively(uint8_t*
     }
 }
 
-__inline__ __device__ int GenomeDecoder::getGenomeDepth(uint8_t* genome, int genomeSize)
+__inline__ __host__ __device__ int GenomeDecoder::getGenomeDepth(uint8_t* genome, int genomeSize)
 {
     auto result = 0;
-    executeForEachNodeRecursively(genome, genomeSize, true, false, [&result](int depth, int nodeAddress, int repetition) { result = max(result, depth); });
+    executeForEachNodeRecursively(genome, genomeSize, true, false, [&result](int depth, int nodeAddress, int repetition) { result = depth > result ? depth : result; });
     return result;
 }
 
-__inline__ __device__ int GenomeDecoder::getNumNodesRecursively(uint8_t* genome, int genomeSize, bool includeRepetitions, bool includedSeparatedParts)
+__inline__ __host__ __device__ int GenomeDecoder::getNumNodesRecursively(uint8_t* genome, int genomeSize, bool includeRepetitions, bool includedSeparatedParts)
 {
     auto result = 0;
     if (!includeRepetitions) {
@@ -180,8 +222,10 @@ __inline__ __device__ int GenomeDecoder::getNumNodesRecursively(uint8_t* genome,
     return result;
 }
 
-__inline__ __device__ int GenomeDecoder::getRandomGenomeNodeAddress(
-    SimulationData& data,
+HOST_DEVICE_EXEC_CHECK_DISABLE
+template <typename RandomGenerator>
+__inline__ __host__ __device__ int GenomeDecoder::getRandomGenomeNodeAddress(
+    RandomGenerator& numberGen,
     uint8_t* genome,
     int genomeSize,
     bool considerZeroSubGenomes,
@@ -198,7 +242,7 @@ __inline__ __device__ int GenomeDecoder::getRandomGenomeNodeAddress(
         return Const::GenomeHeaderSize;
     }
     if (randomRefIndex == 0) {
-        randomRefIndex = data.numberGen1.random(genomeSize - 1);
+        randomRefIndex = numberGen.random(genomeSize - 1);
     }
 
     int result = 0;
@@ -223,7 +267,7 @@ __inline__ __device__ int GenomeDecoder::getRandomGenomeNodeAddress(
                 auto subGenomeStartIndex = nodeAddress + Const::CellBasicBytes + cellFunctionFixedBytes + 3;
                 auto subGenomeSize = getNextSubGenomeSize(genome, genomeSize, nodeAddress);
                 if (subGenomeSize == Const::GenomeHeaderSize) {
-                    if (considerZeroSubGenomes && data.numberGen1.randomBool()) {
+                    if (considerZeroSubGenomes && numberGen.randomBool()) {
                         result += Const::CellBasicBytes + cellFunctionFixedBytes + 3 + Const::GenomeHeaderSize;
                     } else {
                         if (numSubGenomesSizeIndices) {
@@ -244,12 +288,14 @@ __inline__ __device__ int GenomeDecoder::getRandomGenomeNodeAddress(
     return result;
 }
 
-__inline__ __device__ bool GenomeDecoder::readBool(ConstructorFunction& constructor, int& genomeBytePosition)
+template <typename ConstructorOrInjector>
+__inline__ __host__ __device__ bool GenomeDecoder::readBool(ConstructorOrInjector& constructor, int& genomeBytePosition)
 {
     return convertByteToBool(readByte(constructor, genomeBytePosition));
 }
 
-__inline__ __device__ uint8_t GenomeDecoder::readByte(ConstructorFunction& constructor, int& genomeBytePosition)
+template <typename ConstructorOrInjector>
+__inline__ __host__ __device__ uint8_t GenomeDecoder::readByte(ConstructorOrInjector& constructor, int& genomeBytePosition)
 {
     if (isFinished(constructor)) {
         return 0;
@@ -258,53 +304,62 @@ __inline__ __device__ uint8_t GenomeDecoder::readByte(ConstructorFunction& const
     return result;
 }
 
-__inline__ __device__ int GenomeDecoder::readOptionalByte(ConstructorFunction& constructor, int& genomeBytePosition)
+template <typename ConstructorOrInjector>
+__inline__ __host__ __device__ int GenomeDecoder::readOptionalByte(ConstructorOrInjector& constructor, int& genomeBytePosition)
 {
     auto result = static_cast<int>(readByte(constructor, genomeBytePosition));
     result = result > 127 ? -1 : result;
     return result;
 }
 
-__inline__ __device__ int GenomeDecoder::readOptionalByte(ConstructorFunction& constructor, int& genomeBytePosition, int moduloValue)
+template <typename ConstructorOrInjector>
+__inline__ __host__ __device__ int GenomeDecoder::readOptionalByte(ConstructorOrInjector& constructor, int& genomeBytePosition, int moduloValue)
 {
     auto result = static_cast<int>(readByte(constructor, genomeBytePosition));
     result = result > 127 ? -1 : result % moduloValue;
     return result;
 }
 
-__inline__ __device__ int GenomeDecoder::readWord(ConstructorFunction& constructor, int& genomeBytePosition)
+template <typename ConstructorOrInjector>
+__inline__ __host__ __device__ int GenomeDecoder::readWord(ConstructorOrInjector& constructor, int& genomeBytePosition)
 {
     auto b1 = readByte(constructor, genomeBytePosition);
     auto b2 = readByte(constructor, genomeBytePosition);
     return convertBytesToWord(b1, b2);
 }
 
-__inline__ __device__ float GenomeDecoder::readFloat(ConstructorFunction& constructor, int& genomeBytePosition)
+template <typename ConstructorOrInjector>
+__inline__ __host__ __device__ float GenomeDecoder::readFloat(ConstructorOrInjector& constructor, int& genomeBytePosition)
 {
     return static_cast<float>(static_cast<int8_t>(readByte(constructor, genomeBytePosition))) / 128;
 }
 
-__inline__ __device__ float GenomeDecoder::readEnergy(ConstructorFunction& constructor, int& genomeBytePosition)
+template <typename ConstructorOrInjector>
+__inline__ __host__ __device__ float GenomeDecoder::readEnergy(ConstructorOrInjector& constructor, int& genomeBytePosition)
 {
     return static_cast<float>(static_cast<int8_t>(readByte(constructor, genomeBytePosition))) / 128 * 100 + 150;
 }
 
-__inline__ __device__ float GenomeDecoder::readAngle(ConstructorFunction& constructor, int& genomeBytePosition)
+template <typename ConstructorOrInjector>
+__inline__ __host__ __device__ float GenomeDecoder::readAngle(ConstructorOrInjector& constructor, int& genomeBytePosition)
 {
     return convertByteToAngle(readByte(constructor, genomeBytePosition));
 }
 
-__inline__ __device__ bool GenomeDecoder::isFirstNode(ConstructorFunction const& constructor)
+template <typename ConstructorOrInjector>
+__inline__ __host__ __device__ bool GenomeDecoder::isFirstNode(ConstructorOrInjector const& constructor)
 {
     return constructor.genomeCurrentNodeIndex == 0;
 }
 
-__inline__ __device__ bool GenomeDecoder::isFirstRepetition(ConstructorFunction const& constructor)
+template <typename ConstructorOrInjector>
+__inline__ __host__ __device__ bool GenomeDecoder::isFirstRepetition(ConstructorOrInjector const& constructor)
 {
     return constructor.genomeCurrentRepetition == 0;
 }
 
-__inline__ __device__ bool GenomeDecoder::isLastNode(ConstructorFunction const& constructor)
+template <typename ConstructorOrInjector>
+__inline__ __host__ __device__ bool GenomeDecoder::isLastNode(ConstructorOrInjector const& constructor)
 {
     if (hasEmptyGenome(constructor)) {
         return true;
@@ -314,17 +369,20 @@ __inline__ __device__ bool GenomeDecoder::isLastNode(ConstructorFunction const&
     return nodeAddress + nextNodeBytes >= constructor.genomeSize;
 }
 
-__inline__ __device__ bool GenomeDecoder::isLastRepetition(ConstructorFunction const& constructor)
+template <typename ConstructorOrInjector>
+__inline__ __host__ __device__ bool GenomeDecoder::isLastRepetition(ConstructorOrInjector const& constructor)
 {
     return getNumRepetitions(constructor.genome) - 1 == constructor.genomeCurrentRepetition;
 }
 
-__inline__ __device__ bool GenomeDecoder::hasInfiniteRepetitions(ConstructorFunction const& constructor)
+template <typename ConstructorOrInjector>
+__inline__ __host__ __device__ bool GenomeDecoder::hasInfiniteRepetitions(ConstructorOrInjector const& constructor)
 {
-    return getNumRepetitions(constructor.genome) == NPP_MAX_32S;
+    return getNumRepetitions(constructor.genome) == INT_MAX;
 }
 
-__inline__ __device__ bool GenomeDecoder::hasEmptyGenome(ConstructorFunction const& constructor)
+template <typename ConstructorOrInjector>
+__inline__ __host__ __device__ bool GenomeDecoder::hasEmptyGenome(ConstructorOrInjector const& constructor)
 {
     if (constructor.genomeSize <= Const::GenomeHeaderSize) {
         CHECK(constructor.genomeSize == Const::GenomeHeaderSize)
@@ -334,7 +392,8 @@ __inline__ __device__ bool GenomeDecoder::hasEmptyGenome(ConstructorFunction con
     return false;
 }
 
-__inline__ __device__ bool GenomeDecoder::isFinished(ConstructorFunction const& constructor)
+template <typename ConstructorOrInjector>
+__inline__ __host__ __device__ bool GenomeDecoder::isFinished(ConstructorOrInjector const& constructor)
 {
     if (hasEmptyGenome(constructor)) {
         return true;
@@ -342,8 +401,8 @@ __inline__ __device__ bool GenomeDecoder::isFinished(ConstructorFunction const&
     return getNumBranches(constructor.genome) <= constructor.currentBranch;
 }
 
-template <typename CellFunctionSource, typename CellFunctionTarget>
-__inline__ __device__ void GenomeDecoder::copyGenome(SimulationData& data, CellFunctionSource& source, int genomeBytePosition, CellFunctionTarget& target)
+template <typename Data, typename CellFunctionSource, typename CellFunctionTarget>
+__inline__ __device__ void GenomeDecoder::copyGenome(Data& data, CellFunctionSource& source, int genomeBytePosition, CellFunctionTarget& target)
 {
     bool makeGenomeCopy = readBool(source, genomeBytePosition);
     if (!makeGenomeCopy) {
@@ -365,28 +424,28 @@ __inline__ __device__ void GenomeDecoder::copyGenome(SimulationData& data, CellF
     }
 }
 
-__inline__ __device__ bool GenomeDecoder::isSeparating(uint8_t* genome)
+__inline__ __host__ __device__ bool GenomeDecoder::isSeparating(uint8_t* genome)
 {
     return GenomeDecoder::convertByteToBool(genome[Const::GenomeHeaderSeparationPos]);
 }
 
-__inline__ __device__ int GenomeDecoder::getNumBranches(uint8_t* genome)
+__inline__ __host__ __device__ int GenomeDecoder::getNumBranches(uint8_t* genome)
 {
     return isSeparating(genome) ? 1 : (genome[Const::GenomeHeaderNumBranchesPos] + 5) % 6 + 1;
 }
 
-__inline__ __device__ int GenomeDecoder::getNumRepetitions(uint8_t* genome, bool countInfinityAsOne)
+__inline__ __host__ __device__ int GenomeDecoder::getNumRepetitions(uint8_t* genome, bool countInfinityAsOne)
 {
-    int result = max(1, toInt(genome[Const::GenomeHeaderNumRepetitionsPos]));
+    int result = genome[Const::GenomeHeaderNumRepetitionsPos] > 0 ? toInt(genome[Const::GenomeHeaderNumRepetitionsPos]) : 1;
     if (!countInfinityAsOne) {
-        return result == 255 ? NPP_MAX_32S : result;
+        return result == 255 ? INT_MAX : result;
     } else {
         return result == 255 ? 1 : result;
     }
 }
 
 template <typename ConstructorOrInjector>
-__inline__ __device__ bool GenomeDecoder::containsSelfReplication(ConstructorOrInjector const& cellFunction)
+__inline__ __host__ __device__ bool GenomeDecoder::containsSelfReplication(ConstructorOrInjector const& cellFunction)
 {
     for (int currentNodeAddress = Const::GenomeHeaderSize; currentNodeAddress < cellFunction.genomeSize;) {
         if (isNextCellSelfReplication(cellFunction.genome, currentNodeAddress)) {
@@ -398,7 +457,8 @@ __inline__ __device__ bool GenomeDecoder::containsSelfReplication(ConstructorOrI
     return false;
 }
 
-__inline__ __device__ GenomeHeader GenomeDecoder::readGenomeHeader(ConstructorFunction const& constructor)
+template <typename ConstructorOrInjector>
+__inline__ __host__ __device__ GenomeHeader GenomeDecoder::readGenomeHeader(ConstructorOrInjector const& constructor)
 {
     CHECK(constructor.genomeSize >= Const::GenomeHeaderSize)
 
@@ -415,38 +475,38 @@ __inline__ __device__ GenomeHeader GenomeDecoder::readGenomeHeader(ConstructorFu
     return result;
 }
 
-__inline__ __device__ int GenomeDecoder::readWord(uint8_t* genome, int address)
+__inline__ __host__ __device__ int GenomeDecoder::readWord(uint8_t* genome, int address)
 {
     return GenomeDecoder::convertBytesToWord(genome[address], genome[address + 1]);
 }
 
-__inline__ __device__ void GenomeDecoder::writeWord(uint8_t* genome, int address, int word)
+__inline__ __host__ __device__ void GenomeDecoder::writeWord(uint8_t* genome, int address, int word)
 {
     GenomeDecoder::convertWordToBytes(word, genome[address], genome[address + 1]);
 }
 
-__inline__ __device__ bool GenomeDecoder::convertByteToBool(uint8_t b)
+__inline__ __host__ __device__ bool GenomeDecoder::convertByteToBool(uint8_t b)
 {
     return static_cast<int8_t>(b) > 0;
 }
 
-__inline__ __device__ uint8_t GenomeDecoder::convertBoolToByte(bool value)
+__inline__ __host__ __device__ uint8_t GenomeDecoder::convertBoolToByte(bool value)
 {
     return value ? 1 : 0;
 }
 
-__inline__ __device__ int GenomeDecoder::convertBytesToWord(uint8_t b1, uint8_t b2)
+__inline__ __host__ __device__ int GenomeDecoder::convertBytesToWord(uint8_t b1, uint8_t b2)
 {
     return static_cast<int>(b1) | (static_cast<int>(b2 << 8));
 }
 
-__inline__ __device__ void GenomeDecoder::convertWordToBytes(int word, uint8_t& b1, uint8_t& b2)
+__inline__ __host__ __device__ void GenomeDecoder::convertWordToBytes(int word, uint8_t& b1, uint8_t& b2)
 {
     b1 = static_cast<uint8_t>(word & 0xff);
     b2 = static_cast<uint8_t>((word >> 8) & 0xff);
 }
 
-__inline__ __device__ uint8_t GenomeDecoder::convertAngleToByte(float angle)
+__inline__ __host__ __device__ uint8_t GenomeDecoder::convertAngleToByte(float angle)
 {
     if (angle > 180.0f) {
         angle -= 360.0f;
@@ -457,18 +517,20 @@ __inline__ __device__ uint8_t GenomeDecoder::convertAngleToByte(float angle)
     return static_cast<uint8_t>(static_cast<int8_t>(angle / 180 * 120));
 }
 
-__inline__ __device__ float GenomeDecoder::convertByteToAngle(uint8_t b)
+__inline__ __host__ __device__ float GenomeDecoder::convertByteToAngle(uint8_t b)
 {
     return static_cast<float>(static_cast<int8_t>(b)) / 120 * 180;
 }
 
-__inline__ __device__ uint8_t GenomeDecoder::convertOptionalByteToByte(int value)
+__inline__ __host__ __device__ uint8_t GenomeDecoder::convertOptionalByteToByte(int value)
 {
     return static_cast<uint8_t>(value);
 }
 
-__inline__ __device__ void GenomeDecoder::setRandomCellFunctionData(
-    SimulationData& data,
+HOST_DEVICE_EXEC_CHECK_DISABLE
+template <typename RandomGenerator>
+__inline__ __host__ __device__ void GenomeDecoder::setRandomCellFunctionData(
+    RandomGenerator& numberGen,
     uint8_t* genome,
     int nodeAddress,
     CellFunction const& cellFunction,
@@ -476,7 +538,7 @@ __inline__ __device__ void GenomeDecoder::setRandomCellFunctionData(
     int subGenomeSize)
 {
     auto newCellFunctionSize = getCellFunctionDataSize(cellFunction, makeSelfCopy, subGenomeSize);
-    data.numberGen1.randomBytes(genome + nodeAddress, newCellFunctionSize);
+    numberGen.randomBytes(genome + nodeAddress, newCellFunctionSize);
     if (cellFunction == CellFunction_Constructor || cellFunction == CellFunction_Injector) {
         auto cellFunctionFixedBytes = cellFunction == CellFunction_Constructor ? Const::ConstructorFixedBytes : Const::InjectorFixedBytes;
         genome[nodeAddress + cellFunctionFixedBytes] = makeSelfCopy ? 1 : 0;
@@ -490,7 +552,7 @@ __inline__ __device__ void GenomeDecoder::setRandomCellFunctionData(
     }
 }
 
-__inline__ __device__ int GenomeDecoder::getNumNodes(uint8_t* genome, int genomeSize)
+__inline__ __host__ __device__ int GenomeDecoder::getNumNodes(uint8_t* genome, int genomeSize)
 {
     int result = 0;
     int currentNodeAddress = Const::GenomeHeaderSize;
@@ -501,7 +563,7 @@ __inline__ __device__ int GenomeDecoder::getNumNodes(uint8_t* genome, int genome
     return result;
 }
 
-__inline__ __device__ int GenomeDecoder::getNodeAddress(uint8_t* genome, int genomeSize, int nodeIndex)
+__inline__ __host__ __device__ int GenomeDecoder::getNodeAddress(uint8_t* genome, int genomeSize, int nodeIndex)
 {
     int currentNodeAddress = Const::GenomeHeaderSize;
     for (int currentNodeIndex = 0; currentNodeIndex < nodeIndex; ++currentNodeIndex) {
@@ -515,7 +577,7 @@ __inline__ __device__ int GenomeDecoder::getNodeAddress(uint8_t* genome, int gen
 }
 
 
-__inline__ __device__ int GenomeDecoder::findStartNodeAddress(uint8_t* genome, int genomeSize, int refIndex)
+__inline__ __host__ __device__ int GenomeDecoder::findStartNodeAddress(uint8_t* genome, int genomeSize, int refIndex)
 {
     int currentNodeAddress = Const::GenomeHeaderSize;
     for (; currentNodeAddress <= refIndex;) {
@@ -528,7 +590,7 @@ __inline__ __device__ int GenomeDecoder::findStartNodeAddress(uint8_t* genome, i
     return Const::GenomeHeaderSize;
 }
 
-__inline__ __device__ int GenomeDecoder::getNextCellFunctionDataSize(uint8_t* genome, int genomeSize, int nodeAddress, bool withSubgenome)
+__inline__ __host__ __device__ int GenomeDecoder::getNextCellFunctionDataSize(uint8_t* genome, int genomeSize, int nodeAddress, bool withSubgenome)
 {
     auto cellFunction = getNextCellFunctionType(genome, nodeAddress);
     switch (cellFunction) {
@@ -579,12 +641,12 @@ __inline__ __device__ int GenomeDecoder::getNextCellFunctionDataSize(uint8_t* ge
     }
 }
 
-__inline__ __device__ CellFunction GenomeDecoder::getNextCellFunctionType(uint8_t* genome, int nodeAddress)
+__inline__ __host__ __device__ CellFunction GenomeDecoder::getNextCellFunctionType(uint8_t* genome, int nodeAddress)
 {
     return genome[nodeAddress] % CellFunction_Count;
 }
 
-__inline__ __device__ bool GenomeDecoder::isNextCellSelfReplication(uint8_t* genome, int nodeAddress)
+__inline__ __host__ __device__ bool GenomeDecoder::isNextCellSelfReplication(uint8_t* genome, int nodeAddress)
 {
     switch (getNextCellFunctionType(genome, nodeAddress)) {
     case CellFunction_Constructor:
@@ -595,80 +657,83 @@ __inline__ __device__ bool GenomeDecoder::isNextCellSelfReplication(uint8_t* gen
     return false;
 }
 
-__inline__ __device__ int GenomeDecoder::getNextCellColor(uint8_t* genome, int nodeAddress)
+__inline__ __host__ __device__ int GenomeDecoder::getNextCellColor(uint8_t* genome, int nodeAddress)
 {
     return genome[nodeAddress + Const::CellColorPos] % MAX_COLORS;
 }
 
-__inline__ __device__ int GenomeDecoder::getNextExecutionNumber(uint8_t* genome, int nodeAddress)
+__inline__ __host__ __device__ int GenomeDecoder::getNextExecutionNumber(uint8_t* genome, int nodeAddress)
 {
     return genome[nodeAddress + Const::CellExecutionNumberPos];
 }
 
-__inline__ __device__ int GenomeDecoder::getNextInputExecutionNumber(uint8_t* genome, int nodeAddress)
+__inline__ __host__ __device__ int GenomeDecoder::getNextInputExecutionNumber(uint8_t* genome, int nodeAddress)
 {
     return genome[nodeAddress + Const::CellInputExecutionNumberPos];
 }
 
-__inline__ __device__ void GenomeDecoder::setNextCellFunctionType(uint8_t* genome, int nodeAddress, CellFunction cellFunction)
+__inline__ __host__ __device__ void GenomeDecoder::setNextCellFunctionType(uint8_t* genome, int nodeAddress, CellFunction cellFunction)
 {
     genome[nodeAddress] = static_cast<uint8_t>(cellFunction);
 }
 
-__inline__ __device__ void GenomeDecoder::setNextCellColor(uint8_t* genome, int nodeAddress, int color)
+__inline__ __host__ __device__ void GenomeDecoder::setNextCellColor(uint8_t* genome, int nodeAddress, int color)
 {
     genome[nodeAddress + Const::CellColorPos] = color;
 }
 
-__inline__ __device__ void GenomeDecoder::setNextInputExecutionNumber(uint8_t* genome, int nodeAddress, int value)
+__inline__ __host__ __device__ void GenomeDecoder::setNextInputExecutionNumber(uint8_t* genome, int nodeAddress, int value)
 {
     genome[nodeAddress + Const::CellInputExecutionNumberPos] = value;
 }
 
-__inline__ __device__ void GenomeDecoder::setNextOutputBlocked(uint8_t* genome, int nodeAddress, bool value)
+__inline__ __host__ __device__ void GenomeDecoder::setNextOutputBlocked(uint8_t* genome, int nodeAddress, bool value)
 {
     genome[nodeAddress + Const::CellOutputBlockedPos] = value ? 1 : 0;
 }
 
-__inline__ __device__ void GenomeDecoder::setNextAngle(uint8_t* genome, int nodeAddress, uint8_t angle)
+__inline__ __host__ __device__ void GenomeDecoder::setNextAngle(uint8_t* genome, int nodeAddress, uint8_t angle)
 {
     genome[nodeAddress + Const::CellAnglePos] = angle;
 }
 
-__inline__ __device__ void GenomeDecoder::setNextRequiredConnections(uint8_t* genome, int nodeAddress, uint8_t angle)
+__inline__ __host__ __device__ void GenomeDecoder::setNextRequiredConnections(uint8_t* genome, int nodeAddress, uint8_t angle)
 {
     genome[nodeAddress + Const::CellRequiredConnectionsPos] = angle;
 }
 
-__inline__ __device__ void GenomeDecoder::setNextConstructionAngle1(uint8_t* genome, int nodeAddress, uint8_t angle)
+__inline__ __host__ __device__ void GenomeDecoder::setNextConstructionAngle1(uint8_t* genome, int nodeAddress, uint8_t angle)
 {
     genome[nodeAddress + Const::CellBasicBytes + Const::ConstructorConstructionAngle1Pos] = angle;
 }
 
-__inline__ __device__ void GenomeDecoder::setNextConstructionAngle2(uint8_t* genome, int nodeAddress, uint8_t angle)
+__inline__ __host__ __device__ void GenomeDecoder::setNextConstructionAngle2(uint8_t* genome, int nodeAddress, uint8_t angle)
 {
     genome[nodeAddress + Const::CellBasicBytes + Const::ConstructorConstructionAngle2Pos] = angle;
 }
 
-__inline__ __device__ void GenomeDecoder::setNextConstructorSeparation(uint8_t* genome, int nodeAddress, bool separation)
+__inline__ __host__ __device__ void GenomeDecoder::setNextConstructorSeparation(uint8_t* genome, int nodeAddress, bool separation)
 {
     genome[nodeAddress + Const::CellBasicBytes + Const::ConstructorFixedBytes + 3 + Const::GenomeHeaderSeparationPos] = convertBoolToByte(separation);
 }
 
-__inline__ __device__ void GenomeDecoder::setNextConstructorNumBranches(uint8_t* genome, int nodeAddress, int numBranches)
+__inline__ __host__ __device__ void GenomeDecoder::setNextConstructorNumBranches(uint8_t* genome, int nodeAddress, int numBranches)
 {
     genome[nodeAddress + Const::CellBasicBytes + Const::ConstructorFixedBytes + 3 + Const::GenomeHeaderNumBranchesPos] = static_cast<uint8_t>(numBranches);
 }
 
-__inline__ __device__ int GenomeDecoder::getNextSubGenomeSize(uint8_t* genome, int genomeSize, int nodeAddress)
+__inline__ __host__ __device__ int GenomeDecoder::getNextSubGenomeSize(uint8_t* genome, int genomeSize, int nodeAddress)
 {
     auto cellFunction = getNextCellFunctionType(genome, nodeAddress);
     auto cellFunctionFixedBytes = cellFunction == CellFunction_Constructor ? Const::ConstructorFixedBytes : Const::InjectorFixedBytes;
     auto subGenomeSizeIndex = nodeAddress + Const::CellBasicBytes + cellFunctionFixedBytes + 1;
-    return max(min(GenomeDecoder::convertBytesToWord(genome[subGenomeSizeIndex], genome[subGenomeSizeIndex + 1]), genomeSize - (subGenomeSizeIndex + 2)), 0);
+    auto result = GenomeDecoder::convertBytesToWord(genome[subGenomeSizeIndex], genome[subGenomeSizeIndex + 1]);
+    auto maxResult = genomeSize - (subGenomeSizeIndex + 2);
+    result = result < maxResult ? result : maxResult;
+    return result > 0 ? result : 0;
 }
 
-__inline__ __device__ int GenomeDecoder::getCellFunctionDataSize(CellFunction cellFunction, bool makeSelfCopy, int genomeSize)
+__inline__ __host__ __device__ int GenomeDecoder::getCellFunctionDataSize(CellFunction cellFunction, bool makeSelfCopy, int genomeSize)
 {
     switch (cellFunction) {
     case CellFunction_Neuron:
@@ -700,7 +765,7 @@ __inline__ __device__ int GenomeDecoder::getCellFunctionDataSize(CellFunction ce
     }
 }
 
-__inline__ __device__ bool GenomeDecoder::containsSectionSelfReplication(uint8_t* genome, int genomeSize)
+__inline__ __host__ __device__ bool GenomeDecoder::containsSectionSelfReplication(uint8_t* genome, int genomeSize)
 {
     int nodeAddress = 0;
     for (; nodeAddress < genomeSize;) {
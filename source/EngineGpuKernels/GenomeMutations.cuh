@@ -0,0 +1,264 @@
+#pragma once
+
+#include "EngineInterface/CellFunctionConstants.h"
+#include "EngineInterface/Colors.h"
+#include "EngineInterface/GenomeConstants.h"
+
+#include "HostDevice.cuh"
+#include "GenomeDecoder.cuh"
+
+/**
+ * Mutations which change a genome in place, shared between MutationProcessor (device) and the host.
+ * Random choices are drawn from the generator passed as argument. Prerequisite: the genome is not empty.
+ */
+class GenomeMutations
+{
+public:
+    template <typename RandomGenerator>
+    __inline__ __host__ __device__ static void neuronDataMutation(RandomGenerator& numberGen, uint8_t* genome, int genomeSize);
+    template <typename RandomGenerator>
+    __inline__ __host__ __device__ static void
+    propertiesMutation(RandomGenerator& numberGen, uint8_t* genome, int genomeSize, int numExecutionOrderNumbers);
+    template <typename RandomGenerator>
+    __inline__ __host__ __device__ static void customGeometryMutation(RandomGenerator& numberGen, uint8_t* genome, int genomeSize);
+    template <typename RandomGenerator>
+    __inline__ __host__ __device__ static void
+    cellColorMutation(RandomGenerator& numberGen, uint8_t* genome, int genomeSize, ColorMatrix<bool> const& colorTransitions);
+
+    //return true if the color of the (sub-)genome has changed
+    template <typename RandomGenerator>
+    __inline__ __host__ __device__ static bool
+    subgenomeColorMutation(RandomGenerator& numberGen, uint8_t* genome, int genomeSize, ColorMatrix<bool> const& colorTransitions);
+    template <typename RandomGenerator>
+    __inline__ __host__ __device__ static bool
+    genomeColorMutation(RandomGenerator& numberGen, uint8_t* genome, int genomeSize, ColorMatrix<bool> const& colorTransitions);
+
+    //returns -1 if no transition is allowed
+    template <typename RandomGenerator>
+    __inline__ __host__ __device__ static int getNewColorFromTransition(RandomGenerator& numberGen, int origColor, ColorMatrix<bool> const& colorTransitions);
+};
+
+/************************************************************************/
+/* Implementation                                                       */
+/************************************************************************/
+
+HOST_DEVICE_EXEC_CHECK_DISABLE
+template <typename RandomGenerator>
+__inline__ __host__ __device__ void GenomeMutations::neuronDataMutation(RandomGenerator& numberGen, uint8_t* genome, int genomeSize)
+{
+    auto nodeAddress = GenomeDecoder::getRandomGenomeNodeAddress(numberGen, genome, genomeSize, false);
+
+    auto type = GenomeDecoder::getNextCellFunctionType(genome, nodeAddress);
+    if (type == CellFunction_Neuron) {
+        auto delta = numberGen.random(Const::NeuronBytes - 1);
+        genome[nodeAddress + Const::CellBasicBytes + delta] = numberGen.randomByte();
+    }
+}
+
+HOST_DEVICE_EXEC_CHECK_DISABLE
+template <typename RandomGenerator>
+__inline__ __host__ __device__ void
+GenomeMutations::propertiesMutation(RandomGenerator& numberGen, uint8_t* genome, int genomeSize, int numExecutionOrderNumbers)
+{
+    auto numNodes = GenomeDecoder::getNumNodesRecursively(genome, genomeSize, false, true);
+    auto node = numberGen.random(numNodes - 1);
+    auto sequenceNumber = 0;
+
+    uint8_t prevExecutionNumber = numberGen.randomByte();
+    uint8_t nextExecutionNumber = numberGen.randomByte();
+    uint8_t prevInputExecutionNumber = numberGen.randomByte();
+    uint8_t nextInputExecutionNumber = numberGen.randomByte();
+    int nodeAddress = 0;
+    GenomeDecoder::executeForEachNodeRecursively(genome, genomeSize, true, false, [&](int depth, int nodeAddressIntern, int repetition) {
+        auto origSequenceNumber = sequenceNumber;
+        ++sequenceNumber;
+        if (origSequenceNumber == node - 1) {
+            prevExecutionNumber = GenomeDecoder::getNextExecutionNumber(genome, nodeAddressIntern);
+            prevInputExecutionNumber = GenomeDecoder::getNextInputExecutionNumber(genome, nodeAddressIntern);
+        }
+        if (origSequenceNumber == node + 1) {
+            nextExecutionNumber = GenomeDecoder::getNextExecutionNumber(genome, nodeAddressIntern);
+            nextInputExecutionNumber = GenomeDecoder::getNextInputExecutionNumber(genome, nodeAddressIntern);
+        }
+        if (origSequenceNumber == node) {
+            nodeAddress = nodeAddressIntern;
+        }
+    });
+    if (nodeAddress == 0) {
+        return;
+    }
+
+    //already fitting input-output connection? => use other input
+    auto executionNumber = GenomeDecoder::getNextInputExecutionNumber(genome, nodeAddress) % numExecutionOrderNumbers;
+    if (executionNumber == (prevInputExecutionNumber % numExecutionOrderNumbers)) {
+        prevExecutionNumber = nextExecutionNumber;
+    }
+    if (executionNumber == (nextInputExecutionNumber % numExecutionOrderNumbers)) {
+        nextExecutionNumber = prevExecutionNumber;
+    }
+
+    //basic property mutation
+    if (numberGen.randomBool()) {
+        if (numberGen.randomBool()) {
+            auto randomByte = numberGen.randomByte();
+            if (numberGen.random() < 0.8f) {
+                randomByte = numberGen.randomBool() ? prevExecutionNumber : nextExecutionNumber;
+            }
+            GenomeDecoder::setNextInputExecutionNumber(genome, nodeAddress, randomByte);
+        } else {
+            auto randomDelta = numberGen.random(Const::CellBasicBytes - 1);
+            auto randomByte = numberGen.randomByte();
+            if (randomDelta == 0) {  //no cell function type change
+                return;
+            }
+            if (randomDelta == Const::CellColorPos) {  //no color change
+                return;
+            }
+            if (randomDelta == Const::CellAnglePos || randomDelta == Const::CellRequiredConnectionsPos) {  //no structure change
+                return;
+            }
+            genome[nodeAddress + randomDelta] = randomByte;
+        }
+    }
+
+    //cell function specific mutation
+    else {
+        auto nextCellFunctionDataSize = GenomeDecoder::getNextCellFunctionDataSize(genome, genomeSize, nodeAddress, false);
+        if (nextCellFunctionDataSize > 0) {
+            auto randomDelta = numberGen.random(nextCellFunctionDataSize - 1);
+            auto cellFunction = GenomeDecoder::getNextCellFunctionType(genome, nodeAddress);
+            if (cellFunction == CellFunction_Constructor
+                && (randomDelta == Const::ConstructorConstructionAngle1Pos
+                    || randomDelta == Const::ConstructorConstructionAngle2Pos)) {  //no construction angles change
+                return;
+            }
+            genome[nodeAddress + Const::CellBasicBytes + randomDelta] = numberGen.randomByte();
+        }
+    }
+}
+
+HOST_DEVICE_EXEC_CHECK_DISABLE
+template <typename RandomGenerator>
+__inline__ __host__ __device__ void GenomeMutations::customGeometryMutation(RandomGenerator& numberGen, uint8_t* genome, int genomeSize)
+{
+    auto numNodes = GenomeDecoder::getNumNodesRecursively(genome, genomeSize, false, true);
+    auto node = numberGen.random(numNodes - 1);
+    auto sequenceNumber = 0;
+    GenomeDecoder::executeForEachNodeRecursively(genome, genomeSize, true, false, [&](int depth, int nodeAddress, int repetition) {
+        if (sequenceNumber++ != node) {
+            return;
+        }
+        auto cellFunction = GenomeDecoder::getNextCellFunctionType(genome, nodeAddress);
+        auto choice = cellFunction == CellFunction_Constructor ? numberGen.random(3) : numberGen.random(1);
+        switch (choice) {
+        case 0:
+            GenomeDecoder::setNextAngle(genome, nodeAddress, numberGen.randomByte());
+            break;
+        case 1:
+            GenomeDecoder::setNextRequiredConnections(genome, nodeAddress, numberGen.randomByte());
+            break;
+        case 2:
+            GenomeDecoder::setNextConstructionAngle1(genome, nodeAddress, numberGen.randomByte());
+            break;
+        case 3:
+            GenomeDecoder::setNextConstructionAngle2(genome, nodeAddress, numberGen.randomByte());
+            break;
+        }
+    });
+}
+
+HOST_DEVICE_EXEC_CHECK_DISABLE
+template <typename RandomGenerator>
+__inline__ __host__ __device__ void
+GenomeMutations::cellColorMutation(RandomGenerator& numberGen, uint8_t* genome, int genomeSize, ColorMatrix<bool> const& colorTransitions)
+{
+    auto numNodes = GenomeDecoder::getNumNodesRecursively(genome, genomeSize, false, true);
+    auto randomNode = numberGen.random(numNodes - 1);
+    auto sequenceNumber = 0;
+    GenomeDecoder::executeForEachNodeRecursively(genome, genomeSize, true, false, [&](int depth, int nodeAddress, int repetition) {
+        if (sequenceNumber++ != randomNode) {
+            return;
+        }
+        auto origColor = GenomeDecoder::getNextCellColor(genome, nodeAddress);
+        auto newColor = getNewColorFromTransition(numberGen, origColor, colorTransitions);
+        if (newColor == -1) {
+            return;
+        }
+        GenomeDecoder::setNextCellColor(genome, nodeAddress, newColor);
+    });
+}
+
+HOST_DEVICE_EXEC_CHECK_DISABLE
+template <typename RandomGenerator>
+__inline__ __host__ __device__ bool
+GenomeMutations::subgenomeColorMutation(RandomGenerator& numberGen, uint8_t* genome, int genomeSize, ColorMatrix<bool> const& colorTransitions)
+{
+    int subGenomesSizeIndices[GenomeDecoder::MAX_SUBGENOME_RECURSION_DEPTH];
+    int numSubGenomesSizeIndices;
+    GenomeDecoder::getRandomGenomeNodeAddress(numberGen, genome, genomeSize, false, subGenomesSizeIndices, &numSubGenomesSizeIndices);  //return value will be discarded
+
+    int nodeAddress = Const::GenomeHeaderSize;
+    auto subgenome = genome;
+    int subgenomeSize = genomeSize;
+    if (numSubGenomesSizeIndices > 0) {
+        subgenome = genome + subGenomesSizeIndices[numSubGenomesSizeIndices - 1] + 2;  //+2 because 2 bytes encode the sub-genome length
+        subgenomeSize = GenomeDecoder::readWord(genome, subGenomesSizeIndices[numSubGenomesSizeIndices - 1]);
+    }
+
+    auto origColor = GenomeDecoder::getNextCellColor(subgenome, nodeAddress);
+    auto newColor = getNewColorFromTransition(numberGen, origColor, colorTransitions);
+    if (newColor == -1) {
+        return false;
+    }
+
+    for (int dummy = 0; nodeAddress < subgenomeSize && dummy < subgenomeSize; ++dummy) {
+        GenomeDecoder::setNextCellColor(subgenome, nodeAddress, newColor);
+        nodeAddress += Const::CellBasicBytes + GenomeDecoder::getNextCellFunctionDataSize(subgenome, subgenomeSize, nodeAddress);
+    }
+    return origColor != newColor;
+}
+
+HOST_DEVICE_EXEC_CHECK_DISABLE
+template <typename RandomGenerator>
+__inline__ __host__ __device__ bool
+GenomeMutations::genomeColorMutation(RandomGenerator& numberGen, uint8_t* genome, int genomeSize, ColorMatrix<bool> const& colorTransitions)
+{
+    auto origColor = GenomeDecoder::getNextCellColor(genome, Const::GenomeHeaderSize);
+    auto newColor = getNewColorFromTransition(numberGen, origColor, colorTransitions);
+    if (newColor == -1) {
+        return false;
+    }
+
+    GenomeDecoder::executeForEachNodeRecursively(
+        genome, genomeSize, true, false, [&](int depth, int nodeAddress, int repetition) { GenomeDecoder::setNextCellColor(genome, nodeAddress, newColor); });
+    return origColor != newColor;
+}
+
+HOST_DEVICE_EXEC_CHECK_DISABLE
+template <typename RandomGenerator>
+__inline__ __host__ __device__ int
+GenomeMutations::getNewColorFromTransition(RandomGenerator& numberGen, int origColor, ColorMatrix<bool> const& colorTransitions)
+{
+    int numAllowedColors = 0;
+    for (int i = 0; i < MAX_COLORS; ++i) {
+        if (colorTransitions[origColor][i]) {
+            ++numAllowedColors;
+        }
+    }
+    if (numAllowedColors == 0) {
+        return -1;
+    }
+    int randomAllowedColorIndex = numberGen.random(numAllowedColors - 1);
+    int allowedColorIndex = 0;
+    int result = 0;
+    for (int i = 0; i < MAX_COLORS; ++i) {
+        if (colorTransitions[origColor][i]) {
+            if (allowedColorIndex == randomAllowedColorIndex) {
+                result = i;
+                break;
+            }
+            ++allowedColorIndex;
+        }
+    }
+    return result;
+}
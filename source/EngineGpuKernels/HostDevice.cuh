@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cuda_runtime.h>
+#include <vector_types.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+//plain host compilers take CHECK and the conversion functions from here, device code defines its own below
+#if !defined(__CUDACC__)
+#include "Base/Definitions.h"
+#endif
+
+/**
+ * Base for code that is compiled for the device (kernels) and for the host (CPU backend, tests, benchmarks).
+ * This header must not depend on device-only headers.
+ *
+ * Shared code is written as __host__ __device__ functions. Where it needs atomics or a parallel loop it is parameterized by an
+ * execution policy providing
+ *   static void atomicAdd(float* address, float value);
+ *   static void atomicAdd(float2* address, float2 const& value);
+ *   template <typename Func> static void forEach(int numEntities, Func const& func);  //calls func(index) for all indices in parallel
+ * Policies: DeviceExecution (DeviceExecution.cuh) and HostExecution (EngineImpl/HostExecution.h).
+ */
+
+//host instantiations of templates which are only used on the device should not trigger warnings about device functions
+#if defined(__CUDACC__)
+#define HOST_DEVICE_EXEC_CHECK_DISABLE _Pragma("nv_exec_check_disable")
+#else
+#define HOST_DEVICE_EXEC_CHECK_DISABLE
+#endif
+
+//replaces NEAR_ZERO from Base/Definitions.h in device and shared code
+#define NEAR_ZERO 0.00001f
+
+#if defined(__CUDACC__)
+#if defined(__CUDA_ARCH__)
+#define ABORT() asm("trap;");
+#else
+#define ABORT() abort();
+#endif
+
+#define CHECK(condition) \
+    if (!(condition)) { \
+        printf("Check failed. File: %s, Line: %d\n", __FILE__, __LINE__); \
+        ABORT(); \
+    }
+
+template <typename T>
+__device__ __host__ inline float toFloat(T value)
+{
+    return static_cast<float>(value);
+}
+
+template <typename T>
+__device__ __host__ inline double toDouble(T value)
+{
+    return static_cast<double>(value);
+}
+
+template <typename T>
+__device__ __host__ inline int toInt(T value)
+{
+    return static_cast<int>(value);
+}
+#endif
+
+template <typename T>
+__device__ __host__ inline uint64_t toUInt64(T value)
+{
+    return static_cast<uint64_t>(value);
+}
+
+__inline__ __host__ __device__ float alienFastSin(float value)
+{
+#if defined(__CUDA_ARCH__)
+    return __sinf(value);
+#else
+    return sinf(value);
+#endif
+}
+
+__inline__ __host__ __device__ float alienFastCos(float value)
+{
+#if defined(__CUDA_ARCH__)
+    return __cosf(value);
+#else
+    return cosf(value);
+#endif
+}
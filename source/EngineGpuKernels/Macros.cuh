@@ -11,6 +11,8 @@
 #include "Base/GlobalSettings.h"
 #include "Base/LoggingService.h"
 
+#include "HostDevice.cuh"
+
 template< typename T >
 void checkAndThrowError(T result, char const *const func, const char *const file, int const line)
 {
@@ -58,16 +60,6 @@ void checkAndThrowError(T result, char const *const func, const char *const file
 #define CHECK_FOR_CUDA_ERROR(val) \
     checkAndThrowError( (val), #val, __FILENAME__, __LINE__ )
 
-#define ABORT() asm("trap;");
-
-#define NEAR_ZERO 0.00001f
-
-#define CHECK(condition) \
-    if (!(condition)) { \
-        printf("Check failed. File: %s, Line: %d\n", __FILE__, __LINE__); \
-        ABORT(); \
-    }
-
 #define CUDA_THROW_NOT_IMPLEMENTED() \
     printf("Not implemented error. File: %s, Line: %d\n", __FILE__, __LINE__); \
     ABORT();
@@ -2,7 +2,7 @@
 
 #include "EngineInterface/CellFunctionConstants.h"
 
-#include "Base.cuh"
+#include "HostDevice.cuh"
 
 namespace Const
 {
@@ -17,32 +17,32 @@ public:
 
     using Matrix = float[2][2];
 
-    __inline__ __device__ static void rotationMatrix(float angle, Matrix& rotMatrix);
-    __inline__ __device__ static void inverseRotationMatrix(float angle, Matrix& rotMatrix);
-    __inline__ __device__ static float2 applyMatrix(float2 const& vec, Matrix const& matrix);
-    __inline__ __device__ static void angleCorrection(float& angle);
-    __inline__ __device__ static void angleCorrection(int& angle);
-    __inline__ __device__ static bool isInBetweenModulo(float value1, float value2, float candidate, float size);
-    __inline__ __device__ static bool isAngleInBetween(float angle1, float angle2, float angleBetweenCandidate);
-    __inline__ __device__ static void rotateQuarterClockwise(float2& v);
-    __inline__ __device__ static void rotateQuarterCounterClockwise(float2& v);
-    __inline__ __device__ static float angleOfVector(float2 const& v);  //0 DEG corresponds to (0,-1)
-    __inline__ __device__ static float2 unitVectorOfAngle(float angle);
-    __inline__ __device__ static void normalize(float2& vec);
-    __inline__ __device__ static float2 normalized(float2 vec);
-    __inline__ __device__ static float dot(float2 const& p, float2 const& q);
-    __inline__ __device__ static float2 crossProdProjected(float3 const& p, float3 const& q);
-    __inline__ __device__ static float length(float2 const& v);
-    __inline__ __device__ static float lengthMax(float2 const& v);
-    __inline__ __device__ static float length(int2 const& v);
-    __inline__ __device__ static float lengthSquared(float2 const& v);
-    __inline__ __device__ static float2 rotateClockwise(float2 const& v, float angle);
-    __inline__ __device__ static float subtractAngle(float angleMinuend, float angleSubtrahend);
-    __inline__ __device__ static float calcDistanceToLineSegment(float2 const& startSegment, float2 const& endSegment, float2 const& pos, float boundary = 0);
-    __inline__ __device__ static float alignAngle(float angle, ConstructorAngleAlignment alignment);
-    __inline__ __device__ static float alignAngleOnBoundaries(float angle, float maxAngle, ConstructorAngleAlignment alignment);
-    __inline__ __device__ static bool crossing(float2 const& segmentStart, float2 const& segmentEnd, float2 const& otherSegmentStart, float2 const& otherSegmentEnd);
-    __inline__ __device__ static float modulo(float value, float size);
+    __inline__ __host__ __device__ static void rotationMatrix(float angle, Matrix& rotMatrix);
+    __inline__ __host__ __device__ static void inverseRotationMatrix(float angle, Matrix& rotMatrix);
+    __inline__ __host__ __device__ static float2 applyMatrix(float2 const& vec, Matrix const& matrix);
+    __inline__ __host__ __device__ static void angleCorrection(float& angle);
+    __inline__ __host__ __device__ static void angleCorrection(int& angle);
+    __inline__ __host__ __device__ static bool isInBetweenModulo(float value1, float value2, float candidate, float size);
+    __inline__ __host__ __device__ static bool isAngleInBetween(float angle1, float angle2, float angleBetweenCandidate);
+    __inline__ __host__ __device__ static void rotateQuarterClockwise(float2& v);
+    __inline__ __host__ __device__ static void rotateQuarterCounterClockwise(float2& v);
+    __inline__ __host__ __device__ static float angleOfVector(float2 const& v);  //0 DEG corresponds to (0,-1)
+    __inline__ __host__ __device__ static float2 unitVectorOfAngle(float angle);
+    __inline__ __host__ __device__ static void normalize(float2& vec);
+    __inline__ __host__ __device__ static float2 normalized(float2 vec);
+    __inline__ __host__ __device__ static float dot(float2 const& p, float2 const& q);
+    __inline__ __host__ __device__ static float2 crossProdProjected(float3 const& p, float3 const& q);
+    __inline__ __host__ __device__ static float length(float2 const& v);
+    __inline__ __host__ __device__ static float lengthMax(float2 const& v);
+    __inline__ __host__ __device__ static float length(int2 const& v);
+    __inline__ __host__ __device__ static float lengthSquared(float2 const& v);
+    __inline__ __host__ __device__ static float2 rotateClockwise(float2 const& v, float angle);
+    __inline__ __host__ __device__ static float subtractAngle(float angleMinuend, float angleSubtrahend);
+    __inline__ __host__ __device__ static float calcDistanceToLineSegment(float2 const& startSegment, float2 const& endSegment, float2 const& pos, float boundary = 0);
+    __inline__ __host__ __device__ static float alignAngle(float angle, ConstructorAngleAlignment alignment);
+    __inline__ __host__ __device__ static float alignAngleOnBoundaries(float angle, float maxAngle, ConstructorAngleAlignment alignment);
+    __inline__ __host__ __device__ static bool crossing(float2 const& segmentStart, float2 const& segmentEnd, float2 const& otherSegmentStart, float2 const& otherSegmentEnd);
+    __inline__ __host__ __device__ static float modulo(float value, float size);
 };
 
 __inline__ __device__ __host__ float2 operator+(float2 const& p, float2 const& q)
@@ -131,20 +131,20 @@ __inline__ __device__ __host__ void operator-=(float2& p, float2 const& q)
 /* Implementation                                                       */
 /************************************************************************/
 
-__inline__ __device__ float2 Math::unitVectorOfAngle(float angle)
+__inline__ __host__ __device__ float2 Math::unitVectorOfAngle(float angle)
 {
     angle *= Const::DEG_TO_RAD;
     return{ sinf(angle), -cosf(angle) };
 }
 
-__inline__ __device__ float Math::angleOfVector(float2 const & v)
+__inline__ __host__ __device__ float Math::angleOfVector(float2 const & v)
 {
     if (length(v) < NEAR_ZERO) {
         return 0;
     }
 
     auto normalizedVy = -v.y / length(v);
-    normalizedVy = max(-1.0f, min(1.0f, normalizedVy));
+    normalizedVy = fmaxf(-1.0f, fminf(1.0f, normalizedVy));
     float angleSin = asinf(normalizedVy) * Const::RAD_TO_DEG;
     if (v.x >= 0.0f) {
         return 90.0f - angleSin;
@@ -154,51 +154,51 @@ __inline__ __device__ float Math::angleOfVector(float2 const & v)
     }
 }
 
-__inline__ __device__ void Math::rotateQuarterClockwise(float2& v)
+__inline__ __host__ __device__ void Math::rotateQuarterClockwise(float2& v)
 {
     float temp = v.x;
     v.x = -v.y;
     v.y = temp;
 }
 
-__device__ __inline__ void Math::rotateQuarterCounterClockwise(float2 &v)
+__inline__ __host__ __device__ void Math::rotateQuarterCounterClockwise(float2 &v)
 {
     float temp = v.x;
     v.x = v.y;
     v.y = -temp;
 }
 
-__inline__ __device__ void Math::rotationMatrix(float angle, Matrix& rotMatrix)
+__inline__ __host__ __device__ void Math::rotationMatrix(float angle, Matrix& rotMatrix)
 {
-    float sinAngle = __sinf(angle*Const::DEG_TO_RAD);
-    float cosAngle = __cosf(angle*Const::DEG_TO_RAD);
+    float sinAngle = alienFastSin(angle*Const::DEG_TO_RAD);
+    float cosAngle = alienFastCos(angle*Const::DEG_TO_RAD);
     rotMatrix[0][0] = cosAngle;
     rotMatrix[0][1] = -sinAngle;
     rotMatrix[1][0] = sinAngle;
     rotMatrix[1][1] = cosAngle;
 }
 
-__inline__ __device__ void Math::inverseRotationMatrix(float angle, Matrix& rotMatrix)
+__inline__ __host__ __device__ void Math::inverseRotationMatrix(float angle, Matrix& rotMatrix)
 {
-    float sinAngle = __sinf(angle*Const::DEG_TO_RAD);
-    float cosAngle = __cosf(angle*Const::DEG_TO_RAD);
+    float sinAngle = alienFastSin(angle*Const::DEG_TO_RAD);
+    float cosAngle = alienFastCos(angle*Const::DEG_TO_RAD);
     rotMatrix[0][0] = cosAngle;
     rotMatrix[0][1] = sinAngle;
     rotMatrix[1][0] = -sinAngle;
     rotMatrix[1][1] = cosAngle;
 }
 
-__inline__ __device__ float2 Math::applyMatrix(float2 const & vec, Matrix const & matrix)
+__inline__ __host__ __device__ float2 Math::applyMatrix(float2 const & vec, Matrix const & matrix)
 {
     return{ vec.x * matrix[0][0] + vec.y * matrix[0][1],  vec.x * matrix[1][0] + vec.y * matrix[1][1] };
 }
 
-__inline__ __device__ void Math::angleCorrection(int &angle)
+__inline__ __host__ __device__ void Math::angleCorrection(int &angle)
 {
     angle = ((angle % 360) + 360) % 360;
 }
 
-__inline__ __device__ bool Math::isInBetweenModulo(float value1, float value2, float candidate, float size)
+__inline__ __host__ __device__ bool Math::isInBetweenModulo(float value1, float value2, float candidate, float size)
 {
     if (value2 - value1 >= size) {
         return true;
@@ -220,7 +220,7 @@ __inline__ __device__ bool Math::isInBetweenModulo(float value1, float value2, f
     return valueMod2 - valueMod1 < size;
 }
 
-__inline__ __device__ bool Math::isAngleInBetween(float angle1, float angle2, float angleBetweenCandidate)
+__inline__ __host__ __device__ bool Math::isAngleInBetween(float angle1, float angle2, float angleBetweenCandidate)
 {
     if (angle1 == angle2 && angle1 != angleBetweenCandidate) {
         return false;
@@ -235,7 +235,7 @@ __inline__ __device__ bool Math::isAngleInBetween(float angle1, float angle2, fl
     return angle2 - angle1 < 360.0f;
 }
 
-__inline__ __device__ void Math::angleCorrection(float &angle)
+__inline__ __host__ __device__ void Math::angleCorrection(float &angle)
 {
     int intPart = (int)angle;
     float fracPart = angle - intPart;
@@ -243,9 +243,9 @@ __inline__ __device__ void Math::angleCorrection(float &angle)
     angle = (float)intPart + fracPart;
 }
 
-__device__ __inline__ void Math::normalize(float2 &vec)
+__inline__ __host__ __device__ void Math::normalize(float2 &vec)
 {
-    float length = sqrt(vec.x*vec.x + vec.y*vec.y);
+    float length = sqrtf(vec.x*vec.x + vec.y*vec.y);
     if (length > NEAR_ZERO) {
         vec = { vec.x / length, vec.y / length };
     }
@@ -254,50 +254,50 @@ __device__ __inline__ void Math::normalize(float2 &vec)
     }
 }
 
-__device__ __inline__ float2 Math::normalized(float2 vec)
+__inline__ __host__ __device__ float2 Math::normalized(float2 vec)
 {
     normalize(vec);
     return vec;
 }
 
-__device__ __inline__ float Math::dot(float2 const &p, float2 const &q)
+__inline__ __host__ __device__ float Math::dot(float2 const &p, float2 const &q)
 {
     return p.x*q.x + p.y*q.y;
 }
 
-__inline__ __device__ float2 Math::crossProdProjected(float3 const& p, float3 const& q)
+__inline__ __host__ __device__ float2 Math::crossProdProjected(float3 const& p, float3 const& q)
 {
     return {p.y * q.z - p.z * q.y, p.z * q.x - p.x * q.z};
 }
 
-__device__ __inline__ float Math::length(float2 const & v)
+__inline__ __host__ __device__ float Math::length(float2 const & v)
 {
-    return sqrt(v.x * v.x + v.y * v.y);
+    return sqrtf(v.x * v.x + v.y * v.y);
 }
 
-__device__ __inline__ float Math::lengthMax(float2 const& v)
+__inline__ __host__ __device__ float Math::lengthMax(float2 const& v)
 {
-    return max(abs(v.x), abs(v.y));
+    return fmaxf(fabsf(v.x), fabsf(v.y));
 }
 
-__device__ __inline__ float Math::length(int2 const & v)
+__inline__ __host__ __device__ float Math::length(int2 const & v)
 {
-    return sqrt(static_cast<float>(v.x * v.x + v.y * v.y));
+    return sqrtf(static_cast<float>(v.x * v.x + v.y * v.y));
 }
 
-__device__ __inline__ float Math::lengthSquared(float2 const & v)
+__inline__ __host__ __device__ float Math::lengthSquared(float2 const & v)
 {
     return v.x * v.x + v.y * v.y;
 }
 
-__inline__ __device__ float2 Math::rotateClockwise(float2 const & v, float angle)
+__inline__ __host__ __device__ float2 Math::rotateClockwise(float2 const & v, float angle)
 {
     Matrix rotMatrix;
     rotationMatrix(angle, rotMatrix);
     return applyMatrix(v, rotMatrix);
 }
 
-__inline__ __device__ float Math::subtractAngle(float angleMinuend, float angleSubtrahend)
+__inline__ __host__ __device__ float Math::subtractAngle(float angleMinuend, float angleSubtrahend)
 {
     auto angleDiff = angleMinuend - angleSubtrahend;
     if (angleDiff > 360.0f) {
@@ -309,7 +309,7 @@ __inline__ __device__ float Math::subtractAngle(float angleMinuend, float angleS
     return angleDiff;
 }
 
-__inline__ __device__ float
+__inline__ __host__ __device__ float
 Math::calcDistanceToLineSegment(float2 const& startSegment, float2 const& endSegment, float2 const& pos, float boundary)
 {
     auto const relPos = pos - startSegment;
@@ -323,7 +323,7 @@ Math::calcDistanceToLineSegment(float2 const& startSegment, float2 const& endSeg
     auto normal = segmentDirection;
     rotateQuarterCounterClockwise(normal);
     auto const signedDistanceFromLine = dot(relPos, normal);
-    if (abs(signedDistanceFromLine) > boundary) {
+    if (fabsf(signedDistanceFromLine) > boundary) {
         return boundary + 1.0f;
     }
 
@@ -332,10 +332,10 @@ Math::calcDistanceToLineSegment(float2 const& startSegment, float2 const& endSeg
         return boundary + 1.0f;
     }
 
-    return abs(signedDistanceFromLine);
+    return fabsf(signedDistanceFromLine);
 }
 
-__inline__ __device__ float Math::alignAngle(float angle, ConstructorAngleAlignment alignment)
+__inline__ __host__ __device__ float Math::alignAngle(float angle, ConstructorAngleAlignment alignment)
 {
     if (ConstructorAngleAlignment_None == alignment) {
         return angle;
@@ -346,7 +346,7 @@ __inline__ __device__ float Math::alignAngle(float angle, ConstructorAngleAlignm
     return factor * unitAngle;
 }
 
-__inline__ __device__ float Math::alignAngleOnBoundaries(float angle, float maxAngle, ConstructorAngleAlignment alignment)
+__inline__ __host__ __device__ float Math::alignAngleOnBoundaries(float angle, float maxAngle, ConstructorAngleAlignment alignment)
 {
     if (alignment != ConstructorAngleAlignment_None) {
         auto angleUnit = 360.0f / (alignment + 1);
@@ -360,7 +360,7 @@ __inline__ __device__ float Math::alignAngleOnBoundaries(float angle, float maxA
     return angle;
 }
 
-__inline__ __device__ bool Math::crossing(float2 const& segmentStart, float2 const& segmentEnd, float2 const& otherSegmentStart, float2 const& otherSegmentEnd)
+__inline__ __host__ __device__ bool Math::crossing(float2 const& segmentStart, float2 const& segmentEnd, float2 const& otherSegmentStart, float2 const& otherSegmentEnd)
 {
     auto const& p1 = segmentStart;
     auto v1 = segmentEnd - segmentStart;
@@ -368,7 +368,7 @@ __inline__ __device__ bool Math::crossing(float2 const& segmentStart, float2 con
     auto v2 = otherSegmentEnd - otherSegmentStart;
 
     auto divisor = v2.x * v1.y - v2.y * v1.x;
-    if (abs(divisor) < NEAR_ZERO) {
+    if (fabsf(divisor) < NEAR_ZERO) {
         return false;
     }
     auto mue = (v1.x * (p2.y - p1.y) - v1.y * (p2.x - p1.x)) / divisor;
@@ -377,9 +377,9 @@ __inline__ __device__ bool Math::crossing(float2 const& segmentStart, float2 con
     }
 
     float lambda;
-    if (abs(v1.x) > NEAR_ZERO) {
+    if (fabsf(v1.x) > NEAR_ZERO) {
         lambda = (p2.x - p1.x + mue * v2.x) / v1.x;
-    } else if (abs(v1.y) > NEAR_ZERO) {
+    } else if (fabsf(v1.y) > NEAR_ZERO) {
         lambda = (p2.y - p1.y + mue * v2.y) / v1.y;
     } else {
         return false;
@@ -388,7 +388,7 @@ __inline__ __device__ bool Math::crossing(float2 const& segmentStart, float2 con
     return lambda >= NEAR_ZERO && lambda <= 1 - NEAR_ZERO;
 }
 
-__inline__ __device__ float Math::modulo(float value, float size)
+__inline__ __host__ __device__ float Math::modulo(float value, float size)
 {
     return fmodf(fmodf(value, size) + size, size);
 }
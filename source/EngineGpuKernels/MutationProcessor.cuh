@@ -5,6 +5,8 @@
 
 #include "CellConnectionProcessor.cuh"
 #include "GenomeDecoder.cuh"
+#include "GenomeMutations.cuh"
+#include "PhiloxRandom.cuh"
 #include "CudaShapeGenerator.cuh"
 
 class MutationProcessor
@@ -14,27 +16,38 @@ public:
     __inline__ __device__ static void applyRandomMutations(SimulationData& data);
     __inline__ __device__ static void applyRandomMutationsForCell(SimulationData& data, Cell* cell);
 
-    __inline__ __device__ static void neuronDataMutation(SimulationData& data, Cell* cell);
-    __inline__ __device__ static void propertiesMutation(SimulationData& data, Cell* cell);
-    __inline__ __device__ static void geometryMutation(SimulationData& data, Cell* cell);
-    __inline__ __device__ static void customGeometryMutation(SimulationData& data, Cell* cell);
-    __inline__ __device__ static void cellFunctionMutation(SimulationData& data, Cell* cell);
-    __inline__ __device__ static void insertMutation(SimulationData& data, Cell* cell);
-    __inline__ __device__ static void deleteMutation(SimulationData& data, Cell* cell);
-    __inline__ __device__ static void translateMutation(SimulationData& data, Cell* cell);
-    __inline__ __device__ static void duplicateMutation(SimulationData& data, Cell* cell);
-    __inline__ __device__ static void cellColorMutation(SimulationData& data, Cell* cell);
-    __inline__ __device__ static void subgenomeColorMutation(SimulationData& data, Cell* cell);
-    __inline__ __device__ static void genomeColorMutation(SimulationData& data, Cell* cell);
+    template <typename RandomGenerator>
+    __inline__ __device__ static void neuronDataMutation(SimulationData& data, Cell* cell, RandomGenerator& numberGen);
+    template <typename RandomGenerator>
+    __inline__ __device__ static void propertiesMutation(SimulationData& data, Cell* cell, RandomGenerator& numberGen);
+    template <typename RandomGenerator>
+    __inline__ __device__ static void geometryMutation(SimulationData& data, Cell* cell, RandomGenerator& numberGen);
+    template <typename RandomGenerator>
+    __inline__ __device__ static void customGeometryMutation(SimulationData& data, Cell* cell, RandomGenerator& numberGen);
+    template <typename RandomGenerator>
+    __inline__ __device__ static void cellFunctionMutation(SimulationData& data, Cell* cell, RandomGenerator& numberGen);
+    template <typename RandomGenerator>
+    __inline__ __device__ static void insertMutation(SimulationData& data, Cell* cell, RandomGenerator& numberGen);
+    template <typename RandomGenerator>
+    __inline__ __device__ static void deleteMutation(SimulationData& data, Cell* cell, RandomGenerator& numberGen);
+    template <typename RandomGenerator>
+    __inline__ __device__ static void translateMutation(SimulationData& data, Cell* cell, RandomGenerator& numberGen);
+    template <typename RandomGenerator>
+    __inline__ __device__ static void duplicateMutation(SimulationData& data, Cell* cell, RandomGenerator& numberGen);
+    template <typename RandomGenerator>
+    __inline__ __device__ static void cellColorMutation(SimulationData& data, Cell* cell, RandomGenerator& numberGen);
+    template <typename RandomGenerator>
+    __inline__ __device__ static void subgenomeColorMutation(SimulationData& data, Cell* cell, RandomGenerator& numberGen);
+    template <typename RandomGenerator>
+    __inline__ __device__ static void genomeColorMutation(SimulationData& data, Cell* cell, RandomGenerator& numberGen);
 
 private:
     template <typename Func>
-    __inline__ __device__ static void executeEvent(SimulationData& data, float probability, Func eventFunc);
+    __inline__ __device__ static void executeEvent(PhiloxRandom& numberGen, float probability, Func eventFunc);
     template <typename Func>
-    __inline__ __device__ static void executeMultipleEvents(SimulationData& data, float probability, Func eventFunc);
+    __inline__ __device__ static void executeMultipleEvents(PhiloxRandom& numberGen, float probability, Func eventFunc);
     __inline__ __device__ static void adaptMutationId(SimulationData& data, ConstructorFunction& constructor);
-    __inline__ __device__ static bool isRandomEvent(SimulationData& data, float probability);
-    __inline__ __device__ static int getNewColorFromTransition(SimulationData& data, int origColor);
+    __inline__ __device__ static bool isRandomEvent(PhiloxRandom& numberGen, float probability);
 };
 
 /************************************************************************/
@@ -55,6 +68,9 @@ __inline__ __device__ void MutationProcessor::applyRandomMutations(SimulationDat
 
 __inline__ __device__ void MutationProcessor::applyRandomMutationsForCell(SimulationData& data, Cell* cell)
 {
+    //the mutations of a cell only depend on the seed, the time step and the cell, not on the scheduling of the threads
+    PhiloxRandom numberGen(data.seed, data.timestep, cell->id, RandomPurpose_Mutation);
+
     auto& constructor = cell->cellFunctionData.constructor;
     auto numNodes = toFloat(GenomeDecoder::getNumNodesRecursively(constructor.genome, constructor.genomeSize, false, true));
     auto cellCopyMutationNeuronData = SpotCalculator::calcParameter(
@@ -130,138 +146,54 @@ __inline__ __device__ void MutationProcessor::applyRandomMutationsForCell(Simula
         cell->pos,
         cell->color);
 
-    executeMultipleEvents(data, cellCopyMutationCellProperties, [&]() { propertiesMutation(data, cell); });
-    executeMultipleEvents(data, cellCopyMutationNeuronData, [&]() { neuronDataMutation(data, cell); });
-    executeEvent(data, cellCopyMutationGeometry, [&]() { geometryMutation(data, cell); });
-    executeEvent(data, cellCopyMutationCustomGeometry, [&]() { customGeometryMutation(data, cell); });
-    executeMultipleEvents(data, cellCopyMutationCellFunction, [&]() { cellFunctionMutation(data, cell); });
-    executeEvent(data, cellCopyMutationInsertion, [&]() {
+    executeMultipleEvents(numberGen, cellCopyMutationCellProperties, [&]() { propertiesMutation(data, cell, numberGen); });
+    executeMultipleEvents(numberGen, cellCopyMutationNeuronData, [&]() { neuronDataMutation(data, cell, numberGen); });
+    executeEvent(numberGen, cellCopyMutationGeometry, [&]() { geometryMutation(data, cell, numberGen); });
+    executeEvent(numberGen, cellCopyMutationCustomGeometry, [&]() { customGeometryMutation(data, cell, numberGen); });
+    executeMultipleEvents(numberGen, cellCopyMutationCellFunction, [&]() { cellFunctionMutation(data, cell, numberGen); });
+    executeEvent(numberGen, cellCopyMutationInsertion, [&]() {
         auto numNonSeparatedNodes = toFloat(GenomeDecoder::getNumNodesRecursively(constructor.genome, constructor.genomeSize, false, false));
         if (numNodes < 2 * numNonSeparatedNodes) {
-            insertMutation(data, cell);
+            insertMutation(data, cell, numberGen);
         }
     });
-    executeEvent(data, cellCopyMutationDeletion, [&]() { deleteMutation(data, cell); });
-    executeEvent(data, cellCopyMutationCellColor, [&]() { cellColorMutation(data, cell); });
-    executeEvent(data, cellCopyMutationTranslation, [&]() { translateMutation(data, cell); });
-    executeEvent(data, cellCopyMutationDuplication, [&]() {
+    executeEvent(numberGen, cellCopyMutationDeletion, [&]() { deleteMutation(data, cell, numberGen); });
+    executeEvent(numberGen, cellCopyMutationCellColor, [&]() { cellColorMutation(data, cell, numberGen); });
+    executeEvent(numberGen, cellCopyMutationTranslation, [&]() { translateMutation(data, cell, numberGen); });
+    executeEvent(numberGen, cellCopyMutationDuplication, [&]() {
         auto& constructor = cell->cellFunctionData.constructor;
         auto numNodes = toFloat(GenomeDecoder::getNumNodesRecursively(constructor.genome, constructor.genomeSize, false, true));
         auto numNonSeparatedNodes = toFloat(GenomeDecoder::getNumNodesRecursively(constructor.genome, constructor.genomeSize, false, false));
         if (numNodes < 2 * numNonSeparatedNodes) {
-            duplicateMutation(data, cell);
+            duplicateMutation(data, cell, numberGen);
         }
     });
-    executeEvent(data, cellCopyMutationSubgenomeColor, [&]() { subgenomeColorMutation(data, cell); });
-    executeEvent(data, cellCopyMutationGenomeColor, [&]() { genomeColorMutation(data, cell); });
+    executeEvent(numberGen, cellCopyMutationSubgenomeColor, [&]() { subgenomeColorMutation(data, cell, numberGen); });
+    executeEvent(numberGen, cellCopyMutationGenomeColor, [&]() { genomeColorMutation(data, cell, numberGen); });
 }
 
-__inline__ __device__ void MutationProcessor::neuronDataMutation(SimulationData& data, Cell* cell)
+template <typename RandomGenerator>
+__inline__ __device__ void MutationProcessor::neuronDataMutation(SimulationData& data, Cell* cell, RandomGenerator& numberGen)
 {
     auto& constructor = cell->cellFunctionData.constructor;
     if (GenomeDecoder::hasEmptyGenome(constructor)) {
         return;
     }
-
-    auto& genome = constructor.genome;
-    auto const& genomeSize = constructor.genomeSize;
-    auto nodeAddress = GenomeDecoder::getRandomGenomeNodeAddress(data, genome, genomeSize, false);
-
-    auto type = GenomeDecoder::getNextCellFunctionType(genome, nodeAddress);
-    if (type == CellFunction_Neuron) {
-        auto delta = data.numberGen1.random(Const::NeuronBytes - 1);
-        genome[nodeAddress + Const::CellBasicBytes + delta] = data.numberGen1.randomByte();
-    }
+    GenomeMutations::neuronDataMutation(numberGen, constructor.genome, constructor.genomeSize);
 }
 
-__inline__ __device__ void MutationProcessor::propertiesMutation(SimulationData& data, Cell* cell)
+template <typename RandomGenerator>
+__inline__ __device__ void MutationProcessor::propertiesMutation(SimulationData& data, Cell* cell, RandomGenerator& numberGen)
 {
     auto& constructor = cell->cellFunctionData.constructor;
     if (GenomeDecoder::hasEmptyGenome(constructor)) {
         return;
     }
-
-    auto& genome = constructor.genome;
-    auto const& genomeSize = constructor.genomeSize;
-    auto numNodes = GenomeDecoder::getNumNodesRecursively(genome, genomeSize, false, true);
-    auto node = data.numberGen1.random(numNodes - 1);
-    auto sequenceNumber = 0;
-
-    uint8_t prevExecutionNumber = data.numberGen1.randomByte();
-    uint8_t nextExecutionNumber = data.numberGen1.randomByte();
-    uint8_t prevInputExecutionNumber = data.numberGen1.randomByte();
-    uint8_t nextInputExecutionNumber = data.numberGen1.randomByte();
-    int nodeAddress = 0;
-    GenomeDecoder::executeForEachNodeRecursively(genome, genomeSize, true, false, [&](int depth, int nodeAddressIntern, int repetition) {
-        auto origSequenceNumber = sequenceNumber;
-        ++sequenceNumber;
-        if (origSequenceNumber == node - 1) {
-            prevExecutionNumber = GenomeDecoder::getNextExecutionNumber(genome, nodeAddressIntern);
-            prevInputExecutionNumber = GenomeDecoder::getNextInputExecutionNumber(genome, nodeAddressIntern);
-        }
-        if (origSequenceNumber == node + 1) {
-            nextExecutionNumber = GenomeDecoder::getNextExecutionNumber(genome, nodeAddressIntern);
-            nextInputExecutionNumber = GenomeDecoder::getNextInputExecutionNumber(genome, nodeAddressIntern);
-        }
-        if (origSequenceNumber == node) {
-            nodeAddress = nodeAddressIntern;
-        }
-    });
-    if (nodeAddress == 0) {
-        return;
-    }
-
-    //already fitting input-output connection? => use other input
-    auto executionNumber = GenomeDecoder::getNextInputExecutionNumber(genome, nodeAddress) % cudaSimulationParameters.cellNumExecutionOrderNumbers;
-    if (executionNumber == (prevInputExecutionNumber % cudaSimulationParameters.cellNumExecutionOrderNumbers)) {
-        prevExecutionNumber = nextExecutionNumber;
-    }
-    if (executionNumber == (nextInputExecutionNumber % cudaSimulationParameters.cellNumExecutionOrderNumbers)) {
-        nextExecutionNumber = prevExecutionNumber;
-    }
-
-    //basic property mutation
-    if (data.numberGen1.randomBool()) {
-        if (data.numberGen1.randomBool()) {
-            auto randomByte = data.numberGen1.randomByte();
-            if (data.numberGen1.random() < 0.8f) {
-                randomByte = data.numberGen1.randomBool() ? prevExecutionNumber : nextExecutionNumber;
-            }
-            GenomeDecoder::setNextInputExecutionNumber(genome, nodeAddress, randomByte);
-        } else {
-            auto randomDelta = data.numberGen1.random(Const::CellBasicBytes - 1);
-            auto randomByte = data.numberGen1.randomByte();
-            if (randomDelta == 0) {  //no cell function type change
-                return;
-            }
-            if (randomDelta == Const::CellColorPos) {  //no color change
-                return;
-            }
-            if (randomDelta == Const::CellAnglePos || randomDelta == Const::CellRequiredConnectionsPos) {  //no structure change
-                return;
-            }
-            genome[nodeAddress + randomDelta] = randomByte;
-        }
-    }
-
-    //cell function specific mutation
-    else {
-        auto nextCellFunctionDataSize = GenomeDecoder::getNextCellFunctionDataSize(genome, genomeSize, nodeAddress, false);
-        if (nextCellFunctionDataSize > 0) {
-            auto randomDelta = data.numberGen1.random(nextCellFunctionDataSize - 1);
-            auto cellFunction = GenomeDecoder::getNextCellFunctionType(genome, nodeAddress);
-            if (cellFunction == CellFunction_Constructor
-                && (randomDelta == Const::ConstructorConstructionAngle1Pos
-                    || randomDelta == Const::ConstructorConstructionAngle2Pos)) {  //no construction angles change
-                return;
-            }
-            genome[nodeAddress + Const::CellBasicBytes + randomDelta] = data.numberGen1.randomByte();
-            //adaptMutationId(data, constructor);
-        }
-    }
+    GenomeMutations::propertiesMutation(numberGen, constructor.genome, constructor.genomeSize, cudaSimulationParameters.cellNumExecutionOrderNumbers);
 }
 
-__inline__ __device__ void MutationProcessor::geometryMutation(SimulationData& data, Cell* cell)
+template <typename RandomGenerator>
+__inline__ __device__ void MutationProcessor::geometryMutation(SimulationData& data, Cell* cell, RandomGenerator& numberGen)
 {
     auto& constructor = cell->cellFunctionData.constructor;
     if (GenomeDecoder::hasEmptyGenome(constructor)) {
@@ -277,7 +209,7 @@ __inline__ __device__ void MutationProcessor::geometryMutation(SimulationData& d
         int subGenomesSizeIndices[GenomeDecoder::MAX_SUBGENOME_RECURSION_DEPTH];
         int numSubGenomesSizeIndices;
         GenomeDecoder::getRandomGenomeNodeAddress(
-            data, genome, genomeSize, false, subGenomesSizeIndices, &numSubGenomesSizeIndices);  //return value will be discarded
+            numberGen, genome, genomeSize, false, subGenomesSizeIndices, &numSubGenomesSizeIndices);  //return value will be discarded
 
         if (numSubGenomesSizeIndices > 0) {
             subgenome = genome + subGenomesSizeIndices[numSubGenomesSizeIndices - 1] + 2;  //+2 because 2 bytes encode the sub-genome length
@@ -285,16 +217,16 @@ __inline__ __device__ void MutationProcessor::geometryMutation(SimulationData& d
         }
     }
 
-    auto delta = data.numberGen1.random(Const::GenomeHeaderSize - 1);
+    auto delta = numberGen.random(Const::GenomeHeaderSize - 1);
 
     if (delta == Const::GenomeHeaderNumRepetitionsPos) {
-        auto choice = data.numberGen1.random(250);
+        auto choice = numberGen.random(250);
         if (choice < 230) {
-            subgenome[delta] = static_cast<uint8_t>(1 + data.numberGen1.random(2));
+            subgenome[delta] = static_cast<uint8_t>(1 + numberGen.random(2));
         } else if (choice < 240) {
-            subgenome[delta] = static_cast<uint8_t>(1 + data.numberGen1.random(10));
+            subgenome[delta] = static_cast<uint8_t>(1 + numberGen.random(10));
         } else if (choice == 240) {
-            subgenome[delta] = static_cast<uint8_t>(1 + data.numberGen1.random(20));
+            subgenome[delta] = static_cast<uint8_t>(1 + numberGen.random(20));
         } else {
             //no infinite repetitions
             //subgenome[delta] = 255;
@@ -302,10 +234,10 @@ __inline__ __device__ void MutationProcessor::geometryMutation(SimulationData& d
         return;
     }
     if (delta == Const::GenomeHeaderNumBranchesPos) {
-        subgenome[delta] = data.numberGen1.randomBool() ? 1 : data.numberGen1.randomByte();
+        subgenome[delta] = numberGen.randomBool() ? 1 : numberGen.randomByte();
     }
 
-    auto mutatedByte = data.numberGen1.randomByte();
+    auto mutatedByte = numberGen.randomByte();
     //if (delta == Const::GenomeHeaderSeparationPos && GenomeDecoder::convertByteToBool(mutatedByte)) {
     //    return;
     //}
@@ -330,46 +262,18 @@ __inline__ __device__ void MutationProcessor::geometryMutation(SimulationData& d
     subgenome[delta] = mutatedByte;
 }
 
-__inline__ __device__ void MutationProcessor::customGeometryMutation(SimulationData& data, Cell* cell)
+template <typename RandomGenerator>
+__inline__ __device__ void MutationProcessor::customGeometryMutation(SimulationData& data, Cell* cell, RandomGenerator& numberGen)
 {
     auto& constructor = cell->cellFunctionData.constructor;
     if (GenomeDecoder::hasEmptyGenome(constructor)) {
         return;
     }
-
-
-    auto& genome = constructor.genome;
-    auto const& genomeSize = constructor.genomeSize;
-
-    auto numNodes = GenomeDecoder::getNumNodesRecursively(genome, genomeSize, false, true);
-    auto node = data.numberGen1.random(numNodes - 1);
-    auto sequenceNumber = 0;
-    GenomeDecoder::executeForEachNodeRecursively(genome, genomeSize, true, false, [&](int depth, int nodeAddress, int repetition) {
-        if (sequenceNumber++ != node) {
-            return;
-        }
-        auto cellFunction = GenomeDecoder::getNextCellFunctionType(genome, nodeAddress);
-        auto choice =
-            cellFunction == CellFunction_Constructor ? data.numberGen1.random(3) : data.numberGen1.random(1);
-        switch (choice) {
-        case 0:
-            GenomeDecoder::setNextAngle(genome, nodeAddress, data.numberGen1.randomByte());
-            break;
-        case 1:
-            GenomeDecoder::setNextRequiredConnections(genome, nodeAddress, data.numberGen1.randomByte());
-            break;
-        case 2:
-            GenomeDecoder::setNextConstructionAngle1(genome, nodeAddress, data.numberGen1.randomByte());
-            break;
-        case 3:
-            GenomeDecoder::setNextConstructionAngle2(genome, nodeAddress, data.numberGen1.randomByte());
-            break;
-        }
-        //adaptMutationId(data, constructor);
-    });
+    GenomeMutations::customGeometryMutation(numberGen, constructor.genome, constructor.genomeSize);
 }
 
-__inline__ __device__ void MutationProcessor::cellFunctionMutation(SimulationData& data, Cell* cell)
+template <typename RandomGenerator>
+__inline__ __device__ void MutationProcessor::cellFunctionMutation(SimulationData& data, Cell* cell, RandomGenerator& numberGen)
 {
     auto& constructor = cell->cellFunctionData.constructor;
     if (GenomeDecoder::hasEmptyGenome(constructor)) {
@@ -381,10 +285,10 @@ __inline__ __device__ void MutationProcessor::cellFunctionMutation(SimulationDat
 
     int subGenomesSizeIndices[GenomeDecoder::MAX_SUBGENOME_RECURSION_DEPTH];
     int numSubGenomesSizeIndices;
-    auto nodeAddress = GenomeDecoder::getRandomGenomeNodeAddress(data, genome, genomeSize, false, subGenomesSizeIndices, &numSubGenomesSizeIndices);
+    auto nodeAddress = GenomeDecoder::getRandomGenomeNodeAddress(numberGen, genome, genomeSize, false, subGenomesSizeIndices, &numSubGenomesSizeIndices);
 
-    auto newCellFunction = data.numberGen1.random(CellFunction_Count - 1);
-    auto makeSelfCopy = cudaSimulationParameters.cellFunctionConstructorMutationSelfReplication ? data.numberGen1.randomBool() : false;
+    auto newCellFunction = numberGen.random(CellFunction_Count - 1);
+    auto makeSelfCopy = cudaSimulationParameters.cellFunctionConstructorMutationSelfReplication ? numberGen.randomBool() : false;
     if (newCellFunction == CellFunction_Injector) {      //not injection mutation allowed at the moment
         return;
     }
@@ -420,7 +324,7 @@ __inline__ __device__ void MutationProcessor::cellFunctionMutation(SimulationDat
         targetGenome[i] = genome[i];
     }
     GenomeDecoder::setNextCellFunctionType(targetGenome, nodeAddress, newCellFunction);
-    GenomeDecoder::setRandomCellFunctionData(data, targetGenome, nodeAddress + Const::CellBasicBytes, newCellFunction, makeSelfCopy, Const::GenomeHeaderSize);
+    GenomeDecoder::setRandomCellFunctionData(numberGen, targetGenome, nodeAddress + Const::CellBasicBytes, newCellFunction, makeSelfCopy, Const::GenomeHeaderSize);
     //if (newCellFunction == CellFunction_Constructor && !makeSelfCopy) {
     //    GenomeDecoder::setNextConstructorSeparation(targetGenome, nodeAddress, false);  //currently no sub-genome with separation property wished
     //}
@@ -438,7 +342,8 @@ __inline__ __device__ void MutationProcessor::cellFunctionMutation(SimulationDat
     //adaptMutationId(data, constructor);
 }
 
-__inline__ __device__ void MutationProcessor::insertMutation(SimulationData& data, Cell* cell)
+template <typename RandomGenerator>
+__inline__ __device__ void MutationProcessor::insertMutation(SimulationData& data, Cell* cell, RandomGenerator& numberGen)
 {
     auto& constructor = cell->cellFunctionData.constructor;
     auto& genome = constructor.genome;
@@ -448,11 +353,11 @@ __inline__ __device__ void MutationProcessor::insertMutation(SimulationData& dat
     int numSubGenomesSizeIndices;
 
     int nodeAddress = 0;
-    uint8_t prevExecutionNumber = data.numberGen1.randomByte();
-    uint8_t nextExecutionNumber = data.numberGen1.randomByte();
+    uint8_t prevExecutionNumber = numberGen.randomByte();
+    uint8_t nextExecutionNumber = numberGen.randomByte();
 
     //calculate addess where the new node should be inserted
-    if (data.numberGen1.randomBool() && genomeSize > Const::GenomeHeaderSize) {
+    if (numberGen.randomBool() && genomeSize > Const::GenomeHeaderSize) {
 
         //choose a random node position to a constructor with a subgenome
         int numConstructorsWithSubgenome = 0;
@@ -463,7 +368,7 @@ __inline__ __device__ void MutationProcessor::insertMutation(SimulationData& dat
             }
         });
         if (numConstructorsWithSubgenome > 0) {
-            auto randomIndex = data.numberGen1.random(numConstructorsWithSubgenome - 1);
+            auto randomIndex = numberGen.random(numConstructorsWithSubgenome - 1);
             auto counter = 0;
             GenomeDecoder::executeForEachNodeRecursively(genome, genomeSize, true, false, [&](int depth, int nodeAddressIntern, int repetition) {
                 auto cellFunctionType = GenomeDecoder::getNextCellFunctionType(genome, nodeAddressIntern);
@@ -477,7 +382,7 @@ __inline__ __device__ void MutationProcessor::insertMutation(SimulationData& dat
             });
         }
     }
-    nodeAddress = GenomeDecoder::getRandomGenomeNodeAddress(data, genome, genomeSize, true, subGenomesSizeIndices, &numSubGenomesSizeIndices, nodeAddress);
+    nodeAddress = GenomeDecoder::getRandomGenomeNodeAddress(numberGen, genome, genomeSize, true, subGenomesSizeIndices, &numSubGenomesSizeIndices, nodeAddress);
     if (numSubGenomesSizeIndices >= GenomeDecoder::MAX_SUBGENOME_RECURSION_DEPTH - 2) {
         return;
     }
@@ -488,8 +393,8 @@ __inline__ __device__ void MutationProcessor::insertMutation(SimulationData& dat
         newColor = GenomeDecoder::getNextCellColor(genome, nodeAddress);
         nextExecutionNumber = GenomeDecoder::getNextExecutionNumber(genome, nodeAddress);
     }
-    auto newCellFunction = data.numberGen1.random(CellFunction_Count - 1);
-    auto makeSelfCopy = cudaSimulationParameters.cellFunctionConstructorMutationSelfReplication ? data.numberGen1.randomBool() : false;
+    auto newCellFunction = numberGen.random(CellFunction_Count - 1);
+    auto makeSelfCopy = cudaSimulationParameters.cellFunctionConstructorMutationSelfReplication ? numberGen.randomBool() : false;
     if (newCellFunction == CellFunction_Injector) {  //not injection mutation allowed at the moment
         return;
     }
@@ -511,19 +416,19 @@ __inline__ __device__ void MutationProcessor::insertMutation(SimulationData& dat
     for (int i = 0; i < nodeAddress; ++i) {
         targetGenome[i] = genome[i];
     }
-    data.numberGen1.randomBytes(targetGenome + nodeAddress, Const::CellBasicBytes);
+    numberGen.randomBytes(targetGenome + nodeAddress, Const::CellBasicBytes);
     GenomeDecoder::setNextCellFunctionType(targetGenome, nodeAddress, newCellFunction);
     GenomeDecoder::setNextCellColor(targetGenome, nodeAddress, newColor);
-    if (data.numberGen1.random() < 0.9f) {  //fitting input execution number should be often
-        GenomeDecoder::setNextInputExecutionNumber(targetGenome, nodeAddress, data.numberGen1.randomBool() ? prevExecutionNumber : nextExecutionNumber);
+    if (numberGen.random() < 0.9f) {  //fitting input execution number should be often
+        GenomeDecoder::setNextInputExecutionNumber(targetGenome, nodeAddress, numberGen.randomBool() ? prevExecutionNumber : nextExecutionNumber);
     }
-    if (data.numberGen1.random() < 0.9f) {
+    if (numberGen.random() < 0.9f) {
         GenomeDecoder::setNextOutputBlocked(targetGenome, nodeAddress, false);  //non-blocking output should be often
     }
-    GenomeDecoder::setRandomCellFunctionData(data, targetGenome, nodeAddress + Const::CellBasicBytes, newCellFunction, makeSelfCopy, Const::GenomeHeaderSize);
+    GenomeDecoder::setRandomCellFunctionData(numberGen, targetGenome, nodeAddress + Const::CellBasicBytes, newCellFunction, makeSelfCopy, Const::GenomeHeaderSize);
     if (newCellFunction == CellFunction_Constructor && !makeSelfCopy) {
         //GenomeDecoder::setNextConstructorSeparation(targetGenome, nodeAddress, false);      //currently no sub-genome with separation property wished
-        auto numBranches = data.numberGen1.randomBool() ? 1 : data.numberGen1.randomByte();
+        auto numBranches = numberGen.randomBool() ? 1 : numberGen.randomByte();
         GenomeDecoder::setNextConstructorNumBranches(targetGenome, nodeAddress, numBranches);
     }
 
@@ -540,7 +445,8 @@ __inline__ __device__ void MutationProcessor::insertMutation(SimulationData& dat
     adaptMutationId(data, constructor);
 }
 
-__inline__ __device__ void MutationProcessor::deleteMutation(SimulationData& data, Cell* cell)
+template <typename RandomGenerator>
+__inline__ __device__ void MutationProcessor::deleteMutation(SimulationData& data, Cell* cell, RandomGenerator& numberGen)
 {
     auto& constructor = cell->cellFunctionData.constructor;
     if (GenomeDecoder::hasEmptyGenome(constructor)) {
@@ -552,7 +458,7 @@ __inline__ __device__ void MutationProcessor::deleteMutation(SimulationData& dat
 
     int subGenomesSizeIndices[GenomeDecoder::MAX_SUBGENOME_RECURSION_DEPTH];
     int numSubGenomesSizeIndices;
-    auto nodeAddress = GenomeDecoder::getRandomGenomeNodeAddress(data, genome, genomeSize, false, subGenomesSizeIndices, &numSubGenomesSizeIndices);
+    auto nodeAddress = GenomeDecoder::getRandomGenomeNodeAddress(numberGen, genome, genomeSize, false, subGenomesSizeIndices, &numSubGenomesSizeIndices);
 
     auto origCellFunctionSize = GenomeDecoder::getNextCellFunctionDataSize(genome, genomeSize, nodeAddress);
     auto deleteSize = Const::CellBasicBytes + origCellFunctionSize;
@@ -581,7 +487,8 @@ __inline__ __device__ void MutationProcessor::deleteMutation(SimulationData& dat
     adaptMutationId(data, constructor);
 }
 
-__inline__ __device__ void MutationProcessor::translateMutation(SimulationData& data, Cell* cell)
+template <typename RandomGenerator>
+__inline__ __device__ void MutationProcessor::translateMutation(SimulationData& data, Cell* cell, RandomGenerator& numberGen)
 {
     auto& constructor = cell->cellFunctionData.constructor;
     if (GenomeDecoder::hasEmptyGenome(constructor)) {
@@ -593,7 +500,7 @@ __inline__ __device__ void MutationProcessor::translateMutation(SimulationData&
     auto const& genomeSize = constructor.genomeSize;
     int subGenomesSizeIndices1[GenomeDecoder::MAX_SUBGENOME_RECURSION_DEPTH + 1];
     int numSubGenomesSizeIndices1;
-    auto startSourceIndex = GenomeDecoder::getRandomGenomeNodeAddress(data, genome, genomeSize, false, subGenomesSizeIndices1, &numSubGenomesSizeIndices1);
+    auto startSourceIndex = GenomeDecoder::getRandomGenomeNodeAddress(numberGen, genome, genomeSize, false, subGenomesSizeIndices1, &numSubGenomesSizeIndices1);
 
     int subGenomeSize;
     uint8_t* subGenome;
@@ -606,7 +513,7 @@ __inline__ __device__ void MutationProcessor::translateMutation(SimulationData&
         subGenomeSize = genomeSize;
     }
     auto numCells = GenomeDecoder::getNumNodes(subGenome, subGenomeSize);
-    auto endRelativeCellIndex = data.numberGen1.random(numCells - 1) + 1;
+    auto endRelativeCellIndex = numberGen.random(numCells - 1) + 1;
     auto endRelativeNodeAddress = GenomeDecoder::getNodeAddress(subGenome, subGenomeSize, endRelativeCellIndex);
     auto endSourceIndex = toInt(endRelativeNodeAddress + (subGenome - genome));
     if (endSourceIndex <= startSourceIndex) {
@@ -622,7 +529,7 @@ __inline__ __device__ void MutationProcessor::translateMutation(SimulationData&
     //calc target insertion point
     int subGenomesSizeIndices2[GenomeDecoder::MAX_SUBGENOME_RECURSION_DEPTH + 1];
     int numSubGenomesSizeIndices2;
-    auto startTargetIndex = GenomeDecoder::getRandomGenomeNodeAddress(data, genome, genomeSize, true, subGenomesSizeIndices2, &numSubGenomesSizeIndices2);
+    auto startTargetIndex = GenomeDecoder::getRandomGenomeNodeAddress(numberGen, genome, genomeSize, true, subGenomesSizeIndices2, &numSubGenomesSizeIndices2);
 
     if (startTargetIndex >= startSourceIndex && startTargetIndex <= endSourceIndex) {
         return;
@@ -711,7 +618,8 @@ __inline__ __device__ void MutationProcessor::translateMutation(SimulationData&
     adaptMutationId(data, constructor);
 }
 
-__inline__ __device__ void MutationProcessor::duplicateMutation(SimulationData& data, Cell* cell)
+template <typename RandomGenerator>
+__inline__ __device__ void MutationProcessor::duplicateMutation(SimulationData& data, Cell* cell, RandomGenerator& numberGen)
 {
     auto& constructor = cell->cellFunctionData.constructor;
     if (GenomeDecoder::hasEmptyGenome(constructor)) {
@@ -728,7 +636,7 @@ __inline__ __device__ void MutationProcessor::duplicateMutation(SimulationData&
     {
         int subGenomesSizeIndices[GenomeDecoder::MAX_SUBGENOME_RECURSION_DEPTH + 1];
         int numSubGenomesSizeIndices;
-        startSourceIndex = GenomeDecoder::getRandomGenomeNodeAddress(data, genome, genomeSize, false, subGenomesSizeIndices, &numSubGenomesSizeIndices);
+        startSourceIndex = GenomeDecoder::getRandomGenomeNodeAddress(numberGen, genome, genomeSize, false, subGenomesSizeIndices, &numSubGenomesSizeIndices);
 
         if (numSubGenomesSizeIndices > 0) {
             auto sizeIndex = subGenomesSizeIndices[numSubGenomesSizeIndices - 1];
@@ -739,7 +647,7 @@ __inline__ __device__ void MutationProcessor::duplicateMutation(SimulationData&
             subGenomeSize = genomeSize;
         }
         auto numCells = GenomeDecoder::getNumNodes(subGenome, subGenomeSize);
-        auto endRelativeCellIndex = data.numberGen1.random(numCells - 1) + 1;
+        auto endRelativeCellIndex = numberGen.random(numCells - 1) + 1;
         auto endRelativeNodeAddress = GenomeDecoder::getNodeAddress(subGenome, subGenomeSize, endRelativeCellIndex);
         endSourceIndex = toInt(endRelativeNodeAddress + (subGenome - genome));
         if (endSourceIndex <= startSourceIndex) {
@@ -755,7 +663,7 @@ __inline__ __device__ void MutationProcessor::duplicateMutation(SimulationData&
 
     int subGenomesSizeIndices[GenomeDecoder::MAX_SUBGENOME_RECURSION_DEPTH + 1];
     int numSubGenomesSizeIndices;
-    auto startTargetIndex = GenomeDecoder::getRandomGenomeNodeAddress(data, genome, genomeSize, true, subGenomesSizeIndices, &numSubGenomesSizeIndices);
+    auto startTargetIndex = GenomeDecoder::getRandomGenomeNodeAddress(numberGen, genome, genomeSize, true, subGenomesSizeIndices, &numSubGenomesSizeIndices);
 
     auto targetGenomeSize = genomeSize + sizeDelta;
     if (targetGenomeSize > MAX_GENOME_BYTES) {
@@ -793,106 +701,55 @@ __inline__ __device__ void MutationProcessor::duplicateMutation(SimulationData&
     adaptMutationId(data, constructor);
 }
 
-__inline__ __device__ void MutationProcessor::cellColorMutation(SimulationData& data, Cell* cell)
+template <typename RandomGenerator>
+__inline__ __device__ void MutationProcessor::cellColorMutation(SimulationData& data, Cell* cell, RandomGenerator& numberGen)
 {
     auto& constructor = cell->cellFunctionData.constructor;
     if (GenomeDecoder::hasEmptyGenome(constructor)) {
         return;
     }
-
-    auto& genome = constructor.genome;
-    auto const& genomeSize = constructor.genomeSize;
-    auto numNodes = GenomeDecoder::getNumNodesRecursively(genome, genomeSize, false, true);
-    auto randomNode = data.numberGen1.random(numNodes - 1);
-    auto sequenceNumber = 0;
-    GenomeDecoder::executeForEachNodeRecursively(genome, genomeSize, true, false, [&](int depth, int nodeAddress, int repetition) {
-        if (sequenceNumber++ != randomNode) {
-            return;
-        }
-        auto origColor = GenomeDecoder::getNextCellColor(genome, nodeAddress);
-        auto newColor = getNewColorFromTransition(data, origColor);
-        if (newColor == -1) {
-            return;
-        }
-        GenomeDecoder::setNextCellColor(genome, nodeAddress, newColor);
-    });
+    GenomeMutations::cellColorMutation(numberGen, constructor.genome, constructor.genomeSize, cudaSimulationParameters.cellFunctionConstructorMutationColorTransitions);
 }
 
-__inline__ __device__ void MutationProcessor::subgenomeColorMutation(SimulationData& data, Cell* cell)
+template <typename RandomGenerator>
+__inline__ __device__ void MutationProcessor::subgenomeColorMutation(SimulationData& data, Cell* cell, RandomGenerator& numberGen)
 {
     auto& constructor = cell->cellFunctionData.constructor;
     if (GenomeDecoder::hasEmptyGenome(constructor)) {
         return;
     }
-
-    auto& genome = constructor.genome;
-    auto const& genomeSize = constructor.genomeSize;
-
-    int subGenomesSizeIndices[GenomeDecoder::MAX_SUBGENOME_RECURSION_DEPTH];
-    int numSubGenomesSizeIndices;
-    GenomeDecoder::getRandomGenomeNodeAddress(data, genome, genomeSize, false, subGenomesSizeIndices, &numSubGenomesSizeIndices);  //return value will be discarded
-
-    int nodeAddress = Const::GenomeHeaderSize;
-    auto subgenome = genome;
-    int subgenomeSize = genomeSize;
-    if (numSubGenomesSizeIndices > 0) {
-        subgenome = genome + subGenomesSizeIndices[numSubGenomesSizeIndices - 1] + 2;  //+2 because 2 bytes encode the sub-genome length
-        subgenomeSize = GenomeDecoder::readWord(genome, subGenomesSizeIndices[numSubGenomesSizeIndices - 1]);
-    }
-
-    auto origColor = GenomeDecoder::getNextCellColor(subgenome, nodeAddress);
-    auto newColor = getNewColorFromTransition(data, origColor);
-    if (newColor == -1) {
-        return;
-    }
-    if (origColor != newColor) {
+    if (GenomeMutations::subgenomeColorMutation(numberGen, constructor.genome, constructor.genomeSize, cudaSimulationParameters.cellFunctionConstructorMutationColorTransitions)) {
         adaptMutationId(data, constructor);
     }
-
-    for (int dummy = 0; nodeAddress < subgenomeSize && dummy < subgenomeSize; ++dummy) {
-        GenomeDecoder::setNextCellColor(subgenome, nodeAddress, newColor);
-        nodeAddress += Const::CellBasicBytes + GenomeDecoder::getNextCellFunctionDataSize(subgenome, subgenomeSize, nodeAddress);
-    }
 }
 
-__inline__ __device__ void MutationProcessor::genomeColorMutation(SimulationData& data, Cell* cell)
+template <typename RandomGenerator>
+__inline__ __device__ void MutationProcessor::genomeColorMutation(SimulationData& data, Cell* cell, RandomGenerator& numberGen)
 {
     auto& constructor = cell->cellFunctionData.constructor;
     if (GenomeDecoder::hasEmptyGenome(constructor)) {
         return;
     }
-
-    auto& genome = constructor.genome;
-    auto const& genomeSize = constructor.genomeSize;
-
-    auto origColor = GenomeDecoder::getNextCellColor(genome, Const::GenomeHeaderSize);
-    auto newColor = getNewColorFromTransition(data, origColor);
-    if (newColor == -1) {
-        return;
-    }
-    if (origColor != newColor) {
+    if (GenomeMutations::genomeColorMutation(numberGen, constructor.genome, constructor.genomeSize, cudaSimulationParameters.cellFunctionConstructorMutationColorTransitions)) {
         adaptMutationId(data, constructor);
     }
-
-    GenomeDecoder::executeForEachNodeRecursively(
-        genome, genomeSize, true, false, [&](int depth, int nodeAddress, int repetition) { GenomeDecoder::setNextCellColor(genome, nodeAddress, newColor); });
 }
 
 template <typename Func>
-__inline__ __device__ void MutationProcessor::executeMultipleEvents(SimulationData& data, float probability, Func eventFunc)
+__inline__ __device__ void MutationProcessor::executeMultipleEvents(PhiloxRandom& numberGen, float probability, Func eventFunc)
 {
     for (int i = 0, j = toInt(probability); i < j; ++i) {
         eventFunc();
     }
-    if (isRandomEvent(data, probability)) {
+    if (isRandomEvent(numberGen, probability)) {
         eventFunc();
     }
 }
 
 template <typename Func>
-__inline__ __device__ void MutationProcessor::executeEvent(SimulationData& data, float probability, Func eventFunc)
+__inline__ __device__ void MutationProcessor::executeEvent(PhiloxRandom& numberGen, float probability, Func eventFunc)
 {
-    if (isRandomEvent(data, probability)) {
+    if (isRandomEvent(numberGen, probability)) {
         eventFunc();
     }
 }
@@ -900,42 +757,15 @@ __inline__ __device__ void MutationProcessor::executeEvent(SimulationData& data,
 __inline__ __device__ void MutationProcessor::adaptMutationId(SimulationData& data, ConstructorFunction& constructor)
 {
     if (GenomeDecoder::containsSelfReplication(constructor)) {
-        constructor.offspringMutationId = data.numberGen1.createNewSmallId();
+        constructor.offspringMutationId = numberGen.createNewSmallId();
     }
 }
 
-__inline__ __device__ bool MutationProcessor::isRandomEvent(SimulationData& data, float probability)
+__inline__ __device__ bool MutationProcessor::isRandomEvent(PhiloxRandom& numberGen, float probability)
 {
     if (probability > 0.001f) {
-        return data.numberGen1.random() < probability;
+        return numberGen.random() < probability;
     } else {
-        return data.numberGen1.random() < probability * 1000 && data.numberGen2.random() < 0.001f;
+        return numberGen.random() < probability * 1000 && numberGen.random() < 0.001f;
     }
 }
-
-__inline__ __device__ int MutationProcessor::getNewColorFromTransition(SimulationData& data, int origColor)
-{
-    int numAllowedColors = 0;
-    for (int i = 0; i < MAX_COLORS; ++i) {
-        if (cudaSimulationParameters.cellFunctionConstructorMutationColorTransitions[origColor][i]) {
-            ++numAllowedColors;
-        }
-    }
-    if (numAllowedColors == 0) {
-        return -1;
-    }
-    int randomAllowedColorIndex = data.numberGen1.random(numAllowedColors - 1);
-    int allowedColorIndex = 0;
-    int result = 0;
-    for (int i = 0; i < MAX_COLORS; ++i) {
-        if (cudaSimulationParameters.cellFunctionConstructorMutationColorTransitions[origColor][i]) {
-            if (allowedColorIndex == randomAllowedColorIndex) {
-                result = i;
-                break;
-            }
-            ++allowedColorIndex;
-        }
-    }
-    return result;
-}
-
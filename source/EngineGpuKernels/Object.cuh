@@ -1,7 +1,5 @@
 #pragma once
 
-#include <nppdefs.h>
-
 #include "EngineInterface/EngineConstants.h"
 #include "EngineInterface/CellFunctionConstants.h"
 
@@ -38,21 +36,6 @@ struct Particle
     }
 };
 
-struct GenomeHeader
-{
-    ConstructionShape shape;
-    int numBranches;
-    bool separateConstruction;
-    ConstructorAngleAlignment angleAlignment;
-    float stiffness;
-    float connectionDistance;
-    int numRepetitions;
-    float concatenationAngle1;
-    float concatenationAngle2;
-
-    __inline__ __device__ bool hasInfiniteRepetitions() const { return numRepetitions == NPP_MAX_32S; }
-};
-
 struct CellMetadataDescription
 {
     uint16_t nameSize;
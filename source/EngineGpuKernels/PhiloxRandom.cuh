@@ -0,0 +1,153 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "HostDevice.cuh"
+
+//independent random streams for the same seed, time step and object
+using RandomPurpose = uint32_t;
+enum RandomPurpose_ : RandomPurpose
+{
+    RandomPurpose_NumberGenerator1,
+    RandomPurpose_NumberGenerator2,
+    RandomPurpose_Mutation,
+    RandomPurpose_CellFunction,
+    RandomPurpose_Count
+};
+
+/**
+ * Counter-based random number generator (Philox4x32-10, Salmon et al., "Parallel random numbers: as easy as 1, 2, 3").
+ *
+ * A generator is a pure function of (seed, time step, object id, purpose) and the number of previous draws. A thread creates a
+ * generator for the object it processes and obtains the same numbers independent of the execution order of the other threads.
+ * Mutations and cell functions draw from such per-cell streams. The remaining device code draws from the pools of
+ * CudaNumberGenerator, which are filled by a generator with object id 0 and accessed via an atomic index; there the scheduling
+ * still decides which thread obtains which number, hence GPU time steps are not bit-reproducible.
+ */
+class PhiloxRandom
+{
+public:
+    __inline__ __host__ __device__ PhiloxRandom(uint64_t seed, uint64_t timestep, uint64_t objectId, RandomPurpose purpose);
+
+    __inline__ __host__ __device__ uint32_t randomUInt32();
+    __inline__ __host__ __device__ float random();  //[0, 1)
+    __inline__ __host__ __device__ float random(float maxVal);  //[0, maxVal)
+    __inline__ __host__ __device__ float random(float minVal, float maxVal);  //[minVal, maxVal)
+    __inline__ __host__ __device__ int random(int maxVal);  //[0, maxVal] like CudaNumberGenerator::random(int)
+    __inline__ __host__ __device__ bool randomBool();
+    __inline__ __host__ __device__ uint8_t randomByte();
+    __inline__ __host__ __device__ void randomBytes(uint8_t* data, int size);
+
+    //one application of the Philox4x32-10 bijection
+    __inline__ __host__ __device__ static void generateBlock(uint32_t const key[2], uint32_t const counter[4], uint32_t result[4]);
+
+private:
+    __inline__ __host__ __device__ static uint64_t mix(uint64_t value);
+
+    uint32_t _key[2];
+    uint32_t _counter[4];
+    uint32_t _block[4];
+    int _blockIndex = 4;
+};
+
+/************************************************************************/
+/* Implementation                                                       */
+/************************************************************************/
+
+__inline__ __host__ __device__ PhiloxRandom::PhiloxRandom(uint64_t seed, uint64_t timestep, uint64_t objectId, RandomPurpose purpose)
+{
+    auto key = mix(mix(seed) ^ timestep);
+    _key[0] = static_cast<uint32_t>(key);
+    _key[1] = static_cast<uint32_t>(key >> 32);
+
+    //_counter[0] counts the generated blocks, distinct objects and purposes never share a counter value
+    _counter[0] = 0;
+    _counter[1] = purpose;
+    _counter[2] = static_cast<uint32_t>(objectId);
+    _counter[3] = static_cast<uint32_t>(objectId >> 32);
+}
+
+__inline__ __host__ __device__ uint32_t PhiloxRandom::randomUInt32()
+{
+    if (_blockIndex == 4) {
+        generateBlock(_key, _counter, _block);
+        ++_counter[0];
+        _blockIndex = 0;
+    }
+    return _block[_blockIndex++];
+}
+
+__inline__ __host__ __device__ float PhiloxRandom::random()
+{
+    //24 bits fit into the mantissa
+    return static_cast<float>(randomUInt32() >> 8) * (1.0f / 16777216.0f);
+}
+
+__inline__ __host__ __device__ float PhiloxRandom::random(float maxVal)
+{
+    return random() * maxVal;
+}
+
+__inline__ __host__ __device__ float PhiloxRandom::random(float minVal, float maxVal)
+{
+    return minVal + random() * (maxVal - minVal);
+}
+
+__inline__ __host__ __device__ int PhiloxRandom::random(int maxVal)
+{
+    return static_cast<int>((static_cast<uint64_t>(randomUInt32()) * (static_cast<uint64_t>(maxVal) + 1)) >> 32);
+}
+
+__inline__ __host__ __device__ bool PhiloxRandom::randomBool()
+{
+    return (randomUInt32() >> 31) != 0;
+}
+
+__inline__ __host__ __device__ uint8_t PhiloxRandom::randomByte()
+{
+    return static_cast<uint8_t>(randomUInt32() >> 24);
+}
+
+__inline__ __host__ __device__ void PhiloxRandom::randomBytes(uint8_t* data, int size)
+{
+    for (int i = 0; i < size; ++i) {
+        data[i] = randomByte();
+    }
+}
+
+__inline__ __host__ __device__ void PhiloxRandom::generateBlock(uint32_t const key[2], uint32_t const counter[4], uint32_t result[4])
+{
+    uint32_t k0 = key[0];
+    uint32_t k1 = key[1];
+    uint32_t c0 = counter[0];
+    uint32_t c1 = counter[1];
+    uint32_t c2 = counter[2];
+    uint32_t c3 = counter[3];
+    for (int round = 0; round < 10; ++round) {
+        auto product0 = static_cast<uint64_t>(0xD2511F53u) * c0;
+        auto product1 = static_cast<uint64_t>(0xCD9E8D57u) * c2;
+        auto hi0 = static_cast<uint32_t>(product0 >> 32);
+        auto lo0 = static_cast<uint32_t>(product0);
+        auto hi1 = static_cast<uint32_t>(product1 >> 32);
+        auto lo1 = static_cast<uint32_t>(product1);
+        c0 = hi1 ^ c1 ^ k0;
+        c1 = lo1;
+        c2 = hi0 ^ c3 ^ k1;
+        c3 = lo0;
+        k0 += 0x9E3779B9u;
+        k1 += 0xBB67AE85u;
+    }
+    result[0] = c0;
+    result[1] = c1;
+    result[2] = c2;
+    result[3] = c3;
+}
+
+__inline__ __host__ __device__ uint64_t PhiloxRandom::mix(uint64_t value)
+{
+    //finalizer of splitmix64
+    value += 0x9E3779B97F4A7C15ull;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+    return value ^ (value >> 31);
+}
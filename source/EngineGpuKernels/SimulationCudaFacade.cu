@@ -40,6 +40,7 @@
 #include "RenderingData.cuh"
 #include "TestKernelsLauncher.cuh"
 #include "StatisticsService.cuh"
+#include "SimulationProfiler.cuh"
 
 namespace
 {
@@ -64,7 +65,7 @@ _SimulationCudaFacade::_SimulationCudaFacade(uint64_t timestep, Settings const&
     _cudaSimulationStatistics = std::make_shared<SimulationStatistics>();
     _statisticsService = std::make_shared<_StatisticsService>();
 
-    _cudaSimulationData->init({settings.generalSettings.worldSizeX, settings.generalSettings.worldSizeY}, timestep);
+    _cudaSimulationData->init({settings.generalSettings.worldSizeX, settings.generalSettings.worldSizeY}, timestep, settings.generalSettings.seed);
     _cudaRenderingData->init();
     _cudaSimulationStatistics->init();
     _cudaSelectionResult->init();
@@ -109,6 +110,11 @@ _SimulationCudaFacade::~_SimulationCudaFacade()
     log(Priority::Important, "simulation closed");
 }
 
+std::string _SimulationCudaFacade::getDeviceName() const
+{
+    return _gpuInfo.gpuModelName;
+}
+
 void* _SimulationCudaFacade::registerImageResource(GLuint image)
 {
     //unregister old resource
@@ -446,6 +452,33 @@ void _SimulationCudaFacade::setStatisticsHistory(StatisticsHistoryData const& da
     _statisticsService->rewriteHistory(_statisticsHistory, data, getCurrentTimestep());
 }
 
+bool _SimulationCudaFacade::isProfilingEnabled() const
+{
+    std::lock_guard lock(_mutexForProfiling);
+    return _isProfilingEnabled;
+}
+
+void _SimulationCudaFacade::setProfilingEnabled(bool value)
+{
+    std::lock_guard lock(_mutexForProfiling);
+    if (value == _isProfilingEnabled) {
+        return;
+    }
+    _isProfilingEnabled = value;
+    if (value) {
+        _profilingHistory = std::make_shared<ProfilingHistory>(_SimulationProfiler::getPhaseNames());
+        _simulationKernels->setProfiler(std::make_shared<_SimulationProfiler>(_profilingHistory));
+    } else {
+        _simulationKernels->setProfiler(nullptr);
+    }
+}
+
+ProfilingData _SimulationCudaFacade::getProfilingData() const
+{
+    std::lock_guard lock(_mutexForProfiling);
+    return _profilingHistory ? _profilingHistory->getData() : ProfilingData();
+}
+
 void _SimulationCudaFacade::resetTimeIntervalStatistics()
 {
     _cudaSimulationStatistics->resetAccumulatedStatistics();
@@ -18,12 +18,14 @@
 #include "EngineInterface/ShallowUpdateSelectionData.h"
 #include "EngineInterface/MutationType.h"
 #include "EngineInterface/StatisticsHistory.h"
+#include "EngineInterface/ProfilingHistory.h"
 
 #include "Definitions.cuh"
+#include "SimulationFacade.h"
 
 struct cudaGraphicsResource;
 
-class _SimulationCudaFacade
+class _SimulationCudaFacade : public _SimulationFacade
 {
 public:
     struct GpuInfo
@@ -36,59 +38,64 @@ public:
     _SimulationCudaFacade(uint64_t timestep, Settings const& settings);
     ~_SimulationCudaFacade();
 
-    void* registerImageResource(GLuint image);
-
-    void calcTimestep(uint64_t timesteps, bool forceUpdateStatistics);
-    void applyCataclysm(int power);
-
-    void drawVectorGraphics(float2 const& rectUpperLeft, float2 const& rectLowerRight, void* cudaResource, int2 const& imageSize, double zoom);
-    void getSimulationData(int2 const& rectUpperLeft, int2 const& rectLowerRight, DataTO const& dataTO);
-    void getSelectedSimulationData(bool includeClusters, DataTO const& dataTO);
-    void getInspectedSimulationData(std::vector<uint64_t> entityIds, DataTO const& dataTO);
-    void getOverlayData(int2 const& rectUpperLeft, int2 const& rectLowerRight, DataTO const& dataTO);
-    void addAndSelectSimulationData(DataTO const& dataTO);
-    void setSimulationData(DataTO const& dataTO);
-    void removeSelectedObjects(bool includeClusters);
-    void relaxSelectedObjects(bool includeClusters);
-    void uniformVelocitiesForSelectedObjects(bool includeClusters);
-    void makeSticky(bool includeClusters);
-    void removeStickiness(bool includeClusters);
-    void setBarrier(bool value, bool includeClusters);
-    void changeInspectedSimulationData(DataTO const& changeDataTO);
-
-    void applyForce(ApplyForceData const& applyData);
-    void switchSelection(PointSelectionData const& switchData);
-    void swapSelection(PointSelectionData const& selectionData);
-    void setSelection(AreaSelectionData const& selectionData);
-    SelectionShallowData getSelectionShallowData(float2 const& refPos);
-    void shallowUpdateSelectedObjects(ShallowUpdateSelectionData const& shallowUpdateData);
-    void removeSelection();
-    void updateSelection();
-    void colorSelectedObjects(unsigned char color, bool includeClusters);
-    void reconnectSelectedObjects();
-    void setDetached(bool value);
-
-    void setGpuConstants(GpuSettings const& cudaConstants);
-    SimulationParameters getSimulationParameters() const;
-    void setSimulationParameters(SimulationParameters const& parameters);
-
-    ArraySizes getArraySizes() const;
-
-    RawStatisticsData getRawStatistics();
-    void updateStatistics();
-    StatisticsHistory const& getStatisticsHistory() const;
-    void setStatisticsHistory(StatisticsHistoryData const& data);
-
-    void resetTimeIntervalStatistics();
-    uint64_t getCurrentTimestep() const;
-    void setCurrentTimestep(uint64_t timestep);
-
-    void clear();
-
-    void resizeArraysIfNecessary(ArraySizes const& additionals = ArraySizes());
+    std::string getDeviceName() const override;
+    void* registerImageResource(GLuint image) override;
+
+    void calcTimestep(uint64_t timesteps, bool forceUpdateStatistics) override;
+    void applyCataclysm(int power) override;
+
+    void drawVectorGraphics(float2 const& rectUpperLeft, float2 const& rectLowerRight, void* cudaResource, int2 const& imageSize, double zoom) override;
+    void getSimulationData(int2 const& rectUpperLeft, int2 const& rectLowerRight, DataTO const& dataTO) override;
+    void getSelectedSimulationData(bool includeClusters, DataTO const& dataTO) override;
+    void getInspectedSimulationData(std::vector<uint64_t> entityIds, DataTO const& dataTO) override;
+    void getOverlayData(int2 const& rectUpperLeft, int2 const& rectLowerRight, DataTO const& dataTO) override;
+    void addAndSelectSimulationData(DataTO const& dataTO) override;
+    void setSimulationData(DataTO const& dataTO) override;
+    void removeSelectedObjects(bool includeClusters) override;
+    void relaxSelectedObjects(bool includeClusters) override;
+    void uniformVelocitiesForSelectedObjects(bool includeClusters) override;
+    void makeSticky(bool includeClusters) override;
+    void removeStickiness(bool includeClusters) override;
+    void setBarrier(bool value, bool includeClusters) override;
+    void changeInspectedSimulationData(DataTO const& changeDataTO) override;
+
+    void applyForce(ApplyForceData const& applyData) override;
+    void switchSelection(PointSelectionData const& switchData) override;
+    void swapSelection(PointSelectionData const& selectionData) override;
+    void setSelection(AreaSelectionData const& selectionData) override;
+    SelectionShallowData getSelectionShallowData(float2 const& refPos) override;
+    void shallowUpdateSelectedObjects(ShallowUpdateSelectionData const& shallowUpdateData) override;
+    void removeSelection() override;
+    void updateSelection() override;
+    void colorSelectedObjects(unsigned char color, bool includeClusters) override;
+    void reconnectSelectedObjects() override;
+    void setDetached(bool value) override;
+
+    void setGpuConstants(GpuSettings const& cudaConstants) override;
+    SimulationParameters getSimulationParameters() const override;
+    void setSimulationParameters(SimulationParameters const& parameters) override;
+
+    ArraySizes getArraySizes() const override;
+
+    RawStatisticsData getRawStatistics() override;
+    void updateStatistics() override;
+    StatisticsHistory const& getStatisticsHistory() const override;
+    void setStatisticsHistory(StatisticsHistoryData const& data) override;
+
+    bool isProfilingEnabled() const override;
+    void setProfilingEnabled(bool value) override;
+    ProfilingData getProfilingData() const override;
+
+    void resetTimeIntervalStatistics() override;
+    uint64_t getCurrentTimestep() const override;
+    void setCurrentTimestep(uint64_t timestep) override;
+
+    void clear() override;
+
+    void resizeArraysIfNecessary(ArraySizes const& additionals = ArraySizes()) override;
 
     //for tests
-    void testOnly_mutate(uint64_t cellId, MutationType mutationType);
+    void testOnly_mutate(uint64_t cellId, MutationType mutationType) override;
 
 private:
     void initCuda();
@@ -121,6 +128,10 @@ private:
     std::optional<RawStatisticsData> _statisticsData;
     StatisticsService _statisticsService;
     StatisticsHistory _statisticsHistory;
+
+    mutable std::mutex _mutexForProfiling;
+    bool _isProfilingEnabled = false;
+    std::shared_ptr<ProfilingHistory> _profilingHistory;
     std::shared_ptr<SimulationStatistics> _cudaSimulationStatistics;
 
     SimulationKernelsLauncher _simulationKernels;
@@ -3,10 +3,11 @@
 #include "ConstantMemory.cuh"
 #include "GarbageCollectorKernels.cuh"
 
-void SimulationData::init(int2 const& worldSize_, uint64_t timestep_)
+void SimulationData::init(int2 const& worldSize_, uint64_t timestep_, uint64_t seed_)
 {
     worldSize = worldSize_;
     timestep = timestep_;
+    seed = seed_;
 
     objects.init();
     tempObjects.init();
@@ -18,8 +19,8 @@ void SimulationData::init(int2 const& worldSize_, uint64_t timestep_)
     CHECK_FOR_CUDA_ERROR(cudaMemset(externalEnergy, 0, sizeof(double)));
  
     processMemory.init();
-    numberGen1.init(40312357);   //some array size for random numbers (~ 40 MB)
-    numberGen2.init(1536941);  //some array size for random numbers (~ 1.5 MB)
+    numberGen1.init(40312357, seed, timestep, RandomPurpose_NumberGenerator1);   //some array size for random numbers (~ 40 MB)
+    numberGen2.init(1536941, seed, timestep, RandomPurpose_NumberGenerator2);  //some array size for random numbers (~ 1.5 MB)
 
     structuralOperations.init();
     for (int i = 0; i < CellFunction_WithoutNone_Count; ++i) {
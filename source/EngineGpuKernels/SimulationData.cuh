@@ -18,6 +18,7 @@ struct SimulationData
 {
     //maps
     uint64_t timestep;
+    uint64_t seed;  //together with timestep the key of the per-object random streams (see PhiloxRandom)
     int2 worldSize;
     CellMap cellMap;
     ParticleMap particleMap;
@@ -39,7 +40,7 @@ struct SimulationData
     CudaNumberGenerator numberGen1;
     CudaNumberGenerator numberGen2;  //second random number generator used in combination with the first generator for evaluating very low probabilities
 
-    void init(int2 const& worldSize, uint64_t timestep);
+    void init(int2 const& worldSize, uint64_t timestep, uint64_t seed);
     bool shouldResize(ArraySizes const& additionals);
     void resizeTargetObjects(ArraySizes const& additionals);
     void resizeObjects();
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#include <windows.h>
+#endif
+
+#include <vector_types.h>
+#include <GL/gl.h>
+
+#include "EngineInterface/RawStatisticsData.h"
+#include "EngineInterface/Settings.h"
+#include "EngineInterface/SelectionShallowData.h"
+#include "EngineInterface/ShallowUpdateSelectionData.h"
+#include "EngineInterface/MutationType.h"
+#include "EngineInterface/StatisticsHistory.h"
+#include "EngineInterface/ProfilingHistory.h"
+
+#include "Definitions.cuh"
+
+/**
+ * Interface of a simulation backend. Data is exchanged via DataTO in the memory layout of TOs.cuh.
+ * Implementations: _SimulationCudaFacade (GPU) and _SimulationCpuFacade (host, see EngineImpl).
+ */
+class _SimulationFacade
+{
+public:
+    virtual ~_SimulationFacade() = default;
+
+    virtual std::string getDeviceName() const = 0;
+    virtual void* registerImageResource(GLuint image) = 0;
+
+    virtual void calcTimestep(uint64_t timesteps, bool forceUpdateStatistics) = 0;
+    virtual void applyCataclysm(int power) = 0;
+
+    virtual void drawVectorGraphics(float2 const& rectUpperLeft, float2 const& rectLowerRight, void* cudaResource, int2 const& imageSize, double zoom) = 0;
+    virtual void getSimulationData(int2 const& rectUpperLeft, int2 const& rectLowerRight, DataTO const& dataTO) = 0;
+    virtual void getSelectedSimulationData(bool includeClusters, DataTO const& dataTO) = 0;
+    virtual void getInspectedSimulationData(std::vector<uint64_t> entityIds, DataTO const& dataTO) = 0;
+    virtual void getOverlayData(int2 const& rectUpperLeft, int2 const& rectLowerRight, DataTO const& dataTO) = 0;
+    virtual void addAndSelectSimulationData(DataTO const& dataTO) = 0;
+    virtual void setSimulationData(DataTO const& dataTO) = 0;
+    virtual void removeSelectedObjects(bool includeClusters) = 0;
+    virtual void relaxSelectedObjects(bool includeClusters) = 0;
+    virtual void uniformVelocitiesForSelectedObjects(bool includeClusters) = 0;
+    virtual void makeSticky(bool includeClusters) = 0;
+    virtual void removeStickiness(bool includeClusters) = 0;
+    virtual void setBarrier(bool value, bool includeClusters) = 0;
+    virtual void changeInspectedSimulationData(DataTO const& changeDataTO) = 0;
+
+    virtual void applyForce(ApplyForceData const& applyData) = 0;
+    virtual void switchSelection(PointSelectionData const& switchData) = 0;
+    virtual void swapSelection(PointSelectionData const& selectionData) = 0;
+    virtual void setSelection(AreaSelectionData const& selectionData) = 0;
+    virtual SelectionShallowData getSelectionShallowData(float2 const& refPos) = 0;
+    virtual void shallowUpdateSelectedObjects(ShallowUpdateSelectionData const& shallowUpdateData) = 0;
+    virtual void removeSelection() = 0;
+    virtual void updateSelection() = 0;
+    virtual void colorSelectedObjects(unsigned char color, bool includeClusters) = 0;
+    virtual void reconnectSelectedObjects() = 0;
+    virtual void setDetached(bool value) = 0;
+
+    virtual void setGpuConstants(GpuSettings const& cudaConstants) = 0;
+    virtual SimulationParameters getSimulationParameters() const = 0;
+    virtual void setSimulationParameters(SimulationParameters const& parameters) = 0;
+
+    virtual ArraySizes getArraySizes() const = 0;
+
+    virtual RawStatisticsData getRawStatistics() = 0;
+    virtual void updateStatistics() = 0;
+    virtual StatisticsHistory const& getStatisticsHistory() const = 0;
+    virtual void setStatisticsHistory(StatisticsHistoryData const& data) = 0;
+
+    //enabling clears the profiling data, which remains available after disabling
+    virtual bool isProfilingEnabled() const = 0;
+    virtual void setProfilingEnabled(bool value) = 0;
+    virtual ProfilingData getProfilingData() const = 0;
+
+    virtual void resetTimeIntervalStatistics() = 0;
+    virtual uint64_t getCurrentTimestep() const = 0;
+    virtual void setCurrentTimestep(uint64_t timestep) = 0;
+
+    virtual void clear() = 0;
+
+    virtual void resizeArraysIfNecessary(ArraySizes const& additionals = ArraySizes()) = 0;
+
+    //for tests
+    virtual void testOnly_mutate(uint64_t cellId, MutationType mutationType) = 0;
+};
@@ -27,7 +27,11 @@ namespace
 void _SimulationKernelsLauncher::calcTimestep(Settings const& settings, SimulationData const& data, SimulationStatistics const& statistics)
 {
     auto const gpuSettings = settings.gpuSettings;
+    if (_profiler) {
+        _profiler->beginTimestep(data);
+    }
     KERNEL_CALL_1_1(cudaNextTimestep_prepare, data, statistics);
+    endPhase(GpuPhase_Preparation);
 
     //not all kernels need to be executed in each time step for performance reasons
     bool considerForcesFromAngleDifferences = (data.timestep % 3 == 0);
@@ -36,42 +40,58 @@ void _SimulationKernelsLauncher::calcTimestep(Settings const& settings, Simulati
 
     KERNEL_CALL(cudaNextTimestep_physics_init, data);
     KERNEL_CALL_MOD(cudaNextTimestep_physics_fillMaps, 64, data);
+    endPhase(GpuPhase_PhysicsMaps);
     if (settings.simulationParameters.motionType == MotionType_Fluid) {
         auto threadBlockSize = calcOptimalThreadsForFluidKernel(settings.simulationParameters);
         KERNEL_CALL_MOD(cudaNextTimestep_physics_calcFluidForces, threadBlockSize, data);
     } else {
         KERNEL_CALL(cudaNextTimestep_physics_calcCollisionForces, data);
     }
+    endPhase(GpuPhase_CollisionForces);
     if (settings.simulationParameters.numSpots > 0) {
         KERNEL_CALL(cudaApplyFlowFieldSettings, data);
+        endPhase(GpuPhase_FlowField);
     }
     KERNEL_CALL_MOD(cudaNextTimestep_physics_applyForces, 16, data);
     KERNEL_CALL_MOD(cudaNextTimestep_physics_calcConnectionForces, 16, data, considerForcesFromAngleDifferences);
     KERNEL_CALL_MOD(cudaNextTimestep_physics_verletPositionUpdate, 16, data);
     KERNEL_CALL_MOD(cudaNextTimestep_physics_calcConnectionForces, 16, data, considerForcesFromAngleDifferences);
     KERNEL_CALL_MOD(cudaNextTimestep_physics_verletVelocityUpdate, 16, data);
+    endPhase(GpuPhase_ConnectionForces);
 
     //cell functions
     KERNEL_CALL(cudaNextTimestep_cellFunction_prepare_substep1, data);
     KERNEL_CALL(cudaNextTimestep_cellFunction_prepare_substep2, data);
+    endPhase(GpuPhase_CellFunctionPreparation);
     KERNEL_CALL(cudaNextTimestep_cellFunction_nerve, data, statistics);
+    endPhase(GpuPhase_Nerve);
     KERNEL_CALL(cudaNextTimestep_cellFunction_neuron, data, statistics);
+    endPhase(GpuPhase_Neuron);
     if (settings.simulationParameters.cellFunctionConstructorCheckCompletenessForSelfReplication) {
         KERNEL_CALL(cudaNextTimestep_cellFunction_constructor_completenessCheck, data, statistics);
     }
     KERNEL_CALL_MOD(cudaNextTimestep_cellFunction_constructor_process, 4, data, statistics);
+    endPhase(GpuPhase_Constructor);
     KERNEL_CALL(cudaNextTimestep_cellFunction_injector, data, statistics);
+    endPhase(GpuPhase_Injector);
     KERNEL_CALL_MOD(cudaNextTimestep_cellFunction_attacker, 4, data, statistics);
+    endPhase(GpuPhase_Attacker);
     KERNEL_CALL_MOD(cudaNextTimestep_cellFunction_transmitter, 4, data, statistics);
+    endPhase(GpuPhase_Transmitter);
     KERNEL_CALL(cudaNextTimestep_cellFunction_muscle, data, statistics);
+    endPhase(GpuPhase_Muscle);
     KERNEL_CALL_MOD(cudaNextTimestep_cellFunction_sensor, 64, data, statistics);
+    endPhase(GpuPhase_Sensor);
     KERNEL_CALL(cudaNextTimestep_cellFunction_reconnector, data, statistics);
+    endPhase(GpuPhase_Reconnector);
     KERNEL_CALL(cudaNextTimestep_cellFunction_detonator, data, statistics);
+    endPhase(GpuPhase_Detonator);
 
     if (considerInnerFriction) {
         KERNEL_CALL_MOD(cudaNextTimestep_physics_applyInnerFriction, 16, data);
     }
     KERNEL_CALL_MOD(cudaNextTimestep_physics_applyFriction, 16, data);
+    endPhase(GpuPhase_Friction);
 
     if (considerRigidityUpdate && isRigidityUpdateEnabled(settings)) {
         KERNEL_CALL(cudaInitClusterData, data);
@@ -82,14 +102,19 @@ void _SimulationKernelsLauncher::calcTimestep(Settings const& settings, Simulati
         KERNEL_CALL(cudaAccumulateClusterPosAndVel, data);
         KERNEL_CALL(cudaAccumulateClusterAngularProp, data);
         KERNEL_CALL(cudaApplyClusterData, data);
+        endPhase(GpuPhase_Rigidity);
     }
     KERNEL_CALL_1_1(cudaNextTimestep_structuralOperations_substep1, data);
     KERNEL_CALL(cudaNextTimestep_structuralOperations_substep2, data);
     KERNEL_CALL(cudaNextTimestep_structuralOperations_substep3, data);
     KERNEL_CALL(cudaNextTimestep_structuralOperations_substep4, data);
     KERNEL_CALL(cudaNextTimestep_structuralOperations_substep5, data);
+    endPhase(GpuPhase_StructuralOperations);
 
     _garbageCollector->cleanupAfterTimestep(settings.gpuSettings, data);
+    if (_profiler) {
+        _profiler->endTimestep();
+    }
 }
 
 bool _SimulationKernelsLauncher::updateSimulationParametersAfterTimestep(
@@ -158,6 +183,12 @@ void _SimulationKernelsLauncher::prepareForSimulationParametersChanges(Settings
     KERNEL_CALL(cudaResetDensity, data);
 }
 
+void _SimulationKernelsLauncher::setProfiler(SimulationProfiler const& profiler)
+{
+    _profiler = profiler;
+    _garbageCollector->setProfiler(profiler);
+}
+
 bool _SimulationKernelsLauncher::isRigidityUpdateEnabled(Settings const& settings) const
 {
     for (int i = 0; i < settings.simulationParameters.numSpots; ++i) {
@@ -167,3 +198,10 @@ bool _SimulationKernelsLauncher::isRigidityUpdateEnabled(Settings const& setting
     }
     return settings.simulationParameters.baseValues.rigidity != 0;
 }
+
+void _SimulationKernelsLauncher::endPhase(GpuPhase phase)
+{
+    if (_profiler) {
+        _profiler->endPhase(phase);
+    }
+}
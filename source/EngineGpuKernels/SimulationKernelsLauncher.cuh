@@ -5,6 +5,7 @@
 
 #include "Definitions.cuh"
 #include "Macros.cuh"
+#include "SimulationProfiler.cuh"
 
 class _SimulationKernelsLauncher
 {
@@ -18,10 +19,14 @@ public:
         RawStatisticsData const& statistics);  //returns true if parameters have been changed
     void prepareForSimulationParametersChanges(Settings const& settings, SimulationData const& simulationData);
 
+    void setProfiler(SimulationProfiler const& profiler);  //nullptr = profiling disabled
+
 private:
     bool isRigidityUpdateEnabled(Settings const& settings) const;
+    void endPhase(GpuPhase phase);
 
     GarbageCollectorKernelsLauncher _garbageCollector;
     MaxAgeBalancer _maxAgeBalancer;
+    SimulationProfiler _profiler;
 };
 
@@ -0,0 +1,91 @@
+#include "SimulationProfiler.cuh"
+
+#include "Base.cuh"
+#include "Macros.cuh"
+#include "SimulationData.cuh"
+
+std::vector<std::string> _SimulationProfiler::getPhaseNames()
+{
+    std::vector<std::string> result(GpuPhase_Count);
+    result[GpuPhase_Preparation] = "preparation";
+    result[GpuPhase_PhysicsMaps] = "physics maps";
+    result[GpuPhase_CollisionForces] = "collision forces";
+    result[GpuPhase_FlowField] = "flow field";
+    result[GpuPhase_ConnectionForces] = "connection forces";
+    result[GpuPhase_CellFunctionPreparation] = "cell function preparation";
+    result[GpuPhase_Nerve] = "nerve";
+    result[GpuPhase_Neuron] = "neuron";
+    result[GpuPhase_Constructor] = "constructor";
+    result[GpuPhase_Injector] = "injector";
+    result[GpuPhase_Attacker] = "attacker";
+    result[GpuPhase_Transmitter] = "transmitter";
+    result[GpuPhase_Muscle] = "muscle";
+    result[GpuPhase_Sensor] = "sensor";
+    result[GpuPhase_Reconnector] = "reconnector";
+    result[GpuPhase_Detonator] = "detonator";
+    result[GpuPhase_Friction] = "friction";
+    result[GpuPhase_Rigidity] = "rigidity";
+    result[GpuPhase_StructuralOperations] = "structural operations";
+    result[GpuPhase_CleanupMaps] = "garbage collection: maps";
+    result[GpuPhase_CleanupPointerArrays] = "garbage collection: pointer arrays";
+    result[GpuPhase_CleanupArrays] = "garbage collection: arrays";
+    return result;
+}
+
+_SimulationProfiler::_SimulationProfiler(std::shared_ptr<ProfilingHistory> const& history)
+    : _history(history)
+    , _startTimepoint(std::chrono::steady_clock::now())
+    , _events(GpuPhase_Count + 1)
+{
+    for (auto& event : _events) {
+        CHECK_FOR_CUDA_ERROR(cudaEventCreate(&event));
+    }
+    _executedPhases.reserve(GpuPhase_Count);
+    _entries.reserve(GpuPhase_Count);
+}
+
+_SimulationProfiler::~_SimulationProfiler()
+{
+    for (auto const& event : _events) {
+        cudaEventDestroy(event);
+    }
+}
+
+void _SimulationProfiler::beginTimestep(SimulationData const& data)
+{
+    _executedPhases.clear();
+    _timestepEntry.timestep = data.timestep;
+    _timestepEntry.startTime = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - _startTimepoint).count();
+    _timestepEntry.numCells = data.objects.cellPointers.getNumEntries_host();
+    _timestepEntry.numParticles = data.objects.particlePointers.getNumEntries_host();
+    CHECK_FOR_CUDA_ERROR(cudaEventRecord(_events.front()));
+}
+
+void _SimulationProfiler::endPhase(GpuPhase phase)
+{
+    if (_executedPhases.size() + 1 >= _events.size()) {
+        return;
+    }
+    _executedPhases.emplace_back(phase);
+    CHECK_FOR_CUDA_ERROR(cudaEventRecord(_events.at(_executedPhases.size())));
+}
+
+void _SimulationProfiler::endTimestep()
+{
+    CHECK_FOR_CUDA_ERROR(cudaEventSynchronize(_events.at(_executedPhases.size())));
+
+    _entries.clear();
+    for (size_t i = 0; i < _executedPhases.size(); ++i) {
+        float startMilliseconds = 0;
+        float endMilliseconds = 0;
+        CHECK_FOR_CUDA_ERROR(cudaEventElapsedTime(&startMilliseconds, _events.front(), _events.at(i)));
+        CHECK_FOR_CUDA_ERROR(cudaEventElapsedTime(&endMilliseconds, _events.front(), _events.at(i + 1)));
+
+        auto entry = _timestepEntry;
+        entry.phase = _executedPhases.at(i);
+        entry.startTime += toDouble(startMilliseconds) * 1000;
+        entry.duration = toDouble(endMilliseconds - startMilliseconds) * 1000;
+        _entries.emplace_back(entry);
+    }
+    _history->add(_entries);
+}
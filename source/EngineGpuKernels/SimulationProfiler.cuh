@@ -0,0 +1,69 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include <cuda_runtime.h>
+
+#include "EngineInterface/ProfilingHistory.h"
+
+#include "Definitions.cuh"
+
+using GpuPhase = int;
+enum GpuPhase_
+{
+    GpuPhase_Preparation,
+    GpuPhase_PhysicsMaps,
+    GpuPhase_CollisionForces,
+    GpuPhase_FlowField,
+    GpuPhase_ConnectionForces,
+    GpuPhase_CellFunctionPreparation,
+    GpuPhase_Nerve,
+    GpuPhase_Neuron,
+    GpuPhase_Constructor,
+    GpuPhase_Injector,
+    GpuPhase_Attacker,
+    GpuPhase_Transmitter,
+    GpuPhase_Muscle,
+    GpuPhase_Sensor,
+    GpuPhase_Reconnector,
+    GpuPhase_Detonator,
+    GpuPhase_Friction,
+    GpuPhase_Rigidity,
+    GpuPhase_StructuralOperations,
+    GpuPhase_CleanupMaps,
+    GpuPhase_CleanupPointerArrays,
+    GpuPhase_CleanupArrays,
+    GpuPhase_Count
+};
+
+/**
+ * Measures the phases of a time step with CUDA events and writes the durations to a ProfilingHistory.
+ * A phase lasts from the end of the previously executed phase to the call of endPhase. Launchers hold a null profiler if
+ * profiling is disabled, so that the kernel launches are not affected.
+ *
+ * endTimestep waits for the device, hence the start times of the time steps are taken on the host.
+ */
+class _SimulationProfiler
+{
+public:
+    static std::vector<std::string> getPhaseNames();
+
+    _SimulationProfiler(std::shared_ptr<ProfilingHistory> const& history);
+    ~_SimulationProfiler();
+
+    void beginTimestep(SimulationData const& data);
+    void endPhase(GpuPhase phase);
+    void endTimestep();
+
+private:
+    std::shared_ptr<ProfilingHistory> _history;
+    std::chrono::steady_clock::time_point _startTimepoint;
+
+    //events[0] marks the beginning of the time step, events[i] the end of the i-th executed phase
+    std::vector<cudaEvent_t> _events;
+    std::vector<GpuPhase> _executedPhases;
+    std::vector<ProfilingEntry> _entries;
+    ProfilingEntry _timestepEntry;
+};
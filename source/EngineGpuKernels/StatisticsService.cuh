@@ -11,9 +11,7 @@ public:
     void rewriteHistory(StatisticsHistory& history, StatisticsHistoryData const& newHistoryData, uint64_t timestep);
 
 private:
-    static auto constexpr DefaultTimeStepDelta = 10.0;
-
-    double _longtermTimestepDelta = DefaultTimeStepDelta;
+    static auto constexpr TimestepDelta = 10.0;  //between entries of the finest tier of the history
 
     int _numDataPoints = 0;
     std::optional<DataPointCollection> _accumulatedDataPoint;
@@ -12,40 +12,40 @@ __global__ void cudaTestMutate(SimulationData data, uint64_t cellId, MutationTyp
         if (cell->id == cellId) {
             switch (mutationType) {
             case MutationType::Properties:
-                MutationProcessor::propertiesMutation(data, cell);
+                MutationProcessor::propertiesMutation(data, cell, data.numberGen1);
                 break;
             case MutationType::NeuronData:
-                MutationProcessor::neuronDataMutation(data, cell);
+                MutationProcessor::neuronDataMutation(data, cell, data.numberGen1);
                 break;
             case MutationType::Geometry:
-                MutationProcessor::geometryMutation(data, cell);
+                MutationProcessor::geometryMutation(data, cell, data.numberGen1);
                 break;
             case MutationType::CustomGeometry:
-                MutationProcessor::customGeometryMutation(data, cell);
+                MutationProcessor::customGeometryMutation(data, cell, data.numberGen1);
                 break;
             case MutationType::CellFunction:
-                MutationProcessor::cellFunctionMutation(data, cell);
+                MutationProcessor::cellFunctionMutation(data, cell, data.numberGen1);
                 break;
             case MutationType::Insertion:
-                MutationProcessor::insertMutation(data, cell);
+                MutationProcessor::insertMutation(data, cell, data.numberGen1);
                 break;
             case MutationType::Deletion:
-                MutationProcessor::deleteMutation(data, cell);
+                MutationProcessor::deleteMutation(data, cell, data.numberGen1);
                 break;
             case MutationType::Translation:
-                MutationProcessor::translateMutation(data, cell);
+                MutationProcessor::translateMutation(data, cell, data.numberGen1);
                 break;
             case MutationType::Duplication:
-                MutationProcessor::duplicateMutation(data, cell);
+                MutationProcessor::duplicateMutation(data, cell, data.numberGen1);
                 break;
             case MutationType::CellColor:
-                MutationProcessor::cellColorMutation(data, cell);
+                MutationProcessor::cellColorMutation(data, cell, data.numberGen1);
                 break;
             case MutationType::SubgenomeColor:
-                MutationProcessor::subgenomeColorMutation(data, cell);
+                MutationProcessor::subgenomeColorMutation(data, cell, data.numberGen1);
                 break;
             case MutationType::GenomeColor:
-                MutationProcessor::genomeColorMutation(data, cell);
+                MutationProcessor::genomeColorMutation(data, cell, data.numberGen1);
                 break;
             }
         }
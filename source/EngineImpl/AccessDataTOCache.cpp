@@ -1,63 +1,97 @@
 #include "AccessDataTOCache.h"
 
-_AccessDataTOCache::_AccessDataTOCache()
+#include <cuda_runtime.h>
+
+namespace
+{
+    auto constexpr GrowthFactor = 1.5;
+}
+
+_AccessDataTOCache::_AccessDataTOCache(bool pinnedMemory)
+    : _pinnedMemory(pinnedMemory)
 {}
 
 _AccessDataTOCache::~_AccessDataTOCache()
 {
-    if(_dataTO) {
-        deleteDataTO(*_dataTO);
+    for (auto& buffer : _buffers) {
+        deleteBuffer(buffer);
     }
 }
 
-DataTO _AccessDataTOCache::getDataTO(ArraySizes const& arraySizes)
+DataTO _AccessDataTOCache::getDataTO(ArraySizes const& arraySizes, DataTOBuffer bufferType)
 {
-    if (_dataTO) {
-        auto existingArraySizes = getArraySizes(*_dataTO);
-        if (fits(existingArraySizes, arraySizes)) {
-            *_dataTO->numCells = 0;
-            *_dataTO->numParticles = 0;
-            *_dataTO->numAuxiliaryData = 0;
-            return *_dataTO;
-        } else {
-            deleteDataTO(*_dataTO);
-        }
-    }
+    auto& buffer = _buffers[bufferType];
     try {
-        DataTO result;
-        result.numCells = new uint64_t;
-        result.numParticles = new uint64_t;
-        result.numAuxiliaryData = new uint64_t;
-        *result.numCells = 0;
-        *result.numParticles = 0;
-        *result.numAuxiliaryData = 0;
-        result.cells = new CellTO[arraySizes.cellArraySize];
-        result.particles = new ParticleTO[arraySizes.particleArraySize];
-        result.auxiliaryData = new uint8_t[arraySizes.auxiliaryDataSize];
-        _dataTO = result;
-        return result;
+        auto& dataTO = buffer.dataTO;
+        if (!dataTO.numCells) {
+            dataTO.numCells = new uint64_t;
+            dataTO.numParticles = new uint64_t;
+            dataTO.numAuxiliaryData = new uint64_t;
+        }
+        reserve(dataTO.cells, buffer.pinnedCells, buffer.capacities.cellArraySize, arraySizes.cellArraySize);
+        reserve(dataTO.particles, buffer.pinnedParticles, buffer.capacities.particleArraySize, arraySizes.particleArraySize);
+        reserve(dataTO.auxiliaryData, buffer.pinnedAuxiliaryData, buffer.capacities.auxiliaryDataSize, arraySizes.auxiliaryDataSize);
+        *dataTO.numCells = 0;
+        *dataTO.numParticles = 0;
+        *dataTO.numAuxiliaryData = 0;
+        return dataTO;
     } catch (std::bad_alloc const&) {
+        deleteBuffer(buffer);
         throw std::runtime_error("There is not sufficient CPU memory available.");
     }
 }
 
-bool _AccessDataTOCache::fits(ArraySizes const& left, ArraySizes const& right) const
+template <typename T>
+void _AccessDataTOCache::reserve(T*& data, bool& pinned, uint64_t& capacity, uint64_t requiredSize)
+{
+    if (data && capacity >= requiredSize) {
+        return;
+    }
+    auto newCapacity = std::max(requiredSize, static_cast<uint64_t>(toDouble(capacity) * GrowthFactor));
+    deallocate(data, pinned);
+    data = nullptr;
+    capacity = 0;
+
+    data = allocate<T>(newCapacity, pinned);
+    capacity = newCapacity;
+}
+
+template <typename T>
+T* _AccessDataTOCache::allocate(uint64_t size, bool& pinned)
 {
-    return left.cellArraySize >= right.cellArraySize && left.particleArraySize >= right.particleArraySize
-        && left.auxiliaryDataSize >= right.auxiliaryDataSize;
+    if (_pinnedMemory && size > 0) {
+        void* result = nullptr;
+        if (cudaMallocHost(&result, sizeof(T) * size) == cudaSuccess) {
+            pinned = true;
+            return reinterpret_cast<T*>(result);
+        }
+        cudaGetLastError();  //reset error state
+    }
+    pinned = false;
+    return new T[size];
 }
 
-auto _AccessDataTOCache::getArraySizes(DataTO const& dataTO) const -> ArraySizes
+template <typename T>
+void _AccessDataTOCache::deallocate(T* data, bool pinned)
 {
-    return {*dataTO.numCells, *dataTO.numParticles, *dataTO.numAuxiliaryData};
+    if (!data) {
+        return;
+    }
+    if (pinned) {
+        cudaFreeHost(data);
+    } else {
+        delete[] data;
+    }
 }
 
-void _AccessDataTOCache::deleteDataTO(DataTO const& dataTO)
+void _AccessDataTOCache::deleteBuffer(Buffer& buffer)
 {
+    auto& dataTO = buffer.dataTO;
     delete dataTO.numCells;
     delete dataTO.numParticles;
     delete dataTO.numAuxiliaryData;
-    delete[] dataTO.cells;
-    delete[] dataTO.particles;
-    delete[] dataTO.auxiliaryData;
+    deallocate(dataTO.cells, buffer.pinnedCells);
+    deallocate(dataTO.particles, buffer.pinnedParticles);
+    deallocate(dataTO.auxiliaryData, buffer.pinnedAuxiliaryData);
+    buffer = Buffer();
 }
@@ -8,19 +8,37 @@
 
 #include "Definitions.h"
 
+/**
+ * Host buffers for transferring data from and to the device. Each buffer type is cached separately so that the rendering
+ * of overlays and the data access do not reallocate each other's memory. Capacities grow geometrically.
+ */
 class _AccessDataTOCache
 {
 public:
-    _AccessDataTOCache();
+    _AccessDataTOCache(bool pinnedMemory = false);  //page-locked memory speeds up device transfers (falls back to pageable memory)
     ~_AccessDataTOCache();
 
-    DataTO getDataTO(ArraySizes const& arraySizes);
+    //the counters of the returned DataTO are reset
+    DataTO getDataTO(ArraySizes const& arraySizes, DataTOBuffer buffer = DataTOBuffer_DataAccess);
 
 private:
-    bool fits(ArraySizes const& left, ArraySizes const& right) const;
-    ArraySizes getArraySizes(DataTO const& dataTO) const;
-    void deleteDataTO(DataTO const& dataTO);
-
-    std::optional<DataTO> _dataTO;
+    struct Buffer
+    {
+        DataTO dataTO;
+        ArraySizes capacities;
+        bool pinnedCells = false;
+        bool pinnedParticles = false;
+        bool pinnedAuxiliaryData = false;
+    };
+
+    template <typename T>
+    void reserve(T*& data, bool& pinned, uint64_t& capacity, uint64_t requiredSize);
+    template <typename T>
+    T* allocate(uint64_t size, bool& pinned);
+    template <typename T>
+    void deallocate(T* data, bool pinned);
+    void deleteBuffer(Buffer& buffer);
+
+    bool _pinnedMemory = false;
+    Buffer _buffers[DataTOBuffer_Count];
 };
-
@@ -0,0 +1,166 @@
+#include "DataTOSnapshot.h"
+
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include "Base/Resources.h"
+
+namespace
+{
+    char const SnapshotMagic[] = {'A', 'L', 'I', 'E', 'N', 'R', 'A', 'W'};
+    auto constexpr FormatVersion = 1;
+    auto constexpr Alignment = 64;
+
+    uint64_t align(uint64_t offset)
+    {
+        return (offset + Alignment - 1) / Alignment * Alignment;
+    }
+
+    void writePadding(std::ofstream& stream, uint64_t& offset)
+    {
+        static char const zeros[Alignment] = {};
+        auto alignedOffset = align(offset);
+        stream.write(zeros, alignedOffset - offset);
+        offset = alignedOffset;
+    }
+
+    void writeArray(std::ofstream& stream, void const* data, uint64_t size, uint64_t& offset)
+    {
+        writePadding(stream, offset);
+        stream.write(reinterpret_cast<char const*>(data), size);
+        offset += size;
+    }
+
+    //formulated without sums to avoid overflows for crafted values
+    bool isArrayInside(uint64_t offset, uint64_t count, uint64_t elementSize, uint64_t size)
+    {
+        return offset <= size && count <= (size - offset) / elementSize;
+    }
+
+    bool isAuxiliaryDataInside(uint64_t dataIndex, uint64_t dataSize, uint64_t numAuxiliaryData)
+    {
+        return isArrayInside(dataIndex, dataSize, 1, numAuxiliaryData);
+    }
+
+    void checkCells(DataTOSnapshotHeader const& header, CellTO const* cells)
+    {
+        auto numAuxiliaryData = header.numAuxiliaryData;
+        for (uint64_t i = 0; i < header.numCells; ++i) {
+            auto const& cell = cells[i];
+            auto valid = cell.numConnections <= MAX_CELL_BONDS && cell.cellFunction < CellFunction_Count
+                && isAuxiliaryDataInside(cell.metadata.nameDataIndex, cell.metadata.nameSize, numAuxiliaryData)
+                && isAuxiliaryDataInside(cell.metadata.descriptionDataIndex, cell.metadata.descriptionSize, numAuxiliaryData);
+            for (int j = 0; valid && j < cell.numConnections; ++j) {
+                auto cellIndex = cell.connections[j].cellIndex;
+                valid = cellIndex >= 0 && static_cast<uint64_t>(cellIndex) < header.numCells;
+            }
+            if (valid && cell.cellFunction == CellFunction_Neuron) {
+                valid = isAuxiliaryDataInside(
+                    cell.cellFunctionData.neuron.weightsAndBiasesDataIndex, sizeof(float) * MAX_CHANNELS * (MAX_CHANNELS + 1), numAuxiliaryData);
+            }
+            if (valid && cell.cellFunction == CellFunction_Constructor) {
+                auto const& constructor = cell.cellFunctionData.constructor;
+                valid = isAuxiliaryDataInside(constructor.genomeDataIndex, constructor.genomeSize, numAuxiliaryData);
+            }
+            if (valid && cell.cellFunction == CellFunction_Injector) {
+                auto const& injector = cell.cellFunctionData.injector;
+                valid = isAuxiliaryDataInside(injector.genomeDataIndex, injector.genomeSize, numAuxiliaryData);
+            }
+            if (!valid) {
+                throw std::runtime_error("Snapshot contains invalid cell data.");
+            }
+        }
+    }
+}
+
+bool _DataTOSnapshot::isSnapshotFile(std::string const& filename)
+{
+    std::ifstream stream(filename, std::ios::binary);
+    char magic[sizeof(SnapshotMagic)];
+    stream.read(magic, sizeof(magic));
+    return stream && std::memcmp(magic, SnapshotMagic, sizeof(SnapshotMagic)) == 0;
+}
+
+void _DataTOSnapshot::write(std::string const& filename, DataTO const& dataTO, IntVector2D const& worldSize, uint64_t timestep)
+{
+    DataTOSnapshotHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, SnapshotMagic, sizeof(SnapshotMagic));
+    header.formatVersion = FormatVersion;
+    header.headerSize = sizeof(DataTOSnapshotHeader);
+    std::strncpy(header.programVersion, Const::ProgramVersion.c_str(), sizeof(header.programVersion) - 1);
+    header.cellTOSize = sizeof(CellTO);
+    header.particleTOSize = sizeof(ParticleTO);
+    header.worldSizeX = worldSize.x;
+    header.worldSizeY = worldSize.y;
+    header.timestep = timestep;
+    header.numCells = *dataTO.numCells;
+    header.numParticles = *dataTO.numParticles;
+    header.numAuxiliaryData = *dataTO.numAuxiliaryData;
+    header.cellsOffset = align(sizeof(DataTOSnapshotHeader));
+    header.particlesOffset = align(header.cellsOffset + header.numCells * sizeof(CellTO));
+    header.auxiliaryDataOffset = align(header.particlesOffset + header.numParticles * sizeof(ParticleTO));
+
+    std::ofstream stream(filename, std::ios::binary);
+    if (!stream) {
+        throw std::runtime_error("Could not open " + filename + ".");
+    }
+    uint64_t offset = 0;
+    writeArray(stream, &header, sizeof(header), offset);
+    writeArray(stream, dataTO.cells, header.numCells * sizeof(CellTO), offset);
+    writeArray(stream, dataTO.particles, header.numParticles * sizeof(ParticleTO), offset);
+    writeArray(stream, dataTO.auxiliaryData, header.numAuxiliaryData, offset);
+    if (!stream) {
+        throw std::runtime_error("Could not write " + filename + ".");
+    }
+}
+
+_DataTOSnapshot::_DataTOSnapshot(std::string const& filename)
+    : _file(std::make_shared<_MemoryMappedFile>(filename))
+{
+    if (_file->getSize() < sizeof(DataTOSnapshotHeader)) {
+        throw std::runtime_error("No snapshot detected.");
+    }
+    _header = reinterpret_cast<DataTOSnapshotHeader*>(_file->getData());
+    if (std::memcmp(_header->magic, SnapshotMagic, sizeof(SnapshotMagic)) != 0) {
+        throw std::runtime_error("No snapshot detected.");
+    }
+    if (_header->formatVersion != FormatVersion || _header->headerSize != sizeof(DataTOSnapshotHeader) || _header->cellTOSize != sizeof(CellTO)
+        || _header->particleTOSize != sizeof(ParticleTO)) {
+        throw std::runtime_error("Snapshot has been created by an incompatible version.");
+    }
+    auto size = _file->getSize();
+    if (!isArrayInside(_header->cellsOffset, _header->numCells, sizeof(CellTO), size)
+        || !isArrayInside(_header->particlesOffset, _header->numParticles, sizeof(ParticleTO), size)
+        || !isArrayInside(_header->auxiliaryDataOffset, _header->numAuxiliaryData, 1, size)) {
+        throw std::runtime_error("Snapshot is truncated.");
+    }
+    if (_header->cellsOffset % Alignment != 0 || _header->particlesOffset % Alignment != 0) {
+        throw std::runtime_error("Snapshot is corrupted.");
+    }
+    checkCells(*_header, reinterpret_cast<CellTO const*>(_file->getData() + _header->cellsOffset));
+}
+
+DataTOSnapshotHeader const& _DataTOSnapshot::getHeader() const
+{
+    return *_header;
+}
+
+ArraySizes _DataTOSnapshot::getArraySizes() const
+{
+    return {_header->numCells, _header->numParticles, _header->numAuxiliaryData};
+}
+
+DataTO _DataTOSnapshot::getDataTO() const
+{
+    auto data = _file->getData();
+    DataTO result;
+    result.numCells = &_header->numCells;
+    result.numParticles = &_header->numParticles;
+    result.numAuxiliaryData = &_header->numAuxiliaryData;
+    result.cells = reinterpret_cast<CellTO*>(data + _header->cellsOffset);
+    result.particles = reinterpret_cast<ParticleTO*>(data + _header->particlesOffset);
+    result.auxiliaryData = data + _header->auxiliaryDataOffset;
+    return result;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Base/Definitions.h"
+#include "Base/MemoryMappedFile.h"
+
+#include "EngineInterface/ArraySizes.h"
+#include "EngineGpuKernels/TOs.cuh"
+
+#include "Definitions.h"
+
+/**
+ * Raw dump of a DataTO for fast checkpointing and offline analysis.
+ *
+ * The file consists of a fixed-size header followed by the cell, particle and auxiliary data arrays at aligned offsets.
+ * It can be memory-mapped and used as a DataTO without any parsing. The format depends on the memory layout of the TOs
+ * and is therefore only readable by the same program version.
+ */
+struct DataTOSnapshotHeader
+{
+    char magic[8];
+    uint32_t formatVersion;
+    uint32_t headerSize;
+    char programVersion[32];
+    uint32_t cellTOSize;
+    uint32_t particleTOSize;
+    int32_t worldSizeX;
+    int32_t worldSizeY;
+    uint64_t timestep;
+    uint64_t numCells;
+    uint64_t numParticles;
+    uint64_t numAuxiliaryData;
+    uint64_t cellsOffset;
+    uint64_t particlesOffset;
+    uint64_t auxiliaryDataOffset;
+};
+
+class _DataTOSnapshot
+{
+public:
+    static bool isSnapshotFile(std::string const& filename);
+    static void write(std::string const& filename, DataTO const& dataTO, IntVector2D const& worldSize, uint64_t timestep);
+
+    _DataTOSnapshot(std::string const& filename);  //maps the file and checks all indices, throws std::runtime_error if it is no valid snapshot
+
+    DataTOSnapshotHeader const& getHeader() const;
+    ArraySizes getArraySizes() const;
+    DataTO getDataTO() const;  //points directly into the mapped file
+
+private:
+    MemoryMappedFile _file;
+    DataTOSnapshotHeader* _header = nullptr;
+};
@@ -4,3 +4,14 @@
 
 class _AccessDataTOCache;
 using AccessDataTOCache = std::shared_ptr<_AccessDataTOCache>;
+
+using DataTOBuffer = int;
+enum DataTOBuffer_
+{
+    DataTOBuffer_DataAccess,
+    DataTOBuffer_Rendering,
+    DataTOBuffer_Count
+};
+
+class _DataTOSnapshot;
+using DataTOSnapshot = std::shared_ptr<_DataTOSnapshot>;
@@ -1,11 +1,14 @@
 #include "DescriptionConverter.h"
 
 #include <cmath>
+#include <cstring>
 #include <algorithm>
-#include <boost/range/adaptor/map.hpp>
 
+#include "Base/ClusterLabeling.h"
 #include "Base/NumberGenerator.h"
 #include "Base/Exceptions.h"
+#include "Base/ThreadPool.h"
+#include "EngineInterface/ColumnarSerializerService.h"
 #include "EngineInterface/Descriptions.h"
 #include "EngineInterface/GenomeConstants.h"
 
@@ -20,10 +23,7 @@ namespace
 
     void convert(DataTO const& dataTO, uint64_t sourceSize, uint64_t sourceIndex, std::vector<uint8_t>& target)
     {
-        target.resize(sourceSize);
-        for (int i = 0; i < sourceSize; ++i) {
-            target[i] = dataTO.auxiliaryData[sourceIndex + i];
-        }
+        target.assign(dataTO.auxiliaryData + sourceIndex, dataTO.auxiliaryData + sourceIndex + sourceSize);
     }
 
     void convert(DataTO const& dataTO, uint64_t sourceSize, uint64_t sourceIndex, std::vector<float>& target)
@@ -70,6 +70,24 @@ namespace
         }
     }
 
+    //the keys of genomeDataIndexByContent are views into the auxiliary data
+    void convertGenome(
+        DataTO const& dataTO,
+        std::vector<uint8_t> const& genome,
+        uint16_t& targetSize,
+        uint64_t& targetIndex,
+        std::unordered_map<std::string_view, uint64_t>& genomeDataIndexByContent)
+    {
+        auto findResult = genomeDataIndexByContent.find(std::string_view(reinterpret_cast<char const*>(genome.data()), genome.size()));
+        if (findResult != genomeDataIndexByContent.end()) {
+            targetSize = static_cast<uint16_t>(genome.size());
+            targetIndex = findResult->second;
+            return;
+        }
+        convert(dataTO, genome, targetSize, targetIndex);
+        genomeDataIndexByContent.emplace(std::string_view(reinterpret_cast<char const*>(dataTO.auxiliaryData + targetIndex), genome.size()), targetIndex);
+    }
+
     std::vector<float> unitWeightsAndBias(std::vector<std::vector<float>> const& weights, std::vector<float> const& bias)
     {
         std::vector<float> result(MAX_CHANNELS * MAX_CHANNELS + MAX_CHANNELS, 0);
@@ -129,46 +147,78 @@ ArraySizes DescriptionConverter::getArraySizes(ClusteredDataDescription const& d
     return result;
 }
 
-ClusteredDataDescription DescriptionConverter::convertTOtoClusteredDataDescription(DataTO const& dataTO) const
+ArraySizes DescriptionConverter::getArraySizes(ColumnarHeader const& header) const
 {
-	ClusteredDataDescription result;
+    ArraySizes result;
+    result.cellArraySize = header.numCells;
+    result.particleArraySize = header.numParticles;
+    //the TO only needs the deduplicated genomes but each cell needs its own copy on the device
+    result.auxiliaryDataSize =
+        header.metadataBytes + header.cellGenomeBytes + header.numNeurons * MAX_CHANNELS * (MAX_CHANNELS + 1) * sizeof(float);
+    return result;
+}
 
-    //cells
-    std::vector<ClusterDescription> clusters;
-    std::unordered_set<int> freeCellIndices;
-    for (int i = 0; i < *dataTO.numCells; ++i) {
-        freeCellIndices.insert(i);
+ArraySizes DescriptionConverter::getArraySizes(ColumnarSegment const& segment) const
+{
+    ArraySizes result;
+    result.cellArraySize = segment.getNumCells();
+    result.particleArraySize = segment.getNumParticles();
+    for (uint64_t i = 0; i < segment.getNumCells(); ++i) {
+        result.auxiliaryDataSize += segment.metadataNameSizes[i] + segment.metadataDescriptionSizes[i];
+        if (segment.cellFunctions[i] == CellFunction_Neuron) {
+            result.auxiliaryDataSize += MAX_CHANNELS * (MAX_CHANNELS + 1) * sizeof(float);
+        }
+    }
+    for (auto const& genomeRef : segment.genomeRefs) {
+        result.auxiliaryDataSize += segment.genomeSizes[genomeRef];
     }
-    std::unordered_map<int, int> cellTOIndexToCellDescIndex;
-    std::unordered_map<int, int> cellTOIndexToClusterDescIndex;
-    int clusterDescIndex = 0;
-    while (!freeCellIndices.empty()) {
-        auto freeCellIndex = *freeCellIndices.begin();
-        auto createClusterData = scanAndCreateClusterDescription(dataTO, freeCellIndex, freeCellIndices);
-        clusters.emplace_back(createClusterData.cluster);
+    return result;
+}
 
-        //update index maps
-        cellTOIndexToCellDescIndex.insert(
-            createClusterData.cellTOIndexToCellDescIndex.begin(), createClusterData.cellTOIndexToCellDescIndex.end());
-        for (auto const& cellTOIndex : createClusterData.cellTOIndexToCellDescIndex | boost::adaptors::map_keys) {
-            cellTOIndexToClusterDescIndex.emplace(cellTOIndex, clusterDescIndex);
+ArraySizes DescriptionConverter::getArraySizes(ClusteredDataDescription const& data, DescriptionEditService::DuplicationPlan const& plan) const
+{
+    std::vector<uint64_t> auxiliaryDataSizeByCluster(data.clusters.size(), 0);
+    for (size_t i = 0; i < data.clusters.size(); ++i) {
+        for (auto const& cell : data.clusters[i].cells) {
+            addAdditionalDataSizeForCell(cell, auxiliaryDataSizeByCluster[i]);
         }
-        ++clusterDescIndex;
     }
-    result.addClusters(clusters);
 
-    //particles
-    std::vector<ParticleDescription> particles;
-    for (int i = 0; i < *dataTO.numParticles; ++i) {
-        ParticleTO const& particle = dataTO.particles[i];
-        particles.emplace_back(ParticleDescription()
-                                   .setId(particle.id)
-                                   .setPos({particle.pos.x, particle.pos.y})
-                                   .setVel({particle.vel.x, particle.vel.y})
-                                   .setEnergy(particle.energy)
-                                   .setColor(particle.color));
+    //the auxiliary data are shared by the tiles in the TO but each cell needs its own copy on the device
+    ArraySizes result;
+    result.cellArraySize = plan.getNumCells();
+    result.particleArraySize = plan.sourceParticleIndices.size();
+    for (auto const& clusterIndex : plan.sourceClusterIndices) {
+        result.auxiliaryDataSize += auxiliaryDataSizeByCluster[clusterIndex];
     }
-    result.addParticles(particles);
+    return result;
+}
+
+ClusteredDataDescription DescriptionConverter::convertTOtoClusteredDataDescription(DataTO const& dataTO) const
+{
+    ClusteredDataDescription result;
+
+    //cells
+    auto numCells = toInt(*dataTO.numCells);
+    std::vector<int> clusterIndices;
+    auto numClusters = calcClusterIndices(dataTO, clusterIndices);
+
+    std::vector<int> indicesInCluster(numCells);
+    std::vector<int> clusterSizes(numClusters, 0);
+    for (int i = 0; i < numCells; ++i) {
+        indicesInCluster[i] = clusterSizes[clusterIndices[i]]++;
+    }
+    result.clusters.resize(numClusters);
+    for (int i = 0; i < numClusters; ++i) {
+        result.clusters[i].cells.resize(clusterSizes[i]);
+    }
+    ThreadPool::getInstance().parallelFor(0, numCells, [&](size_t index) {
+        auto cellIndex = toInt(index);
+        result.clusters[clusterIndices[cellIndex]].cells[indicesInCluster[cellIndex]] = createCellDescription(dataTO, cellIndex);
+    });
+
+    //particles
+    result.particles = createParticleDescriptions(dataTO);
 
     return result;
 }
@@ -178,24 +228,13 @@ DataDescription DescriptionConverter::convertTOtoDataDescription(DataTO const& d
     DataDescription result;
 
     //cells
-    std::vector<CellDescription> cells;
-    for (int i = 0; i < *dataTO.numCells; ++i) {
-        cells.emplace_back(createCellDescription(dataTO, i));
-    }
-    result.addCells(cells);
+    result.cells.resize(*dataTO.numCells);
+    ThreadPool::getInstance().parallelFor(0, *dataTO.numCells, [&](size_t index) {
+        result.cells[index] = createCellDescription(dataTO, toInt(index));
+    });
 
     //particles
-    std::vector<ParticleDescription> particles;
-    for (int i = 0; i < *dataTO.numParticles; ++i) {
-        ParticleTO const& particle = dataTO.particles[i];
-        particles.emplace_back(ParticleDescription()
-                                   .setId(particle.id)
-                                   .setPos({particle.pos.x, particle.pos.y})
-                                   .setVel({particle.vel.x, particle.vel.y})
-                                   .setEnergy(particle.energy)
-                                   .setColor(particle.color));
-    }
-    result.addParticles(particles);
+    result.particles = createParticleDescriptions(dataTO);
 
     return result;
 }
@@ -231,9 +270,10 @@ OverlayDescription DescriptionConverter::convertTOtoOverlayDescription(DataTO co
 void DescriptionConverter::convertDescriptionToTO(DataTO& result, ClusteredDataDescription const& description) const
 {
     std::unordered_map<uint64_t, int> cellIndexByIds;
+    std::unordered_map<std::string_view, uint64_t> genomeDataIndexByContent;
     for (auto const& cluster: description.clusters) {
         for (auto const& cell : cluster.cells) {
-            addCell(result, cell, cellIndexByIds);
+            addCell(result, cell, cellIndexByIds, genomeDataIndexByContent);
         }
     }
     for (auto const& cluster : description.clusters) {
@@ -251,8 +291,9 @@ void DescriptionConverter::convertDescriptionToTO(DataTO& result, ClusteredDataD
 void DescriptionConverter::convertDescriptionToTO(DataTO& result, DataDescription const& description) const
 {
     std::unordered_map<uint64_t, int> cellIndexByIds;
+    std::unordered_map<std::string_view, uint64_t> genomeDataIndexByContent;
     for (auto const& cell : description.cells) {
-        addCell(result, cell, cellIndexByIds);
+        addCell(result, cell, cellIndexByIds, genomeDataIndexByContent);
     }
     for (auto const& cell : description.cells) {
         if (cell.id != 0) {
@@ -264,10 +305,77 @@ void DescriptionConverter::convertDescriptionToTO(DataTO& result, DataDescriptio
     }
 }
 
+void DescriptionConverter::convertDuplicatedDescriptionToTO(
+    DataTO& result,
+    ClusteredDataDescription const& description,
+    DescriptionEditService::DuplicationPlan const& plan) const
+{
+    //convert source cells once, their auxiliary data are written directly to result
+    std::vector<CellTO> sourceCells(plan.sourceCellOffsets.back());
+    uint64_t numSourceCells = 0;
+    DataTO sourceTO = result;
+    sourceTO.numCells = &numSourceCells;
+    sourceTO.cells = sourceCells.data();
+
+    std::unordered_map<uint64_t, int> cellIndexByIds;
+    std::unordered_map<std::string_view, uint64_t> genomeDataIndexByContent;
+    for (auto const& cluster : description.clusters) {
+        for (auto const& cell : cluster.cells) {
+            addCell(sourceTO, cell, cellIndexByIds, genomeDataIndexByContent);
+        }
+    }
+    for (auto const& cluster : description.clusters) {
+        for (auto const& cell : cluster.cells) {
+            if (cell.id != 0) {
+                setConnections(sourceTO, cell, cellIndexByIds);
+            }
+        }
+    }
+
+    //fill tiles
+    auto cellIndexBase = *result.numCells;
+    ThreadPool::getInstance().parallelFor(0, plan.getNumCells(), [&](size_t index) {
+        auto clusterIndex = plan.getOutputClusterIndex(index);
+        auto tileIndex = plan.clusterTileIndices[clusterIndex];
+        auto const& offset = plan.tileOffsets[tileIndex];
+        auto sourceCellOffset = plan.sourceCellOffsets[plan.sourceClusterIndices[clusterIndex]];
+        auto cellOffset = cellIndexBase + plan.cellOffsets[clusterIndex];
+
+        auto& cellTO = result.cells[cellIndexBase + index];
+        cellTO = sourceCells[sourceCellOffset + index - plan.cellOffsets[clusterIndex]];
+        cellTO.id = plan.firstId + index;
+        cellTO.pos = {cellTO.pos.x + offset.x, cellTO.pos.y + offset.y};
+        for (int i = 0; i < cellTO.numConnections; ++i) {
+            cellTO.connections[i].cellIndex = toInt(cellOffset + cellTO.connections[i].cellIndex - sourceCellOffset);
+        }
+        if (cellTO.creatureId != 0) {
+            cellTO.creatureId = plan.getNewCreatureId(tileIndex, cellTO.creatureId);
+        }
+        if (cellTO.cellFunction == CellFunction_Constructor) {
+            auto& offspringCreatureId = cellTO.cellFunctionData.constructor.offspringCreatureId;
+            offspringCreatureId = plan.getNewCreatureId(tileIndex, offspringCreatureId);
+        }
+        if (tileIndex > 0) {
+            cellTO.metadata.nameSize = 0;
+            cellTO.metadata.descriptionSize = 0;
+        }
+    });
+    *result.numCells += plan.getNumCells();
+
+    for (size_t i = 0; i < plan.sourceParticleIndices.size(); ++i) {
+        auto const& offset = plan.tileOffsets[plan.particleTileIndices[i]];
+        auto particle = description.particles[plan.sourceParticleIndices[i]];
+        particle.pos = RealVector2D{particle.pos.x + offset.x, particle.pos.y + offset.y};
+        particle.id = plan.firstId + plan.getNumCells() + i;
+        addParticle(result, particle);
+    }
+}
+
 void DescriptionConverter::convertDescriptionToTO(DataTO& result, CellDescription const& cell) const
 {
     std::unordered_map<uint64_t, int> cellIndexByIds;
-    addCell(result, cell, cellIndexByIds);
+    std::unordered_map<std::string_view, uint64_t> genomeDataIndexByContent;
+    addCell(result, cell, cellIndexByIds, genomeDataIndexByContent);
 }
 
 void DescriptionConverter::convertDescriptionToTO(DataTO& result, ParticleDescription const& particle) const
@@ -307,56 +415,32 @@ void DescriptionConverter::addAdditionalDataSizeForCell(CellDescription const& c
     }
 }    
 
-namespace
+int DescriptionConverter::calcClusterIndices(DataTO const& dataTO, std::vector<int>& clusterIndices) const
 {
-    template <typename T>
-    void setInplaceDifference(std::unordered_set<T>& a, std::unordered_set<T> const& b)
-    {
-        for (auto const& element : b) {
-            a.erase(element);
+    auto numCells = toInt(*dataTO.numCells);
+    ClusterLabeling labeling(numCells);
+    for (int i = 0; i < numCells; ++i) {
+        auto const& cellTO = dataTO.cells[i];
+        for (int j = 0; j < cellTO.numConnections; ++j) {
+            labeling.connect(i, cellTO.connections[j].cellIndex);
         }
     }
+    return labeling.calcLabels(clusterIndices);
 }
 
-auto DescriptionConverter::scanAndCreateClusterDescription(
-    DataTO const& dataTO,
-    int startCellIndex,
-    std::unordered_set<int>& freeCellIndices) const
-    -> CreateClusterReturnData
+std::vector<ParticleDescription> DescriptionConverter::createParticleDescriptions(DataTO const& dataTO) const
 {
-    CreateClusterReturnData result; 
-
-    std::unordered_set<int> currentCellIndices;
-    currentCellIndices.insert(startCellIndex);
-    std::unordered_set<int> scannedCellIndices = currentCellIndices;
-
-    std::vector<CellDescription> cells;
-    std::unordered_set<int> nextCellIndices;
-    int cellDescIndex = 0;
-    do {
-        for (auto const& currentCellIndex : currentCellIndices) {
-            cells.emplace_back(createCellDescription(dataTO, currentCellIndex));
-            result.cellTOIndexToCellDescIndex.emplace(currentCellIndex, cellDescIndex);
-            auto const& cellTO = dataTO.cells[currentCellIndex];
-            for (int i = 0; i < cellTO.numConnections; ++i) {
-                auto connectionTO = cellTO.connections[i];
-                if (connectionTO.cellIndex != -1) {
-                    if (scannedCellIndices.find(connectionTO.cellIndex) == scannedCellIndices.end()) {
-                        nextCellIndices.insert(connectionTO.cellIndex);
-                        scannedCellIndices.insert(connectionTO.cellIndex);
-                    }
-                }
-            }
-            ++cellDescIndex;
-        }
-        currentCellIndices = nextCellIndices;
-        nextCellIndices.clear();
-    } while (!currentCellIndices.empty());
-
-    setInplaceDifference(freeCellIndices, scannedCellIndices);
-
-    result.cluster.addCells(cells);
-
+    std::vector<ParticleDescription> result;
+    result.reserve(*dataTO.numParticles);
+    for (int i = 0; i < *dataTO.numParticles; ++i) {
+        ParticleTO const& particle = dataTO.particles[i];
+        result.emplace_back(ParticleDescription()
+                                .setId(particle.id)
+                                .setPos({particle.pos.x, particle.pos.y})
+                                .setVel({particle.vel.x, particle.vel.y})
+                                .setEnergy(particle.energy)
+                                .setColor(particle.color));
+    }
     return result;
 }
 
@@ -371,7 +455,7 @@ CellDescription DescriptionConverter::createCellDescription(DataTO const& dataTO
     result.energy = cellTO.energy;
     result.stiffness = cellTO.stiffness;
     result.maxConnections = cellTO.maxConnections;
-    std::vector<ConnectionDescription> connections;
+    result.connections.reserve(cellTO.numConnections);
     for (int i = 0; i < cellTO.numConnections; ++i) {
         auto const& connectionTO = cellTO.connections[i];
         ConnectionDescription connection;
@@ -382,9 +466,8 @@ CellDescription DescriptionConverter::createCellDescription(DataTO const& dataTO
         }
         connection.distance = connectionTO.distance;
         connection.angleFromPrevious = connectionTO.angleFromPrevious;
-        connections.emplace_back(connection);
+        result.connections.emplace_back(connection);
     }
-    result.connections = connections;
     result.livingState = cellTO.livingState;
     result.creatureId = cellTO.creatureId;
     result.mutationId = cellTO.mutationId;
@@ -400,17 +483,12 @@ CellDescription DescriptionConverter::createCellDescription(DataTO const& dataTO
     result.cellFunctionUsed = cellTO.cellFunctionUsed;
 
     auto const& metadataTO = cellTO.metadata;
-    auto metadata = CellMetadataDescription();
     if (metadataTO.nameSize > 0) {
-        auto const name = std::string(reinterpret_cast<char*>(&dataTO.auxiliaryData[metadataTO.nameDataIndex]), metadataTO.nameSize);
-        metadata.setName(name);
+        result.metadata.name.assign(reinterpret_cast<char*>(&dataTO.auxiliaryData[metadataTO.nameDataIndex]), metadataTO.nameSize);
     }
     if (metadataTO.descriptionSize > 0) {
-        auto const description =
-            std::string(reinterpret_cast<char*>(&dataTO.auxiliaryData[metadataTO.descriptionDataIndex]), metadataTO.descriptionSize);
-        metadata.setDescription(description);
+        result.metadata.description.assign(reinterpret_cast<char*>(&dataTO.auxiliaryData[metadataTO.descriptionDataIndex]), metadataTO.descriptionSize);
     }
-    result.metadata = metadata;
 
     switch (cellTO.cellFunction) {
     case CellFunction_Neuron: {
@@ -421,7 +499,7 @@ CellDescription DescriptionConverter::createCellDescription(DataTO const& dataTO
         for (int i = 0; i < MAX_CHANNELS; ++i) {
             neuron.activationFunctions[i] = cellTO.cellFunctionData.neuron.activationFunctions[i];
         }
-        result.cellFunction = neuron;
+        result.cellFunction = std::move(neuron);
     } break;
     case CellFunction_Transmitter: {
         TransmitterDescription transmitter;
@@ -443,7 +521,7 @@ CellDescription DescriptionConverter::createCellDescription(DataTO const& dataTO
         constructor.genomeGeneration = cellTO.cellFunctionData.constructor.genomeGeneration;
         constructor.constructionAngle1 = cellTO.cellFunctionData.constructor.constructionAngle1;
         constructor.constructionAngle2 = cellTO.cellFunctionData.constructor.constructionAngle2;
-        result.cellFunction = constructor;
+        result.cellFunction = std::move(constructor);
     } break;
     case CellFunction_Sensor: {
         SensorDescription sensor;
@@ -480,7 +558,7 @@ CellDescription DescriptionConverter::createCellDescription(DataTO const& dataTO
         injector.counter = cellTO.cellFunctionData.injector.counter;
         convert(dataTO, cellTO.cellFunctionData.injector.genomeSize, cellTO.cellFunctionData.injector.genomeDataIndex, injector.genome);
         injector.genomeGeneration = cellTO.cellFunctionData.injector.genomeGeneration;
-        result.cellFunction = injector;
+        result.cellFunction = std::move(injector);
     } break;
     case CellFunction_Muscle: {
         MuscleDescription muscle;
@@ -546,7 +624,10 @@ void DescriptionConverter::addParticle(DataTO const& dataTO, ParticleDescription
 }
 
 void DescriptionConverter::addCell(
-    DataTO const& dataTO, CellDescription const& cellDesc, std::unordered_map<uint64_t, int>& cellIndexTOByIds) const
+    DataTO const& dataTO,
+    CellDescription const& cellDesc,
+    std::unordered_map<uint64_t, int>& cellIndexTOByIds,
+    std::unordered_map<std::string_view, uint64_t>& genomeDataIndexByContent) const
 {
     int cellIndex = (*dataTO.numCells)++;
     CellTO& cellTO = dataTO.cells[cellIndex];
@@ -592,7 +673,7 @@ void DescriptionConverter::addCell(
         constructorTO.activationMode = constructorDesc.activationMode;
         constructorTO.constructionActivationTime = constructorDesc.constructionActivationTime;
         CHECK(constructorDesc.genome.size() >= Const::GenomeHeaderSize)
-        convert(dataTO, constructorDesc.genome, constructorTO.genomeSize, constructorTO.genomeDataIndex);
+        convertGenome(dataTO, constructorDesc.genome, constructorTO.genomeSize, constructorTO.genomeDataIndex, genomeDataIndexByContent);
         constructorTO.numInheritedGenomeNodes = static_cast<uint16_t>(constructorDesc.numInheritedGenomeNodes);
         constructorTO.lastConstructedCellId = constructorDesc.lastConstructedCellId;
         constructorTO.genomeCurrentNodeIndex = static_cast<uint16_t>(constructorDesc.genomeCurrentNodeIndex);
@@ -641,7 +722,7 @@ void DescriptionConverter::addCell(
         injectorTO.mode = injectorDesc.mode;
         injectorTO.counter = injectorDesc.counter;
         CHECK(injectorDesc.genome.size() >= Const::GenomeHeaderSize)
-        convert(dataTO, injectorDesc.genome, injectorTO.genomeSize, injectorTO.genomeDataIndex);
+        convertGenome(dataTO, injectorDesc.genome, injectorTO.genomeSize, injectorTO.genomeDataIndex, genomeDataIndexByContent);
         injectorTO.genomeGeneration = injectorDesc.genomeGeneration;
         cellTO.cellFunctionData.injector = injectorTO;
     } break;
@@ -714,4 +795,239 @@ void DescriptionConverter::setConnections(DataTO const& dataTO, CellDescription
         cellTO.connections[0].angleFromPrevious += angleOffset;
     }
     cellTO.numConnections = index;
-}
\ No newline at end of file
+}
+
+namespace
+{
+    template <typename T>
+    uint64_t appendAuxiliaryData(DataTO const& dataTO, T const* source, uint64_t count)
+    {
+        auto targetIndex = *dataTO.numAuxiliaryData;
+        auto size = count * sizeof(T);
+        if (size > 0) {
+            std::memcpy(dataTO.auxiliaryData + targetIndex, source, size);
+            (*dataTO.numAuxiliaryData) += size;
+        }
+        return targetIndex;
+    }
+
+    //upper bound since genomes which are not referenced are not appended
+    uint64_t getAuxiliaryDataSize(ColumnarSegment const& segment)
+    {
+        uint64_t result = 0;
+        for (uint64_t i = 0; i < segment.getNumCells(); ++i) {
+            result += segment.metadataNameSizes[i] + segment.metadataDescriptionSizes[i];
+            if (segment.cellFunctions[i] == CellFunction_Neuron) {
+                result += MAX_CHANNELS * (MAX_CHANNELS + 1) * sizeof(float);
+            }
+        }
+        for (auto const& genomeSize : segment.genomeSizes) {
+            result += genomeSize;
+        }
+        return result;
+    }
+}
+
+void DescriptionConverter::convertSegmentToTO(DataTO& result, ColumnarSegment const& segment, uint64_t cellIndexOffset, ArraySizes const& capacities) const
+{
+    if (*result.numCells + segment.getNumCells() > capacities.cellArraySize
+        || *result.numParticles + segment.getNumParticles() > capacities.particleArraySize
+        || *result.numAuxiliaryData + getAuxiliaryDataSize(segment) > capacities.auxiliaryDataSize) {
+        throw std::runtime_error("Columnar data exceed the sizes specified in the header.");
+    }
+
+    uint64_t connectionIndex = 0;
+    uint64_t nameIndex = 0;
+    uint64_t descriptionIndex = 0;
+    uint64_t genomeIndex = 0;
+    auto genomeDataIndices = segment.getGenomeDataIndices();
+    std::vector<std::optional<uint64_t>> genomeDataIndicesTO(segment.genomeSizes.size());
+    ColumnarRecordReader record(segment.cellFunctionData);
+
+    //genomes referenced multiple times in the segment share their auxiliary data
+    auto appendGenome = [&](uint16_t& genomeSize, uint64_t& genomeDataIndexTO) {
+        auto genomeRef = segment.genomeRefs[genomeIndex++];
+        auto size = segment.genomeSizes[genomeRef];
+        CHECK(size >= Const::GenomeHeaderSize);
+        genomeSize = static_cast<uint16_t>(size);
+        if (!genomeDataIndicesTO[genomeRef]) {
+            genomeDataIndicesTO[genomeRef] = appendAuxiliaryData(result, segment.genomeData.data() + genomeDataIndices[genomeRef], size);
+        }
+        genomeDataIndexTO = *genomeDataIndicesTO[genomeRef];
+    };
+
+    for (uint64_t i = 0; i < segment.getNumCells(); ++i) {
+        CellTO& cellTO = result.cells[(*result.numCells)++];
+        cellTO.id = segment.cellIds[i] == 0 ? NumberGenerator::getInstance().getId() : segment.cellIds[i];
+        cellTO.pos = {segment.cellPosX[i], segment.cellPosY[i]};
+        cellTO.vel = {segment.cellVelX[i], segment.cellVelY[i]};
+        cellTO.energy = segment.cellEnergies[i];
+        checkAndCorrectInvalidEnergy(cellTO.energy);
+        cellTO.stiffness = segment.cellStiffnesses[i];
+        cellTO.maxConnections = segment.cellMaxConnections[i];
+        cellTO.executionOrderNumber = segment.cellExecutionOrderNumbers[i];
+        cellTO.livingState = segment.cellLivingStates[i];
+        cellTO.creatureId = segment.cellCreatureIds[i];
+        cellTO.mutationId = segment.cellMutationIds[i];
+        cellTO.ancestorMutationId = segment.cellAncestorMutationIds[i];
+        cellTO.inputExecutionOrderNumber = segment.cellInputExecutionOrderNumbers[i];
+        cellTO.outputBlocked = segment.cellOutputBlocked[i] != 0;
+        cellTO.cellFunction = segment.cellFunctions[i];
+        cellTO.detectedByCreatureId = segment.cellDetectedByCreatureIds[i];
+        cellTO.cellFunctionUsed = segment.cellCellFunctionUsed[i];
+
+        //record layouts are defined in ColumnarSerializerService
+        switch (segment.cellFunctions[i]) {
+        case CellFunction_Neuron: {
+            NeuronTO neuronTO;
+            float weightsAndBiases[MAX_CHANNELS * (MAX_CHANNELS + 1)];
+            for (auto& weightOrBias : weightsAndBiases) {
+                weightOrBias = record.read<float>();
+            }
+            neuronTO.weightsAndBiasesDataIndex = appendAuxiliaryData(result, weightsAndBiases, MAX_CHANNELS * (MAX_CHANNELS + 1));
+            for (int j = 0; j < MAX_CHANNELS; ++j) {
+                neuronTO.activationFunctions[j] = record.read<int32_t>();
+            }
+            cellTO.cellFunctionData.neuron = neuronTO;
+        } break;
+        case CellFunction_Transmitter: {
+            TransmitterTO transmitterTO;
+            transmitterTO.mode = record.read<int32_t>();
+            cellTO.cellFunctionData.transmitter = transmitterTO;
+        } break;
+        case CellFunction_Constructor: {
+            ConstructorTO constructorTO;
+            constructorTO.activationMode = record.read<int32_t>();
+            constructorTO.constructionActivationTime = record.read<int32_t>();
+            constructorTO.numInheritedGenomeNodes = static_cast<uint16_t>(record.read<int32_t>());
+            constructorTO.genomeGeneration = record.read<int32_t>();
+            constructorTO.constructionAngle1 = record.read<float>();
+            constructorTO.constructionAngle2 = record.read<float>();
+            constructorTO.lastConstructedCellId = record.read<uint64_t>();
+            constructorTO.genomeCurrentNodeIndex = static_cast<uint16_t>(record.read<int32_t>());
+            constructorTO.genomeCurrentRepetition = static_cast<uint16_t>(record.read<int32_t>());
+            constructorTO.currentBranch = static_cast<uint8_t>(record.read<int32_t>());
+            constructorTO.offspringCreatureId = record.read<int32_t>();
+            constructorTO.offspringMutationId = record.read<int32_t>();
+            appendGenome(constructorTO.genomeSize, constructorTO.genomeDataIndex);
+            cellTO.cellFunctionData.constructor = constructorTO;
+        } break;
+        case CellFunction_Sensor: {
+            SensorTO sensorTO;
+            auto hasFixedAngle = record.read<uint8_t>() != 0;
+            sensorTO.mode = hasFixedAngle ? SensorMode_FixedAngle : SensorMode_Neighborhood;
+            sensorTO.angle = record.read<float>();
+            sensorTO.minDensity = record.read<float>();
+            sensorTO.minRange = static_cast<int8_t>(record.read<int32_t>());
+            sensorTO.maxRange = static_cast<int8_t>(record.read<int32_t>());
+            auto restrictToColor = record.read<int32_t>();
+            sensorTO.restrictToColor = restrictToColor >= 0 ? toUInt8(restrictToColor) : 255;
+            sensorTO.restrictToMutants = record.read<int32_t>();
+            sensorTO.memoryChannel1 = record.read<float>();
+            sensorTO.memoryChannel2 = record.read<float>();
+            sensorTO.memoryChannel3 = record.read<float>();
+            sensorTO.memoryTargetX = record.read<float>();
+            sensorTO.memoryTargetY = record.read<float>();
+            cellTO.cellFunctionData.sensor = sensorTO;
+        } break;
+        case CellFunction_Nerve: {
+            NerveTO nerveTO;
+            nerveTO.pulseMode = record.read<int32_t>();
+            nerveTO.alternationMode = record.read<int32_t>();
+            cellTO.cellFunctionData.nerve = nerveTO;
+        } break;
+        case CellFunction_Attacker: {
+            AttackerTO attackerTO;
+            attackerTO.mode = record.read<int32_t>();
+            cellTO.cellFunctionData.attacker = attackerTO;
+        } break;
+        case CellFunction_Injector: {
+            InjectorTO injectorTO;
+            injectorTO.mode = record.read<int32_t>();
+            injectorTO.counter = record.read<int32_t>();
+            injectorTO.genomeGeneration = record.read<int32_t>();
+            appendGenome(injectorTO.genomeSize, injectorTO.genomeDataIndex);
+            cellTO.cellFunctionData.injector = injectorTO;
+        } break;
+        case CellFunction_Muscle: {
+            MuscleTO muscleTO;
+            muscleTO.mode = record.read<int32_t>();
+            muscleTO.lastBendingDirection = record.read<int32_t>();
+            muscleTO.lastBendingSourceIndex = record.read<int32_t>();
+            muscleTO.consecutiveBendingAngle = record.read<float>();
+            muscleTO.lastMovementX = record.read<float>();
+            muscleTO.lastMovementY = record.read<float>();
+            cellTO.cellFunctionData.muscle = muscleTO;
+        } break;
+        case CellFunction_Defender: {
+            DefenderTO defenderTO;
+            defenderTO.mode = record.read<int32_t>();
+            cellTO.cellFunctionData.defender = defenderTO;
+        } break;
+        case CellFunction_Reconnector: {
+            ReconnectorTO reconnectorTO;
+            auto restrictToColor = record.read<int32_t>();
+            reconnectorTO.restrictToColor = restrictToColor >= 0 ? toUInt8(restrictToColor) : 255;
+            reconnectorTO.restrictToMutants = record.read<int32_t>();
+            cellTO.cellFunctionData.reconnector = reconnectorTO;
+        } break;
+        case CellFunction_Detonator: {
+            DetonatorTO detonatorTO;
+            detonatorTO.state = record.read<int32_t>();
+            detonatorTO.countdown = record.read<int32_t>();
+            cellTO.cellFunctionData.detonator = detonatorTO;
+        } break;
+        }
+
+        for (int j = 0; j < MAX_CHANNELS; ++j) {
+            cellTO.activity.channels[j] = segment.activityChannels[i * MAX_CHANNELS + j];
+        }
+        cellTO.activity.origin = segment.activityOrigins[i];
+        cellTO.activity.targetX = segment.activityTargetX[i];
+        cellTO.activity.targetY = segment.activityTargetY[i];
+        cellTO.activationTime = segment.cellActivationTimes[i];
+        cellTO.barrier = segment.cellBarriers[i] != 0;
+        cellTO.age = segment.cellAges[i];
+        cellTO.color = segment.cellColors[i];
+        cellTO.genomeComplexity = segment.cellGenomeComplexities[i];
+
+        auto nameSize = segment.metadataNameSizes[i];
+        cellTO.metadata.nameSize = static_cast<uint16_t>(nameSize);
+        cellTO.metadata.nameDataIndex = appendAuxiliaryData(result, segment.metadataNames.data() + nameIndex, nameSize);
+        nameIndex += nameSize;
+        auto descriptionSize = segment.metadataDescriptionSizes[i];
+        cellTO.metadata.descriptionSize = static_cast<uint16_t>(descriptionSize);
+        cellTO.metadata.descriptionDataIndex = appendAuxiliaryData(result, segment.metadataDescriptions.data() + descriptionIndex, descriptionSize);
+        descriptionIndex += descriptionSize;
+
+        //connections to cells not present in the file are skipped and their angles are added to the next connection
+        int index = 0;
+        float angleOffset = 0;
+        for (int j = 0; j < segment.cellNumConnections[i]; ++j, ++connectionIndex) {
+            auto connectedCellIndex = segment.connectionCellIndices[connectionIndex];
+            if (connectedCellIndex >= 0 && index < MAX_CELL_BONDS) {
+                cellTO.connections[index].cellIndex = static_cast<int>(cellIndexOffset + connectedCellIndex);
+                cellTO.connections[index].distance = segment.connectionDistances[connectionIndex];
+                cellTO.connections[index].angleFromPrevious = segment.connectionAngles[connectionIndex] + angleOffset;
+                ++index;
+                angleOffset = 0;
+            } else {
+                angleOffset += segment.connectionAngles[connectionIndex];
+            }
+        }
+        if (angleOffset != 0 && index > 0) {
+            cellTO.connections[0].angleFromPrevious += angleOffset;
+        }
+        cellTO.numConnections = index;
+    }
+
+    for (uint64_t i = 0; i < segment.getNumParticles(); ++i) {
+        ParticleTO& particleTO = result.particles[(*result.numParticles)++];
+        particleTO.id = segment.particleIds[i] == 0 ? NumberGenerator::getInstance().getId() : segment.particleIds[i];
+        particleTO.pos = {segment.particlePosX[i], segment.particlePosY[i]};
+        particleTO.vel = {segment.particleVelX[i], segment.particleVelY[i]};
+        particleTO.energy = segment.particleEnergies[i];
+        checkAndCorrectInvalidEnergy(particleTO.energy);
+        particleTO.color = segment.particleColors[i];
+    }
+}
@@ -1,9 +1,11 @@
 #pragma once
 
+#include <string_view>
 #include <unordered_map>
 
 #include "EngineInterface/Definitions.h"
 #include "EngineInterface/ArraySizes.h"
+#include "EngineInterface/DescriptionEditService.h"
 #include "EngineInterface/Descriptions.h"
 #include "EngineInterface/OverlayDescriptions.h"
 #include "EngineInterface/SimulationParameters.h"
@@ -17,6 +19,9 @@ public:
 
     ArraySizes getArraySizes(DataDescription const& data) const;
     ArraySizes getArraySizes(ClusteredDataDescription const& data) const;
+    ArraySizes getArraySizes(ColumnarHeader const& header) const;
+    ArraySizes getArraySizes(ColumnarSegment const& segment) const;  //sizes on the device, i.e. shared genomes are counted per cell
+    ArraySizes getArraySizes(ClusteredDataDescription const& data, DescriptionEditService::DuplicationPlan const& plan) const;
 
     ClusteredDataDescription convertTOtoClusteredDataDescription(DataTO const& dataTO) const;
     DataDescription convertTOtoDataDescription(DataTO const& dataTO) const;
@@ -26,22 +31,28 @@ public:
     void convertDescriptionToTO(DataTO& result, CellDescription const& cell) const;
     void convertDescriptionToTO(DataTO& result, ParticleDescription const& particle) const;
 
+    //converts the tiles of a duplicated world without building their descriptions, the tiles share the auxiliary data
+    void convertDuplicatedDescriptionToTO(DataTO& result, ClusteredDataDescription const& description, DescriptionEditService::DuplicationPlan const& plan) const;
+
+    //appends the cells and particles of a segment without building descriptions
+    //cellIndexOffset: index in result of the first cell of the file
+    //capacities: array sizes of result, throws std::runtime_error if the segment does not fit (e.g. for a corrupted header)
+    void convertSegmentToTO(DataTO& result, ColumnarSegment const& segment, uint64_t cellIndexOffset, ArraySizes const& capacities) const;
+
 private:
     void addAdditionalDataSizeForCell(CellDescription const& cell, uint64_t& additionalDataSize) const;
 
-	struct CreateClusterReturnData
-    {
-        ClusterDescription cluster;
-        std::unordered_map<int, int> cellTOIndexToCellDescIndex;
-	};
-    CreateClusterReturnData scanAndCreateClusterDescription(
-        DataTO const& dataTO,
-        int startCellIndex,
-        std::unordered_set<int>& freeCellIndices) const;
-    CellDescription createCellDescription(DataTO const& dataTO, int cellIndex) const;
+    //returns the number of clusters, clusterIndices contains the cluster index for each cell
+    int calcClusterIndices(DataTO const& dataTO, std::vector<int>& clusterIndices) const;
+    CellDescription createCellDescription(DataTO const& dataTO, int cellIndex) const;  //thread-safe
+    std::vector<ParticleDescription> createParticleDescriptions(DataTO const& dataTO) const;
 
+	//genomeDataIndexByContent: auxiliary data indices of the already added genomes, identical genomes share their auxiliary data
 	void addCell(
-        DataTO const& dataTO, CellDescription const& cellToAdd, std::unordered_map<uint64_t, int>& cellIndexTOByIds) const;
+        DataTO const& dataTO,
+        CellDescription const& cellToAdd,
+        std::unordered_map<uint64_t, int>& cellIndexTOByIds,
+        std::unordered_map<std::string_view, uint64_t>& genomeDataIndexByContent) const;
     void addParticle(DataTO const& dataTO, ParticleDescription const& particleDesc) const;
 
 	void setConnections(
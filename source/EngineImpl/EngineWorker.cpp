@@ -4,31 +4,41 @@
 
 #include "EngineGpuKernels/TOs.cuh"
 #include "EngineGpuKernels/SimulationCudaFacade.cuh"
+#include "EngineInterface/ColumnarDataReader.h"
 #include "AccessDataTOCache.h"
+#include "DataTOSnapshot.h"
 #include "DescriptionConverter.h"
+#include "SimulationCpuFacade.h"
 
 namespace
 {
     std::chrono::milliseconds const FrameTimeout(500);
 }
 
-void EngineWorker::newSimulation(uint64_t timestep, GeneralSettings const& generalSettings, SimulationParameters const& parameters)
+void EngineWorker::newSimulation(uint64_t timestep, GeneralSettings const& generalSettings, SimulationParameters const& parameters, EngineBackend backend)
 {
     _accessState = 0;
+    _backend = backend;
     _settings.generalSettings = generalSettings;
     _settings.simulationParameters = parameters;
-    _dataTOCache = std::make_shared<_AccessDataTOCache>();
-    _simulationCudaFacade = std::make_shared<_SimulationCudaFacade>(timestep, _settings);
+
+    //pinned memory is only beneficial for transfers to the GPU
+    _dataTOCache = std::make_shared<_AccessDataTOCache>(backend == EngineBackend_Gpu);
+    if (backend == EngineBackend_Gpu) {
+        _simulationFacade = std::make_shared<_SimulationCudaFacade>(timestep, _settings);
+    } else {
+        _simulationFacade = std::make_shared<_SimulationCpuFacade>(timestep, _settings);
+    }
 
     if (_imageResource) {
-        _cudaResource = _simulationCudaFacade->registerImageResource(*_imageResource);
+        _cudaResource = _simulationFacade->registerImageResource(*_imageResource);
     }
 }
 
 void EngineWorker::clear()
 {
     EngineWorkerGuard access(this);
-    return _simulationCudaFacade->clear();
+    return _simulationFacade->clear();
 }
 
 void EngineWorker::setImageResource(void* image)
@@ -36,14 +46,22 @@ void EngineWorker::setImageResource(void* image)
     GLuint imageId = reinterpret_cast<uintptr_t>(image);
     _imageResource = imageId;
 
-    if (_simulationCudaFacade) {
+    if (_simulationFacade) {
         EngineWorkerGuard access(this);
-        _cudaResource = _simulationCudaFacade->registerImageResource(imageId);
+        _cudaResource = _simulationFacade->registerImageResource(imageId);
     }
 }
 
+EngineBackend EngineWorker::getEngineBackend() const
+{
+    return _backend;
+}
+
 std::string EngineWorker::getGpuName() const
 {
+    if (_simulationFacade) {
+        return _simulationFacade->getDeviceName();
+    }
     return _SimulationCudaFacade::checkAndReturnGpuInfo().gpuModelName;
 }
 
@@ -56,7 +74,7 @@ void EngineWorker::tryDrawVectorGraphics(
     EngineWorkerGuard access(this, FrameTimeout);
 
     if (!access.isTimeout()) {
-        _simulationCudaFacade->drawVectorGraphics(
+        _simulationFacade->drawVectorGraphics(
             {rectUpperLeft.x, rectUpperLeft.y},
             {rectLowerRight.x, rectLowerRight.y},
             _cudaResource,
@@ -75,16 +93,16 @@ std::optional<OverlayDescription> EngineWorker::tryDrawVectorGraphicsAndReturnOv
     EngineWorkerGuard access(this, FrameTimeout);
 
     if (!access.isTimeout()) {
-        _simulationCudaFacade->drawVectorGraphics(
+        _simulationFacade->drawVectorGraphics(
             {rectUpperLeft.x, rectUpperLeft.y},
             {rectLowerRight.x, rectLowerRight.y},
             _cudaResource,
             {imageSize.x, imageSize.y},
             zoom);
 
-        DataTO dataTO = provideTO();
+        DataTO dataTO = provideTO(DataTOBuffer_Rendering);
 
-        _simulationCudaFacade->getOverlayData(
+        _simulationFacade->getOverlayData(
             {toInt(rectUpperLeft.x), toInt(rectUpperLeft.y)},
             int2{toInt(rectLowerRight.x), toInt(rectLowerRight.y)},
             dataTO);
@@ -106,6 +124,7 @@ bool EngineWorker::isSyncSimulationWithRendering() const
 void EngineWorker::setSyncSimulationWithRendering(bool value)
 {
     _syncSimulationWithRendering = value;
+    notifyWorkerThread();
 }
 
 int EngineWorker::getSyncSimulationWithRenderingRatio() const
@@ -124,7 +143,7 @@ ClusteredDataDescription EngineWorker::getClusteredSimulationData(IntVector2D co
 
     DataTO dataTO = provideTO();
     
-    _simulationCudaFacade->getSimulationData(
+    _simulationFacade->getSimulationData(
         {rectUpperLeft.x, rectUpperLeft.y}, int2{rectLowerRight.x, rectLowerRight.y}, dataTO);
 
     DescriptionConverter converter(_settings.simulationParameters);
@@ -139,7 +158,7 @@ DataDescription EngineWorker::getSimulationData(IntVector2D const& rectUpperLeft
 
     DataTO dataTO = provideTO();
     
-    _simulationCudaFacade->getSimulationData({rectUpperLeft.x, rectUpperLeft.y}, int2{rectLowerRight.x, rectLowerRight.y}, dataTO);
+    _simulationFacade->getSimulationData({rectUpperLeft.x, rectUpperLeft.y}, int2{rectLowerRight.x, rectLowerRight.y}, dataTO);
 
     DescriptionConverter converter(_settings.simulationParameters);
 
@@ -153,7 +172,7 @@ ClusteredDataDescription EngineWorker::getSelectedClusteredSimulationData(bool i
 
     DataTO dataTO = provideTO();
     
-    _simulationCudaFacade->getSelectedSimulationData(includeClusters, dataTO);
+    _simulationFacade->getSelectedSimulationData(includeClusters, dataTO);
 
     DescriptionConverter converter(_settings.simulationParameters);
 
@@ -167,7 +186,7 @@ DataDescription EngineWorker::getSelectedSimulationData(bool includeClusters)
 
     DataTO dataTO = provideTO();
     
-    _simulationCudaFacade->getSelectedSimulationData(includeClusters, dataTO);
+    _simulationFacade->getSelectedSimulationData(includeClusters, dataTO);
 
     DescriptionConverter converter(_settings.simulationParameters);
 
@@ -182,7 +201,7 @@ DataDescription EngineWorker::getInspectedSimulationData(std::vector<uint64_t> o
 
     DataTO dataTO = provideTO();
     
-    _simulationCudaFacade->getInspectedSimulationData(objectsIds, dataTO);
+    _simulationFacade->getInspectedSimulationData(objectsIds, dataTO);
 
     DescriptionConverter converter(_settings.simulationParameters);
 
@@ -192,17 +211,33 @@ DataDescription EngineWorker::getInspectedSimulationData(std::vector<uint64_t> o
 
 RawStatisticsData EngineWorker::getRawStatistics() const
 {
-    return _simulationCudaFacade->getRawStatistics();
+    return _simulationFacade->getRawStatistics();
 }
 
 StatisticsHistory const& EngineWorker::getStatisticsHistory() const
 {
-    return _simulationCudaFacade->getStatisticsHistory();
+    return _simulationFacade->getStatisticsHistory();
 }
 
 void EngineWorker::setStatisticsHistory(StatisticsHistoryData const& data)
 {
-    _simulationCudaFacade->setStatisticsHistory(data);
+    _simulationFacade->setStatisticsHistory(data);
+}
+
+bool EngineWorker::isProfilingEnabled() const
+{
+    return _simulationFacade->isProfilingEnabled();
+}
+
+void EngineWorker::setProfilingEnabled(bool value)
+{
+    EngineWorkerGuard access(this);
+    _simulationFacade->setProfilingEnabled(value);
+}
+
+ProfilingData EngineWorker::getProfilingData() const
+{
+    return _simulationFacade->getProfilingData();
 }
 
 void EngineWorker::addAndSelectSimulationData(DataDescription const& dataToUpdate)
@@ -213,13 +248,13 @@ void EngineWorker::addAndSelectSimulationData(DataDescription const& dataToUpdat
 
     EngineWorkerGuard access(this);
 
-    _simulationCudaFacade->resizeArraysIfNecessary(arraySizes);
+    _simulationFacade->resizeArraysIfNecessary(arraySizes);
 
     DataTO dataTO = provideTO();
 
     converter.convertDescriptionToTO(dataTO, dataToUpdate);
 
-    _simulationCudaFacade->addAndSelectSimulationData(dataTO);
+    _simulationFacade->addAndSelectSimulationData(dataTO);
 }
 
 void EngineWorker::setClusteredSimulationData(ClusteredDataDescription const& dataToUpdate)
@@ -228,13 +263,13 @@ void EngineWorker::setClusteredSimulationData(ClusteredDataDescription const& da
 
     EngineWorkerGuard access(this);
 
-    _simulationCudaFacade->resizeArraysIfNecessary(converter.getArraySizes(dataToUpdate));
+    _simulationFacade->resizeArraysIfNecessary(converter.getArraySizes(dataToUpdate));
 
     DataTO dataTO = provideTO();
 
     converter.convertDescriptionToTO(dataTO, dataToUpdate);
 
-    _simulationCudaFacade->setSimulationData(dataTO);
+    _simulationFacade->setSimulationData(dataTO);
 }
 
 void EngineWorker::setSimulationData(DataDescription const& dataToUpdate)
@@ -243,103 +278,220 @@ void EngineWorker::setSimulationData(DataDescription const& dataToUpdate)
 
     EngineWorkerGuard access(this);
 
-    _simulationCudaFacade->resizeArraysIfNecessary(converter.getArraySizes(dataToUpdate));
+    _simulationFacade->resizeArraysIfNecessary(converter.getArraySizes(dataToUpdate));
 
     DataTO dataTO = provideTO();
     converter.convertDescriptionToTO(dataTO, dataToUpdate);
 
-    _simulationCudaFacade->setSimulationData(dataTO);
+    _simulationFacade->setSimulationData(dataTO);
+}
+
+void EngineWorker::setDuplicatedSimulationData(ClusteredDataDescription const& dataToUpdate, IntVector2D const& origWorldSize)
+{
+    DescriptionConverter converter(_settings.simulationParameters);
+    auto worldSize = IntVector2D{_settings.generalSettings.worldSizeX, _settings.generalSettings.worldSizeY};
+    auto plan = DescriptionEditService::createDuplicationPlan(dataToUpdate, origWorldSize, worldSize);
+
+    EngineWorkerGuard access(this);
+
+    _simulationFacade->resizeArraysIfNecessary(converter.getArraySizes(dataToUpdate, plan));
+
+    DataTO dataTO = provideTO();
+    converter.convertDuplicatedDescriptionToTO(dataTO, dataToUpdate, plan);
+
+    _simulationFacade->setSimulationData(dataTO);
+}
+
+void EngineWorker::setColumnarSimulationData(ColumnarDataReader const& reader)
+{
+    DescriptionConverter converter(_settings.simulationParameters);
+
+    EngineWorkerGuard access(this);
+
+    //the sizes from the header bound the host buffers while reading, the simulation is only resized after they have been checked
+    auto const& header = reader->getHeader();
+    auto arraySizes = converter.getArraySizes(header);
+    DataTO dataTO = _dataTOCache->getDataTO(arraySizes);
+    ArraySizes segmentSizes;
+    ColumnarSegment segment;
+    while (reader->readSegment(segment)) {
+        converter.convertSegmentToTO(dataTO, segment, 0, arraySizes);
+        auto sizes = converter.getArraySizes(segment);
+        segmentSizes.cellArraySize += sizes.cellArraySize;
+        segmentSizes.particleArraySize += sizes.particleArraySize;
+        segmentSizes.auxiliaryDataSize += sizes.auxiliaryDataSize;
+    }
+
+    //connections may refer to all cells announced in the header
+    if (segmentSizes.cellArraySize != arraySizes.cellArraySize || segmentSizes.particleArraySize != arraySizes.particleArraySize
+        || segmentSizes.auxiliaryDataSize != arraySizes.auxiliaryDataSize) {
+        throw std::runtime_error("Columnar data do not match the sizes specified in the header.");
+    }
+
+    _simulationFacade->resizeArraysIfNecessary(arraySizes);
+    _simulationFacade->setSimulationData(dataTO);
+}
+
+void EngineWorker::saveRawSnapshot(std::string const& filename)
+{
+    EngineWorkerGuard access(this);
+
+    DataTO dataTO = provideTO();
+
+    auto worldSize = IntVector2D{_settings.generalSettings.worldSizeX, _settings.generalSettings.worldSizeY};
+    _simulationFacade->getSimulationData({-10, -10}, int2{worldSize.x + 10, worldSize.y + 10}, dataTO);
+
+    _DataTOSnapshot::write(filename, dataTO, worldSize, _simulationFacade->getCurrentTimestep());
+}
+
+void EngineWorker::loadRawSnapshot(std::string const& filename)
+{
+    auto snapshot = std::make_shared<_DataTOSnapshot>(filename);
+    auto const& header = snapshot->getHeader();
+    if (header.worldSizeX != _settings.generalSettings.worldSizeX || header.worldSizeY != _settings.generalSettings.worldSizeY) {
+        throw std::runtime_error("Snapshot world size does not match the simulation.");
+    }
+
+    EngineWorkerGuard access(this);
+
+    _simulationFacade->resizeArraysIfNecessary(snapshot->getArraySizes());
+    _simulationFacade->setSimulationData(snapshot->getDataTO());
+    _simulationFacade->setCurrentTimestep(header.timestep);
 }
 
 void EngineWorker::removeSelectedObjects(bool includeClusters)
 {
     EngineWorkerGuard access(this);
 
-    _simulationCudaFacade->removeSelectedObjects(includeClusters);
+    _simulationFacade->removeSelectedObjects(includeClusters);
 }
 
 void EngineWorker::relaxSelectedObjects(bool includeClusters)
 {
     EngineWorkerGuard access(this);
 
-    _simulationCudaFacade->relaxSelectedObjects(includeClusters);
+    _simulationFacade->relaxSelectedObjects(includeClusters);
 }
 
 void EngineWorker::uniformVelocitiesForSelectedObjects(bool includeClusters)
 {
     EngineWorkerGuard access(this);
 
-    _simulationCudaFacade->uniformVelocitiesForSelectedObjects(includeClusters);
+    _simulationFacade->uniformVelocitiesForSelectedObjects(includeClusters);
 }
 
 void EngineWorker::makeSticky(bool includeClusters)
 {
     EngineWorkerGuard access(this);
 
-    _simulationCudaFacade->makeSticky(includeClusters);
+    _simulationFacade->makeSticky(includeClusters);
 }
 
 void EngineWorker::removeStickiness(bool includeClusters)
 {
     EngineWorkerGuard access(this);
 
-    _simulationCudaFacade->removeStickiness(includeClusters);
+    _simulationFacade->removeStickiness(includeClusters);
 }
 
 void EngineWorker::setBarrier(bool value, bool includeClusters)
 {
     EngineWorkerGuard access(this);
 
-    _simulationCudaFacade->setBarrier(value, includeClusters);
+    _simulationFacade->setBarrier(value, includeClusters);
 }
 
 void EngineWorker::changeCell(CellDescription const& changedCell)
 {
     EngineWorkerGuard access(this);
+    changeCellIntern(changedCell);
+}
 
-    auto dataTO = provideTO();
+void EngineWorker::changeParticle(ParticleDescription const& changedParticle)
+{
+    EngineWorkerGuard access(this);
+    changeParticleIntern(changedParticle);
+}
 
-    DescriptionConverter converter(_settings.simulationParameters);
-    converter.convertDescriptionToTO(dataTO, changedCell);
+std::future<void> EngineWorker::removeSelectedObjects_async(bool includeClusters)
+{
+    return enqueueCommand([this, includeClusters] { _simulationFacade->removeSelectedObjects(includeClusters); });
+}
 
-    _simulationCudaFacade->changeInspectedSimulationData(dataTO);
+std::future<void> EngineWorker::relaxSelectedObjects_async(bool includeClusters)
+{
+    return enqueueCommand([this, includeClusters] { _simulationFacade->relaxSelectedObjects(includeClusters); });
 }
 
-void EngineWorker::changeParticle(ParticleDescription const& changedParticle)
+std::future<void> EngineWorker::uniformVelocitiesForSelectedObjects_async(bool includeClusters)
 {
-    EngineWorkerGuard access(this);
+    return enqueueCommand([this, includeClusters] { _simulationFacade->uniformVelocitiesForSelectedObjects(includeClusters); });
+}
 
-    auto dataTO = provideTO();
+std::future<void> EngineWorker::makeSticky_async(bool includeClusters)
+{
+    return enqueueCommand([this, includeClusters] { _simulationFacade->makeSticky(includeClusters); });
+}
 
-    DescriptionConverter converter(_settings.simulationParameters);
-    converter.convertDescriptionToTO(dataTO, changedParticle);
+std::future<void> EngineWorker::removeStickiness_async(bool includeClusters)
+{
+    return enqueueCommand([this, includeClusters] { _simulationFacade->removeStickiness(includeClusters); });
+}
+
+std::future<void> EngineWorker::setBarrier_async(bool value, bool includeClusters)
+{
+    return enqueueCommand([this, value, includeClusters] { _simulationFacade->setBarrier(value, includeClusters); });
+}
+
+std::future<void> EngineWorker::colorSelectedObjects_async(unsigned char color, bool includeClusters)
+{
+    return enqueueCommand([this, color, includeClusters] { _simulationFacade->colorSelectedObjects(color, includeClusters); });
+}
+
+std::future<void> EngineWorker::reconnectSelectedObjects_async()
+{
+    return enqueueCommand([this] { _simulationFacade->reconnectSelectedObjects(); });
+}
+
+std::future<void> EngineWorker::setDetached_async(bool value)
+{
+    return enqueueCommand([this, value] { _simulationFacade->setDetached(value); });
+}
 
-    _simulationCudaFacade->changeInspectedSimulationData(dataTO);
+std::future<void> EngineWorker::changeCell_async(CellDescription const& changedCell)
+{
+    return enqueueCommand([this, changedCell] { changeCellIntern(changedCell); });
+}
+
+std::future<void> EngineWorker::changeParticle_async(ParticleDescription const& changedParticle)
+{
+    return enqueueCommand([this, changedParticle] { changeParticleIntern(changedParticle); });
 }
 
 void EngineWorker::calcTimesteps(uint64_t timesteps)
 {
     EngineWorkerGuard access(this);
 
-    _simulationCudaFacade->calcTimestep(timesteps, true);
+    _simulationFacade->calcTimestep(timesteps, true);
 }
 
 void EngineWorker::applyCataclysm(int power)
 {
     EngineWorkerGuard access(this);
-    _simulationCudaFacade->applyCataclysm(power);
+    _simulationFacade->applyCataclysm(power);
 }
 
 void EngineWorker::beginShutdown()
 {
     _isShutdown.store(true);
+    notifyWorkerThread();
 }
 
 void EngineWorker::endShutdown()
 {
     _isSimulationRunning = false;
     _isShutdown = false;
-    _simulationCudaFacade.reset();
+    _simulationFacade.reset();
 }
 
 int EngineWorker::getTpsRestriction() const
@@ -360,30 +512,34 @@ float EngineWorker::getTps() const
 
 uint64_t EngineWorker::getCurrentTimestep() const
 {
-    return _simulationCudaFacade->getCurrentTimestep();
+    return _simulationFacade->getCurrentTimestep();
 }
 
 void EngineWorker::setCurrentTimestep(uint64_t value)
 {
     EngineWorkerGuard access(this);
-    _simulationCudaFacade->setCurrentTimestep(value);
+    _simulationFacade->setCurrentTimestep(value);
     resetTimeIntervalStatistics();
 }
 
 SimulationParameters EngineWorker::getSimulationParameters() const
 {
-    return _simulationCudaFacade->getSimulationParameters();
+    return _simulationFacade->getSimulationParameters();
 }
 
 void EngineWorker::setSimulationParameters(SimulationParameters const& parameters)
 {
-    _simulationCudaFacade->setSimulationParameters(parameters);
+    _simulationFacade->setSimulationParameters(parameters);
 }
 
 void EngineWorker::setGpuSettings_async(GpuSettings const& gpuSettings)
 {
-    std::unique_lock<std::mutex> uniqueLock(_mutexForAsyncJobs);
-    _updateGpuSettingsJob = gpuSettings;
+    {
+        std::unique_lock<std::mutex> uniqueLock(_mutexForAsyncJobs);
+        _updateGpuSettingsJob = gpuSettings;
+        _hasPendingJobs = true;
+    }
+    notifyWorkerThread();
 }
 
 void EngineWorker::applyForce_async(
@@ -392,91 +548,93 @@ void EngineWorker::applyForce_async(
     RealVector2D const& force,
     float radius)
 {
-    std::unique_lock<std::mutex> uniqueLock(_mutexForAsyncJobs);
-    _applyForceJobs.emplace_back(ApplyForceJob{start, end, force, radius});
+    {
+        std::unique_lock<std::mutex> uniqueLock(_mutexForAsyncJobs);
+        _applyForceJobs.emplace_back(ApplyForceJob{start, end, force, radius});
+        _hasPendingJobs = true;
+    }
+    notifyWorkerThread();
 }
 
 void EngineWorker::switchSelection(RealVector2D const& pos, float radius)
 {
     EngineWorkerGuard access(this);
-    _simulationCudaFacade->switchSelection(PointSelectionData{{pos.x, pos.y}, radius});
+    _simulationFacade->switchSelection(PointSelectionData{{pos.x, pos.y}, radius});
 }
 
 void EngineWorker::swapSelection(RealVector2D const& pos, float radius)
 {
     EngineWorkerGuard access(this);
-    _simulationCudaFacade->swapSelection(PointSelectionData{{pos.x, pos.y}, radius});
+    _simulationFacade->swapSelection(PointSelectionData{{pos.x, pos.y}, radius});
 }
 
 SelectionShallowData EngineWorker::getSelectionShallowData(RealVector2D const& refPos)
 {
     EngineWorkerGuard access(this);
-    return _simulationCudaFacade->getSelectionShallowData({refPos.x, refPos.y});
+    return _simulationFacade->getSelectionShallowData({refPos.x, refPos.y});
 }
 
 void EngineWorker::setSelection(RealVector2D const& startPos, RealVector2D const& endPos)
 {
     EngineWorkerGuard access(this);
-    _simulationCudaFacade->setSelection(AreaSelectionData{{startPos.x, startPos.y}, {endPos.x, endPos.y}});
+    _simulationFacade->setSelection(AreaSelectionData{{startPos.x, startPos.y}, {endPos.x, endPos.y}});
 }
 
 void EngineWorker::removeSelection()
 {
     EngineWorkerGuard access(this);
-    _simulationCudaFacade->removeSelection();
+    _simulationFacade->removeSelection();
 }
 
 void EngineWorker::updateSelection()
 {
     EngineWorkerGuard access(this);
-    _simulationCudaFacade->updateSelection();
+    _simulationFacade->updateSelection();
 }
 
 void EngineWorker::shallowUpdateSelectedObjects(ShallowUpdateSelectionData const& updateData)
 {
     EngineWorkerGuard access(this);
-    _simulationCudaFacade->shallowUpdateSelectedObjects(updateData);
+    _simulationFacade->shallowUpdateSelectedObjects(updateData);
 }
 
 void EngineWorker::colorSelectedObjects(unsigned char color, bool includeClusters)
 {
     EngineWorkerGuard access(this);
-    _simulationCudaFacade->colorSelectedObjects(color, includeClusters);
+    _simulationFacade->colorSelectedObjects(color, includeClusters);
 }
 
 void EngineWorker::reconnectSelectedObjects()
 {
     EngineWorkerGuard access(this);
-    _simulationCudaFacade->reconnectSelectedObjects();
+    _simulationFacade->reconnectSelectedObjects();
 }
 
 void EngineWorker::setDetached(bool value)
 {
     EngineWorkerGuard access(this);
-    _simulationCudaFacade->setDetached(value);
+    _simulationFacade->setDetached(value);
 }
 
 void EngineWorker::runThreadLoop()
 {
     try {
-        std::mutex mutexForLoop;
-        std::unique_lock<std::mutex> lockForLoop(mutexForLoop);
-
         while (!_isShutdown.load()) {
 
             if (!_syncSimulationWithRendering && _accessState == 0) {
                 if (_isSimulationRunning.load()) {
-                    _simulationCudaFacade->calcTimestep(1, false);
+                    _simulationFacade->calcTimestep(1, false);
                 }
                 measureTPS();
                 slowdownTPS();
             }
             
-            processJobs();
-
-            if (_accessState == 1) {
-                _accessState = 2;
+            //jobs are only processed while no other thread has access, see EngineWorkerGuard for the remaining case
+            if (_accessState != 2) {
+                processJobs();
             }
+
+            allowAccessAndWaitForWork();
         }
     } catch (std::exception const& e) {
         std::unique_lock<std::mutex> uniqueLock(_exceptionData.mutex);
@@ -487,6 +645,7 @@ void EngineWorker::runThreadLoop()
 void EngineWorker::runSimulation()
 {
     _isSimulationRunning.store(true);
+    notifyWorkerThread();
 }
 
 void EngineWorker::pauseSimulation()
@@ -503,39 +662,88 @@ bool EngineWorker::isSimulationRunning() const
 void EngineWorker::testOnly_mutate(uint64_t cellId, MutationType mutationType)
 {
     EngineWorkerGuard access(this);
-    _simulationCudaFacade->testOnly_mutate(cellId, mutationType);
+    _simulationFacade->testOnly_mutate(cellId, mutationType);
 }
 
-DataTO EngineWorker::provideTO()
+DataTO EngineWorker::provideTO(DataTOBuffer buffer)
 {
-    return _dataTOCache->getDataTO(_simulationCudaFacade->getArraySizes());
+    return _dataTOCache->getDataTO(_simulationFacade->getArraySizes(), buffer);
 }
 
 void EngineWorker::resetTimeIntervalStatistics()
 {
-    _simulationCudaFacade->resetTimeIntervalStatistics();
+    _simulationFacade->resetTimeIntervalStatistics();
 }
 
 void EngineWorker::processJobs()
 {
-    std::unique_lock<std::mutex> asyncJobsLock(_mutexForAsyncJobs);
-    if (_updateGpuSettingsJob) {
-        _simulationCudaFacade->setGpuConstants(*_updateGpuSettingsJob);
-        _updateGpuSettingsJob = std::nullopt;
+    std::optional<GpuSettings> updateGpuSettingsJob;
+    std::vector<ApplyForceJob> applyForceJobs;
+    std::vector<Command> commands;
+    {
+        std::unique_lock<std::mutex> asyncJobsLock(_mutexForAsyncJobs);
+        _hasPendingJobs = false;
+        updateGpuSettingsJob.swap(_updateGpuSettingsJob);
+        applyForceJobs.swap(_applyForceJobs);
+        commands.swap(_commands);
     }
-    if (!_applyForceJobs.empty()) {
-        for (auto const& applyForceJob : _applyForceJobs) {
-            _simulationCudaFacade->applyForce(
-                {{applyForceJob.start.x, applyForceJob.start.y},
-                 {applyForceJob.end.x, applyForceJob.end.y},
-                 {applyForceJob.force.x, applyForceJob.force.y},
-                 applyForceJob.radius,
-                 false});
+
+    if (updateGpuSettingsJob) {
+        _simulationFacade->setGpuConstants(*updateGpuSettingsJob);
+    }
+    for (auto const& applyForceJob : applyForceJobs) {
+        _simulationFacade->applyForce(
+            {{applyForceJob.start.x, applyForceJob.start.y},
+             {applyForceJob.end.x, applyForceJob.end.y},
+             {applyForceJob.force.x, applyForceJob.force.y},
+             applyForceJob.radius,
+             false});
+    }
+
+    //errors of commands are reported to their futures and do not terminate the worker thread
+    for (auto& command : commands) {
+        try {
+            command.function();
+            command.promise.set_value();
+        } catch (...) {
+            command.promise.set_exception(std::current_exception());
         }
-        _applyForceJobs.clear();
     }
 }
 
+std::future<void> EngineWorker::enqueueCommand(std::function<void()> const& function)
+{
+    std::future<void> result;
+    {
+        std::unique_lock<std::mutex> uniqueLock(_mutexForAsyncJobs);
+        auto& command = _commands.emplace_back(Command{function, std::promise<void>()});
+        result = command.promise.get_future();
+        _hasPendingJobs = true;
+    }
+    notifyWorkerThread();
+    return result;
+}
+
+void EngineWorker::changeCellIntern(CellDescription const& changedCell)
+{
+    auto dataTO = provideTO();
+
+    DescriptionConverter converter(_settings.simulationParameters);
+    converter.convertDescriptionToTO(dataTO, changedCell);
+
+    _simulationFacade->changeInspectedSimulationData(dataTO);
+}
+
+void EngineWorker::changeParticleIntern(ParticleDescription const& changedParticle)
+{
+    auto dataTO = provideTO();
+
+    DescriptionConverter converter(_settings.simulationParameters);
+    converter.convertDescriptionToTO(dataTO, changedParticle);
+
+    _simulationFacade->changeInspectedSimulationData(dataTO);
+}
+
 void EngineWorker::syncSimulationWithRenderingIfDesired()
 {
     if (_syncSimulationWithRendering && _isSimulationRunning) {
@@ -549,14 +757,45 @@ void EngineWorker::syncSimulationWithRenderingIfDesired()
 
 void EngineWorker::waitAndAllowAccess(std::chrono::microseconds const& duration)
 {
-    auto startTimepoint = std::chrono::steady_clock::now();
-    while (std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTimepoint) < duration) {
+    auto endTimepoint = std::chrono::steady_clock::now() + duration;
+    std::unique_lock<std::mutex> accessLock(_mutexForAccess);
+    while (!_isShutdown.load()) {
         if (_accessState == 1) {
             _accessState = 2;
+            _accessChanged.notify_all();
+        }
+        if (!_accessChanged.wait_until(accessLock, endTimepoint, [this] { return _accessState == 1 || _isShutdown.load(); })) {
+            break;
         }
     }
 }
 
+void EngineWorker::allowAccessAndWaitForWork()
+{
+    std::unique_lock<std::mutex> accessLock(_mutexForAccess);
+    if (_accessState == 1) {
+        _accessState = 2;
+        _accessChanged.notify_all();
+    }
+
+    //blocks while paused, synchronized with rendering or while another thread has access
+    _accessChanged.wait(accessLock, [this] { return isWorkAvailable(); });
+}
+
+bool EngineWorker::isWorkAvailable() const
+{
+    if (_isShutdown.load() || _accessState == 1 || (_hasPendingJobs.load() && _accessState != 2)) {
+        return true;
+    }
+    return _accessState == 0 && _isSimulationRunning.load() && !_syncSimulationWithRendering;
+}
+
+void EngineWorker::notifyWorkerThread()
+{
+    std::unique_lock<std::mutex> accessLock(_mutexForAccess);
+    _accessChanged.notify_all();
+}
+
 void EngineWorker::measureTPS()
 {
     if (_isSimulationRunning.load()) {
@@ -606,29 +845,31 @@ EngineWorkerGuard::EngineWorkerGuard(EngineWorker* worker, std::optional<std::ch
 {
     checkForException(worker->_exceptionData);
 
+    std::unique_lock<std::mutex> accessLock(worker->_mutexForAccess);
     worker->_accessState = 1;
-
-    auto startTimepoint = std::chrono::steady_clock::now();
-    while (worker->_accessState == 1) {
-        auto timePassed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTimepoint);
-        if (maxDuration) {
-            if (timePassed > *maxDuration) {
-                _isTimeout = true;
-                break;
-            }
-        } else {
-            if (timePassed > std::chrono::seconds(7)) {
-                _isTimeout = true;
-                throw std::runtime_error("GPU worker thread is not reachable.");
-            }
+    worker->_accessChanged.notify_all();
+
+    auto timeout = maxDuration ? std::chrono::duration_cast<std::chrono::microseconds>(*maxDuration) : std::chrono::microseconds(std::chrono::seconds(7));
+    if (!worker->_accessChanged.wait_for(accessLock, timeout, [worker] { return worker->_accessState != 1; })) {
+        _isTimeout = true;
+        if (!maxDuration) {
+            worker->_accessState = 0;
+            worker->_accessChanged.notify_all();
+            throw std::runtime_error("GPU worker thread is not reachable.");
         }
+        return;
     }
+    accessLock.unlock();
 
+    //queued commands are applied before the access so that callers observe their own preceding changes
+    worker->processJobs();
 }
 
 EngineWorkerGuard::~EngineWorkerGuard()
 {
+    std::unique_lock<std::mutex> accessLock(_worker->_mutexForAccess);
     _worker->_accessState = 0;
+    _worker->_accessChanged.notify_all();
 }
 
 bool EngineWorkerGuard::isTimeout() const
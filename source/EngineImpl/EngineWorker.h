@@ -3,6 +3,8 @@
 #include <atomic>
 #include <mutex>
 #include <condition_variable>
+#include <functional>
+#include <future>
 
 #if defined(_WIN32)
 #include <windows.h>
@@ -12,6 +14,7 @@
 #include "Base/Definitions.h"
 
 #include "EngineInterface/Definitions.h"
+#include "EngineInterface/EngineBackend.h"
 #include "EngineInterface/SimulationParameters.h"
 #include "EngineInterface/GpuSettings.h"
 #include "EngineInterface/RawStatisticsData.h"
@@ -21,6 +24,7 @@
 #include "EngineInterface/ShallowUpdateSelectionData.h"
 #include "EngineInterface/MutationType.h"
 #include "EngineInterface/StatisticsHistory.h"
+#include "EngineInterface/ProfilingHistory.h"
 
 #include "EngineGpuKernels/Definitions.h"
 
@@ -38,7 +42,8 @@ class EngineWorker
 {
     friend class EngineWorkerGuard;
 public:
-    void newSimulation(uint64_t timestep, GeneralSettings const& generalSettings, SimulationParameters const& parameters);
+    void newSimulation(uint64_t timestep, GeneralSettings const& generalSettings, SimulationParameters const& parameters, EngineBackend backend);
+    EngineBackend getEngineBackend() const;
     void clear();
 
     void setImageResource(void* image);
@@ -61,10 +66,17 @@ public:
     RawStatisticsData getRawStatistics() const;
     StatisticsHistory const& getStatisticsHistory() const;
     void setStatisticsHistory(StatisticsHistoryData const& data);
+    bool isProfilingEnabled() const;
+    void setProfilingEnabled(bool value);
+    ProfilingData getProfilingData() const;
 
     void addAndSelectSimulationData(DataDescription const& dataToUpdate);
     void setClusteredSimulationData(ClusteredDataDescription const& dataToUpdate);
     void setSimulationData(DataDescription const& dataToUpdate);
+    void setDuplicatedSimulationData(ClusteredDataDescription const& dataToUpdate, IntVector2D const& origWorldSize);
+    void setColumnarSimulationData(ColumnarDataReader const& reader);
+    void saveRawSnapshot(std::string const& filename);
+    void loadRawSnapshot(std::string const& filename);
     void removeSelectedObjects(bool includeClusters);
     void relaxSelectedObjects(bool includeClusters);
     void uniformVelocitiesForSelectedObjects(bool includeClusters);
@@ -74,6 +86,19 @@ public:
     void changeCell(CellDescription const& changedCell);
     void changeParticle(ParticleDescription const& changedParticle);
 
+    //queued variants: the commands are applied together at the next time step boundary or before the next guarded access
+    std::future<void> removeSelectedObjects_async(bool includeClusters);
+    std::future<void> relaxSelectedObjects_async(bool includeClusters);
+    std::future<void> uniformVelocitiesForSelectedObjects_async(bool includeClusters);
+    std::future<void> makeSticky_async(bool includeClusters);
+    std::future<void> removeStickiness_async(bool includeClusters);
+    std::future<void> setBarrier_async(bool value, bool includeClusters);
+    std::future<void> colorSelectedObjects_async(unsigned char color, bool includeClusters);
+    std::future<void> reconnectSelectedObjects_async();
+    std::future<void> setDetached_async(bool value);
+    std::future<void> changeCell_async(CellDescription const& changedCell);
+    std::future<void> changeParticle_async(ParticleDescription const& changedParticle);
+
     void calcTimesteps(uint64_t timesteps);
     void applyCataclysm(int power);
 
@@ -113,17 +138,24 @@ public:
     void testOnly_mutate(uint64_t cellId, MutationType mutationType);
 
 private:
-    DataTO provideTO(); 
+    DataTO provideTO(DataTOBuffer buffer = DataTOBuffer_DataAccess);
     void resetTimeIntervalStatistics();
     void updateStatistics(bool afterMinDuration = false);
     void processJobs();
+    std::future<void> enqueueCommand(std::function<void()> const& function);
+    void changeCellIntern(CellDescription const& changedCell);
+    void changeParticleIntern(ParticleDescription const& changedParticle);
 
     void syncSimulationWithRenderingIfDesired();
     void waitAndAllowAccess(std::chrono::microseconds const& duration);
+    void allowAccessAndWaitForWork();
+    bool isWorkAvailable() const;
+    void notifyWorkerThread();
     void measureTPS();
     void slowdownTPS();
 
-    CudaSimulationFacade _simulationCudaFacade;
+    EngineBackend _backend = EngineBackend_Gpu;
+    SimulationFacade _simulationFacade;
 
     //settings
     Settings _settings;
@@ -134,9 +166,12 @@ private:
     std::atomic<int> _accessState{0};  //0 = worker thread has access, 1 = require access from other thread, 2 = access granted to other thread
     std::atomic<bool> _isSimulationRunning{false};
     std::atomic<bool> _isShutdown{false};
+    std::mutex _mutexForAccess;
+    std::condition_variable _accessChanged;  //notified on every change that could end a wait of the worker thread or of a guard
     ExceptionData _exceptionData;
 
     //async jobs
+    std::atomic<bool> _hasPendingJobs{false};
     mutable std::mutex _mutexForAsyncJobs;
     std::optional<GpuSettings> _updateGpuSettingsJob;
     std::optional<GLuint> _imageResource;
@@ -150,6 +185,13 @@ private:
     };
     std::vector<ApplyForceJob> _applyForceJobs;
 
+    struct Command
+    {
+        std::function<void()> function;
+        std::promise<void> promise;
+    };
+    std::vector<Command> _commands;
+
     //time step measurements
     std::atomic<int> _tpsRestriction{0};  //0 = no restriction
     std::atomic<float> _tps;
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include <vector_types.h>
+
+#include "Base/ThreadPool.h"
+
+/**
+ * Execution policy for shared host/device code on the host, see EngineGpuKernels/HostDevice.cuh.
+ * forEach must not be called from a job of the thread pool.
+ *
+ * The order of floating point additions by atomicAdd depends on the thread scheduling. SequentialExecution processes the
+ * entities in index order instead and is used for bit-reproducible time steps.
+ */
+struct HostExecution
+{
+    static void atomicAdd(float* address, float value) { std::atomic_ref<float>(*address).fetch_add(value, std::memory_order_relaxed); }
+
+    static void atomicAdd(uint64_t* address, uint64_t value) { std::atomic_ref<uint64_t>(*address).fetch_add(value, std::memory_order_relaxed); }
+
+    static void atomicAdd(float2* address, float2 const& value)
+    {
+        atomicAdd(&address->x, value.x);
+        atomicAdd(&address->y, value.y);
+    }
+
+    template <typename Func>
+    static void forEach(int numEntities, Func const& func)
+    {
+        ThreadPool::getInstance().parallelFor(0, static_cast<size_t>(numEntities), [&func](size_t index) { func(static_cast<int>(index)); });
+    }
+};
+
+struct SequentialExecution
+{
+    static void atomicAdd(float* address, float value) { *address += value; }
+
+    static void atomicAdd(uint64_t* address, uint64_t value) { *address += value; }
+
+    static void atomicAdd(float2* address, float2 const& value)
+    {
+        address->x += value.x;
+        address->y += value.y;
+    }
+
+    template <typename Func>
+    static void forEach(int numEntities, Func const& func)
+    {
+        for (int index = 0; index < numEntities; ++index) {
+            func(index);
+        }
+    }
+};
@@ -1,13 +1,19 @@
 #include "SimulationControllerImpl.h"
 
+#include "Base/NumberGenerator.h"
 #include "EngineInterface/Descriptions.h"
 
-void _SimulationControllerImpl::newSimulation(uint64_t timestep, GeneralSettings const& generalSettings, SimulationParameters const& parameters)
+void _SimulationControllerImpl::newSimulation(
+    uint64_t timestep,
+    GeneralSettings const& generalSettings,
+    SimulationParameters const& parameters,
+    EngineBackend backend)
 {
     _generalSettings = generalSettings;
     _origSettings.generalSettings = generalSettings;
     _origSettings.simulationParameters = parameters;
-    _worker.newSimulation(timestep, generalSettings, parameters);
+    NumberGenerator::getInstance().setSeed(generalSettings.seed);
+    _worker.newSimulation(timestep, generalSettings, parameters, backend);
 
     _thread = new std::thread(&EngineWorker::runThreadLoop, &_worker);
 
@@ -18,6 +24,11 @@ void _SimulationControllerImpl::newSimulation(uint64_t timestep, GeneralSettings
     ++_sessionId;
 }
 
+EngineBackend _SimulationControllerImpl::getEngineBackend() const
+{
+    return _worker.getEngineBackend();
+}
+
 int _SimulationControllerImpl::getSessionId() const
 {
     return _sessionId;
@@ -124,6 +135,29 @@ void _SimulationControllerImpl::setSimulationData(DataDescription const& dataToU
     _selectionNeedsUpdate = true;
 }
 
+void _SimulationControllerImpl::setDuplicatedSimulationData(ClusteredDataDescription const& dataToUpdate, IntVector2D const& origWorldSize)
+{
+    _worker.setDuplicatedSimulationData(dataToUpdate, origWorldSize);
+    _selectionNeedsUpdate = true;
+}
+
+void _SimulationControllerImpl::setColumnarSimulationData(ColumnarDataReader const& reader)
+{
+    _worker.setColumnarSimulationData(reader);
+    _selectionNeedsUpdate = true;
+}
+
+void _SimulationControllerImpl::saveRawSnapshot(std::string const& filename)
+{
+    _worker.saveRawSnapshot(filename);
+}
+
+void _SimulationControllerImpl::loadRawSnapshot(std::string const& filename)
+{
+    _worker.loadRawSnapshot(filename);
+    _selectionNeedsUpdate = true;
+}
+
 void _SimulationControllerImpl::removeSelectedObjects(bool includeClusters)
 {
     _worker.removeSelectedObjects(includeClusters);
@@ -180,6 +214,63 @@ void _SimulationControllerImpl::changeParticle(ParticleDescription const& change
     _worker.changeParticle(changedParticle);
 }
 
+std::future<void> _SimulationControllerImpl::removeSelectedObjects_async(bool includeClusters)
+{
+    auto result = _worker.removeSelectedObjects_async(includeClusters);
+    _selectionNeedsUpdate = true;
+    return result;
+}
+
+std::future<void> _SimulationControllerImpl::relaxSelectedObjects_async(bool includeClusters)
+{
+    return _worker.relaxSelectedObjects_async(includeClusters);
+}
+
+std::future<void> _SimulationControllerImpl::uniformVelocitiesForSelectedObjects_async(bool includeClusters)
+{
+    return _worker.uniformVelocitiesForSelectedObjects_async(includeClusters);
+}
+
+std::future<void> _SimulationControllerImpl::makeSticky_async(bool includeClusters)
+{
+    return _worker.makeSticky_async(includeClusters);
+}
+
+std::future<void> _SimulationControllerImpl::removeStickiness_async(bool includeClusters)
+{
+    return _worker.removeStickiness_async(includeClusters);
+}
+
+std::future<void> _SimulationControllerImpl::setBarrier_async(bool value, bool includeClusters)
+{
+    return _worker.setBarrier_async(value, includeClusters);
+}
+
+std::future<void> _SimulationControllerImpl::colorSelectedObjects_async(unsigned char color, bool includeClusters)
+{
+    return _worker.colorSelectedObjects_async(color, includeClusters);
+}
+
+std::future<void> _SimulationControllerImpl::reconnectSelectedObjects_async()
+{
+    return _worker.reconnectSelectedObjects_async();
+}
+
+std::future<void> _SimulationControllerImpl::setDetached_async(bool value)
+{
+    return _worker.setDetached_async(value);
+}
+
+std::future<void> _SimulationControllerImpl::changeCell_async(CellDescription const& changedCell)
+{
+    return _worker.changeCell_async(changedCell);
+}
+
+std::future<void> _SimulationControllerImpl::changeParticle_async(ParticleDescription const& changedParticle)
+{
+    return _worker.changeParticle_async(changedParticle);
+}
+
 void _SimulationControllerImpl::calcTimesteps(uint64_t timesteps)
 {
     _worker.calcTimesteps(timesteps);
@@ -357,6 +448,21 @@ void _SimulationControllerImpl::setStatisticsHistory(StatisticsHistoryData const
     _worker.setStatisticsHistory(data);
 }
 
+bool _SimulationControllerImpl::isProfilingEnabled() const
+{
+    return _worker.isProfilingEnabled();
+}
+
+void _SimulationControllerImpl::setProfilingEnabled(bool value)
+{
+    _worker.setProfilingEnabled(value);
+}
+
+ProfilingData _SimulationControllerImpl::getProfilingData() const
+{
+    return _worker.getProfilingData();
+}
+
 std::optional<int> _SimulationControllerImpl::getTpsRestriction() const
 {
     auto result = _worker.getTpsRestriction();
@@ -16,7 +16,8 @@
 class _SimulationControllerImpl : public _SimulationController
 {
 public:
-    void newSimulation(uint64_t timestep, GeneralSettings const& generalSettings, SimulationParameters const& parameters) override;
+    void newSimulation(uint64_t timestep, GeneralSettings const& generalSettings, SimulationParameters const& parameters, EngineBackend backend) override;
+    EngineBackend getEngineBackend() const override;
     int getSessionId() const override;
 
     void clear() override;
@@ -54,6 +55,10 @@ public:
     void addAndSelectSimulationData(DataDescription const& dataToAdd) override;
     void setClusteredSimulationData(ClusteredDataDescription const& dataToUpdate) override;
     void setSimulationData(DataDescription const& dataToUpdate) override;
+    void setDuplicatedSimulationData(ClusteredDataDescription const& dataToUpdate, IntVector2D const& origWorldSize) override;
+    void setColumnarSimulationData(ColumnarDataReader const& reader) override;
+    void saveRawSnapshot(std::string const& filename) override;
+    void loadRawSnapshot(std::string const& filename) override;
     void removeSelectedObjects(bool includeClusters) override;
     void relaxSelectedObjects(bool includeClusters) override;
     void uniformVelocitiesForSelectedObjects(bool includeClusters) override;
@@ -65,6 +70,17 @@ public:
     void setDetached(bool value) override;
     void changeCell(CellDescription const& changedCell) override;
     void changeParticle(ParticleDescription const& changedParticle) override;
+    std::future<void> removeSelectedObjects_async(bool includeClusters) override;
+    std::future<void> relaxSelectedObjects_async(bool includeClusters) override;
+    std::future<void> uniformVelocitiesForSelectedObjects_async(bool includeClusters) override;
+    std::future<void> makeSticky_async(bool includeClusters) override;
+    std::future<void> removeStickiness_async(bool includeClusters) override;
+    std::future<void> setBarrier_async(bool value, bool includeClusters) override;
+    std::future<void> colorSelectedObjects_async(unsigned char color, bool includeClusters) override;
+    std::future<void> reconnectSelectedObjects_async() override;
+    std::future<void> setDetached_async(bool value) override;
+    std::future<void> changeCell_async(CellDescription const& changedCell) override;
+    std::future<void> changeParticle_async(ParticleDescription const& changedParticle) override;
 
     void calcTimesteps(uint64_t timesteps) override;
     void runSimulation() override;
@@ -106,6 +122,10 @@ public:
     StatisticsHistory const& getStatisticsHistory() const override;
     void setStatisticsHistory(StatisticsHistoryData const& data) override;
 
+    bool isProfilingEnabled() const override;
+    void setProfilingEnabled(bool value) override;
+    ProfilingData getProfilingData() const override;
+
     std::optional<int> getTpsRestriction() const override;
     void setTpsRestriction(std::optional<int> const& value) override;
 
@@ -0,0 +1,1447 @@
+#include "SimulationCpuFacade.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <deque>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "Base/LoggingService.h"
+#include "Base/ThreadPool.h"
+#include "EngineGpuKernels/CellForces.cuh"
+#include "EngineGpuKernels/Math.cuh"
+#include "EngineGpuKernels/StatisticsService.cuh"
+
+#include "HostExecution.h"
+
+namespace
+{
+    std::chrono::milliseconds const StatisticsUpdate(30);
+
+    bool isConnected(CellTO const& cell, int otherIndex)
+    {
+        for (int i = 0; i < cell.numConnections; ++i) {
+            if (cell.connections[i].cellIndex == otherIndex) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void offsetAuxiliaryDataIndices(CellTO& cell, uint64_t offset)
+    {
+        cell.metadata.nameDataIndex += offset;
+        cell.metadata.descriptionDataIndex += offset;
+        if (cell.cellFunction == CellFunction_Neuron) {
+            cell.cellFunctionData.neuron.weightsAndBiasesDataIndex += offset;
+        }
+        if (cell.cellFunction == CellFunction_Constructor) {
+            cell.cellFunctionData.constructor.genomeDataIndex += offset;
+        }
+        if (cell.cellFunction == CellFunction_Injector) {
+            cell.cellFunctionData.injector.genomeDataIndex += offset;
+        }
+    }
+
+    bool isCellFunctionSupported(CellTO const& cell)
+    {
+        return cell.cellFunction == CellFunction_None || cell.cellFunction == CellFunction_Nerve || cell.cellFunction == CellFunction_Neuron;
+    }
+
+    bool isFlowDirectionLegacyMode(SimulationParameters const& parameters)
+    {
+        return parameters.features.legacyModes && parameters.legacyCellDirectionalConnection;
+    }
+
+    //see CellFunctionProcessor::calcInputActivity
+    ActivityTO calcInputActivity(std::vector<CellTO> const& cells, CellTO const& cell, SimulationParameters const& parameters)
+    {
+        ActivityTO result;
+        result.origin = ActivityOrigin_Unknown;
+        result.targetX = 0;
+        result.targetY = 0;
+        for (int i = 0; i < MAX_CHANNELS; ++i) {
+            result.channels[i] = 0;
+        }
+
+        if (cell.inputExecutionOrderNumber == -1 || cell.inputExecutionOrderNumber == cell.executionOrderNumber) {
+            return result;
+        }
+        for (int i = 0; i < cell.numConnections; ++i) {
+            auto const& connectedCell = cells[cell.connections[i].cellIndex];
+            if (connectedCell.outputBlocked || connectedCell.livingState != LivingState_Ready) {
+                continue;
+            }
+            if (!isFlowDirectionLegacyMode(parameters) && connectedCell.inputExecutionOrderNumber == cell.executionOrderNumber
+                && connectedCell.executionOrderNumber > cell.executionOrderNumber && !cell.outputBlocked) {
+                continue;
+            }
+            if (connectedCell.executionOrderNumber == cell.inputExecutionOrderNumber) {
+                for (int j = 0; j < MAX_CHANNELS; ++j) {
+                    result.channels[j] += connectedCell.activity.channels[j];
+                    result.channels[j] = std::max(-1000000.0f, std::min(1000000.0f, result.channels[j]));  //truncate value to avoid overflow
+                }
+                if (connectedCell.activity.origin == ActivityOrigin_Sensor) {
+                    result.origin = ActivityOrigin_Sensor;
+                    result.targetX = connectedCell.activity.targetX;
+                    result.targetY = connectedCell.activity.targetY;
+                }
+            }
+        }
+        return result;
+    }
+
+    void updateInvocationState(CellTO& cell, ActivityTO const& activity)
+    {
+        if (cell.cellFunctionUsed == CellFunctionUsed_No) {
+            for (int i = 0; i < MAX_CHANNELS - 1; ++i) {
+                if (activity.channels[i] != 0) {
+                    cell.cellFunctionUsed = CellFunctionUsed_Yes;
+                    break;
+                }
+            }
+        }
+    }
+
+    //see NeuronProcessor::applyActivationFunction
+    float applyActivationFunction(NeuronActivationFunction activationFunction, float x)
+    {
+        switch (activationFunction) {
+        case NeuronActivationFunction_Sigmoid:
+            return 2.0f / (1.0f + expf(-x)) - 1.0f;
+        case NeuronActivationFunction_BinaryStep:
+            return x >= NEAR_ZERO ? 1.0f : 0.0f;
+        case NeuronActivationFunction_Identity:
+            return std::max(-1.0f, std::min(1.0f, x));
+        case NeuronActivationFunction_Abs:
+            return std::min(1.0f, std::abs(x));
+        case NeuronActivationFunction_Gaussian:
+            return expf(-2 * x * x);
+        }
+        return 0;
+    }
+
+    //removes a connection and keeps the angles of the remaining connections
+    void removeConnection(CellTO& cell, int connectionIndex)
+    {
+        auto numConnections = cell.numConnections;
+        if (numConnections > 1) {
+            auto nextIndex = (connectionIndex + 1) % numConnections;
+            cell.connections[nextIndex].angleFromPrevious += cell.connections[connectionIndex].angleFromPrevious;
+        }
+        for (int i = connectionIndex; i < numConnections - 1; ++i) {
+            cell.connections[i] = cell.connections[i + 1];
+        }
+        --cell.numConnections;
+    }
+
+    struct HostCellAccess
+    {
+        using Handle = int;
+
+        std::vector<CellTO> const& cells;
+        std::vector<float2>& forces;
+        float2 worldSize;
+
+        int getNumConnections(int cell) const { return cells[cell].numConnections; }
+        int getConnectedCell(int cell, int connectionIndex) const { return cells[cell].connections[connectionIndex].cellIndex; }
+        float getBondDistance(int cell, int connectionIndex) const { return cells[cell].connections[connectionIndex].distance; }
+        float getAngleFromPrevious(int cell, int connectionIndex) const { return cells[cell].connections[connectionIndex].angleFromPrevious; }
+        float2 getPos(int cell) const { return cells[cell].pos; }
+        float getStiffness(int cell) const { return cells[cell].stiffness; }
+        bool isBarrier(int cell) const { return cells[cell].barrier; }
+        float2* getForce(int cell) const { return &forces[cell]; }
+        void correctDirection(float2& direction) const
+        {
+            direction.x = remainderf(direction.x, worldSize.x);
+            direction.y = remainderf(direction.y, worldSize.y);
+        }
+    };
+}
+
+_SimulationCpuFacade::_SimulationCpuFacade(uint64_t timestep, Settings const& settings)
+    : _settings(settings)
+    , _timestep(timestep)
+    , _cellGrid({settings.generalSettings.worldSizeX, settings.generalSettings.worldSizeY})
+    , _phaseCounters(CpuPhase_Count)
+{
+    _phaseCounters[CpuPhase_Physics].name = "physics";
+    _phaseCounters[CpuPhase_CellFunctionPreparation].name = "cell function preparation";
+    _phaseCounters[CpuPhase_Nerve].name = "nerve";
+    _phaseCounters[CpuPhase_Neuron].name = "neuron";
+    _phaseCounters[CpuPhase_Friction].name = "friction";
+
+    _statisticsService = std::make_shared<_StatisticsService>();
+    _statisticsService->resetTime(_statisticsHistory, timestep);
+    log(Priority::Important, "CPU backend with " + std::to_string(ThreadPool::getInstance().getNumThreads()) + " threads selected");
+}
+
+std::string _SimulationCpuFacade::getDeviceName() const
+{
+    return "CPU (" + std::to_string(ThreadPool::getInstance().getNumThreads()) + " threads)";
+}
+
+void* _SimulationCpuFacade::registerImageResource(GLuint image)
+{
+    throw std::runtime_error("Rendering is not supported by the CPU backend.");
+}
+
+void _SimulationCpuFacade::calcTimestep(uint64_t timesteps, bool forceUpdateStatistics)
+{
+    for (uint64_t i = 0; i < timesteps; ++i) {
+        checkAndProcessSimulationParameterChanges();
+
+        {
+            std::lock_guard lock(_mutexForSimulationData);
+            calcTimestepIntern();
+            ++_timestep;
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        if (!_lastStatisticsUpdateTime || now - *_lastStatisticsUpdateTime > StatisticsUpdate) {
+            _lastStatisticsUpdateTime = now;
+            updateStatistics();
+        }
+    }
+    if (forceUpdateStatistics) {
+        updateStatistics();
+    }
+}
+
+void _SimulationCpuFacade::applyCataclysm(int power)
+{
+    throw std::runtime_error("Cataclysms are not supported by the CPU backend.");
+}
+
+void _SimulationCpuFacade::drawVectorGraphics(float2 const& rectUpperLeft, float2 const& rectLowerRight, void* cudaResource, int2 const& imageSize, double zoom)
+{
+    throw std::runtime_error("Rendering is not supported by the CPU backend.");
+}
+
+void _SimulationCpuFacade::getSimulationData(int2 const& rectUpperLeft, int2 const& rectLowerRight, DataTO const& dataTO)
+{
+    auto isContainedInRect = [&](float2 pos) {
+        correctPosition(pos);
+        return pos.x >= rectUpperLeft.x && pos.x <= rectLowerRight.x && pos.y >= rectUpperLeft.y && pos.y <= rectLowerRight.y;
+    };
+    copyToDataTO(
+        dataTO, [&](CellTO const& cell) { return isContainedInRect(cell.pos); }, [&](ParticleTO const& particle) { return isContainedInRect(particle.pos); });
+}
+
+void _SimulationCpuFacade::getSelectedSimulationData(bool includeClusters, DataTO const& dataTO)
+{
+    copyToDataTO(
+        dataTO,
+        [&](CellTO const& cell) { return isSelected(cell, includeClusters); },
+        [&](ParticleTO const& particle) { return particle.selected != 0; });
+}
+
+void _SimulationCpuFacade::getInspectedSimulationData(std::vector<uint64_t> entityIds, DataTO const& dataTO)
+{
+    std::unordered_set<uint64_t> ids(entityIds.begin(), entityIds.end());
+    copyToDataTO(
+        dataTO, [&](CellTO const& cell) { return ids.contains(cell.id); }, [&](ParticleTO const& particle) { return ids.contains(particle.id); });
+}
+
+void _SimulationCpuFacade::getOverlayData(int2 const& rectUpperLeft, int2 const& rectLowerRight, DataTO const& dataTO)
+{
+    getSimulationData(rectUpperLeft, rectLowerRight, dataTO);
+}
+
+void _SimulationCpuFacade::addAndSelectSimulationData(DataTO const& dataTO)
+{
+    std::lock_guard lock(_mutexForSimulationData);
+    for (auto& cell : _cells) {
+        cell.selected = 0;
+    }
+    for (auto& particle : _particles) {
+        particle.selected = 0;
+    }
+    addFromDataTO(dataTO, true, true);
+}
+
+void _SimulationCpuFacade::setSimulationData(DataTO const& dataTO)
+{
+    {
+        std::lock_guard lock(_mutexForSimulationData);
+        _cells.clear();
+        _particles.clear();
+        _auxiliaryData.clear();
+        _densities.clear();
+        _prevForces.clear();
+        addFromDataTO(dataTO, false, false);
+    }
+    updateStatistics();
+}
+
+void _SimulationCpuFacade::removeSelectedObjects(bool includeClusters)
+{
+    removeObjects(
+        [&](CellTO const& cell) { return isSelected(cell, includeClusters); }, [](ParticleTO const& particle) { return particle.selected != 0; });
+}
+
+void _SimulationCpuFacade::relaxSelectedObjects(bool includeClusters)
+{
+    std::lock_guard lock(_mutexForSimulationData);
+    for (auto& cell : _cells) {
+        if (!isSelected(cell, includeClusters)) {
+            continue;
+        }
+        auto numConnections = cell.numConnections;
+        for (int i = 0; i < numConnections; ++i) {
+            auto const& connectedCell = _cells.at(cell.connections[i].cellIndex);
+            if (isSelected(connectedCell, includeClusters)) {
+                auto delta = connectedCell.pos - cell.pos;
+                correctDirection(delta);
+                cell.connections[i].distance = Math::length(delta);
+            }
+        }
+        if (numConnections > 1) {
+            for (int i = 0; i < numConnections; ++i) {
+                auto const& prevConnectedCell = _cells.at(cell.connections[(i + numConnections - 1) % numConnections].cellIndex);
+                auto const& connectedCell = _cells.at(cell.connections[i].cellIndex);
+                if (isSelected(connectedCell, includeClusters) && isSelected(prevConnectedCell, includeClusters)) {
+                    auto prevDisplacement = prevConnectedCell.pos - cell.pos;
+                    correctDirection(prevDisplacement);
+                    auto displacement = connectedCell.pos - cell.pos;
+                    correctDirection(displacement);
+                    cell.connections[i].angleFromPrevious = Math::subtractAngle(Math::angleOfVector(displacement), Math::angleOfVector(prevDisplacement));
+                }
+            }
+        }
+    }
+}
+
+void _SimulationCpuFacade::uniformVelocitiesForSelectedObjects(bool includeClusters)
+{
+    std::lock_guard lock(_mutexForSimulationData);
+    float2 velocity{0, 0};
+    int numEntities = 0;
+    for (auto const& cell : _cells) {
+        if (isSelected(cell, includeClusters)) {
+            velocity += cell.vel;
+            ++numEntities;
+        }
+    }
+    for (auto const& particle : _particles) {
+        if (particle.selected != 0) {
+            velocity += particle.vel;
+            ++numEntities;
+        }
+    }
+    if (numEntities == 0) {
+        return;
+    }
+    velocity = velocity / toFloat(numEntities);
+    for (auto& cell : _cells) {
+        if (isSelected(cell, includeClusters)) {
+            cell.vel = velocity;
+        }
+    }
+    for (auto& particle : _particles) {
+        if (particle.selected != 0) {
+            particle.vel = velocity;
+        }
+    }
+}
+
+void _SimulationCpuFacade::makeSticky(bool includeClusters)
+{
+    std::lock_guard lock(_mutexForSimulationData);
+    for (auto& cell : _cells) {
+        if (isSelected(cell, includeClusters)) {
+            cell.maxConnections = MAX_CELL_BONDS;
+        }
+    }
+}
+
+void _SimulationCpuFacade::removeStickiness(bool includeClusters)
+{
+    std::lock_guard lock(_mutexForSimulationData);
+    for (auto& cell : _cells) {
+        if (isSelected(cell, includeClusters)) {
+            cell.maxConnections = cell.numConnections;
+        }
+    }
+}
+
+void _SimulationCpuFacade::setBarrier(bool value, bool includeClusters)
+{
+    std::lock_guard lock(_mutexForSimulationData);
+    for (auto& cell : _cells) {
+        if (isSelected(cell, includeClusters)) {
+            cell.barrier = value;
+        }
+    }
+}
+
+void _SimulationCpuFacade::changeInspectedSimulationData(DataTO const& changeDataTO)
+{
+    std::lock_guard lock(_mutexForSimulationData);
+    auto auxiliaryDataOffset = _auxiliaryData.size();
+    _auxiliaryData.insert(_auxiliaryData.end(), changeDataTO.auxiliaryData, changeDataTO.auxiliaryData + *changeDataTO.numAuxiliaryData);
+    _capacities.auxiliaryDataSize = std::max<uint64_t>(_capacities.auxiliaryDataSize, _auxiliaryData.size());
+
+    if (*changeDataTO.numCells == 1) {
+        auto changedCell = changeDataTO.cells[0];
+        offsetAuxiliaryDataIndices(changedCell, auxiliaryDataOffset);
+        for (auto& cell : _cells) {
+            if (cell.id == changedCell.id) {
+                auto connections = std::to_array(cell.connections);
+                auto numConnections = cell.numConnections;
+                auto selected = cell.selected;
+                cell = changedCell;
+                std::copy(connections.begin(), connections.end(), cell.connections);
+                cell.numConnections = numConnections;
+                cell.selected = selected;
+            }
+        }
+    }
+    if (*changeDataTO.numParticles == 1) {
+        auto const& changedParticle = changeDataTO.particles[0];
+        for (auto& particle : _particles) {
+            if (particle.id == changedParticle.id) {
+                auto selected = particle.selected;
+                particle = changedParticle;
+                particle.selected = selected;
+            }
+        }
+    }
+
+    //the previous data of the changed cell are no longer referenced
+    compactAuxiliaryData();
+}
+
+void _SimulationCpuFacade::applyForce(ApplyForceData const& applyData)
+{
+    std::lock_guard lock(_mutexForSimulationData);
+    for (auto& cell : _cells) {
+        auto delta = cell.pos - applyData.startPos;
+        correctDirection(delta);
+        auto pos = applyData.startPos + delta;
+        if (Math::calcDistanceToLineSegment(applyData.startPos, applyData.endPos, pos, applyData.radius) < applyData.radius && !cell.barrier) {
+            cell.vel += applyData.force;
+        }
+    }
+    for (auto& particle : _particles) {
+        if (Math::calcDistanceToLineSegment(applyData.startPos, applyData.endPos, particle.pos, applyData.radius) < applyData.radius) {
+            particle.vel += applyData.force;
+        }
+    }
+}
+
+void _SimulationCpuFacade::switchSelection(PointSelectionData const& switchData)
+{
+    {
+        std::lock_guard lock(_mutexForSimulationData);
+        auto isInRadius = [&](float2 const& pos) {
+            auto delta = pos - switchData.pos;
+            correctDirection(delta);
+            return Math::length(delta) < switchData.radius;
+        };
+        for (auto const& cell : _cells) {
+            if (cell.selected != 0 && isInRadius(cell.pos)) {
+                return;
+            }
+        }
+        for (auto const& particle : _particles) {
+            if (particle.selected != 0 && isInRadius(particle.pos)) {
+                return;
+            }
+        }
+        for (auto& cell : _cells) {
+            cell.selected = isInRadius(cell.pos) ? 1 : 0;
+        }
+        for (auto& particle : _particles) {
+            particle.selected = isInRadius(particle.pos) ? 1 : 0;
+        }
+    }
+    updateSelection();
+}
+
+void _SimulationCpuFacade::swapSelection(PointSelectionData const& selectionData)
+{
+    {
+        std::lock_guard lock(_mutexForSimulationData);
+        auto isInRadius = [&](float2 const& pos) {
+            auto delta = pos - selectionData.pos;
+            correctDirection(delta);
+            return Math::length(delta) < selectionData.radius;
+        };
+        for (auto& cell : _cells) {
+            if (isInRadius(cell.pos)) {
+                if (cell.selected == 0) {
+                    cell.selected = 1;
+                } else if (cell.selected == 1) {
+                    cell.selected = 0;
+                }
+            }
+        }
+        for (auto& particle : _particles) {
+            if (isInRadius(particle.pos)) {
+                particle.selected = 1 - particle.selected;
+            }
+        }
+    }
+    updateSelection();
+}
+
+void _SimulationCpuFacade::setSelection(AreaSelectionData const& selectionData)
+{
+    {
+        std::lock_guard lock(_mutexForSimulationData);
+        auto worldSizeX = toFloat(_settings.generalSettings.worldSizeX);
+        auto worldSizeY = toFloat(_settings.generalSettings.worldSizeY);
+        auto isInArea = [&](float2 const& pos) {
+            return Math::isInBetweenModulo(selectionData.startPos.x, selectionData.endPos.x, pos.x, worldSizeX)
+                && Math::isInBetweenModulo(selectionData.startPos.y, selectionData.endPos.y, pos.y, worldSizeY);
+        };
+        for (auto& cell : _cells) {
+            cell.selected = isInArea(cell.pos) ? 1 : 0;
+        }
+        for (auto& particle : _particles) {
+            particle.selected = isInArea(particle.pos) ? 1 : 0;
+        }
+    }
+    updateSelection();
+}
+
+SelectionShallowData _SimulationCpuFacade::getSelectionShallowData(float2 const& refPos)
+{
+    std::lock_guard lock(_mutexForSimulationData);
+    SelectionShallowData result;
+    float2 centerPos{0, 0};
+    float2 centerVel{0, 0};
+    float2 clusterCenterPos{0, 0};
+    float2 clusterCenterVel{0, 0};
+    auto getPosRelativeToRef = [&](float2 const& pos) {
+        auto delta = pos - refPos;
+        correctDirection(delta);
+        return delta;
+    };
+    for (auto const& cell : _cells) {
+        if (cell.selected == 0) {
+            continue;
+        }
+        auto pos = getPosRelativeToRef(cell.pos);
+        if (cell.selected == 1) {
+            ++result.numCells;
+            centerPos += pos;
+            centerVel += cell.vel;
+        }
+        ++result.numClusterCells;
+        clusterCenterPos += pos;
+        clusterCenterVel += cell.vel;
+    }
+    for (auto const& particle : _particles) {
+        if (particle.selected == 0) {
+            continue;
+        }
+        auto pos = getPosRelativeToRef(particle.pos);
+        ++result.numParticles;
+        centerPos += pos;
+        centerVel += particle.vel;
+        clusterCenterPos += pos;
+        clusterCenterVel += particle.vel;
+    }
+    if (auto numEntities = result.numCells + result.numParticles) {
+        centerPos = refPos + centerPos / toFloat(numEntities);
+        correctPosition(centerPos);
+        centerVel = centerVel / toFloat(numEntities);
+        result.centerPosX = centerPos.x;
+        result.centerPosY = centerPos.y;
+        result.centerVelX = centerVel.x;
+        result.centerVelY = centerVel.y;
+    }
+    if (auto numEntities = result.numClusterCells + result.numParticles) {
+        clusterCenterPos = refPos + clusterCenterPos / toFloat(numEntities);
+        correctPosition(clusterCenterPos);
+        clusterCenterVel = clusterCenterVel / toFloat(numEntities);
+        result.clusterCenterPosX = clusterCenterPos.x;
+        result.clusterCenterPosY = clusterCenterPos.y;
+        result.clusterCenterVelX = clusterCenterVel.x;
+        result.clusterCenterVelY = clusterCenterVel.y;
+    }
+    return result;
+}
+
+void _SimulationCpuFacade::shallowUpdateSelectedObjects(ShallowUpdateSelectionData const& shallowUpdateData)
+{
+    auto includeClusters = shallowUpdateData.considerClusters;
+    std::optional<float2> center;
+    if (shallowUpdateData.angleDelta != 0 || shallowUpdateData.angularVelDelta != 0) {
+        auto selectionData = getSelectionShallowData({0, 0});
+        center = includeClusters ? float2{selectionData.clusterCenterPosX, selectionData.clusterCenterPosY}
+                                 : float2{selectionData.centerPosX, selectionData.centerPosY};
+    }
+
+    std::lock_guard lock(_mutexForSimulationData);
+    float2 posDelta{shallowUpdateData.posDeltaX, shallowUpdateData.posDeltaY};
+    float2 velDelta{shallowUpdateData.velDeltaX, shallowUpdateData.velDeltaY};
+    auto sinAngle = std::sin(shallowUpdateData.angleDelta * Const::DEG_TO_RAD);
+    auto cosAngle = std::cos(shallowUpdateData.angleDelta * Const::DEG_TO_RAD);
+    auto updatePosAndVel = [&](float2& pos, float2& vel) {
+        if (center) {
+            auto relPos = pos - *center;
+            correctDirection(relPos);
+            pos = *center + float2{relPos.x * cosAngle - relPos.y * sinAngle, relPos.x * sinAngle + relPos.y * cosAngle};
+            Math::rotateQuarterClockwise(relPos);
+            vel += relPos * (shallowUpdateData.angularVelDelta * Const::DEG_TO_RAD);
+        }
+        pos += posDelta;
+        correctPosition(pos);
+        vel += velDelta;
+    };
+    for (auto& cell : _cells) {
+        if (isSelected(cell, includeClusters)) {
+            updatePosAndVel(cell.pos, cell.vel);
+        }
+    }
+    for (auto& particle : _particles) {
+        if (particle.selected != 0) {
+            updatePosAndVel(particle.pos, particle.vel);
+        }
+    }
+}
+
+void _SimulationCpuFacade::removeSelection()
+{
+    std::lock_guard lock(_mutexForSimulationData);
+    for (auto& cell : _cells) {
+        cell.selected = 0;
+    }
+    for (auto& particle : _particles) {
+        particle.selected = 0;
+    }
+}
+
+void _SimulationCpuFacade::updateSelection()
+{
+    std::lock_guard lock(_mutexForSimulationData);
+    for (auto& cell : _cells) {
+        if (cell.selected == 2) {
+            cell.selected = 0;
+        }
+    }
+    rolloutSelection();
+}
+
+void _SimulationCpuFacade::colorSelectedObjects(unsigned char color, bool includeClusters)
+{
+    std::lock_guard lock(_mutexForSimulationData);
+    for (auto& cell : _cells) {
+        if (isSelected(cell, includeClusters)) {
+            cell.color = color;
+        }
+    }
+    for (auto& particle : _particles) {
+        if (particle.selected != 0) {
+            particle.color = color;
+        }
+    }
+}
+
+void _SimulationCpuFacade::reconnectSelectedObjects()
+{
+    throw std::runtime_error("Reconnecting objects is not supported by the CPU backend.");
+}
+
+void _SimulationCpuFacade::setDetached(bool value)
+{
+    throw std::runtime_error("Detaching objects is not supported by the CPU backend.");
+}
+
+void _SimulationCpuFacade::setGpuConstants(GpuSettings const& cudaConstants)
+{
+    _settings.gpuSettings = cudaConstants;
+}
+
+SimulationParameters _SimulationCpuFacade::getSimulationParameters() const
+{
+    std::lock_guard lock(_mutexForSimulationParameters);
+    return _newSimulationParameters ? *_newSimulationParameters : _settings.simulationParameters;
+}
+
+void _SimulationCpuFacade::setSimulationParameters(SimulationParameters const& parameters)
+{
+    std::lock_guard lock(_mutexForSimulationParameters);
+    _newSimulationParameters = parameters;
+}
+
+ArraySizes _SimulationCpuFacade::getArraySizes() const
+{
+    std::lock_guard lock(_mutexForSimulationData);
+    return _capacities;
+}
+
+RawStatisticsData _SimulationCpuFacade::getRawStatistics()
+{
+    std::lock_guard lock(_mutexForStatistics);
+    return _statisticsData ? *_statisticsData : RawStatisticsData();
+}
+
+void _SimulationCpuFacade::updateStatistics()
+{
+    RawStatisticsData statistics;
+    uint64_t timestep;
+    {
+        std::lock_guard lock(_mutexForSimulationData);
+        auto& timestepStatistics = statistics.timeline.timestep;
+        for (auto const& cell : _cells) {
+            auto color = cell.color % MAX_COLORS;
+            ++timestepStatistics.numCells[color];
+            timestepStatistics.numConnections[color] += cell.numConnections;
+            timestepStatistics.totalEnergy[color] += cell.energy;
+        }
+        for (auto const& particle : _particles) {
+            auto color = particle.color % MAX_COLORS;
+            ++timestepStatistics.numParticles[color];
+            timestepStatistics.totalEnergy[color] += particle.energy;
+        }
+        statistics.timeline.accumulated = _accumulatedStatistics;
+        timestep = _timestep;
+    }
+    {
+        std::lock_guard lock(_mutexForStatistics);
+        _statisticsData = statistics;
+    }
+    _statisticsService->addDataPoint(_statisticsHistory, statistics.timeline, timestep);
+}
+
+StatisticsHistory const& _SimulationCpuFacade::getStatisticsHistory() const
+{
+    return _statisticsHistory;
+}
+
+void _SimulationCpuFacade::setStatisticsHistory(StatisticsHistoryData const& data)
+{
+    _statisticsService->rewriteHistory(_statisticsHistory, data, getCurrentTimestep());
+}
+
+bool _SimulationCpuFacade::isProfilingEnabled() const
+{
+    std::lock_guard lock(_mutexForProfiling);
+    return _isProfilingEnabled;
+}
+
+void _SimulationCpuFacade::setProfilingEnabled(bool value)
+{
+    //the data lock ensures that no time step is running
+    std::scoped_lock lock(_mutexForSimulationData, _mutexForProfiling);
+    if (value == _isProfilingEnabled) {
+        return;
+    }
+    _isProfilingEnabled = value;
+    if (value) {
+        std::vector<std::string> phaseNames;
+        for (auto const& counters : _phaseCounters) {
+            phaseNames.emplace_back(counters.name);
+        }
+        _profilingHistory = std::make_shared<ProfilingHistory>(phaseNames);
+        _profilingStartTimepoint = std::chrono::steady_clock::now();
+    }
+}
+
+ProfilingData _SimulationCpuFacade::getProfilingData() const
+{
+    std::lock_guard lock(_mutexForProfiling);
+    return _profilingHistory ? _profilingHistory->getData() : ProfilingData();
+}
+
+void _SimulationCpuFacade::resetTimeIntervalStatistics()
+{
+    std::lock_guard lock(_mutexForSimulationData);
+    _accumulatedStatistics = AccumulatedStatistics();
+}
+
+uint64_t _SimulationCpuFacade::getCurrentTimestep() const
+{
+    std::lock_guard lock(_mutexForSimulationData);
+    return _timestep;
+}
+
+void _SimulationCpuFacade::setCurrentTimestep(uint64_t timestep)
+{
+    {
+        std::lock_guard lock(_mutexForSimulationData);
+        _timestep = timestep;
+    }
+    _statisticsService->resetTime(_statisticsHistory, timestep);
+}
+
+void _SimulationCpuFacade::clear()
+{
+    std::lock_guard lock(_mutexForSimulationData);
+    _cells.clear();
+    _particles.clear();
+    _auxiliaryData.clear();
+}
+
+void _SimulationCpuFacade::resizeArraysIfNecessary(ArraySizes const& additionals)
+{
+    std::lock_guard lock(_mutexForSimulationData);
+    _capacities.cellArraySize = std::max<uint64_t>(_capacities.cellArraySize, _cells.size() + additionals.cellArraySize);
+    _capacities.particleArraySize = std::max<uint64_t>(_capacities.particleArraySize, _particles.size() + additionals.particleArraySize);
+    _capacities.auxiliaryDataSize = std::max<uint64_t>(_capacities.auxiliaryDataSize, _auxiliaryData.size() + additionals.auxiliaryDataSize);
+}
+
+void _SimulationCpuFacade::testOnly_mutate(uint64_t cellId, MutationType mutationType)
+{
+    throw std::runtime_error("Mutations are not supported by the CPU backend.");
+}
+
+std::vector<CpuPhaseCounters> _SimulationCpuFacade::getPhaseCounters() const
+{
+    std::lock_guard lock(_mutexForSimulationData);
+    return _phaseCounters;
+}
+
+void _SimulationCpuFacade::checkAndProcessSimulationParameterChanges()
+{
+    std::lock_guard lock(_mutexForSimulationParameters);
+    if (_newSimulationParameters) {
+        _settings.simulationParameters = *_newSimulationParameters;
+        _newSimulationParameters.reset();
+    }
+}
+
+void _SimulationCpuFacade::calcTimestepIntern()
+{
+    auto const& parameters = _settings.simulationParameters;
+    auto numCells = _cells.size();
+    _forces.assign(numCells, {0, 0});
+    _posCorrections.assign(numCells, {0, 0});
+    _prevForces.resize(numCells, {0, 0});
+    _densities.resize(numCells, 1.0f);
+
+    //not all parts need to be executed in each time step for performance reasons
+    bool considerForcesFromAngleDifferences = (_timestep % 3 == 0);
+    bool considerInnerFriction = (_timestep % 3 == 0);
+
+    measurePhase(CpuPhase_Physics, toInt(numCells), [&] {
+        fillMap();
+        if (parameters.motionType == MotionType_Fluid) {
+            calcFluidForces();
+        } else {
+            calcCollisionForces();
+        }
+        applyForces();
+        moveParticles();
+        calcConnectionForces(considerForcesFromAngleDifferences);
+        verletPositionUpdate();
+        calcConnectionForces(considerForcesFromAngleDifferences);
+        verletVelocityUpdate();
+    });
+
+    measurePhase(CpuPhase_CellFunctionPreparation, toInt(numCells), [&] { collectCellFunctionOperations(); });
+    measurePhase(CpuPhase_Nerve, toInt(_cellFunctionOperations[CellFunction_Nerve].size()), [&] { processNerves(); });
+    measurePhase(CpuPhase_Neuron, toInt(_cellFunctionOperations[CellFunction_Neuron].size()), [&] { processNeurons(); });
+
+    measurePhase(CpuPhase_Friction, toInt(numCells), [&] {
+        if (considerInnerFriction) {
+            applyInnerFriction();
+        }
+        resetFetchedActivities();
+        applyFriction();
+    });
+
+    if (!_profilingEntries.empty()) {
+        _profilingHistory->add(_profilingEntries);
+        _profilingEntries.clear();
+    }
+}
+
+void _SimulationCpuFacade::fillMap()
+{
+    _cellPositions.resize(_cells.size());
+    for (int i = 0; i < toInt(_cells.size()); ++i) {
+        _cellPositions[i] = {_cells[i].pos.x, _cells[i].pos.y};
+    }
+    _cellGrid.build(_cellPositions);
+}
+
+void _SimulationCpuFacade::calcCollisionForces()
+{
+    auto const& parameters = _settings.simulationParameters;
+    auto const& motion = parameters.motionData.collisionMotion;
+
+    HostExecution::forEach(toInt(_cells.size()), [&](int index) {
+        auto const& cell = _cells[index];
+        float2 force{0, 0};
+        forEachCellInRadius(cell.pos, motion.cellMaxCollisionDistance, [&](int otherIndex, float2 const& posDelta, float distance) {
+            if (otherIndex == index) {
+                return;
+            }
+            auto const& otherCell = _cells[otherIndex];
+
+            //overlap correction
+            if (!cell.barrier && distance < parameters.cellMinDistance) {
+                _posCorrections[index] += posDelta * parameters.cellMinDistance / 5;
+            }
+
+            //the force pair of the other cell is also accumulated here to avoid write conflicts
+            if (!isConnected(cell, otherIndex)) {
+                force += CellForces::calcCollisionForce(posDelta, cell.vel, otherCell.vel, cell.barrier, motion);
+                force -= CellForces::calcCollisionForce(posDelta * (-1), otherCell.vel, cell.vel, otherCell.barrier, motion);
+            }
+        });
+        _forces[index] = force;
+    });
+}
+
+void _SimulationCpuFacade::calcFluidForces()
+{
+    auto const& parameters = _settings.simulationParameters;
+    auto const& motion = parameters.motionData.fluidMotion;
+    auto const& smoothingLength = motion.smoothingLength;
+    std::vector<float> newDensities(_cells.size());
+
+    HostExecution::forEach(toInt(_cells.size()), [&](int index) {
+        auto const& cell = _cells[index];
+        float2 F_pressure{0, 0};
+        float2 F_viscosity{0, 0};
+        float density = 0;
+        std::optional<int> closestBarrierCellIndex;
+        float closestBarrierCellDistance = 0;
+
+        forEachCellInRadius(cell.pos, smoothingLength * 2, [&](int otherIndex, float2 const& posDelta, float distance) {
+            auto const& otherCell = _cells[otherIndex];
+            if (otherCell.barrier) {
+                if (!closestBarrierCellIndex || distance < closestBarrierCellDistance) {
+                    closestBarrierCellIndex = otherIndex;
+                    closestBarrierCellDistance = distance;
+                }
+                return;
+            }
+
+            density += CellForces::calcKernel(distance / smoothingLength) / (smoothingLength * smoothingLength);
+            if (otherIndex == index) {
+                return;
+            }
+
+            //overlap correction
+            if (!cell.barrier && distance < parameters.cellMinDistance) {
+                _posCorrections[index] += posDelta * parameters.cellMinDistance / 5;
+            }
+
+            if (!isConnected(cell, otherIndex)) {
+
+                //for simplicity pressure = density, the densities from last time step are used
+                float2 pressureForce;
+                float2 viscosityForce;
+                CellForces::calcFluidForces(
+                    posDelta,
+                    distance,
+                    cell.vel - otherCell.vel,
+                    _densities[index],
+                    _densities[otherIndex],
+                    smoothingLength,
+                    pressureForce,
+                    viscosityForce);
+                F_pressure += pressureForce;
+                F_viscosity += viscosityForce;
+            }
+        });
+
+        auto force = F_pressure * motion.pressureStrength + F_viscosity * motion.viscosityStrength;
+
+        //reflection at barrier cells
+        if (closestBarrierCellIndex) {
+            auto const& barrierCell = _cells[*closestBarrierCellIndex];
+            auto getDirection = [&](float2 const& from, float2 const& to) {
+                auto result = to - from;
+                correctDirection(result);
+                return result;
+            };
+            float2 r{0, 0};
+            if (barrierCell.numConnections <= 1) {
+                r = getDirection(barrierCell.pos, cell.pos);
+            } else {
+                auto angleToCell = Math::angleOfVector(getDirection(barrierCell.pos, cell.pos));
+                auto numConnections = barrierCell.numConnections;
+                for (int i = 0; i < numConnections; ++i) {
+                    auto const& otherCell1 = _cells[barrierCell.connections[i].cellIndex];
+                    auto const& otherCell2 = _cells[barrierCell.connections[(i + 1) % numConnections].cellIndex];
+                    auto angleToOtherCell1 = Math::angleOfVector(getDirection(barrierCell.pos, otherCell1.pos));
+                    auto angleToOtherCell2 = Math::angleOfVector(getDirection(barrierCell.pos, otherCell2.pos));
+                    if (Math::isAngleInBetween(angleToOtherCell1, angleToOtherCell2, angleToCell)) {
+                        r = getDirection(otherCell1.pos, otherCell2.pos);
+                        Math::rotateQuarterCounterClockwise(r);
+                        break;
+                    }
+                }
+            }
+            force += CellForces::calcBarrierReflectionForce(cell.vel, barrierCell.vel, r, closestBarrierCellDistance);
+        }
+        _forces[index] = force;
+        newDensities[index] = density;
+    });
+    _densities.swap(newDensities);
+}
+
+void _SimulationCpuFacade::applyForces()
+{
+    auto const& parameters = _settings.simulationParameters;
+    HostExecution::forEach(toInt(_cells.size()), [&](int index) {
+        auto& cell = _cells[index];
+        cell.pos += _posCorrections[index];
+        correctPosition(cell.pos);
+        if (cell.barrier) {
+            return;
+        }
+        cell.vel += _forces[index];
+        if (Math::length(cell.vel) > parameters.cellMaxVelocity) {
+            cell.vel = Math::normalized(cell.vel) * parameters.cellMaxVelocity;
+        }
+        _forces[index] = {0, 0};
+    });
+}
+
+void _SimulationCpuFacade::calcConnectionForces(bool considerAngles)
+{
+    auto const& parameters = _settings.simulationParameters;
+    HostCellAccess access{_cells, _forces, {toFloat(_settings.generalSettings.worldSizeX), toFloat(_settings.generalSettings.worldSizeY)}};
+    auto calcForces = [&]<typename Execution>() {
+        Execution::forEach(toInt(_cells.size()), [&](int index) {
+            auto const& cell = _cells[index];
+            if (0 == cell.numConnections || cell.barrier) {
+                return;
+            }
+            CellForces::calcConnectionForces<Execution>(access, index, considerAngles, parameters.cellMinDistance);
+        });
+    };
+
+    //forces are added to connected cells, hence the summation order is only fixed in sequential execution
+    if (_settings.generalSettings.deterministic) {
+        calcForces.operator()<SequentialExecution>();
+    } else {
+        calcForces.operator()<HostExecution>();
+    }
+}
+
+void _SimulationCpuFacade::verletPositionUpdate()
+{
+    auto const& timestepSize = _settings.simulationParameters.timestepSize;
+    HostExecution::forEach(toInt(_cells.size()), [&](int index) {
+        auto& cell = _cells[index];
+        if (cell.barrier) {
+            cell.pos += cell.vel * timestepSize;
+        } else {
+            cell.pos += cell.vel * timestepSize + _forces[index] * timestepSize * timestepSize / 2;
+            _prevForces[index] = _forces[index];
+            _forces[index] = {0, 0};
+        }
+        correctPosition(cell.pos);
+    });
+}
+
+void _SimulationCpuFacade::verletVelocityUpdate()
+{
+    auto const& timestepSize = _settings.simulationParameters.timestepSize;
+    HostExecution::forEach(toInt(_cells.size()), [&](int index) {
+        auto& cell = _cells[index];
+        if (cell.barrier) {
+            return;
+        }
+        auto acceleration = (_forces[index] + _prevForces[index]) / 2;
+        cell.vel += acceleration * timestepSize;
+    });
+}
+
+void _SimulationCpuFacade::applyInnerFriction()
+{
+    //velocities are averaged with all connected cells at once (instead of pairwise with locks) to be independent of the processing order
+    auto const& innerFriction = _settings.simulationParameters.innerFriction;
+    std::vector<float2> newVelocities(_cells.size());
+    HostExecution::forEach(toInt(_cells.size()), [&](int index) {
+        auto const& cell = _cells[index];
+        newVelocities[index] = cell.vel;
+        if (cell.barrier) {
+            return;
+        }
+        for (int i = 0; i < cell.numConnections; ++i) {
+            auto const& connectedCell = _cells[cell.connections[i].cellIndex];
+            if (!connectedCell.barrier) {
+                newVelocities[index] += (connectedCell.vel - cell.vel) * (innerFriction / 2);
+            }
+        }
+    });
+    HostExecution::forEach(toInt(_cells.size()), [&](int index) { _cells[index].vel = newVelocities[index]; });
+}
+
+void _SimulationCpuFacade::applyFriction()
+{
+    //spots are not considered
+    auto const& friction = _settings.simulationParameters.baseValues.friction;
+    HostExecution::forEach(toInt(_cells.size()), [&](int index) {
+        auto& cell = _cells[index];
+        if (!cell.barrier) {
+            cell.vel = cell.vel * (1.0f - friction);
+        }
+    });
+}
+
+void _SimulationCpuFacade::moveParticles()
+{
+    auto const& timestepSize = _settings.simulationParameters.timestepSize;
+    HostExecution::forEach(toInt(_particles.size()), [&](int index) {
+        auto& particle = _particles[index];
+        particle.pos += particle.vel * timestepSize;
+        correctPosition(particle.pos);
+    });
+}
+
+void _SimulationCpuFacade::collectCellFunctionOperations()
+{
+    auto const& parameters = _settings.simulationParameters;
+    auto executionOrderNumber = toInt(_timestep % parameters.cellNumExecutionOrderNumbers);
+    for (auto& operations : _cellFunctionOperations) {
+        operations.clear();
+    }
+    for (int index = 0; index < toInt(_cells.size()); ++index) {
+        auto& cell = _cells[index];
+
+        //aging without color transitions
+        if (!cell.barrier) {
+            ++cell.age;
+        }
+        if (cell.livingState == LivingState_Ready && cell.activationTime > 0) {
+            --cell.activationTime;
+        }
+        if (cell.cellFunction != CellFunction_None && cell.executionOrderNumber == executionOrderNumber && cell.livingState == LivingState_Ready
+            && cell.activationTime == 0) {
+            _cellFunctionOperations[cell.cellFunction].emplace_back(index);
+        }
+    }
+}
+
+void _SimulationCpuFacade::processNerves()
+{
+    auto const& parameters = _settings.simulationParameters;
+    auto const& operations = _cellFunctionOperations[CellFunction_Nerve];
+    auto numExecutionOrderNumbers = static_cast<uint32_t>(parameters.cellNumExecutionOrderNumbers);
+    _scheduler.run(toInt(operations.size()), [&](int operationIndex) {
+        auto& cell = _cells[operations[operationIndex]];
+        auto activity = calcInputActivity(_cells, cell, parameters);
+        updateInvocationState(cell, activity);
+
+        auto const& nerve = cell.cellFunctionData.nerve;
+        auto counter = (cell.age / numExecutionOrderNumbers) * numExecutionOrderNumbers + cell.executionOrderNumber % numExecutionOrderNumbers;
+        if (nerve.pulseMode > 0 && (counter % (numExecutionOrderNumbers * nerve.pulseMode) == cell.executionOrderNumber)) {
+            HostExecution::atomicAdd(&_accumulatedStatistics.numNervePulses[cell.color % MAX_COLORS], uint64_t(1));
+            if (nerve.alternationMode == 0) {
+                activity.channels[0] += 1.0f;
+            } else {
+                auto evenPulse = counter % (numExecutionOrderNumbers * nerve.pulseMode * nerve.alternationMode * 2)
+                    < cell.executionOrderNumber + numExecutionOrderNumbers * nerve.pulseMode * nerve.alternationMode;
+                activity.channels[0] += evenPulse ? 1.0f : -1.0f;
+            }
+        }
+        cell.activity = activity;
+    });
+}
+
+void _SimulationCpuFacade::processNeurons()
+{
+    auto const& parameters = _settings.simulationParameters;
+    auto const& operations = _cellFunctionOperations[CellFunction_Neuron];
+    _scheduler.run(toInt(operations.size()), [&](int operationIndex) {
+        auto& cell = _cells[operations[operationIndex]];
+        auto inputActivity = calcInputActivity(_cells, cell, parameters);
+        updateInvocationState(cell, inputActivity);
+
+        //weights and biases are stored as in NeuronFunction::NeuronState
+        float weightsAndBiases[MAX_CHANNELS * (MAX_CHANNELS + 1)];
+        std::memcpy(weightsAndBiases, _auxiliaryData.data() + cell.cellFunctionData.neuron.weightsAndBiasesDataIndex, sizeof(weightsAndBiases));
+        auto const* weights = weightsAndBiases;
+        auto const* biases = weightsAndBiases + MAX_CHANNELS * MAX_CHANNELS;
+
+        ActivityTO outputActivity;
+        for (int row = 0; row < MAX_CHANNELS; ++row) {
+            auto sumInput = biases[row];
+            for (int col = 0; col < MAX_CHANNELS; ++col) {
+                sumInput += weights[row * MAX_CHANNELS + col] * inputActivity.channels[col];
+            }
+            outputActivity.channels[row] = applyActivationFunction(cell.cellFunctionData.neuron.activationFunctions[row], sumInput);
+        }
+        outputActivity.origin = inputActivity.origin;
+        outputActivity.targetX = inputActivity.targetX;
+        outputActivity.targetY = inputActivity.targetY;
+        cell.activity = outputActivity;
+        HostExecution::atomicAdd(&_accumulatedStatistics.numNeuronActivities[cell.color % MAX_COLORS], uint64_t(1));
+    });
+}
+
+//see CellFunctionProcessor::resetFetchedActivities
+void _SimulationCpuFacade::resetFetchedActivities()
+{
+    auto const& parameters = _settings.simulationParameters;
+    auto executionOrderNumber = toInt(_timestep % parameters.cellNumExecutionOrderNumbers);
+    HostExecution::forEach(toInt(_cells.size()), [&](int index) {
+        auto& cell = _cells[index];
+        if (cell.cellFunction == CellFunction_None) {
+            for (int i = 0; i < MAX_CHANNELS; ++i) {
+                cell.activity.channels[i] = 0;
+            }
+            return;
+        }
+        int maxOtherExecutionOrderNumber = -1;
+        if (!cell.outputBlocked) {
+            for (int i = 0; i < cell.numConnections; ++i) {
+                auto const& connectedCell = _cells[cell.connections[i].cellIndex];
+                auto otherExecutionOrderNumber = connectedCell.executionOrderNumber;
+                auto otherInputExecutionOrderNumber = connectedCell.inputExecutionOrderNumber;
+                bool flowToCell = !isFlowDirectionLegacyMode(parameters)
+                    ? cell.inputExecutionOrderNumber == otherExecutionOrderNumber && !connectedCell.outputBlocked
+                        && cell.executionOrderNumber > otherInputExecutionOrderNumber
+                    : false;
+                if (otherInputExecutionOrderNumber == cell.executionOrderNumber && !flowToCell) {
+                    if (maxOtherExecutionOrderNumber == -1) {
+                        maxOtherExecutionOrderNumber = otherExecutionOrderNumber;
+                    } else if (
+                        (maxOtherExecutionOrderNumber > cell.executionOrderNumber
+                         && (otherExecutionOrderNumber > maxOtherExecutionOrderNumber || otherExecutionOrderNumber < cell.executionOrderNumber))
+                        || (maxOtherExecutionOrderNumber < cell.executionOrderNumber && otherExecutionOrderNumber > maxOtherExecutionOrderNumber
+                            && otherExecutionOrderNumber < cell.executionOrderNumber)) {
+                        maxOtherExecutionOrderNumber = otherExecutionOrderNumber;
+                    }
+                }
+            }
+        }
+        if ((maxOtherExecutionOrderNumber == -1 && executionOrderNumber == (cell.executionOrderNumber + 1) % parameters.cellNumExecutionOrderNumbers)
+            || (maxOtherExecutionOrderNumber != -1 && maxOtherExecutionOrderNumber == executionOrderNumber)) {
+            for (int i = 0; i < MAX_CHANNELS; ++i) {
+                cell.activity.channels[i] = 0;
+            }
+        }
+    });
+}
+
+template <typename Func>
+void _SimulationCpuFacade::measurePhase(CpuPhase phase, int numTasks, Func const& func)
+{
+    auto startTime = std::chrono::steady_clock::now();
+    func();
+    auto endTime = std::chrono::steady_clock::now();
+    auto& counters = _phaseCounters[phase];
+    counters.duration += std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - startTime);
+    ++counters.numInvocations;
+    counters.numTasks += numTasks;
+
+    if (_isProfilingEnabled) {
+        ProfilingEntry entry;
+        entry.phase = phase;
+        entry.timestep = _timestep;
+        entry.startTime = std::chrono::duration<double, std::micro>(startTime - _profilingStartTimepoint).count();
+        entry.duration = std::chrono::duration<double, std::micro>(endTime - startTime).count();
+        entry.numCells = _cells.size();
+        entry.numParticles = _particles.size();
+        _profilingEntries.emplace_back(entry);
+    }
+}
+
+template <typename Func>
+void _SimulationCpuFacade::forEachCellInRadius(float2 const& pos, float radius, Func const& func) const
+{
+    _cellGrid.forEachInRadius({pos.x, pos.y}, radius, [&](int otherIndex, RealVector2D const& delta, float distanceSquared) {
+        func(otherIndex, float2{-delta.x, -delta.y}, sqrtf(distanceSquared));
+    });
+}
+
+void _SimulationCpuFacade::correctPosition(float2& pos) const
+{
+    auto worldSizeX = toFloat(_settings.generalSettings.worldSizeX);
+    auto worldSizeY = toFloat(_settings.generalSettings.worldSizeY);
+    pos.x = std::fmod(pos.x, worldSizeX);
+    if (pos.x < 0) {
+        pos.x += worldSizeX;
+    }
+    pos.y = std::fmod(pos.y, worldSizeY);
+    if (pos.y < 0) {
+        pos.y += worldSizeY;
+    }
+}
+
+void _SimulationCpuFacade::correctDirection(float2& direction) const
+{
+    auto worldSizeX = toFloat(_settings.generalSettings.worldSizeX);
+    auto worldSizeY = toFloat(_settings.generalSettings.worldSizeY);
+    direction.x = remainderf(direction.x, worldSizeX);
+    direction.y = remainderf(direction.y, worldSizeY);
+}
+
+void _SimulationCpuFacade::copyToDataTO(
+    DataTO const& dataTO,
+    std::function<bool(CellTO const&)> const& cellFilter,
+    std::function<bool(ParticleTO const&)> const& particleFilter) const
+{
+    std::lock_guard lock(_mutexForSimulationData);
+    std::vector<int> newIndices(_cells.size(), -1);
+    uint64_t numCells = 0;
+    for (size_t i = 0; i < _cells.size(); ++i) {
+        if (cellFilter(_cells[i])) {
+            newIndices[i] = toInt(numCells);
+            dataTO.cells[numCells++] = _cells[i];
+        }
+    }
+    for (uint64_t i = 0; i < numCells; ++i) {
+        auto& cellTO = dataTO.cells[i];
+        for (int j = 0; j < cellTO.numConnections; ++j) {
+            cellTO.connections[j].cellIndex = newIndices[cellTO.connections[j].cellIndex];
+        }
+    }
+    *dataTO.numCells = numCells;
+
+    uint64_t numParticles = 0;
+    for (auto const& particle : _particles) {
+        if (particleFilter(particle)) {
+            dataTO.particles[numParticles++] = particle;
+        }
+    }
+    *dataTO.numParticles = numParticles;
+
+    //auxiliary data is copied as a whole such that the indices stay valid
+    if (!_auxiliaryData.empty()) {
+        std::memcpy(dataTO.auxiliaryData, _auxiliaryData.data(), _auxiliaryData.size());
+    }
+    *dataTO.numAuxiliaryData = _auxiliaryData.size();
+}
+
+void _SimulationCpuFacade::addFromDataTO(DataTO const& dataTO, bool selectData, bool createIds)
+{
+    auto cellIndexOffset = _cells.size();
+    auto auxiliaryDataOffset = _auxiliaryData.size();
+    auto numCells = *dataTO.numCells;
+    _auxiliaryData.insert(_auxiliaryData.end(), dataTO.auxiliaryData, dataTO.auxiliaryData + *dataTO.numAuxiliaryData);
+
+    for (uint64_t i = 0; i < numCells; ++i) {
+        auto cell = dataTO.cells[i];
+        if (createIds) {
+            cell.id = _nextId++;
+        } else {
+            _nextId = std::max(_nextId, cell.id + 1);
+        }
+        cell.selected = selectData ? 1 : 0;
+        offsetAuxiliaryDataIndices(cell, auxiliaryDataOffset);
+
+        //connections to cells outside of the transfer object are dropped
+        for (int j = cell.numConnections - 1; j >= 0; --j) {
+            auto cellIndex = cell.connections[j].cellIndex;
+            if (cellIndex < 0 || static_cast<uint64_t>(cellIndex) >= numCells) {
+                removeConnection(cell, j);
+            } else {
+                cell.connections[j].cellIndex = toInt(cellIndex + cellIndexOffset);
+            }
+        }
+        _cells.emplace_back(cell);
+    }
+    for (uint64_t i = 0; i < *dataTO.numParticles; ++i) {
+        auto particle = dataTO.particles[i];
+        if (createIds) {
+            particle.id = _nextId++;
+        } else {
+            _nextId = std::max(_nextId, particle.id + 1);
+        }
+        particle.selected = selectData ? 1 : 0;
+        _particles.emplace_back(particle);
+    }
+    _capacities.cellArraySize = std::max<uint64_t>(_capacities.cellArraySize, _cells.size());
+    _capacities.particleArraySize = std::max<uint64_t>(_capacities.particleArraySize, _particles.size());
+    _capacities.auxiliaryDataSize = std::max<uint64_t>(_capacities.auxiliaryDataSize, _auxiliaryData.size());
+
+    auto numUnsupportedCells = std::count_if(_cells.end() - numCells, _cells.end(), [](CellTO const& cell) { return !isCellFunctionSupported(cell); });
+    if (numUnsupportedCells > 0) {
+        log(Priority::Important,
+            std::to_string(numUnsupportedCells) + " cells with cell functions other than nerves and neurons are not executed by the CPU backend");
+    }
+}
+
+void _SimulationCpuFacade::removeObjects(
+    std::function<bool(CellTO const&)> const& cellFilter,
+    std::function<bool(ParticleTO const&)> const& particleFilter)
+{
+    std::lock_guard lock(_mutexForSimulationData);
+    std::vector<int> newIndices(_cells.size(), -1);
+    int numRemainingCells = 0;
+    for (size_t i = 0; i < _cells.size(); ++i) {
+        if (!cellFilter(_cells[i])) {
+            newIndices[i] = numRemainingCells;
+            _cells[numRemainingCells++] = _cells[i];
+        }
+    }
+    _cells.resize(numRemainingCells);
+    for (auto& cell : _cells) {
+        for (int j = cell.numConnections - 1; j >= 0; --j) {
+            auto newIndex = newIndices[cell.connections[j].cellIndex];
+            if (newIndex == -1) {
+                removeConnection(cell, j);
+            } else {
+                cell.connections[j].cellIndex = newIndex;
+            }
+        }
+    }
+    std::erase_if(_particles, particleFilter);
+    _densities.clear();
+    _prevForces.clear();
+    compactAuxiliaryData();
+}
+
+bool _SimulationCpuFacade::isSelected(CellTO const& cell, bool includeClusters) const
+{
+    return (includeClusters && cell.selected != 0) || (!includeClusters && cell.selected == 1);
+}
+
+void _SimulationCpuFacade::rolloutSelection()
+{
+    std::deque<int> cellIndices;
+    for (int i = 0; i < toInt(_cells.size()); ++i) {
+        if (_cells[i].selected == 1) {
+            cellIndices.emplace_back(i);
+        }
+    }
+    while (!cellIndices.empty()) {
+        auto const& cell = _cells[cellIndices.front()];
+        cellIndices.pop_front();
+        for (int i = 0; i < cell.numConnections; ++i) {
+            auto connectedCellIndex = cell.connections[i].cellIndex;
+            if (_cells[connectedCellIndex].selected == 0) {
+                _cells[connectedCellIndex].selected = 2;
+                cellIndices.emplace_back(connectedCellIndex);
+            }
+        }
+    }
+}
+
+void _SimulationCpuFacade::compactAuxiliaryData()
+{
+    std::vector<uint8_t> newAuxiliaryData;
+    std::unordered_map<uint64_t, uint64_t> newIndexByIndex;  //blocks can be shared by several cells
+    auto moveBlock = [&](uint64_t& dataIndex, uint64_t size) {
+        if (size == 0) {
+            dataIndex = 0;
+            return;
+        }
+        auto [it, inserted] = newIndexByIndex.emplace(dataIndex, newAuxiliaryData.size());
+        if (inserted) {
+            newAuxiliaryData.insert(newAuxiliaryData.end(), _auxiliaryData.begin() + dataIndex, _auxiliaryData.begin() + dataIndex + size);
+        }
+        dataIndex = it->second;
+    };
+    for (auto& cell : _cells) {
+        moveBlock(cell.metadata.nameDataIndex, cell.metadata.nameSize);
+        moveBlock(cell.metadata.descriptionDataIndex, cell.metadata.descriptionSize);
+        if (cell.cellFunction == CellFunction_Neuron) {
+            moveBlock(cell.cellFunctionData.neuron.weightsAndBiasesDataIndex, sizeof(float) * MAX_CHANNELS * (MAX_CHANNELS + 1));
+        }
+        if (cell.cellFunction == CellFunction_Constructor) {
+            moveBlock(cell.cellFunctionData.constructor.genomeDataIndex, cell.cellFunctionData.constructor.genomeSize);
+        }
+        if (cell.cellFunction == CellFunction_Injector) {
+            moveBlock(cell.cellFunctionData.injector.genomeDataIndex, cell.cellFunctionData.injector.genomeSize);
+        }
+    }
+    _auxiliaryData = std::move(newAuxiliaryData);
+}
@@ -0,0 +1,195 @@
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "Base/WorkStealingScheduler.h"
+#include "EngineGpuKernels/Definitions.h"
+#include "EngineGpuKernels/SimulationFacade.h"
+#include "EngineGpuKernels/TOs.cuh"
+#include "EngineInterface/SpatialHashGrid.h"
+
+/**
+ * Host implementation of the simulation backend for machines without a CUDA device. Objects are stored in the memory layout of
+ * DataTO and processed on the thread pool.
+ *
+ * The physics part of the time step (collision or fluid forces, connection forces, Verlet integration, friction) follows
+ * SimulationKernelsLauncher. The cell function phase collects the operations per cell function like
+ * CellFunctionProcessor::collectCellFunctionOperations and distributes them with a work-stealing scheduler. The implemented
+ * cell functions have a uniform cost, so there is no skew to balance yet.
+ *
+ * Scope: only nerves and neurons are executed. The other cell functions, radiation, color transitions, structural operations
+ * (fusion, connection decay, cell death) and garbage collection of cells are not, so simulations containing them evolve
+ * differently than on the GPU and a warning is logged when such cells are added. Rendering, cataclysms, reconnecting, detaching
+ * and mutations throw std::runtime_error. The backend is tested by CpuEngineTests only.
+ *
+ * If GeneralSettings::deterministic is set, the phases which accumulate forces of other cells run sequentially so that the
+ * time steps are bit-reproducible. None of the implemented phases draws random numbers, so the seed has no effect here.
+ */
+using CpuPhase = int;
+enum CpuPhase_
+{
+    CpuPhase_Physics,
+    CpuPhase_CellFunctionPreparation,
+    CpuPhase_Nerve,
+    CpuPhase_Neuron,
+    CpuPhase_Friction,
+    CpuPhase_Count
+};
+
+struct CpuPhaseCounters
+{
+    std::string name;
+    uint64_t numInvocations = 0;
+    uint64_t numTasks = 0;
+    std::chrono::nanoseconds duration = std::chrono::nanoseconds::zero();
+};
+
+class _SimulationCpuFacade : public _SimulationFacade
+{
+public:
+    _SimulationCpuFacade(uint64_t timestep, Settings const& settings);
+    ~_SimulationCpuFacade() = default;
+
+    std::string getDeviceName() const override;
+    void* registerImageResource(GLuint image) override;
+
+    void calcTimestep(uint64_t timesteps, bool forceUpdateStatistics) override;
+    void applyCataclysm(int power) override;
+
+    void drawVectorGraphics(float2 const& rectUpperLeft, float2 const& rectLowerRight, void* cudaResource, int2 const& imageSize, double zoom) override;
+    void getSimulationData(int2 const& rectUpperLeft, int2 const& rectLowerRight, DataTO const& dataTO) override;
+    void getSelectedSimulationData(bool includeClusters, DataTO const& dataTO) override;
+    void getInspectedSimulationData(std::vector<uint64_t> entityIds, DataTO const& dataTO) override;
+    void getOverlayData(int2 const& rectUpperLeft, int2 const& rectLowerRight, DataTO const& dataTO) override;
+    void addAndSelectSimulationData(DataTO const& dataTO) override;
+    void setSimulationData(DataTO const& dataTO) override;
+    void removeSelectedObjects(bool includeClusters) override;
+    void relaxSelectedObjects(bool includeClusters) override;
+    void uniformVelocitiesForSelectedObjects(bool includeClusters) override;
+    void makeSticky(bool includeClusters) override;
+    void removeStickiness(bool includeClusters) override;
+    void setBarrier(bool value, bool includeClusters) override;
+    void changeInspectedSimulationData(DataTO const& changeDataTO) override;
+
+    void applyForce(ApplyForceData const& applyData) override;
+    void switchSelection(PointSelectionData const& switchData) override;
+    void swapSelection(PointSelectionData const& selectionData) override;
+    void setSelection(AreaSelectionData const& selectionData) override;
+    SelectionShallowData getSelectionShallowData(float2 const& refPos) override;
+    void shallowUpdateSelectedObjects(ShallowUpdateSelectionData const& shallowUpdateData) override;
+    void removeSelection() override;
+    void updateSelection() override;
+    void colorSelectedObjects(unsigned char color, bool includeClusters) override;
+    void reconnectSelectedObjects() override;
+    void setDetached(bool value) override;
+
+    void setGpuConstants(GpuSettings const& cudaConstants) override;
+    SimulationParameters getSimulationParameters() const override;
+    void setSimulationParameters(SimulationParameters const& parameters) override;
+
+    ArraySizes getArraySizes() const override;
+
+    RawStatisticsData getRawStatistics() override;
+    void updateStatistics() override;
+    StatisticsHistory const& getStatisticsHistory() const override;
+    void setStatisticsHistory(StatisticsHistoryData const& data) override;
+
+    bool isProfilingEnabled() const override;
+    void setProfilingEnabled(bool value) override;
+    ProfilingData getProfilingData() const override;
+
+    void resetTimeIntervalStatistics() override;
+    uint64_t getCurrentTimestep() const override;
+    void setCurrentTimestep(uint64_t timestep) override;
+
+    void clear() override;
+
+    void resizeArraysIfNecessary(ArraySizes const& additionals = ArraySizes()) override;
+
+    //for tests
+    void testOnly_mutate(uint64_t cellId, MutationType mutationType) override;
+
+    std::vector<CpuPhaseCounters> getPhaseCounters() const;  //accumulated since creation
+
+private:
+    void checkAndProcessSimulationParameterChanges();
+
+    //time step
+    void calcTimestepIntern();
+    void fillMap();
+    void calcCollisionForces();
+    void calcFluidForces();
+    void applyForces();
+    void calcConnectionForces(bool considerAngles);
+    void verletPositionUpdate();
+    void verletVelocityUpdate();
+    void applyInnerFriction();
+    void applyFriction();
+    void moveParticles();
+    void collectCellFunctionOperations();
+    void processNerves();
+    void processNeurons();
+    void resetFetchedActivities();
+
+    template <typename Func>
+    void measurePhase(CpuPhase phase, int numTasks, Func const& func);
+
+    template <typename Func>
+    void forEachCellInRadius(float2 const& pos, float radius, Func const& func) const;
+    void correctPosition(float2& pos) const;
+    void correctDirection(float2& direction) const;
+
+    //data access
+    void copyToDataTO(DataTO const& dataTO, std::function<bool(CellTO const&)> const& cellFilter, std::function<bool(ParticleTO const&)> const& particleFilter)
+        const;
+    void addFromDataTO(DataTO const& dataTO, bool selectData, bool createIds);
+    void removeObjects(std::function<bool(CellTO const&)> const& cellFilter, std::function<bool(ParticleTO const&)> const& particleFilter);
+    bool isSelected(CellTO const& cell, bool includeClusters) const;
+    void rolloutSelection();
+    void compactAuxiliaryData();  //removes auxiliary data which is no longer referenced by cells, like the garbage collector on the GPU
+
+    Settings _settings;
+    mutable std::mutex _mutexForSimulationParameters;
+    std::optional<SimulationParameters> _newSimulationParameters;
+
+    mutable std::mutex _mutexForSimulationData;
+    uint64_t _timestep = 0;
+    uint64_t _nextId = 1;
+    std::vector<CellTO> _cells;
+    std::vector<ParticleTO> _particles;
+    std::vector<uint8_t> _auxiliaryData;
+    ArraySizes _capacities;
+
+    //intermediate data per cell, indexed like _cells
+    std::vector<float2> _forces;
+    std::vector<float2> _prevForces;
+    std::vector<float2> _posCorrections;
+    std::vector<float> _densities;
+
+    //cell map
+    std::vector<RealVector2D> _cellPositions;
+    SpatialHashGrid _cellGrid;
+
+    //indices of the cells whose cell function is executed in the current time step
+    std::vector<int> _cellFunctionOperations[CellFunction_Count];
+    WorkStealingScheduler _scheduler;
+    std::vector<CpuPhaseCounters> _phaseCounters;
+
+    mutable std::mutex _mutexForStatistics;
+    std::optional<std::chrono::steady_clock::time_point> _lastStatisticsUpdateTime;
+    std::optional<RawStatisticsData> _statisticsData;
+    AccumulatedStatistics _accumulatedStatistics;
+    StatisticsService _statisticsService;
+    StatisticsHistory _statisticsHistory;
+
+    mutable std::mutex _mutexForProfiling;
+    bool _isProfilingEnabled = false;
+    std::shared_ptr<ProfilingHistory> _profilingHistory;
+    std::chrono::steady_clock::time_point _profilingStartTimepoint;
+    std::vector<ProfilingEntry> _profilingEntries;  //of the current time step
+};
@@ -1,5 +1,7 @@
 #include "AuxiliaryDataParserService.h"
 
+#include <stdexcept>
+
 #include "GeneralSettings.h"
 #include "LegacyAuxiliaryDataParserService.h"
 #include "Settings.h"
@@ -1029,9 +1031,27 @@ namespace
         PropertyParser::encodeDecode(tree, data.center.y, 0.0f, "general.center.y", parserTask);
         PropertyParser::encodeDecode(tree, data.generalSettings.worldSizeX, defaultSettings.generalSettings.worldSizeX, "general.world size.x", parserTask);
         PropertyParser::encodeDecode(tree, data.generalSettings.worldSizeY, defaultSettings.generalSettings.worldSizeY, "general.world size.y", parserTask);
+        PropertyParser::encodeDecode(tree, data.generalSettings.seed, defaultSettings.generalSettings.seed, "general.seed", parserTask);
+        PropertyParser::encodeDecode(
+            tree, data.generalSettings.deterministic, defaultSettings.generalSettings.deterministic, "general.deterministic", parserTask);
 
         encodeDecodeSimulationParameters(tree, data.simulationParameters, parserTask);
     }
+
+    void applyPatchEntries(boost::property_tree::ptree& tree, boost::property_tree::ptree const& patch, std::string const& path)
+    {
+        for (auto const& [key, patchChild] : patch) {
+            auto childPath = path.empty() ? key : path + "." + key;
+            if (!patchChild.empty()) {
+                applyPatchEntries(tree, patchChild, childPath);
+                continue;
+            }
+            if (!tree.get_child_optional(childPath)) {
+                throw std::runtime_error("Unknown parameter \"" + childPath + "\".");
+            }
+            tree.put(childPath, patchChild.data());
+        }
+    }
 }
 
 boost::property_tree::ptree AuxiliaryDataParserService::encodeAuxiliaryData(AuxiliaryData const& data)
@@ -1048,6 +1068,13 @@ AuxiliaryData AuxiliaryDataParserService::decodeAuxiliaryData(boost::property_tr
     return result;
 }
 
+AuxiliaryData AuxiliaryDataParserService::applyPatch(AuxiliaryData const& data, boost::property_tree::ptree const& patch)
+{
+    auto tree = encodeAuxiliaryData(data);
+    applyPatchEntries(tree, patch, "");
+    return decodeAuxiliaryData(tree);
+}
+
 boost::property_tree::ptree AuxiliaryDataParserService::encodeSimulationParameters(SimulationParameters const& data)
 {
     boost::property_tree::ptree tree;
@@ -14,6 +14,10 @@ public:
     static boost::property_tree::ptree encodeAuxiliaryData(AuxiliaryData const& data);
     static AuxiliaryData decodeAuxiliaryData(boost::property_tree::ptree tree);
 
+    //overrides values of data by the leaves of patch, which has the structure of the encoded tree (keys may also be paths such as
+    //"simulation parameters.friction"), throws std::runtime_error for entries not contained in the encoded tree
+    static AuxiliaryData applyPatch(AuxiliaryData const& data, boost::property_tree::ptree const& patch);
+
     static boost::property_tree::ptree encodeSimulationParameters(SimulationParameters const& data);
     static SimulationParameters decodeSimulationParameters(boost::property_tree::ptree tree);
 };
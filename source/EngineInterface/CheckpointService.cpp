@@ -0,0 +1,127 @@
+#include "CheckpointService.h"
+
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+#include "Base/LoggingService.h"
+
+bool CheckpointService::saveCheckpoint(
+    std::string const& filename,
+    int numRotatingFiles,
+    DeserializedSimulation const& data,
+    SerializationSettings const& settings)
+{
+    try {
+        //at least two slots are needed so that the latest checkpoint is never overwritten
+        if (numRotatingFiles < 2) {
+            return false;
+        }
+        auto index = readIndex(filename);
+        auto slot = index ? (index->latestSlot + 1) % numRotatingFiles : 0;
+        auto slotFilename = getCheckpointFilename(filename, std::to_string(slot));
+        log(Priority::Important, "save checkpoint to " + slotFilename);
+
+        auto tempFilename = getCheckpointFilename(filename, "-temp");
+        if (!SerializerService::serializeSimulationToFiles(tempFilename, data, settings)) {
+            return false;
+        }
+        auto tempFilenames = getAllFilenames(tempFilename);
+        auto slotFilenames = getAllFilenames(slotFilename);
+        for (size_t i = 0; i < tempFilenames.size(); ++i) {
+            if (std::filesystem::exists(tempFilenames.at(i))) {
+                std::filesystem::rename(tempFilenames.at(i), slotFilenames.at(i));
+            } else {
+                std::filesystem::remove(slotFilenames.at(i));  //e.g. statistics file from an earlier checkpoint
+            }
+        }
+        writeIndex(filename, {slot, numRotatingFiles});
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
+std::vector<std::string> CheckpointService::getCheckpoints(std::string const& filename)
+{
+    std::vector<std::string> result;
+    auto index = readIndex(filename);
+    if (!index) {
+        return result;
+    }
+    for (int i = 0; i < index->numSlots; ++i) {
+        auto slot = (index->latestSlot - i + index->numSlots) % index->numSlots;
+        auto checkpointFilename = getCheckpointFilename(filename, std::to_string(slot));
+        if (std::filesystem::exists(checkpointFilename)) {
+            result.emplace_back(checkpointFilename);
+        }
+    }
+    return result;
+}
+
+void CheckpointService::removeCheckpoints(std::string const& filename)
+{
+    std::vector<std::string> checkpointFilenames{getCheckpointFilename(filename, "-temp")};
+    if (auto index = readIndex(filename)) {
+        for (int slot = 0; slot < index->numSlots; ++slot) {
+            checkpointFilenames.emplace_back(getCheckpointFilename(filename, std::to_string(slot)));
+        }
+    }
+    for (auto const& checkpointFilename : checkpointFilenames) {
+        for (auto const& fileToRemove : getAllFilenames(checkpointFilename)) {
+            std::filesystem::remove(fileToRemove);
+        }
+    }
+    std::filesystem::remove(getIndexFilename(filename));
+}
+
+std::optional<CheckpointService::CheckpointIndex> CheckpointService::readIndex(std::string const& filename)
+{
+    std::ifstream stream(getIndexFilename(filename));
+    if (!stream) {
+        return std::nullopt;
+    }
+    CheckpointIndex result;
+    stream >> result.latestSlot >> result.numSlots;
+    if (!stream || result.numSlots <= 0 || result.latestSlot < 0 || result.latestSlot >= result.numSlots) {
+        return std::nullopt;
+    }
+    return result;
+}
+
+void CheckpointService::writeIndex(std::string const& filename, CheckpointIndex const& index)
+{
+    auto indexFilename = getIndexFilename(filename);
+    auto tempIndexFilename = indexFilename + ".temp";
+    {
+        std::ofstream stream(tempIndexFilename, std::ios::trunc);
+        stream << index.latestSlot << " " << index.numSlots << std::endl;
+        if (!stream) {
+            throw std::runtime_error("Could not write checkpoint index.");
+        }
+    }
+    std::filesystem::rename(tempIndexFilename, indexFilename);
+}
+
+std::string CheckpointService::getIndexFilename(std::string const& filename)
+{
+    std::filesystem::path result(filename);
+    result.replace_extension(std::filesystem::path(".checkpoint"));
+    return result.string();
+}
+
+std::string CheckpointService::getCheckpointFilename(std::string const& filename, std::string const& slotName)
+{
+    std::filesystem::path result(filename);
+    result.replace_extension(std::filesystem::path(".checkpoint" + slotName + std::filesystem::path(filename).extension().string()));
+    return result.string();
+}
+
+std::vector<std::string> CheckpointService::getAllFilenames(std::string const& mainFilename)
+{
+    std::filesystem::path settingsFilename(mainFilename);
+    settingsFilename.replace_extension(std::filesystem::path(".settings.json"));
+    std::filesystem::path statisticsFilename(mainFilename);
+    statisticsFilename.replace_extension(std::filesystem::path(".statistics.csv"));
+    return {mainFilename, settingsFilename.string(), statisticsFilename.string()};
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "SerializerService.h"
+
+/**
+ * Rotating checkpoints for long-running simulations.
+ *
+ * The checkpoints of a simulation file (e.g. sim.sim) are stored in numRotatingFiles slots (sim.checkpoint0.sim,
+ * sim.checkpoint1.sim, ...). A checkpoint is first written to temporary files and then renamed into the oldest slot. Afterwards
+ * the index file (sim.checkpoint) is replaced in the same way. Hence a crash at any time leaves the previous checkpoints intact
+ * and the index file always refers to a complete one.
+ */
+class CheckpointService
+{
+public:
+    static bool saveCheckpoint(
+        std::string const& filename,
+        int numRotatingFiles,
+        DeserializedSimulation const& data,
+        SerializationSettings const& settings = SerializationSettings());
+
+    //filenames of the existing checkpoints of filename, latest first
+    static std::vector<std::string> getCheckpoints(std::string const& filename);
+
+    static void removeCheckpoints(std::string const& filename);
+
+private:
+    struct CheckpointIndex
+    {
+        int latestSlot = 0;
+        int numSlots = 0;
+    };
+    static std::optional<CheckpointIndex> readIndex(std::string const& filename);
+    static void writeIndex(std::string const& filename, CheckpointIndex const& index);
+
+    static std::string getIndexFilename(std::string const& filename);
+    static std::string getCheckpointFilename(std::string const& filename, std::string const& slotName);
+    static std::vector<std::string> getAllFilenames(std::string const& mainFilename);  //main, settings and statistics file
+};
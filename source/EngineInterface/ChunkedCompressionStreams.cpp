@@ -0,0 +1,362 @@
+#include "ChunkedCompressionStreams.h"
+
+#include <cstring>
+#include <deque>
+#include <future>
+#include <stdexcept>
+#include <streambuf>
+#include <vector>
+
+#include <zlib.h>
+
+#include "Base/ThreadPool.h"
+
+namespace
+{
+    char const ChunkedMagic[] = {'A', 'L', 'I', 'E', 'N', 'C', 'H', 'K'};
+    auto constexpr ContainerVersion = 1;
+    auto constexpr BlockSize = 4 << 20;
+
+    struct Block
+    {
+        std::vector<char> data;
+        uint32_t uncompressedSize = 0;
+    };
+
+    struct BlockIndexEntry
+    {
+        uint64_t offset = 0;
+        uint32_t compressedSize = 0;
+        uint32_t uncompressedSize = 0;
+    };
+
+    int getMaxBlocksInFlight()
+    {
+        return ThreadPool::getInstance().getNumThreads() * 2;
+    }
+
+    template <typename T>
+    void writeValue(std::ostream& stream, T const& value)
+    {
+        stream.write(reinterpret_cast<char const*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    T readValue(std::istream& stream)
+    {
+        T result;
+        stream.read(reinterpret_cast<char*>(&result), sizeof(T));
+        if (!stream) {
+            throw std::runtime_error("Unexpected end of compressed data.");
+        }
+        return result;
+    }
+
+    Block compressBlock(std::vector<char> const& input, CompressionCodec codec)
+    {
+        Block result;
+        result.uncompressedSize = static_cast<uint32_t>(input.size());
+        if (codec == CompressionCodec::None) {
+            result.data = input;
+            return result;
+        }
+        auto compressedSize = compressBound(static_cast<uLong>(input.size()));
+        result.data.resize(compressedSize);
+        auto level = codec == CompressionCodec::DeflateFast ? Z_BEST_SPEED : Z_DEFAULT_COMPRESSION;
+        if (compress2(
+                reinterpret_cast<Bytef*>(result.data.data()),
+                &compressedSize,
+                reinterpret_cast<Bytef const*>(input.data()),
+                static_cast<uLong>(input.size()),
+                level)
+            != Z_OK) {
+            throw std::runtime_error("Compression failed.");
+        }
+        result.data.resize(compressedSize);
+        return result;
+    }
+
+    std::vector<char> decompressBlock(Block const& input, CompressionCodec codec)
+    {
+        if (codec == CompressionCodec::None) {
+            return input.data;
+        }
+        std::vector<char> result(input.uncompressedSize);
+        uLongf uncompressedSize = input.uncompressedSize;
+        if (uncompress(
+                reinterpret_cast<Bytef*>(result.data()),
+                &uncompressedSize,
+                reinterpret_cast<Bytef const*>(input.data.data()),
+                static_cast<uLong>(input.data.size()))
+                != Z_OK
+            || uncompressedSize != input.uncompressedSize) {
+            throw std::runtime_error("Decompression failed.");
+        }
+        return result;
+    }
+}
+
+bool ChunkedCompressionService::isChunkedFormat(std::istream& stream)
+{
+    auto pos = stream.tellg();
+    char magic[sizeof(ChunkedMagic)];
+    stream.read(magic, sizeof(magic));
+    auto result = stream.gcount() == sizeof(magic) && std::memcmp(magic, ChunkedMagic, sizeof(ChunkedMagic)) == 0;
+    stream.clear();
+    stream.seekg(pos);
+    return result;
+}
+
+/************************************************************************/
+/* Output                                                               */
+/************************************************************************/
+class ChunkedCompressionOutputStream::OutputBuffer : public std::streambuf
+{
+public:
+    OutputBuffer(std::ostream& target, CompressionCodec codec)
+        : _target(target)
+        , _codec(codec)
+    {
+        _buffer.resize(BlockSize);
+        setp(_buffer.data(), _buffer.data() + _buffer.size());
+
+        _target.write(ChunkedMagic, sizeof(ChunkedMagic));
+        writeValue<uint32_t>(_target, ContainerVersion);
+        writeValue<uint8_t>(_target, static_cast<uint8_t>(codec));
+        _offset = sizeof(ChunkedMagic) + sizeof(uint32_t) + sizeof(uint8_t);
+    }
+
+    void close()
+    {
+        if (_closed) {
+            return;
+        }
+        _closed = true;
+        submitBlock();
+        while (!_pendingBlocks.empty()) {
+            writeNextBlock();
+        }
+
+        //end marker
+        writeValue<uint32_t>(_target, 0);
+        writeValue<uint32_t>(_target, 0);
+        auto indexOffset = _offset + 2 * sizeof(uint32_t);
+
+        writeValue<uint64_t>(_target, _index.size());
+        for (auto const& entry : _index) {
+            writeValue(_target, entry.offset);
+            writeValue(_target, entry.compressedSize);
+            writeValue(_target, entry.uncompressedSize);
+        }
+        writeValue<uint64_t>(_target, indexOffset);
+        _target.write(ChunkedMagic, sizeof(ChunkedMagic));
+        _target.flush();
+    }
+
+protected:
+    int_type overflow(int_type ch) override
+    {
+        submitBlock();
+        if (ch != traits_type::eof()) {
+            *pptr() = traits_type::to_char_type(ch);
+            pbump(1);
+        }
+        return traits_type::not_eof(ch);
+    }
+
+    std::streamsize xsputn(char const* data, std::streamsize count) override
+    {
+        auto remaining = count;
+        while (remaining > 0) {
+            if (pptr() == epptr()) {
+                submitBlock();
+            }
+            auto numBytes = std::min(remaining, static_cast<std::streamsize>(epptr() - pptr()));
+            std::memcpy(pptr(), data, numBytes);
+            pbump(static_cast<int>(numBytes));
+            data += numBytes;
+            remaining -= numBytes;
+        }
+        return count;
+    }
+
+private:
+    void submitBlock()
+    {
+        auto size = pptr() - pbase();
+        if (size == 0) {
+            return;
+        }
+        if (toInt(_pendingBlocks.size()) >= getMaxBlocksInFlight()) {
+            writeNextBlock();
+        }
+        auto input = std::make_shared<std::vector<char>>(_buffer.begin(), _buffer.begin() + size);
+        auto codec = _codec;
+        _pendingBlocks.emplace_back(ThreadPool::getInstance().submit([input, codec] { return compressBlock(*input, codec); }));
+        setp(_buffer.data(), _buffer.data() + _buffer.size());
+    }
+
+    void writeNextBlock()
+    {
+        auto block = _pendingBlocks.front().get();
+        _pendingBlocks.pop_front();
+
+        auto compressedSize = static_cast<uint32_t>(block.data.size());
+        writeValue(_target, block.uncompressedSize);
+        writeValue(_target, compressedSize);
+        _target.write(block.data.data(), block.data.size());
+
+        _index.emplace_back(BlockIndexEntry{_offset, compressedSize, block.uncompressedSize});
+        _offset += 2 * sizeof(uint32_t) + compressedSize;
+    }
+
+    std::ostream& _target;
+    CompressionCodec _codec;
+    std::vector<char> _buffer;
+    std::deque<std::future<Block>> _pendingBlocks;
+    std::vector<BlockIndexEntry> _index;
+    uint64_t _offset = 0;
+    bool _closed = false;
+};
+
+ChunkedCompressionOutputStream::ChunkedCompressionOutputStream(std::ostream& target, CompressionCodec codec)
+    : std::ostream(nullptr)
+    , _buffer(std::make_unique<OutputBuffer>(target, codec))
+{
+    rdbuf(_buffer.get());
+}
+
+ChunkedCompressionOutputStream::~ChunkedCompressionOutputStream()
+{
+    try {
+        _buffer->close();
+    } catch (...) {
+    }
+}
+
+void ChunkedCompressionOutputStream::close()
+{
+    _buffer->close();
+}
+
+/************************************************************************/
+/* Input                                                                */
+/************************************************************************/
+class ChunkedCompressionInputStream::InputBuffer : public std::streambuf
+{
+public:
+    InputBuffer(std::istream& source)
+        : _source(source)
+    {
+        char magic[sizeof(ChunkedMagic)];
+        _source.read(magic, sizeof(magic));
+        if (!_source || std::memcmp(magic, ChunkedMagic, sizeof(ChunkedMagic)) != 0) {
+            throw std::runtime_error("No chunked data detected.");
+        }
+        if (readValue<uint32_t>(_source) > ContainerVersion) {
+            throw std::runtime_error("Container version not supported.");
+        }
+        _codec = static_cast<CompressionCodec>(readValue<uint8_t>(_source));
+        _offset = sizeof(ChunkedMagic) + sizeof(uint32_t) + sizeof(uint8_t);
+        setg(nullptr, nullptr, nullptr);
+    }
+
+    ~InputBuffer()
+    {
+        //pending jobs reference nothing from this object but their results should be collected
+        for (auto& block : _pendingBlocks) {
+            block.wait();
+        }
+    }
+
+protected:
+    int_type underflow() override
+    {
+        if (gptr() < egptr()) {
+            return traits_type::to_int_type(*gptr());
+        }
+        readAhead();
+        if (_pendingBlocks.empty()) {
+            return traits_type::eof();
+        }
+        _buffer = _pendingBlocks.front().get();
+        _pendingBlocks.pop_front();
+        readAhead();
+
+        setg(_buffer.data(), _buffer.data(), _buffer.data() + _buffer.size());
+        if (_buffer.empty()) {
+            return underflow();
+        }
+        return traits_type::to_int_type(*gptr());
+    }
+
+private:
+    //reads compressed blocks from the source and schedules their decompression
+    void readAhead()
+    {
+        while (!_endReached && toInt(_pendingBlocks.size()) < getMaxBlocksInFlight()) {
+            auto block = std::make_shared<Block>();
+            block->uncompressedSize = readValue<uint32_t>(_source);
+            auto compressedSize = readValue<uint32_t>(_source);
+            if (block->uncompressedSize == 0 && compressedSize == 0) {
+                _endReached = true;
+                validateIndex();
+                return;
+            }
+            if (block->uncompressedSize > BlockSize || compressedSize > compressBound(BlockSize)) {
+                throw std::runtime_error("Compressed data are corrupted.");
+            }
+            block->data.resize(compressedSize);
+            _source.read(block->data.data(), compressedSize);
+            if (!_source) {
+                throw std::runtime_error("Unexpected end of compressed data.");
+            }
+            _readBlocks.emplace_back(BlockIndexEntry{_offset, compressedSize, block->uncompressedSize});
+            _offset += 2 * sizeof(uint32_t) + compressedSize;
+
+            auto codec = _codec;
+            _pendingBlocks.emplace_back(ThreadPool::getInstance().submit([block, codec] { return decompressBlock(*block, codec); }));
+        }
+    }
+
+    //compares the trailing block index with the blocks actually read
+    void validateIndex()
+    {
+        auto indexOffset = _offset + 2 * sizeof(uint32_t);
+        auto numEntries = readValue<uint64_t>(_source);
+        if (numEntries != _readBlocks.size()) {
+            throw std::runtime_error("Compressed data are corrupted.");
+        }
+        for (auto const& block : _readBlocks) {
+            auto offset = readValue<uint64_t>(_source);
+            auto compressedSize = readValue<uint32_t>(_source);
+            auto uncompressedSize = readValue<uint32_t>(_source);
+            if (offset != block.offset || compressedSize != block.compressedSize || uncompressedSize != block.uncompressedSize) {
+                throw std::runtime_error("Compressed data are corrupted.");
+            }
+        }
+        char magic[sizeof(ChunkedMagic)];
+        if (readValue<uint64_t>(_source) != indexOffset || !_source.read(magic, sizeof(magic))
+            || std::memcmp(magic, ChunkedMagic, sizeof(ChunkedMagic)) != 0) {
+            throw std::runtime_error("Compressed data are corrupted.");
+        }
+        _readBlocks.clear();
+    }
+
+    std::istream& _source;
+    CompressionCodec _codec = CompressionCodec::Deflate;
+    std::vector<char> _buffer;
+    std::deque<std::future<std::vector<char>>> _pendingBlocks;
+    std::vector<BlockIndexEntry> _readBlocks;
+    uint64_t _offset = 0;
+    bool _endReached = false;
+};
+
+ChunkedCompressionInputStream::ChunkedCompressionInputStream(std::istream& source)
+    : std::istream(nullptr)
+    , _buffer(std::make_unique<InputBuffer>(source))
+{
+    rdbuf(_buffer.get());
+}
+
+ChunkedCompressionInputStream::~ChunkedCompressionInputStream() = default;
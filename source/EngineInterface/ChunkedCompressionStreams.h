@@ -0,0 +1,53 @@
+#pragma once
+
+#include <istream>
+#include <memory>
+#include <ostream>
+
+#include "Base/Definitions.h"
+
+enum class CompressionCodec
+{
+    Deflate,
+    DeflateFast,
+    None
+};
+
+/**
+ * Container for large binary data consisting of independently compressed blocks, which are compressed and decompressed
+ * in parallel on the thread pool.
+ *
+ * Layout: magic, version, codec, blocks (each with uncompressed and compressed size), end marker, block index
+ * (offset and sizes of each block), index offset, magic. The input stream checks the block index against the blocks it
+ * has read and fails on a mismatch.
+ */
+class ChunkedCompressionService
+{
+public:
+    static bool isChunkedFormat(std::istream& stream);  //reads the magic and restores the stream position
+};
+
+class ChunkedCompressionOutputStream : public std::ostream
+{
+public:
+    ChunkedCompressionOutputStream(std::ostream& target, CompressionCodec codec = CompressionCodec::Deflate);
+    ~ChunkedCompressionOutputStream();
+
+    //flushes the remaining blocks and writes the index
+    void close();
+
+private:
+    class OutputBuffer;
+    std::unique_ptr<OutputBuffer> _buffer;
+};
+
+class ChunkedCompressionInputStream : public std::istream
+{
+public:
+    ChunkedCompressionInputStream(std::istream& source);
+    ~ChunkedCompressionInputStream();
+
+private:
+    class InputBuffer;
+    std::unique_ptr<InputBuffer> _buffer;
+};
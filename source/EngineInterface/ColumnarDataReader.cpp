@@ -0,0 +1,70 @@
+#include "ColumnarDataReader.h"
+
+#include <fstream>
+#include <stdexcept>
+#include <zstr.hpp>
+
+#include "ChunkedCompressionStreams.h"
+
+struct _ColumnarDataReader::Streams
+{
+    std::ifstream fileStream;
+    std::unique_ptr<std::istream> decompressedStream;
+};
+
+namespace
+{
+    std::unique_ptr<std::istream> createDecompressedStream(std::istream& stream)
+    {
+        if (ChunkedCompressionService::isChunkedFormat(stream)) {
+            return std::make_unique<ChunkedCompressionInputStream>(stream);
+        } else {
+            return std::make_unique<zstr::istream>(stream);
+        }
+    }
+}
+
+_ColumnarDataReader::_ColumnarDataReader(std::string const& filename)
+    : _streams(std::make_unique<Streams>())
+{
+    _streams->fileStream.open(filename, std::ios::binary);
+    if (!_streams->fileStream) {
+        throw std::runtime_error("Could not open " + filename + ".");
+    }
+    _streams->decompressedStream = createDecompressedStream(_streams->fileStream);
+    if (!ColumnarSerializerService::isColumnarFormat(*_streams->decompressedStream)) {
+        throw std::runtime_error("No columnar data detected.");
+    }
+    _header = ColumnarSerializerService::readHeader(*_streams->decompressedStream);
+}
+
+_ColumnarDataReader::~_ColumnarDataReader() = default;
+
+bool _ColumnarDataReader::isColumnarFile(std::string const& filename)
+{
+    try {
+        std::ifstream fileStream(filename, std::ios::binary);
+        if (!fileStream) {
+            return false;
+        }
+        auto decompressedStream = createDecompressedStream(fileStream);
+        return ColumnarSerializerService::isColumnarFormat(*decompressedStream);
+    } catch (...) {
+        return false;
+    }
+}
+
+ColumnarHeader const& _ColumnarDataReader::getHeader() const
+{
+    return _header;
+}
+
+bool _ColumnarDataReader::readSegment(ColumnarSegment& segment)
+{
+    if (_numReadSegments == _header.numSegments) {
+        return false;
+    }
+    ColumnarSerializerService::readSegment(segment, _header, *_streams->decompressedStream);
+    ++_numReadSegments;
+    return true;
+}
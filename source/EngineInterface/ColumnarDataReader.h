@@ -0,0 +1,27 @@
+#pragma once
+
+#include "Base/Definitions.h"
+
+#include "ColumnarSerializerService.h"
+#include "Definitions.h"
+
+//reads a simulation file in columnar format segment by segment without building descriptions
+class _ColumnarDataReader
+{
+public:
+    _ColumnarDataReader(std::string const& filename);  //throws if the file is not in columnar format
+    ~_ColumnarDataReader();
+
+    static bool isColumnarFile(std::string const& filename);
+
+    ColumnarHeader const& getHeader() const;
+
+    //returns false if all segments have already been read
+    bool readSegment(ColumnarSegment& segment);
+
+private:
+    struct Streams;
+    std::unique_ptr<Streams> _streams;
+    ColumnarHeader _header;
+    uint64_t _numReadSegments = 0;
+};
@@ -0,0 +1,927 @@
+#include "ColumnarSerializerService.h"
+
+#include <bit>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_set>
+
+#include "Base/Resources.h"
+#include "Base/VersionChecker.h"
+
+#include "Descriptions.h"
+
+//columns are written as raw memory blocks
+static_assert(std::endian::native == std::endian::little);
+
+namespace
+{
+    char const ColumnarMagic[] = {'A', 'L', 'I', 'E', 'N', 'C', 'O', 'L'};
+    auto constexpr SchemaVersion = 2;  //version 2: genome references and per-cell genome sizes
+    auto constexpr SegmentSize = 1 << 16;   //cells or particles per segment
+
+    auto constexpr ColumnId_ClusterSizes = 0;
+
+    auto constexpr ColumnId_CellIds = 10;
+    auto constexpr ColumnId_CellPosX = 11;
+    auto constexpr ColumnId_CellPosY = 12;
+    auto constexpr ColumnId_CellVelX = 13;
+    auto constexpr ColumnId_CellVelY = 14;
+    auto constexpr ColumnId_CellEnergies = 15;
+    auto constexpr ColumnId_CellStiffnesses = 16;
+    auto constexpr ColumnId_CellColors = 17;
+    auto constexpr ColumnId_CellMaxConnections = 18;
+    auto constexpr ColumnId_CellBarriers = 19;
+    auto constexpr ColumnId_CellAges = 20;
+    auto constexpr ColumnId_CellLivingStates = 21;
+    auto constexpr ColumnId_CellCreatureIds = 22;
+    auto constexpr ColumnId_CellMutationIds = 23;
+    auto constexpr ColumnId_CellAncestorMutationIds = 24;
+    auto constexpr ColumnId_CellGenomeComplexities = 25;
+    auto constexpr ColumnId_CellExecutionOrderNumbers = 26;
+    auto constexpr ColumnId_CellInputExecutionOrderNumbers = 27;
+    auto constexpr ColumnId_CellOutputBlocked = 28;
+    auto constexpr ColumnId_CellActivationTimes = 29;
+    auto constexpr ColumnId_CellDetectedByCreatureIds = 30;
+    auto constexpr ColumnId_CellCellFunctionUsed = 31;
+    auto constexpr ColumnId_CellFunctions = 32;
+
+    auto constexpr ColumnId_CellNumConnections = 40;
+    auto constexpr ColumnId_ConnectionCellIndices = 41;
+    auto constexpr ColumnId_ConnectionDistances = 42;
+    auto constexpr ColumnId_ConnectionAngles = 43;
+
+    auto constexpr ColumnId_ActivityChannels = 50;
+    auto constexpr ColumnId_ActivityOrigins = 51;
+    auto constexpr ColumnId_ActivityTargetX = 52;
+    auto constexpr ColumnId_ActivityTargetY = 53;
+
+    auto constexpr ColumnId_MetadataNameSizes = 60;
+    auto constexpr ColumnId_MetadataNames = 61;
+    auto constexpr ColumnId_MetadataDescriptionSizes = 62;
+    auto constexpr ColumnId_MetadataDescriptions = 63;
+
+    auto constexpr ColumnId_CellFunctionData = 70;
+    auto constexpr ColumnId_GenomeSizes = 71;
+    auto constexpr ColumnId_GenomeData = 72;
+    auto constexpr ColumnId_GenomeRefs = 73;
+
+    auto constexpr ColumnId_ParticleIds = 100;
+    auto constexpr ColumnId_ParticlePosX = 101;
+    auto constexpr ColumnId_ParticlePosY = 102;
+    auto constexpr ColumnId_ParticleVelX = 103;
+    auto constexpr ColumnId_ParticleVelY = 104;
+    auto constexpr ColumnId_ParticleEnergies = 105;
+    auto constexpr ColumnId_ParticleColors = 106;
+
+    enum class ColumnGroup
+    {
+        Required,
+        Activity,
+        Metadata,
+        CellFunction
+    };
+
+    template <typename Segment, typename Visitor>
+    void visitColumns(Segment& segment, Visitor const& visitor)
+    {
+        visitor(ColumnId_ClusterSizes, ColumnGroup::Required, segment.clusterSizes);
+
+        visitor(ColumnId_CellIds, ColumnGroup::Required, segment.cellIds);
+        visitor(ColumnId_CellPosX, ColumnGroup::Required, segment.cellPosX);
+        visitor(ColumnId_CellPosY, ColumnGroup::Required, segment.cellPosY);
+        visitor(ColumnId_CellVelX, ColumnGroup::Required, segment.cellVelX);
+        visitor(ColumnId_CellVelY, ColumnGroup::Required, segment.cellVelY);
+        visitor(ColumnId_CellEnergies, ColumnGroup::Required, segment.cellEnergies);
+        visitor(ColumnId_CellStiffnesses, ColumnGroup::Required, segment.cellStiffnesses);
+        visitor(ColumnId_CellColors, ColumnGroup::Required, segment.cellColors);
+        visitor(ColumnId_CellMaxConnections, ColumnGroup::Required, segment.cellMaxConnections);
+        visitor(ColumnId_CellBarriers, ColumnGroup::Required, segment.cellBarriers);
+        visitor(ColumnId_CellAges, ColumnGroup::Required, segment.cellAges);
+        visitor(ColumnId_CellLivingStates, ColumnGroup::Required, segment.cellLivingStates);
+        visitor(ColumnId_CellCreatureIds, ColumnGroup::Required, segment.cellCreatureIds);
+        visitor(ColumnId_CellMutationIds, ColumnGroup::Required, segment.cellMutationIds);
+        visitor(ColumnId_CellAncestorMutationIds, ColumnGroup::Required, segment.cellAncestorMutationIds);
+        visitor(ColumnId_CellGenomeComplexities, ColumnGroup::Required, segment.cellGenomeComplexities);
+        visitor(ColumnId_CellExecutionOrderNumbers, ColumnGroup::Required, segment.cellExecutionOrderNumbers);
+        visitor(ColumnId_CellInputExecutionOrderNumbers, ColumnGroup::Required, segment.cellInputExecutionOrderNumbers);
+        visitor(ColumnId_CellOutputBlocked, ColumnGroup::Required, segment.cellOutputBlocked);
+        visitor(ColumnId_CellActivationTimes, ColumnGroup::Required, segment.cellActivationTimes);
+        visitor(ColumnId_CellDetectedByCreatureIds, ColumnGroup::Required, segment.cellDetectedByCreatureIds);
+        visitor(ColumnId_CellCellFunctionUsed, ColumnGroup::Required, segment.cellCellFunctionUsed);
+        visitor(ColumnId_CellFunctions, ColumnGroup::Required, segment.cellFunctions);
+
+        visitor(ColumnId_CellNumConnections, ColumnGroup::Required, segment.cellNumConnections);
+        visitor(ColumnId_ConnectionCellIndices, ColumnGroup::Required, segment.connectionCellIndices);
+        visitor(ColumnId_ConnectionDistances, ColumnGroup::Required, segment.connectionDistances);
+        visitor(ColumnId_ConnectionAngles, ColumnGroup::Required, segment.connectionAngles);
+
+        visitor(ColumnId_ActivityChannels, ColumnGroup::Activity, segment.activityChannels);
+        visitor(ColumnId_ActivityOrigins, ColumnGroup::Activity, segment.activityOrigins);
+        visitor(ColumnId_ActivityTargetX, ColumnGroup::Activity, segment.activityTargetX);
+        visitor(ColumnId_ActivityTargetY, ColumnGroup::Activity, segment.activityTargetY);
+
+        visitor(ColumnId_MetadataNameSizes, ColumnGroup::Metadata, segment.metadataNameSizes);
+        visitor(ColumnId_MetadataNames, ColumnGroup::Metadata, segment.metadataNames);
+        visitor(ColumnId_MetadataDescriptionSizes, ColumnGroup::Metadata, segment.metadataDescriptionSizes);
+        visitor(ColumnId_MetadataDescriptions, ColumnGroup::Metadata, segment.metadataDescriptions);
+
+        visitor(ColumnId_CellFunctionData, ColumnGroup::CellFunction, segment.cellFunctionData);
+        visitor(ColumnId_GenomeSizes, ColumnGroup::CellFunction, segment.genomeSizes);
+        visitor(ColumnId_GenomeData, ColumnGroup::CellFunction, segment.genomeData);
+        visitor(ColumnId_GenomeRefs, ColumnGroup::CellFunction, segment.genomeRefs);
+
+        visitor(ColumnId_ParticleIds, ColumnGroup::Required, segment.particleIds);
+        visitor(ColumnId_ParticlePosX, ColumnGroup::Required, segment.particlePosX);
+        visitor(ColumnId_ParticlePosY, ColumnGroup::Required, segment.particlePosY);
+        visitor(ColumnId_ParticleVelX, ColumnGroup::Required, segment.particleVelX);
+        visitor(ColumnId_ParticleVelY, ColumnGroup::Required, segment.particleVelY);
+        visitor(ColumnId_ParticleEnergies, ColumnGroup::Required, segment.particleEnergies);
+        visitor(ColumnId_ParticleColors, ColumnGroup::Required, segment.particleColors);
+    }
+
+    void writeRaw(std::ostream& stream, void const* data, size_t size)
+    {
+        stream.write(reinterpret_cast<char const*>(data), size);
+    }
+
+    template <typename T>
+    void writeValue(std::ostream& stream, T const& value)
+    {
+        writeRaw(stream, &value, sizeof(T));
+    }
+
+    void writeString(std::ostream& stream, std::string const& value)
+    {
+        writeValue(stream, static_cast<uint32_t>(value.size()));
+        writeRaw(stream, value.data(), value.size());
+    }
+
+    void readRaw(std::istream& stream, void* data, size_t size)
+    {
+        stream.read(reinterpret_cast<char*>(data), size);
+        if (!stream) {
+            throw std::runtime_error("Unexpected end of columnar data.");
+        }
+    }
+
+    template <typename T>
+    T readValue(std::istream& stream)
+    {
+        T result;
+        readRaw(stream, &result, sizeof(T));
+        return result;
+    }
+
+    std::string readString(std::istream& stream)
+    {
+        auto size = readValue<uint32_t>(stream);
+        std::string result(size, '\0');
+        readRaw(stream, result.data(), size);
+        return result;
+    }
+
+    //packed records of cell function data
+    template <typename T>
+    void appendValue(std::vector<uint8_t>& data, T const& value)
+    {
+        auto pos = data.size();
+        data.resize(pos + sizeof(T));
+        std::memcpy(data.data() + pos, &value, sizeof(T));
+    }
+
+    template <typename T>
+    void fillUp(std::vector<T>& column, size_t size, T const& defaultValue)
+    {
+        if (column.size() < size) {
+            column.resize(size, defaultValue);
+        }
+    }
+
+    std::optional<int> toOptional(int32_t value)
+    {
+        return value >= 0 ? std::make_optional(static_cast<int>(value)) : std::nullopt;
+    }
+
+    bool hasDefaultActivity(CellDescription const& cell)
+    {
+        static ActivityDescription const defaultActivity;
+        return cell.activity == defaultActivity;
+    }
+
+    std::vector<uint8_t> const& getGenome(CellDescription const& cell)
+    {
+        if (cell.getCellFunctionType() == CellFunction_Constructor) {
+            return std::get<ConstructorDescription>(*cell.cellFunction).genome;
+        }
+        return std::get<InjectorDescription>(*cell.cellFunction).genome;
+    }
+
+    std::string_view getContent(std::vector<uint8_t> const& genome)
+    {
+        return {reinterpret_cast<char const*>(genome.data()), genome.size()};
+    }
+}
+
+void ColumnarSegment::clear()
+{
+    visitColumns(*this, [](int, ColumnGroup, auto& column) { column.clear(); });
+}
+
+std::vector<uint64_t> ColumnarSegment::getGenomeDataIndices() const
+{
+    std::vector<uint64_t> result;
+    result.reserve(genomeSizes.size());
+    uint64_t genomeDataIndex = 0;
+    for (auto const& genomeSize : genomeSizes) {
+        result.emplace_back(genomeDataIndex);
+        genomeDataIndex += genomeSize;
+    }
+    return result;
+}
+
+bool ColumnarSerializerService::isColumnarFormat(std::istream& stream)
+{
+    return stream.peek() == ColumnarMagic[0];
+}
+
+void ColumnarSerializerService::serialize(ClusteredDataDescription const& data, std::ostream& stream)
+{
+    //gather header information
+    ColumnarHeader header;
+    header.programVersion = Const::ProgramVersion;
+    header.schemaVersion = SchemaVersion;
+    header.numClusters = data.clusters.size();
+    header.numParticles = data.particles.size();
+
+    bool hasActivities = false;
+    bool hasMetadata = false;
+    bool hasCellFunctions = false;
+    std::unordered_map<uint64_t, int64_t> cellIndexById;
+    for (auto const& cluster : data.clusters) {
+        for (auto const& cell : cluster.cells) {
+            cellIndexById.emplace(cell.id, toInt(header.numCells));
+            ++header.numCells;
+            header.numConnections += cell.connections.size();
+            header.metadataBytes += cell.metadata.name.size() + cell.metadata.description.size();
+            hasActivities |= !hasDefaultActivity(cell);
+            hasMetadata |= !cell.metadata.name.empty() || !cell.metadata.description.empty();
+            hasCellFunctions |= cell.cellFunction.has_value();
+            if (cell.hasGenome()) {
+                header.cellGenomeBytes += getGenome(cell).size();
+            }
+            if (cell.getCellFunctionType() == CellFunction_Neuron) {
+                ++header.numNeurons;
+            }
+        }
+    }
+
+    //determine segments consisting of whole clusters
+    std::vector<size_t> clusterSegmentBounds{0};
+    size_t cellsInSegment = 0;
+    for (size_t i = 0; i < data.clusters.size(); ++i) {
+        cellsInSegment += data.clusters[i].cells.size();
+        if (cellsInSegment >= SegmentSize) {
+            clusterSegmentBounds.emplace_back(i + 1);
+            cellsInSegment = 0;
+        }
+    }
+    if (clusterSegmentBounds.back() != data.clusters.size()) {
+        clusterSegmentBounds.emplace_back(data.clusters.size());
+    }
+    auto numClusterSegments = clusterSegmentBounds.size() - 1;
+
+    //genomes are stored once per segment
+    for (size_t i = 0; i < numClusterSegments; ++i) {
+        std::unordered_set<std::string_view> genomes;
+        for (auto clusterIndex = clusterSegmentBounds[i]; clusterIndex < clusterSegmentBounds[i + 1]; ++clusterIndex) {
+            for (auto const& cell : data.clusters[clusterIndex].cells) {
+                if (cell.hasGenome() && genomes.insert(getContent(getGenome(cell))).second) {
+                    header.genomeBytes += getGenome(cell).size();
+                }
+            }
+        }
+    }
+
+    auto numParticleSegments = (data.particles.size() + SegmentSize - 1) / SegmentSize;
+    header.numSegments = std::max(numClusterSegments, numParticleSegments);
+
+    auto isColumnPresent = [&](ColumnGroup group) {
+        switch (group) {
+        case ColumnGroup::Activity:
+            return hasActivities;
+        case ColumnGroup::Metadata:
+            return hasMetadata;
+        case ColumnGroup::CellFunction:
+            return hasCellFunctions;
+        default:
+            return true;
+        }
+    };
+    ColumnarSegment segment;
+    visitColumns(segment, [&](int columnId, ColumnGroup group, auto& column) {
+        if (isColumnPresent(group)) {
+            header.schema.emplace_back(static_cast<uint16_t>(columnId), static_cast<uint8_t>(sizeof(column[0])));
+        }
+    });
+
+    //write header
+    writeRaw(stream, ColumnarMagic, sizeof(ColumnarMagic));
+    writeString(stream, header.programVersion);
+    writeValue(stream, header.schemaVersion);
+    writeValue(stream, header.numSegments);
+    writeValue(stream, header.numClusters);
+    writeValue(stream, header.numCells);
+    writeValue(stream, header.numParticles);
+    writeValue(stream, header.numConnections);
+    writeValue(stream, header.numNeurons);
+    writeValue(stream, header.genomeBytes);
+    writeValue(stream, header.cellGenomeBytes);
+    writeValue(stream, header.metadataBytes);
+    writeValue(stream, static_cast<uint32_t>(header.schema.size()));
+    for (auto const& entry : header.schema) {
+        writeValue(stream, entry.columnId);
+        writeValue(stream, entry.elementSize);
+    }
+
+    //write segments
+    for (size_t i = 0; i < header.numSegments; ++i) {
+        auto clusterBegin = i < numClusterSegments ? clusterSegmentBounds[i] : data.clusters.size();
+        auto clusterEnd = i < numClusterSegments ? clusterSegmentBounds[i + 1] : data.clusters.size();
+        auto particleBegin = std::min(i * SegmentSize, data.particles.size());
+        auto particleEnd = std::min((i + 1) * SegmentSize, data.particles.size());
+        fillSegment(segment, data, clusterBegin, clusterEnd, particleBegin, particleEnd, cellIndexById);
+
+        visitColumns(segment, [&](int, ColumnGroup group, auto const& column) {
+            if (isColumnPresent(group)) {
+                auto byteSize = static_cast<uint64_t>(column.size() * sizeof(column[0]));
+                writeValue(stream, byteSize);
+                writeRaw(stream, column.data(), byteSize);
+            }
+        });
+    }
+}
+
+void ColumnarSerializerService::deserialize(ClusteredDataDescription& data, std::istream& stream)
+{
+    auto header = readHeader(stream);
+
+    data.clear();
+    data.clusters.reserve(header.numClusters);
+    data.particles.reserve(header.numParticles);
+
+    ColumnarSegment segment;
+    for (uint64_t i = 0; i < header.numSegments; ++i) {
+        readSegment(segment, header, stream);
+        convertSegmentToDescription(data, segment);
+    }
+
+    //connections temporarily hold the cell index + 1 and are now resolved to cell ids
+    std::vector<uint64_t> cellIds;
+    cellIds.reserve(header.numCells);
+    for (auto const& cluster : data.clusters) {
+        for (auto const& cell : cluster.cells) {
+            cellIds.emplace_back(cell.id);
+        }
+    }
+    for (auto& cluster : data.clusters) {
+        for (auto& cell : cluster.cells) {
+            for (auto& connection : cell.connections) {
+                if (connection.cellId != 0) {
+                    auto cellIndex = connection.cellId - 1;
+                    connection.cellId = cellIndex < cellIds.size() ? cellIds[cellIndex] : 0;
+                }
+            }
+        }
+    }
+}
+
+ColumnarHeader ColumnarSerializerService::readHeader(std::istream& stream)
+{
+    char magic[sizeof(ColumnarMagic)];
+    readRaw(stream, magic, sizeof(magic));
+    if (std::memcmp(magic, ColumnarMagic, sizeof(ColumnarMagic)) != 0) {
+        throw std::runtime_error("No columnar data detected.");
+    }
+
+    ColumnarHeader result;
+    result.programVersion = readString(stream);
+    if (!VersionChecker::isVersionValid(result.programVersion)) {
+        throw std::runtime_error("No version detected.");
+    }
+    if (VersionChecker::isVersionOutdated(result.programVersion)) {
+        throw std::runtime_error("Version not supported.");
+    }
+    result.schemaVersion = readValue<uint32_t>(stream);
+    if (result.schemaVersion > SchemaVersion) {
+        throw std::runtime_error("Schema version not supported.");
+    }
+    result.numSegments = readValue<uint64_t>(stream);
+    result.numClusters = readValue<uint64_t>(stream);
+    result.numCells = readValue<uint64_t>(stream);
+    result.numParticles = readValue<uint64_t>(stream);
+    result.numConnections = readValue<uint64_t>(stream);
+    result.numNeurons = readValue<uint64_t>(stream);
+    result.genomeBytes = readValue<uint64_t>(stream);
+    result.cellGenomeBytes = result.schemaVersion >= 2 ? readValue<uint64_t>(stream) : result.genomeBytes;
+    result.metadataBytes = readValue<uint64_t>(stream);
+    auto numColumns = readValue<uint32_t>(stream);
+    result.schema.reserve(numColumns);
+    for (uint32_t i = 0; i < numColumns; ++i) {
+        ColumnarSchemaEntry entry;
+        entry.columnId = readValue<uint16_t>(stream);
+        entry.elementSize = readValue<uint8_t>(stream);
+        result.schema.emplace_back(entry);
+    }
+    return result;
+}
+
+void ColumnarSerializerService::readSegment(ColumnarSegment& segment, ColumnarHeader const& header, std::istream& stream)
+{
+    segment.clear();
+
+    std::unordered_map<int, std::function<void(uint8_t, uint64_t)>> columnReaders;
+    visitColumns(segment, [&](int columnId, ColumnGroup, auto& column) {
+        columnReaders.emplace(columnId, [&stream, &column](uint8_t elementSize, uint64_t byteSize) {
+            if (elementSize != sizeof(column[0]) || byteSize % elementSize != 0) {
+                stream.ignore(byteSize);
+                return;
+            }
+            column.resize(byteSize / elementSize);
+            readRaw(stream, column.data(), byteSize);
+        });
+    });
+
+    for (auto const& entry : header.schema) {
+        auto byteSize = readValue<uint64_t>(stream);
+        auto findResult = columnReaders.find(entry.columnId);
+        if (findResult != columnReaders.end()) {
+            findResult->second(entry.elementSize, byteSize);
+        } else {
+            stream.ignore(byteSize);
+        }
+    }
+    normalizeSegment(segment, header);
+}
+
+void ColumnarSerializerService::normalizeSegment(ColumnarSegment& segment, ColumnarHeader const& header)
+{
+    auto numCells = segment.getNumCells();
+    uint64_t numClusterCells = 0;
+    for (auto const& clusterSize : segment.clusterSizes) {
+        numClusterCells += clusterSize;
+    }
+    if (numClusterCells != numCells) {
+        throw std::runtime_error("Invalid segment.");
+    }
+
+    //missing columns are filled with default values
+    CellDescription defaultCell;
+    fillUp(segment.cellPosX, numCells, 0.0f);
+    fillUp(segment.cellPosY, numCells, 0.0f);
+    fillUp(segment.cellVelX, numCells, 0.0f);
+    fillUp(segment.cellVelY, numCells, 0.0f);
+    fillUp(segment.cellEnergies, numCells, defaultCell.energy);
+    fillUp(segment.cellStiffnesses, numCells, defaultCell.stiffness);
+    fillUp<int32_t>(segment.cellColors, numCells, defaultCell.color);
+    fillUp<int32_t>(segment.cellMaxConnections, numCells, defaultCell.maxConnections);
+    fillUp<uint8_t>(segment.cellBarriers, numCells, defaultCell.barrier ? 1 : 0);
+    fillUp<int32_t>(segment.cellAges, numCells, defaultCell.age);
+    fillUp<int32_t>(segment.cellLivingStates, numCells, defaultCell.livingState);
+    fillUp<int32_t>(segment.cellCreatureIds, numCells, defaultCell.creatureId);
+    fillUp<int32_t>(segment.cellMutationIds, numCells, defaultCell.mutationId);
+    fillUp<int32_t>(segment.cellAncestorMutationIds, numCells, defaultCell.ancestorMutationId);
+    fillUp(segment.cellGenomeComplexities, numCells, defaultCell.genomeComplexity);
+    fillUp<int32_t>(segment.cellExecutionOrderNumbers, numCells, defaultCell.executionOrderNumber);
+    fillUp<int32_t>(segment.cellInputExecutionOrderNumbers, numCells, -1);
+    fillUp<uint8_t>(segment.cellOutputBlocked, numCells, defaultCell.outputBlocked ? 1 : 0);
+    fillUp<int32_t>(segment.cellActivationTimes, numCells, defaultCell.activationTime);
+    fillUp(segment.cellDetectedByCreatureIds, numCells, defaultCell.detectedByCreatureId);
+    fillUp(segment.cellCellFunctionUsed, numCells, defaultCell.cellFunctionUsed);
+    fillUp<uint8_t>(segment.cellFunctions, numCells, CellFunction_None);
+
+    fillUp<uint8_t>(segment.cellNumConnections, numCells, 0);
+    uint64_t numConnections = 0;
+    for (auto const& cellNumConnections : segment.cellNumConnections) {
+        numConnections += cellNumConnections;
+    }
+    fillUp<int64_t>(segment.connectionCellIndices, numConnections, -1);
+    fillUp(segment.connectionDistances, numConnections, 0.0f);
+    fillUp(segment.connectionAngles, numConnections, 0.0f);
+    for (auto& connectionCellIndex : segment.connectionCellIndices) {
+        if (connectionCellIndex >= static_cast<int64_t>(header.numCells)) {
+            connectionCellIndex = -1;
+        }
+    }
+
+    fillUp(segment.activityChannels, numCells * MAX_CHANNELS, 0.0f);
+    fillUp(segment.activityOrigins, numCells, defaultCell.activity.origin);
+    fillUp(segment.activityTargetX, numCells, 0.0f);
+    fillUp(segment.activityTargetY, numCells, 0.0f);
+
+    fillUp<uint32_t>(segment.metadataNameSizes, numCells, 0);
+    fillUp<uint32_t>(segment.metadataDescriptionSizes, numCells, 0);
+    uint64_t numNameBytes = 0;
+    uint64_t numDescriptionBytes = 0;
+    for (uint64_t i = 0; i < numCells; ++i) {
+        numNameBytes += segment.metadataNameSizes[i];
+        numDescriptionBytes += segment.metadataDescriptionSizes[i];
+    }
+    if (numNameBytes > segment.metadataNames.size() || numDescriptionBytes > segment.metadataDescriptions.size()) {
+        throw std::runtime_error("Invalid metadata.");
+    }
+
+    uint64_t numGenomes = 0;
+    for (auto const& cellFunction : segment.cellFunctions) {
+        if (cellFunction == CellFunction_Constructor || cellFunction == CellFunction_Injector) {
+            ++numGenomes;
+        }
+    }
+    if (segment.genomeRefs.empty()) {
+        //schema version 1 stores each genome separately
+        for (uint64_t i = 0; i < std::min(numGenomes, static_cast<uint64_t>(segment.genomeSizes.size())); ++i) {
+            segment.genomeRefs.emplace_back(static_cast<uint32_t>(i));
+        }
+    }
+    uint64_t numGenomeBytes = 0;
+    for (auto const& genomeSize : segment.genomeSizes) {
+        numGenomeBytes += genomeSize;
+    }
+    if (numGenomes > segment.genomeRefs.size() || numGenomeBytes > segment.genomeData.size()) {
+        throw std::runtime_error("Invalid genome data.");
+    }
+    for (auto const& genomeRef : segment.genomeRefs) {
+        if (genomeRef >= segment.genomeSizes.size()) {
+            throw std::runtime_error("Invalid genome data.");
+        }
+    }
+
+    auto numParticles = segment.getNumParticles();
+    ParticleDescription defaultParticle;
+    fillUp(segment.particlePosX, numParticles, 0.0f);
+    fillUp(segment.particlePosY, numParticles, 0.0f);
+    fillUp(segment.particleVelX, numParticles, 0.0f);
+    fillUp(segment.particleVelY, numParticles, 0.0f);
+    fillUp(segment.particleEnergies, numParticles, defaultParticle.energy);
+    fillUp<int32_t>(segment.particleColors, numParticles, defaultParticle.color);
+}
+
+void ColumnarSerializerService::fillSegment(
+    ColumnarSegment& segment,
+    ClusteredDataDescription const& data,
+    size_t clusterBegin,
+    size_t clusterEnd,
+    size_t particleBegin,
+    size_t particleEnd,
+    std::unordered_map<uint64_t, int64_t> const& cellIndexById)
+{
+    segment.clear();
+
+    //identical genomes are stored once, the views point into the genomes of data
+    std::unordered_map<std::string_view, uint32_t> genomeRefByContent;
+    for (auto clusterIndex = clusterBegin; clusterIndex < clusterEnd; ++clusterIndex) {
+        auto const& cluster = data.clusters[clusterIndex];
+        segment.clusterSizes.emplace_back(static_cast<uint32_t>(cluster.cells.size()));
+
+        for (auto const& cell : cluster.cells) {
+            segment.cellIds.emplace_back(cell.id);
+            segment.cellPosX.emplace_back(cell.pos.x);
+            segment.cellPosY.emplace_back(cell.pos.y);
+            segment.cellVelX.emplace_back(cell.vel.x);
+            segment.cellVelY.emplace_back(cell.vel.y);
+            segment.cellEnergies.emplace_back(cell.energy);
+            segment.cellStiffnesses.emplace_back(cell.stiffness);
+            segment.cellColors.emplace_back(cell.color);
+            segment.cellMaxConnections.emplace_back(cell.maxConnections);
+            segment.cellBarriers.emplace_back(cell.barrier ? 1 : 0);
+            segment.cellAges.emplace_back(cell.age);
+            segment.cellLivingStates.emplace_back(cell.livingState);
+            segment.cellCreatureIds.emplace_back(cell.creatureId);
+            segment.cellMutationIds.emplace_back(cell.mutationId);
+            segment.cellAncestorMutationIds.emplace_back(cell.ancestorMutationId);
+            segment.cellGenomeComplexities.emplace_back(cell.genomeComplexity);
+            segment.cellExecutionOrderNumbers.emplace_back(cell.executionOrderNumber);
+            segment.cellInputExecutionOrderNumbers.emplace_back(cell.inputExecutionOrderNumber.value_or(-1));
+            segment.cellOutputBlocked.emplace_back(cell.outputBlocked ? 1 : 0);
+            segment.cellActivationTimes.emplace_back(cell.activationTime);
+            segment.cellDetectedByCreatureIds.emplace_back(cell.detectedByCreatureId);
+            segment.cellCellFunctionUsed.emplace_back(cell.cellFunctionUsed);
+            segment.cellFunctions.emplace_back(static_cast<uint8_t>(cell.getCellFunctionType()));
+
+            segment.cellNumConnections.emplace_back(static_cast<uint8_t>(cell.connections.size()));
+            for (auto const& connection : cell.connections) {
+                auto findResult = cellIndexById.find(connection.cellId);
+                segment.connectionCellIndices.emplace_back(connection.cellId != 0 && findResult != cellIndexById.end() ? findResult->second : -1);
+                segment.connectionDistances.emplace_back(connection.distance);
+                segment.connectionAngles.emplace_back(connection.angleFromPrevious);
+            }
+
+            segment.activityChannels.insert(segment.activityChannels.end(), cell.activity.channels.begin(), cell.activity.channels.end());
+            segment.activityOrigins.emplace_back(cell.activity.origin);
+            segment.activityTargetX.emplace_back(cell.activity.targetX);
+            segment.activityTargetY.emplace_back(cell.activity.targetY);
+
+            segment.metadataNameSizes.emplace_back(static_cast<uint32_t>(cell.metadata.name.size()));
+            segment.metadataNames.insert(segment.metadataNames.end(), cell.metadata.name.begin(), cell.metadata.name.end());
+            segment.metadataDescriptionSizes.emplace_back(static_cast<uint32_t>(cell.metadata.description.size()));
+            segment.metadataDescriptions.insert(segment.metadataDescriptions.end(), cell.metadata.description.begin(), cell.metadata.description.end());
+
+            auto& record = segment.cellFunctionData;
+            switch (cell.getCellFunctionType()) {
+            case CellFunction_Neuron: {
+                auto const& neuron = std::get<NeuronDescription>(*cell.cellFunction);
+                for (int row = 0; row < MAX_CHANNELS; ++row) {
+                    for (int col = 0; col < MAX_CHANNELS; ++col) {
+                        appendValue(record, neuron.weights[row][col]);
+                    }
+                }
+                for (int i = 0; i < MAX_CHANNELS; ++i) {
+                    appendValue(record, neuron.biases[i]);
+                }
+                for (int i = 0; i < MAX_CHANNELS; ++i) {
+                    appendValue<int32_t>(record, neuron.activationFunctions[i]);
+                }
+            } break;
+            case CellFunction_Transmitter: {
+                auto const& transmitter = std::get<TransmitterDescription>(*cell.cellFunction);
+                appendValue<int32_t>(record, transmitter.mode);
+            } break;
+            case CellFunction_Constructor: {
+                auto const& constructor = std::get<ConstructorDescription>(*cell.cellFunction);
+                appendValue<int32_t>(record, constructor.activationMode);
+                appendValue<int32_t>(record, constructor.constructionActivationTime);
+                appendValue<int32_t>(record, constructor.numInheritedGenomeNodes);
+                appendValue<int32_t>(record, constructor.genomeGeneration);
+                appendValue(record, constructor.constructionAngle1);
+                appendValue(record, constructor.constructionAngle2);
+                appendValue(record, constructor.lastConstructedCellId);
+                appendValue<int32_t>(record, constructor.genomeCurrentNodeIndex);
+                appendValue<int32_t>(record, constructor.genomeCurrentRepetition);
+                appendValue<int32_t>(record, constructor.currentBranch);
+                appendValue<int32_t>(record, constructor.offspringCreatureId);
+                appendValue<int32_t>(record, constructor.offspringMutationId);
+            } break;
+            case CellFunction_Sensor: {
+                auto const& sensor = std::get<SensorDescription>(*cell.cellFunction);
+                appendValue<uint8_t>(record, sensor.fixedAngle.has_value() ? 1 : 0);
+                appendValue(record, sensor.fixedAngle.value_or(0.0f));
+                appendValue(record, sensor.minDensity);
+                appendValue<int32_t>(record, sensor.minRange.value_or(-1));
+                appendValue<int32_t>(record, sensor.maxRange.value_or(-1));
+                appendValue<int32_t>(record, sensor.restrictToColor.value_or(-1));
+                appendValue<int32_t>(record, sensor.restrictToMutants);
+                appendValue(record, sensor.memoryChannel1);
+                appendValue(record, sensor.memoryChannel2);
+                appendValue(record, sensor.memoryChannel3);
+                appendValue(record, sensor.memoryTargetX);
+                appendValue(record, sensor.memoryTargetY);
+            } break;
+            case CellFunction_Nerve: {
+                auto const& nerve = std::get<NerveDescription>(*cell.cellFunction);
+                appendValue<int32_t>(record, nerve.pulseMode);
+                appendValue<int32_t>(record, nerve.alternationMode);
+            } break;
+            case CellFunction_Attacker: {
+                auto const& attacker = std::get<AttackerDescription>(*cell.cellFunction);
+                appendValue<int32_t>(record, attacker.mode);
+            } break;
+            case CellFunction_Injector: {
+                auto const& injector = std::get<InjectorDescription>(*cell.cellFunction);
+                appendValue<int32_t>(record, injector.mode);
+                appendValue<int32_t>(record, injector.counter);
+                appendValue<int32_t>(record, injector.genomeGeneration);
+            } break;
+            case CellFunction_Muscle: {
+                auto const& muscle = std::get<MuscleDescription>(*cell.cellFunction);
+                appendValue<int32_t>(record, muscle.mode);
+                appendValue<int32_t>(record, muscle.lastBendingDirection);
+                appendValue<int32_t>(record, muscle.lastBendingSourceIndex);
+                appendValue(record, muscle.consecutiveBendingAngle);
+                appendValue(record, muscle.lastMovementX);
+                appendValue(record, muscle.lastMovementY);
+            } break;
+            case CellFunction_Defender: {
+                auto const& defender = std::get<DefenderDescription>(*cell.cellFunction);
+                appendValue<int32_t>(record, defender.mode);
+            } break;
+            case CellFunction_Reconnector: {
+                auto const& reconnector = std::get<ReconnectorDescription>(*cell.cellFunction);
+                appendValue<int32_t>(record, reconnector.restrictToColor.value_or(-1));
+                appendValue<int32_t>(record, reconnector.restrictToMutants);
+            } break;
+            case CellFunction_Detonator: {
+                auto const& detonator = std::get<DetonatorDescription>(*cell.cellFunction);
+                appendValue<int32_t>(record, detonator.state);
+                appendValue<int32_t>(record, detonator.countdown);
+            } break;
+            }
+
+            if (cell.hasGenome()) {
+                auto const& genome = getGenome(cell);
+                auto [genomeRef, inserted] = genomeRefByContent.try_emplace(getContent(genome), static_cast<uint32_t>(segment.genomeSizes.size()));
+                if (inserted) {
+                    segment.genomeSizes.emplace_back(static_cast<uint32_t>(genome.size()));
+                    segment.genomeData.insert(segment.genomeData.end(), genome.begin(), genome.end());
+                }
+                segment.genomeRefs.emplace_back(genomeRef->second);
+            }
+        }
+    }
+
+    for (auto particleIndex = particleBegin; particleIndex < particleEnd; ++particleIndex) {
+        auto const& particle = data.particles[particleIndex];
+        segment.particleIds.emplace_back(particle.id);
+        segment.particlePosX.emplace_back(particle.pos.x);
+        segment.particlePosY.emplace_back(particle.pos.y);
+        segment.particleVelX.emplace_back(particle.vel.x);
+        segment.particleVelY.emplace_back(particle.vel.y);
+        segment.particleEnergies.emplace_back(particle.energy);
+        segment.particleColors.emplace_back(particle.color);
+    }
+}
+
+void ColumnarSerializerService::convertSegmentToDescription(ClusteredDataDescription& data, ColumnarSegment const& segment)
+{
+    size_t cellIndex = 0;
+    size_t connectionIndex = 0;
+    size_t nameIndex = 0;
+    size_t descriptionIndex = 0;
+    size_t genomeIndex = 0;
+    auto genomeDataIndices = segment.getGenomeDataIndices();
+    ColumnarRecordReader record(segment.cellFunctionData);
+
+    for (auto const& clusterSize : segment.clusterSizes) {
+        ClusterDescription cluster;
+        cluster.cells.reserve(clusterSize);
+        for (uint32_t i = 0; i < clusterSize; ++i, ++cellIndex) {
+            CellDescription cell;
+            cell.id = segment.cellIds[cellIndex];
+            cell.pos = {segment.cellPosX[cellIndex], segment.cellPosY[cellIndex]};
+            cell.vel = {segment.cellVelX[cellIndex], segment.cellVelY[cellIndex]};
+            cell.energy = segment.cellEnergies[cellIndex];
+            cell.stiffness = segment.cellStiffnesses[cellIndex];
+            cell.color = segment.cellColors[cellIndex];
+            cell.maxConnections = segment.cellMaxConnections[cellIndex];
+            cell.barrier = segment.cellBarriers[cellIndex] != 0;
+            cell.age = segment.cellAges[cellIndex];
+            cell.livingState = segment.cellLivingStates[cellIndex];
+            cell.creatureId = segment.cellCreatureIds[cellIndex];
+            cell.mutationId = segment.cellMutationIds[cellIndex];
+            cell.ancestorMutationId = segment.cellAncestorMutationIds[cellIndex];
+            cell.genomeComplexity = segment.cellGenomeComplexities[cellIndex];
+            cell.executionOrderNumber = segment.cellExecutionOrderNumbers[cellIndex];
+            cell.inputExecutionOrderNumber = toOptional(segment.cellInputExecutionOrderNumbers[cellIndex]);
+            cell.outputBlocked = segment.cellOutputBlocked[cellIndex] != 0;
+            cell.activationTime = segment.cellActivationTimes[cellIndex];
+            cell.detectedByCreatureId = segment.cellDetectedByCreatureIds[cellIndex];
+            cell.cellFunctionUsed = segment.cellCellFunctionUsed[cellIndex];
+
+            auto numConnections = segment.cellNumConnections[cellIndex];
+            cell.connections.resize(numConnections);
+            for (auto& connection : cell.connections) {
+                auto connectedCellIndex = segment.connectionCellIndices[connectionIndex];
+                connection.cellId = connectedCellIndex >= 0 ? static_cast<uint64_t>(connectedCellIndex) + 1 : 0;
+                connection.distance = segment.connectionDistances[connectionIndex];
+                connection.angleFromPrevious = segment.connectionAngles[connectionIndex];
+                ++connectionIndex;
+            }
+
+            std::copy_n(segment.activityChannels.begin() + cellIndex * MAX_CHANNELS, MAX_CHANNELS, cell.activity.channels.begin());
+            cell.activity.origin = segment.activityOrigins[cellIndex];
+            cell.activity.targetX = segment.activityTargetX[cellIndex];
+            cell.activity.targetY = segment.activityTargetY[cellIndex];
+
+            auto nameSize = segment.metadataNameSizes[cellIndex];
+            cell.metadata.name.assign(segment.metadataNames.begin() + nameIndex, segment.metadataNames.begin() + nameIndex + nameSize);
+            nameIndex += nameSize;
+            auto descriptionSize = segment.metadataDescriptionSizes[cellIndex];
+            cell.metadata.description.assign(
+                segment.metadataDescriptions.begin() + descriptionIndex, segment.metadataDescriptions.begin() + descriptionIndex + descriptionSize);
+            descriptionIndex += descriptionSize;
+
+            auto readGenome = [&] {
+                auto genomeRef = segment.genomeRefs[genomeIndex++];
+                auto genomeBegin = segment.genomeData.begin() + genomeDataIndices[genomeRef];
+                return std::vector<uint8_t>(genomeBegin, genomeBegin + segment.genomeSizes[genomeRef]);
+            };
+
+            switch (segment.cellFunctions[cellIndex]) {
+            case CellFunction_Neuron: {
+                NeuronDescription neuron;
+                for (int row = 0; row < MAX_CHANNELS; ++row) {
+                    for (int col = 0; col < MAX_CHANNELS; ++col) {
+                        neuron.weights[row][col] = record.read<float>();
+                    }
+                }
+                for (int i = 0; i < MAX_CHANNELS; ++i) {
+                    neuron.biases[i] = record.read<float>();
+                }
+                for (int i = 0; i < MAX_CHANNELS; ++i) {
+                    neuron.activationFunctions[i] = record.read<int32_t>();
+                }
+                cell.cellFunction = neuron;
+            } break;
+            case CellFunction_Transmitter: {
+                TransmitterDescription transmitter;
+                transmitter.mode = record.read<int32_t>();
+                cell.cellFunction = transmitter;
+            } break;
+            case CellFunction_Constructor: {
+                ConstructorDescription constructor;
+                constructor.activationMode = record.read<int32_t>();
+                constructor.constructionActivationTime = record.read<int32_t>();
+                constructor.numInheritedGenomeNodes = record.read<int32_t>();
+                constructor.genomeGeneration = record.read<int32_t>();
+                constructor.constructionAngle1 = record.read<float>();
+                constructor.constructionAngle2 = record.read<float>();
+                constructor.lastConstructedCellId = record.read<uint64_t>();
+                constructor.genomeCurrentNodeIndex = record.read<int32_t>();
+                constructor.genomeCurrentRepetition = record.read<int32_t>();
+                constructor.currentBranch = record.read<int32_t>();
+                constructor.offspringCreatureId = record.read<int32_t>();
+                constructor.offspringMutationId = record.read<int32_t>();
+                constructor.genome = readGenome();
+                cell.cellFunction = constructor;
+            } break;
+            case CellFunction_Sensor: {
+                SensorDescription sensor;
+                auto hasFixedAngle = record.read<uint8_t>() != 0;
+                auto fixedAngle = record.read<float>();
+                if (hasFixedAngle) {
+                    sensor.fixedAngle = fixedAngle;
+                }
+                sensor.minDensity = record.read<float>();
+                sensor.minRange = toOptional(record.read<int32_t>());
+                sensor.maxRange = toOptional(record.read<int32_t>());
+                sensor.restrictToColor = toOptional(record.read<int32_t>());
+                sensor.restrictToMutants = record.read<int32_t>();
+                sensor.memoryChannel1 = record.read<float>();
+                sensor.memoryChannel2 = record.read<float>();
+                sensor.memoryChannel3 = record.read<float>();
+                sensor.memoryTargetX = record.read<float>();
+                sensor.memoryTargetY = record.read<float>();
+                cell.cellFunction = sensor;
+            } break;
+            case CellFunction_Nerve: {
+                NerveDescription nerve;
+                nerve.pulseMode = record.read<int32_t>();
+                nerve.alternationMode = record.read<int32_t>();
+                cell.cellFunction = nerve;
+            } break;
+            case CellFunction_Attacker: {
+                AttackerDescription attacker;
+                attacker.mode = record.read<int32_t>();
+                cell.cellFunction = attacker;
+            } break;
+            case CellFunction_Injector: {
+                InjectorDescription injector;
+                injector.mode = record.read<int32_t>();
+                injector.counter = record.read<int32_t>();
+                injector.genomeGeneration = record.read<int32_t>();
+                injector.genome = readGenome();
+                cell.cellFunction = injector;
+            } break;
+            case CellFunction_Muscle: {
+                MuscleDescription muscle;
+                muscle.mode = record.read<int32_t>();
+                muscle.lastBendingDirection = record.read<int32_t>();
+                muscle.lastBendingSourceIndex = record.read<int32_t>();
+                muscle.consecutiveBendingAngle = record.read<float>();
+                muscle.lastMovementX = record.read<float>();
+                muscle.lastMovementY = record.read<float>();
+                cell.cellFunction = muscle;
+            } break;
+            case CellFunction_Defender: {
+                DefenderDescription defender;
+                defender.mode = record.read<int32_t>();
+                cell.cellFunction = defender;
+            } break;
+            case CellFunction_Reconnector: {
+                ReconnectorDescription reconnector;
+                reconnector.restrictToColor = toOptional(record.read<int32_t>());
+                reconnector.restrictToMutants = record.read<int32_t>();
+                cell.cellFunction = reconnector;
+            } break;
+            case CellFunction_Detonator: {
+                DetonatorDescription detonator;
+                detonator.state = record.read<int32_t>();
+                detonator.countdown = record.read<int32_t>();
+                cell.cellFunction = detonator;
+            } break;
+            }
+            cluster.cells.emplace_back(std::move(cell));
+        }
+        data.clusters.emplace_back(std::move(cluster));
+    }
+
+    for (size_t i = 0; i < segment.getNumParticles(); ++i) {
+        ParticleDescription particle;
+        particle.id = segment.particleIds[i];
+        particle.pos = {segment.particlePosX[i], segment.particlePosY[i]};
+        particle.vel = {segment.particleVelX[i], segment.particleVelY[i]};
+        particle.energy = segment.particleEnergies[i];
+        particle.color = segment.particleColors[i];
+        data.particles.emplace_back(particle);
+    }
+}
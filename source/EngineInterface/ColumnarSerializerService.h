@@ -0,0 +1,166 @@
+#pragma once
+
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+
+#include "Base/Definitions.h"
+
+#include "Definitions.h"
+
+/**
+ * Column-oriented binary format for simulation data.
+ *
+ * The file consists of a header and a sequence of segments. Each segment contains a batch of whole clusters and
+ * particles stored as typed columns (ids, positions, velocities, energies, connections, genome blobs, etc.).
+ * Identical genomes are stored once per segment and referenced by the constructors and injectors.
+ * The header contains a schema listing the columns present in the file. Optional columns (e.g. metadata or activities)
+ * are omitted if they only contain default values and columns unknown to the reader are skipped.
+ */
+struct ColumnarSchemaEntry
+{
+    uint16_t columnId = 0;
+    uint8_t elementSize = 0;
+};
+
+struct ColumnarHeader
+{
+    std::string programVersion;
+    uint32_t schemaVersion = 0;
+    uint64_t numSegments = 0;
+
+    uint64_t numClusters = 0;
+    uint64_t numCells = 0;
+    uint64_t numParticles = 0;
+
+    //sizes of variable-length data for preallocation
+    uint64_t numConnections = 0;
+    uint64_t numNeurons = 0;
+    uint64_t genomeBytes = 0;  //genomes stored once per segment
+    uint64_t cellGenomeBytes = 0;  //genomes of all cells since each cell needs its own copy on the device
+    uint64_t metadataBytes = 0;
+
+    std::vector<ColumnarSchemaEntry> schema;
+};
+
+struct ColumnarSegment
+{
+    std::vector<uint32_t> clusterSizes;
+
+    //cells
+    std::vector<uint64_t> cellIds;
+    std::vector<float> cellPosX;
+    std::vector<float> cellPosY;
+    std::vector<float> cellVelX;
+    std::vector<float> cellVelY;
+    std::vector<float> cellEnergies;
+    std::vector<float> cellStiffnesses;
+    std::vector<int32_t> cellColors;
+    std::vector<int32_t> cellMaxConnections;
+    std::vector<uint8_t> cellBarriers;
+    std::vector<int32_t> cellAges;
+    std::vector<int32_t> cellLivingStates;
+    std::vector<int32_t> cellCreatureIds;
+    std::vector<int32_t> cellMutationIds;
+    std::vector<int32_t> cellAncestorMutationIds;
+    std::vector<float> cellGenomeComplexities;
+    std::vector<int32_t> cellExecutionOrderNumbers;
+    std::vector<int32_t> cellInputExecutionOrderNumbers;  //-1 = not set
+    std::vector<uint8_t> cellOutputBlocked;
+    std::vector<int32_t> cellActivationTimes;
+    std::vector<uint8_t> cellDetectedByCreatureIds;
+    std::vector<uint8_t> cellCellFunctionUsed;
+    std::vector<uint8_t> cellFunctions;
+
+    //connections of all cells in consecutive order
+    std::vector<uint8_t> cellNumConnections;
+    std::vector<int64_t> connectionCellIndices;  //index of the connected cell in the whole file, -1 = not present
+    std::vector<float> connectionDistances;
+    std::vector<float> connectionAngles;
+
+    //activities: MAX_CHANNELS values per cell
+    std::vector<float> activityChannels;
+    std::vector<uint8_t> activityOrigins;
+    std::vector<float> activityTargetX;
+    std::vector<float> activityTargetY;
+
+    //metadata: string lengths per cell and concatenated characters
+    std::vector<uint32_t> metadataNameSizes;
+    std::vector<uint8_t> metadataNames;
+    std::vector<uint32_t> metadataDescriptionSizes;
+    std::vector<uint8_t> metadataDescriptions;
+
+    //packed cell function records for all cells with a cell function (in cell order)
+    std::vector<uint8_t> cellFunctionData;
+
+    //genome references for all constructors and injectors (in cell order) to the unique genome blobs of the segment
+    std::vector<uint32_t> genomeRefs;
+    std::vector<uint32_t> genomeSizes;
+    std::vector<uint8_t> genomeData;
+
+    //particles
+    std::vector<uint64_t> particleIds;
+    std::vector<float> particlePosX;
+    std::vector<float> particlePosY;
+    std::vector<float> particleVelX;
+    std::vector<float> particleVelY;
+    std::vector<float> particleEnergies;
+    std::vector<int32_t> particleColors;
+
+    void clear();
+    uint64_t getNumCells() const { return cellIds.size(); }
+    uint64_t getNumParticles() const { return particleIds.size(); }
+    std::vector<uint64_t> getGenomeDataIndices() const;  //positions of the unique genomes in genomeData
+};
+
+//reads the packed cell function records of a segment (see ColumnarSerializerService::fillSegment for the layouts)
+class ColumnarRecordReader
+{
+public:
+    ColumnarRecordReader(std::vector<uint8_t> const& data)
+        : _data(data)
+    {}
+
+    template <typename T>
+    T read()
+    {
+        if (_pos + sizeof(T) > _data.size()) {
+            throw std::runtime_error("Invalid cell function data.");
+        }
+        T result;
+        std::memcpy(&result, _data.data() + _pos, sizeof(T));
+        _pos += sizeof(T);
+        return result;
+    }
+
+private:
+    std::vector<uint8_t> const& _data;
+    size_t _pos = 0;
+};
+
+class ColumnarSerializerService
+{
+public:
+    static bool isColumnarFormat(std::istream& stream);  //peeks at the next byte without consuming it
+
+    static void serialize(ClusteredDataDescription const& data, std::ostream& stream);
+    static void deserialize(ClusteredDataDescription& data, std::istream& stream);
+
+    //building blocks for batch-wise processing of large files
+    //segments returned by readSegment contain all columns with numCells or numParticles entries (filled up with default values if necessary)
+    static ColumnarHeader readHeader(std::istream& stream);
+    static void readSegment(ColumnarSegment& segment, ColumnarHeader const& header, std::istream& stream);
+
+private:
+    static void fillSegment(
+        ColumnarSegment& segment,
+        ClusteredDataDescription const& data,
+        size_t clusterBegin,
+        size_t clusterEnd,
+        size_t particleBegin,
+        size_t particleEnd,
+        std::unordered_map<uint64_t, int64_t> const& cellIndexById);
+    static void normalizeSegment(ColumnarSegment& segment, ColumnarHeader const& header);
+    static void convertSegmentToDescription(ClusteredDataDescription& data, ColumnarSegment const& segment);
+};
@@ -24,6 +24,11 @@ struct Settings;
 class _SimulationController;
 using SimulationController = std::shared_ptr<_SimulationController>;
 
+struct ColumnarHeader;
+struct ColumnarSegment;
+class _ColumnarDataReader;
+using ColumnarDataReader = std::shared_ptr<_ColumnarDataReader>;
+
 struct TimelineStatistics;
 struct HistogramData;
 struct RawStatisticsData;
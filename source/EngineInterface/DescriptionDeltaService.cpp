@@ -0,0 +1,253 @@
+#include "DescriptionDeltaService.h"
+
+#include <bit>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace
+{
+    bool equalGeneralFields(CellDescription const& cell1, CellDescription const& cell2)
+    {
+        return cell1.pos == cell2.pos && cell1.vel == cell2.vel && cell1.energy == cell2.energy && cell1.stiffness == cell2.stiffness
+            && cell1.color == cell2.color && cell1.maxConnections == cell2.maxConnections && cell1.barrier == cell2.barrier && cell1.age == cell2.age
+            && cell1.livingState == cell2.livingState && cell1.creatureId == cell2.creatureId && cell1.mutationId == cell2.mutationId
+            && cell1.ancestorMutationId == cell2.ancestorMutationId && cell1.genomeComplexity == cell2.genomeComplexity
+            && cell1.executionOrderNumber == cell2.executionOrderNumber && cell1.inputExecutionOrderNumber == cell2.inputExecutionOrderNumber
+            && cell1.outputBlocked == cell2.outputBlocked && cell1.activationTime == cell2.activationTime
+            && cell1.detectedByCreatureId == cell2.detectedByCreatureId && cell1.cellFunctionUsed == cell2.cellFunctionUsed;
+    }
+
+    void copyGeneralFields(CellDescription& target, CellDescription const& source)
+    {
+        target.pos = source.pos;
+        target.vel = source.vel;
+        target.energy = source.energy;
+        target.stiffness = source.stiffness;
+        target.color = source.color;
+        target.maxConnections = source.maxConnections;
+        target.barrier = source.barrier;
+        target.age = source.age;
+        target.livingState = source.livingState;
+        target.creatureId = source.creatureId;
+        target.mutationId = source.mutationId;
+        target.ancestorMutationId = source.ancestorMutationId;
+        target.genomeComplexity = source.genomeComplexity;
+        target.executionOrderNumber = source.executionOrderNumber;
+        target.inputExecutionOrderNumber = source.inputExecutionOrderNumber;
+        target.outputBlocked = source.outputBlocked;
+        target.activationTime = source.activationTime;
+        target.detectedByCreatureId = source.detectedByCreatureId;
+        target.cellFunctionUsed = source.cellFunctionUsed;
+    }
+
+    CellFieldGroups calcChangedFields(CellDescription const& base, CellDescription const& target)
+    {
+        CellFieldGroups result = CellFieldGroups_None;
+        if (!equalGeneralFields(base, target)) {
+            result |= CellFieldGroups_General;
+        }
+        if (base.connections != target.connections) {
+            result |= CellFieldGroups_Connections;
+        }
+        if (base.cellFunction != target.cellFunction) {
+            result |= CellFieldGroups_CellFunction;
+        }
+        if (base.activity != target.activity) {
+            result |= CellFieldGroups_Activity;
+        }
+        if (base.metadata != target.metadata) {
+            result |= CellFieldGroups_Metadata;
+        }
+        return result;
+    }
+
+    //only the changed field groups are kept to save space
+    CellDescription extractFields(CellDescription const& cell, CellFieldGroups fields)
+    {
+        CellDescription result;
+        result.id = cell.id;
+        if (fields & CellFieldGroups_General) {
+            copyGeneralFields(result, cell);
+        }
+        if (fields & CellFieldGroups_Connections) {
+            result.connections = cell.connections;
+        }
+        if (fields & CellFieldGroups_CellFunction) {
+            result.cellFunction = cell.cellFunction;
+        }
+        if (fields & CellFieldGroups_Activity) {
+            result.activity = cell.activity;
+        }
+        if (fields & CellFieldGroups_Metadata) {
+            result.metadata = cell.metadata;
+        }
+        return result;
+    }
+
+    void applyFields(CellDescription& target, CellDelta const& delta)
+    {
+        if (delta.changedFields & CellFieldGroups_General) {
+            copyGeneralFields(target, delta.cell);
+        }
+        if (delta.changedFields & CellFieldGroups_Connections) {
+            target.connections = delta.cell.connections;
+        }
+        if (delta.changedFields & CellFieldGroups_CellFunction) {
+            target.cellFunction = delta.cell.cellFunction;
+        }
+        if (delta.changedFields & CellFieldGroups_Activity) {
+            target.activity = delta.cell.activity;
+        }
+        if (delta.changedFields & CellFieldGroups_Metadata) {
+            target.metadata = delta.cell.metadata;
+        }
+    }
+
+    uint64_t mix(uint64_t value)
+    {
+        value += 0x9e3779b97f4a7c15ull;
+        value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+        value = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+        return value ^ (value >> 31);
+    }
+
+    uint64_t hashObject(uint64_t id, RealVector2D const& pos, float energy)
+    {
+        auto result = mix(id);
+        result = mix(result ^ std::bit_cast<uint32_t>(pos.x));
+        result = mix(result ^ std::bit_cast<uint32_t>(pos.y));
+        return mix(result ^ std::bit_cast<uint32_t>(energy));
+    }
+}
+
+bool DescriptionDelta::isEmpty() const
+{
+    return getNumberOfEntries() == 0;
+}
+
+int DescriptionDelta::getNumberOfEntries() const
+{
+    return toInt(
+        removedCellIds.size() + addedCells.size() + changedCells.size() + removedParticleIds.size() + addedOrChangedParticles.size());
+}
+
+DescriptionDelta DescriptionDeltaService::calcDelta(ClusteredDataDescription const& base, ClusteredDataDescription const& target)
+{
+    DescriptionDelta result;
+
+    std::unordered_map<uint64_t, CellDescription const*> baseCellById;
+    for (auto const& cluster : base.clusters) {
+        for (auto const& cell : cluster.cells) {
+            baseCellById.emplace(cell.id, &cell);
+        }
+    }
+    std::unordered_set<uint64_t> targetCellIds;
+    for (auto const& cluster : target.clusters) {
+        for (auto const& cell : cluster.cells) {
+            targetCellIds.insert(cell.id);
+            auto findResult = baseCellById.find(cell.id);
+            if (findResult == baseCellById.end()) {
+                result.addedCells.emplace_back(cell);
+                continue;
+            }
+            auto changedFields = calcChangedFields(*findResult->second, cell);
+            if (changedFields != CellFieldGroups_None) {
+                result.changedCells.emplace_back(CellDelta{changedFields, extractFields(cell, changedFields)});
+            }
+        }
+    }
+    for (auto const& [id, cell] : baseCellById) {
+        if (!targetCellIds.contains(id)) {
+            result.removedCellIds.emplace_back(id);
+        }
+    }
+
+    std::unordered_map<uint64_t, ParticleDescription const*> baseParticleById;
+    for (auto const& particle : base.particles) {
+        baseParticleById.emplace(particle.id, &particle);
+    }
+    std::unordered_set<uint64_t> targetParticleIds;
+    for (auto const& particle : target.particles) {
+        targetParticleIds.insert(particle.id);
+        auto findResult = baseParticleById.find(particle.id);
+        if (findResult == baseParticleById.end() || *findResult->second != particle) {
+            result.addedOrChangedParticles.emplace_back(particle);
+        }
+    }
+    for (auto const& [id, particle] : baseParticleById) {
+        if (!targetParticleIds.contains(id)) {
+            result.removedParticleIds.emplace_back(id);
+        }
+    }
+    return result;
+}
+
+ClusteredDataDescription DescriptionDeltaService::applyDelta(ClusteredDataDescription const& base, DescriptionDelta const& delta)
+{
+    DataDescription result;
+
+    //cells
+    std::unordered_set<uint64_t> removedCellIds(delta.removedCellIds.begin(), delta.removedCellIds.end());
+    auto& cells = result.cells;
+    for (auto const& cluster : base.clusters) {
+        for (auto const& cell : cluster.cells) {
+            if (!removedCellIds.contains(cell.id)) {
+                cells.emplace_back(cell);
+            }
+        }
+    }
+    std::unordered_map<uint64_t, int> cellIndexById;
+    for (int i = 0; i < toInt(cells.size()); ++i) {
+        cellIndexById.emplace(cells[i].id, i);
+    }
+    for (auto const& cellDelta : delta.changedCells) {
+        auto findResult = cellIndexById.find(cellDelta.cell.id);
+        if (findResult == cellIndexById.end()) {
+            throw std::runtime_error("Delta refers to an unknown cell.");
+        }
+        applyFields(cells.at(findResult->second), cellDelta);
+    }
+    cells.insert(cells.end(), delta.addedCells.begin(), delta.addedCells.end());
+
+    //particles
+    std::unordered_set<uint64_t> removedParticleIds(delta.removedParticleIds.begin(), delta.removedParticleIds.end());
+    std::unordered_map<uint64_t, ParticleDescription const*> changedParticleById;
+    for (auto const& particle : delta.addedOrChangedParticles) {
+        changedParticleById.emplace(particle.id, &particle);
+    }
+    for (auto const& particle : base.particles) {
+        if (removedParticleIds.contains(particle.id)) {
+            continue;
+        }
+        auto findResult = changedParticleById.find(particle.id);
+        if (findResult != changedParticleById.end()) {
+            result.particles.emplace_back(*findResult->second);
+            changedParticleById.erase(findResult);
+        } else {
+            result.particles.emplace_back(particle);
+        }
+    }
+    for (auto const& particle : delta.addedOrChangedParticles) {
+        if (changedParticleById.contains(particle.id)) {
+            result.particles.emplace_back(particle);
+        }
+    }
+    return ClusteredDataDescription(result);
+}
+
+uint64_t DescriptionDeltaService::calcFingerprint(ClusteredDataDescription const& data)
+{
+    uint64_t result = 0;
+    uint64_t numObjects = 0;
+    for (auto const& cluster : data.clusters) {
+        for (auto const& cell : cluster.cells) {
+            result += hashObject(cell.id, cell.pos, cell.energy);
+            ++numObjects;
+        }
+    }
+    for (auto const& particle : data.particles) {
+        result += mix(hashObject(particle.id, particle.pos, particle.energy));
+        ++numObjects;
+    }
+    return mix(result ^ numObjects);
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "Base/Definitions.h"
+#include "Descriptions.h"
+
+using CellFieldGroups = uint8_t;
+enum CellFieldGroups_
+{
+    CellFieldGroups_None = 0,
+    CellFieldGroups_General = 1 << 0,  //position, velocity, energy and all other scalar properties
+    CellFieldGroups_Connections = 1 << 1,
+    CellFieldGroups_CellFunction = 1 << 2,
+    CellFieldGroups_Activity = 1 << 3,
+    CellFieldGroups_Metadata = 1 << 4,
+    CellFieldGroups_All = 0x1f
+};
+
+struct CellDelta
+{
+    CellFieldGroups changedFields = CellFieldGroups_None;
+    CellDescription cell;  //only the field groups in changedFields are valid
+
+    auto operator<=>(CellDelta const&) const = default;
+};
+
+/**
+ * Difference between two states of a simulation in id-space. Cells and particles are identified by their ids,
+ * changed cells only contain the field groups that differ.
+ */
+struct DescriptionDelta
+{
+    std::vector<uint64_t> removedCellIds;
+    std::vector<CellDescription> addedCells;
+    std::vector<CellDelta> changedCells;
+
+    std::vector<uint64_t> removedParticleIds;
+    std::vector<ParticleDescription> addedOrChangedParticles;
+
+    auto operator<=>(DescriptionDelta const&) const = default;
+
+    bool isEmpty() const;
+    int getNumberOfEntries() const;
+};
+
+class DescriptionDeltaService
+{
+public:
+    static DescriptionDelta calcDelta(ClusteredDataDescription const& base, ClusteredDataDescription const& target);
+
+    //the clusters of the result are rebuilt from the cell connections
+    static ClusteredDataDescription applyDelta(ClusteredDataDescription const& base, DescriptionDelta const& delta);
+
+    //order-independent hash over ids, positions and energies for validating a chain of deltas
+    static uint64_t calcFingerprint(ClusteredDataDescription const& data);
+};
@@ -1,14 +1,17 @@
 #include "DescriptionEditService.h"
 
+#include <algorithm>
 #include <cmath>
 #include <boost/range/adaptor/indexed.hpp>
 #include <boost/range/adaptor/map.hpp>
 
 #include "Base/NumberGenerator.h"
 #include "Base/Math.h"
+#include "Base/ThreadPool.h"
+#include "Base/WorkStealingScheduler.h"
 #include "GenomeDescriptions.h"
-#include "SpaceCalculator.h"
 #include "GenomeDescriptionService.h"
+#include "SpaceCalculator.h"
 
 DataDescription DescriptionEditService::createRect(CreateRectParameters const& parameters)
 {
@@ -164,74 +167,151 @@ namespace
     }
 }
 
-void DescriptionEditService::duplicate(ClusteredDataDescription& data, IntVector2D const& origSize, IntVector2D const& size)
+uint64_t DescriptionEditService::DuplicationPlan::getNumCells() const
 {
-    ClusteredDataDescription result;
+    return cellOffsets.back();
+}
 
+int DescriptionEditService::DuplicationPlan::getOutputClusterIndex(uint64_t cellIndex) const
+{
+    return toInt(std::upper_bound(cellOffsets.begin(), cellOffsets.end(), cellIndex) - cellOffsets.begin()) - 1;
+}
+
+uint64_t DescriptionEditService::DuplicationPlan::getSourceCellIndex(uint64_t cellId) const
+{
+    auto findResult = std::lower_bound(
+        sourceCellIndexById.begin(), sourceCellIndexById.end(), cellId, [](auto const& element, uint64_t id) { return element.first < id; });
+    CHECK(findResult != sourceCellIndexById.end() && findResult->first == cellId);
+    return findResult->second;
+}
+
+int DescriptionEditService::DuplicationPlan::getNewCreatureId(int tileIndex, int creatureId) const
+{
+    auto index = std::lower_bound(sourceCreatureIds.begin(), sourceCreatureIds.end(), creatureId) - sourceCreatureIds.begin();
+    return newCreatureIds.at(tileIndex * sourceCreatureIds.size() + index);
+}
+
+auto DescriptionEditService::createDuplicationPlan(ClusteredDataDescription const& data, IntVector2D const& origSize, IntVector2D const& size)
+    -> DuplicationPlan
+{
+    DuplicationPlan result;
     for (int incX = 0; incX < size.x; incX += origSize.x) {
         for (int incY = 0; incY < size.y; incY += origSize.y) {
-            generateNewCreatureIds(data);
-
-            for (auto cluster : data.clusters) {
-                auto origPos = cluster.getClusterPosFromCells();
-                RealVector2D clusterPos = {origPos.x + incX, origPos.y + incY};
-                if (clusterPos.x < size.x && clusterPos.y < size.y) {
-                    for (auto& cell : cluster.cells) {
-                        cell.pos = RealVector2D{cell.pos.x + incX, cell.pos.y + incY};
-                        if (incX > 0 || incY > 0) {
-                            removeMetadata(cell);
-                        }
-                    }
-                    generateNewIds(cluster);
+            result.tileOffsets.emplace_back(RealVector2D{toFloat(incX), toFloat(incY)});
+        }
+    }
 
-                    result.addCluster(cluster);
-                }
+    //source data
+    std::vector<RealVector2D> clusterPositions;
+    clusterPositions.reserve(data.clusters.size());
+    result.sourceCellOffsets.reserve(data.clusters.size() + 1);
+    result.sourceCellOffsets.emplace_back(0);
+    for (auto const& cluster : data.clusters) {
+        clusterPositions.emplace_back(cluster.getClusterPosFromCells());
+        result.sourceCellOffsets.emplace_back(result.sourceCellOffsets.back() + cluster.cells.size());
+    }
+    result.sourceCellIndexById.reserve(result.sourceCellOffsets.back());
+    for (auto const& cluster : data.clusters) {
+        for (auto const& cell : cluster.cells) {
+            result.sourceCellIndexById.emplace_back(cell.id, result.sourceCellIndexById.size());
+            if (cell.creatureId != 0) {
+                result.sourceCreatureIds.emplace_back(cell.creatureId);
             }
-            for (auto particle : data.particles) {
-                auto origPos = particle.pos;
-                particle.pos = RealVector2D{origPos.x + incX, origPos.y + incY};
-                if (particle.pos.x < size.x && particle.pos.y < size.y) {
-                    particle.setId(NumberGenerator::getInstance().getId());
-                    result.addParticle(particle);
-                }
+            if (cell.getCellFunctionType() == CellFunction_Constructor) {
+                result.sourceCreatureIds.emplace_back(std::get<ConstructorDescription>(*cell.cellFunction).offspringCreatureId);
+            }
+        }
+    }
+    std::sort(result.sourceCellIndexById.begin(), result.sourceCellIndexById.end());
+    std::sort(result.sourceCreatureIds.begin(), result.sourceCreatureIds.end());
+    result.sourceCreatureIds.erase(std::unique(result.sourceCreatureIds.begin(), result.sourceCreatureIds.end()), result.sourceCreatureIds.end());
+
+    //connections must not leave their cluster, checked here so that the parallel filling cannot fail
+    for (int clusterIndex = 0; clusterIndex < toInt(data.clusters.size()); ++clusterIndex) {
+        for (auto const& cell : data.clusters.at(clusterIndex).cells) {
+            for (auto const& connection : cell.connections) {
+                auto connectedCellIndex = result.getSourceCellIndex(connection.cellId);
+                CHECK(connectedCellIndex >= result.sourceCellOffsets.at(clusterIndex) && connectedCellIndex < result.sourceCellOffsets.at(clusterIndex + 1));
+            }
+        }
+    }
+
+    //output objects
+    result.cellOffsets.emplace_back(0);
+    for (int tileIndex = 0; tileIndex < toInt(result.tileOffsets.size()); ++tileIndex) {
+        auto const& offset = result.tileOffsets.at(tileIndex);
+        for (int clusterIndex = 0; clusterIndex < toInt(data.clusters.size()); ++clusterIndex) {
+            auto const& origPos = clusterPositions.at(clusterIndex);
+            if (origPos.x + offset.x < size.x && origPos.y + offset.y < size.y) {
+                result.sourceClusterIndices.emplace_back(clusterIndex);
+                result.clusterTileIndices.emplace_back(tileIndex);
+                result.cellOffsets.emplace_back(result.cellOffsets.back() + data.clusters.at(clusterIndex).cells.size());
+            }
+        }
+        for (int particleIndex = 0; particleIndex < toInt(data.particles.size()); ++particleIndex) {
+            auto const& origPos = data.particles.at(particleIndex).pos;
+            if (origPos.x + offset.x < size.x && origPos.y + offset.y < size.y) {
+                result.sourceParticleIndices.emplace_back(particleIndex);
+                result.particleTileIndices.emplace_back(tileIndex);
             }
         }
     }
-    data = result;
+
+    //new ids
+    auto& numberGen = NumberGenerator::getInstance();
+    result.firstId = numberGen.getIds(result.getNumCells() + result.sourceParticleIndices.size());
+    result.newCreatureIds.reserve(result.tileOffsets.size() * result.sourceCreatureIds.size());
+    for (size_t i = 0; i < result.tileOffsets.size() * result.sourceCreatureIds.size(); ++i) {
+        int newCreatureId = 0;
+        while (newCreatureId == 0) {
+            newCreatureId = numberGen.getRandomInt();
+        }
+        result.newCreatureIds.emplace_back(newCreatureId);
+    }
+    return result;
 }
 
-namespace
+void DescriptionEditService::duplicate(ClusteredDataDescription& data, IntVector2D const& origSize, IntVector2D const& size)
 {
-    std::vector<int> getCellIndicesWithinRadius(
-        DataDescription const& data,
-        std::unordered_map<int, std::unordered_map<int, std::vector<int>>> const& cellIndicesBySlot,
-        RealVector2D const& pos,
-        float radius)
-    {
-        std::vector<int> result;
-        IntVector2D upperLeftIntPos{toInt(pos.x - radius - 0.5f), toInt(pos.y - radius - 0.5f)};
-        IntVector2D lowerRightIntPos{toInt(pos.x + radius + 0.5f), toInt(pos.y + radius + 0.5f)};
-        for (int x = upperLeftIntPos.x; x <= lowerRightIntPos.x; ++x) {
-            for (int y = upperLeftIntPos.y; y <= lowerRightIntPos.y; ++y) {
-                if (cellIndicesBySlot.find(x) != cellIndicesBySlot.end()) {
-                    if (cellIndicesBySlot.at(x).find(y) != cellIndicesBySlot.at(x).end()) {
-                        for (auto const& cellIndex : cellIndicesBySlot.at(x).at(y)) {
-                            auto const& cell = data.cells.at(cellIndex);
-                            if (Math::length(cell.pos - pos) <= radius) {
-                                result.emplace_back(cellIndex);
-                            }
-                        }
-                    }
-                }
+    auto plan = createDuplicationPlan(data, origSize, size);
+
+    ClusteredDataDescription result;
+    result.clusters.resize(plan.sourceClusterIndices.size());
+    WorkStealingScheduler().run(toInt(result.clusters.size()), [&](int clusterIndex) {
+        auto const& sourceCluster = data.clusters.at(plan.sourceClusterIndices.at(clusterIndex));
+        auto tileIndex = plan.clusterTileIndices.at(clusterIndex);
+        auto const& offset = plan.tileOffsets.at(tileIndex);
+        auto cellIndexOffset = plan.cellOffsets.at(clusterIndex) - plan.sourceCellOffsets.at(plan.sourceClusterIndices.at(clusterIndex));
+
+        auto& cells = result.clusters.at(clusterIndex).cells;
+        cells = sourceCluster.cells;
+        for (auto& cell : cells) {
+            cell.id = plan.firstId + cellIndexOffset + plan.getSourceCellIndex(cell.id);
+            cell.pos = RealVector2D{cell.pos.x + offset.x, cell.pos.y + offset.y};
+            for (auto& connection : cell.connections) {
+                connection.cellId = plan.firstId + cellIndexOffset + plan.getSourceCellIndex(connection.cellId);
+            }
+            if (cell.creatureId != 0) {
+                cell.creatureId = plan.getNewCreatureId(tileIndex, cell.creatureId);
+            }
+            if (cell.getCellFunctionType() == CellFunction_Constructor) {
+                auto& offspringCreatureId = std::get<ConstructorDescription>(*cell.cellFunction).offspringCreatureId;
+                offspringCreatureId = plan.getNewCreatureId(tileIndex, offspringCreatureId);
+            }
+            if (tileIndex > 0) {
+                removeMetadata(cell);
             }
         }
-        std::sort(result.begin(), result.end(), [&](int index1, int index2) {
-            auto const& cell1 = data.cells.at(index1);
-            auto const& cell2 = data.cells.at(index2);
-            return Math::length(cell1.pos - pos) < Math::length(cell2.pos - pos);
-        });
-        return result;
+    });
+
+    result.particles.reserve(plan.sourceParticleIndices.size());
+    for (size_t i = 0; i < plan.sourceParticleIndices.size(); ++i) {
+        auto const& offset = plan.tileOffsets.at(plan.particleTileIndices.at(i));
+        auto& particle = result.particles.emplace_back(data.particles.at(plan.sourceParticleIndices.at(i)));
+        particle.pos = RealVector2D{particle.pos.x + offset.x, particle.pos.y + offset.y};
+        particle.id = plan.firstId + plan.getNumCells() + i;
     }
+    data = std::move(result);
 }
 
 DataDescription DescriptionEditService::gridMultiply(DataDescription const& input, GridMultiplyParameters const& parameters)
@@ -263,6 +343,17 @@ DataDescription DescriptionEditService::gridMultiply(DataDescription const& inpu
     return result;
 }
 
+namespace
+{
+    struct Placement
+    {
+        RealVector2D shift;
+        float angle;
+        RealVector2D velDelta;
+        float angularVelDelta;
+    };
+}
+
 DataDescription DescriptionEditService::randomMultiply(
     DataDescription const& input,
     RandomMultiplyParameters const& parameters,
@@ -270,67 +361,141 @@ DataDescription DescriptionEditService::randomMultiply(
     DataDescription&& existentData,
     bool& overlappingCheckSuccessful)
 {
+    static auto constexpr MaxAttempts = 200;
+    static auto constexpr MinCellDistance = 2.0f;
+
     overlappingCheckSuccessful = true;
-    SpaceCalculator spaceCalculator(worldSize);
-    std::unordered_map<IntVector2D, std::vector<RealVector2D>> cellPosBySlot;
 
-    //create map for overlapping check
+    //create grid for overlapping check with existent data
+    SpatialHashGrid existentCellPositions(worldSize, MinCellDistance);
     if (parameters._overlappingCheck) {
-        int index = 0;
+        std::vector<RealVector2D> positions;
+        positions.reserve(existentData.cells.size());
         for (auto const& cell : existentData.cells) {
-            auto intPos = toIntVector2D(spaceCalculator.getCorrectedPosition(cell.pos));
-            cellPosBySlot[intPos].emplace_back(cell.pos);
-            ++index;
+            positions.emplace_back(cell.pos);
         }
+        existentCellPositions.build(positions);
     }
 
-    //do multiplication
-    DataDescription result = input;
-    generateNewIds(result);
+    //cell positions of the input relative to its center, a placement moves the center to center + shift and rotates around it
+    auto center = input.calcCenter();
+    std::vector<RealVector2D> relPositions;
+    relPositions.reserve(input.cells.size());
+    float boundingRadius = 0;
+    for (auto const& cell : input.cells) {
+        relPositions.emplace_back(cell.pos - center);
+        boundingRadius = std::max(boundingRadius, toFloat(Math::length(relPositions.back())));
+    }
+    auto getRotatedRelPositions = [&](Placement const& placement, RealVector2D* result) {
+        auto rotationMatrix = Math::calcRotationMatrix(placement.angle);
+        for (auto const& relPos : relPositions) {
+            *result++ = rotationMatrix * relPos;
+        }
+    };
+
+    //copies placed so far: a grid of their centers (broad phase, Poisson-disc like) and a grid of their cell positions
+    auto numCells = toInt(relPositions.size());
+    auto copyDistance = boundingRadius * 2 + MinCellDistance;
+    SpatialHashGrid copyCenters(worldSize, std::max(1.0f, copyDistance));
+    SpatialHashGrid copyCellPositions(worldSize, MinCellDistance);
+
+    auto isOverlappingWithCells = [&](SpatialHashGrid const& cellPositions, RealVector2D const& candidateCenter, RealVector2D const* rotatedRelPositions) {
+        for (int i = 0; i < numCells; ++i) {
+            if (cellPositions.isOccupied(candidateCenter + rotatedRelPositions[i], MinCellDistance)) {
+                return true;
+            }
+        }
+        return false;
+    };
+    auto isOverlapping = [&](Placement const& placement, RealVector2D const* rotatedRelPositions) {
+        if (numCells == 0) {
+            return false;
+        }
+        auto candidateCenter = center + placement.shift;
+        if (existentCellPositions.isOccupied(candidateCenter, boundingRadius + MinCellDistance)
+            && isOverlappingWithCells(existentCellPositions, candidateCenter, rotatedRelPositions)) {
+            return true;
+        }
+        return copyCenters.isOccupied(candidateCenter, copyDistance) && isOverlappingWithCells(copyCellPositions, candidateCenter, rotatedRelPositions);
+    };
+
+    //placement: candidates are drawn in batches (dart throwing), tested in parallel against the state before the batch and
+    //accepted in order after testing them against the copies of the same batch
     auto& numberGen = NumberGenerator::getInstance();
-    for (int i = 0; i < parameters._number; ++i) {
-        bool overlapping = false;
-        DataDescription copy;
-        int attempts = 0;
-        do {
-            copy = input;
-            removeMetadata(copy);
-            copy.shift({toFloat(numberGen.getRandomReal(0, toInt(worldSize.x))), toFloat(numberGen.getRandomReal(0, toInt(worldSize.y)))});
-            copy.rotate(toInt(numberGen.getRandomReal(parameters._minAngle, parameters._maxAngle)));
-            copy.accelerate(
-                {toFloat(numberGen.getRandomReal(parameters._minVelX, parameters._maxVelX)),
-                 toFloat(numberGen.getRandomReal(parameters._minVelY, parameters._maxVelY))},
-                toFloat(numberGen.getRandomReal(parameters._minAngularVel, parameters._maxAngularVel)));
-
-            //overlapping check
-            overlapping = false;
-            if (parameters._overlappingCheck) {
-                for (auto const& cell : copy.cells) {
-                    auto pos = spaceCalculator.getCorrectedPosition(cell.pos);
-                    if (isCellPresent(cellPosBySlot, spaceCalculator, pos, 2.0f)) {
-                        overlapping = true;
-                    }
-                }
+    auto batchSize = parameters._overlappingCheck ? std::max(16, ThreadPool::getInstance().getNumThreads() * 4) : 1;
+    std::vector<Placement> placements;
+    placements.reserve(parameters._number);
+    std::vector<Placement> candidates(batchSize);
+    std::vector<RealVector2D> candidateRelPositions(batchSize * numCells);
+    std::vector<char> overlappingCandidates(batchSize);
+    std::vector<RealVector2D> copyCentersOfBatch;
+    SpaceCalculator spaceCalculator(worldSize);
+    int attempts = 0;
+    while (toInt(placements.size()) < parameters._number) {
+        for (auto& candidate : candidates) {
+            candidate.shift = {toFloat(numberGen.getRandomReal(0, toInt(worldSize.x))), toFloat(numberGen.getRandomReal(0, toInt(worldSize.y)))};
+            candidate.angle = toFloat(toInt(numberGen.getRandomReal(parameters._minAngle, parameters._maxAngle)));
+            candidate.velDelta = {
+                toFloat(numberGen.getRandomReal(parameters._minVelX, parameters._maxVelX)),
+                toFloat(numberGen.getRandomReal(parameters._minVelY, parameters._maxVelY))};
+            candidate.angularVelDelta = toFloat(numberGen.getRandomReal(parameters._minAngularVel, parameters._maxAngularVel));
+        }
+        if (!parameters._overlappingCheck || !overlappingCheckSuccessful) {
+            placements.emplace_back(candidates.front());
+            continue;
+        }
+
+        ThreadPool::getInstance().parallelFor(0, batchSize, [&](size_t index) {
+            auto rotatedRelPositions = candidateRelPositions.data() + index * numCells;
+            getRotatedRelPositions(candidates[index], rotatedRelPositions);
+            overlappingCandidates[index] = isOverlapping(candidates[index], rotatedRelPositions);
+        });
+
+        copyCentersOfBatch.clear();
+        for (int index = 0; index < batchSize && toInt(placements.size()) < parameters._number; ++index) {
+            auto const& candidate = candidates[index];
+            auto candidateCenter = center + candidate.shift;
+            auto rotatedRelPositions = candidateRelPositions.data() + index * numCells;
+            auto overlapping = overlappingCandidates[index] != 0;
+            if (!overlapping) {
+                auto isNearCopyOfBatch = std::ranges::any_of(copyCentersOfBatch, [&](RealVector2D const& copyCenter) {
+                    return spaceCalculator.distance(copyCenter, candidateCenter) <= copyDistance;
+                });
+                overlapping = isNearCopyOfBatch && isOverlappingWithCells(copyCellPositions, candidateCenter, rotatedRelPositions);
             }
             ++attempts;
-        } while (overlapping && attempts < 200 && overlappingCheckSuccessful);
-        if (attempts == 200) {
-            overlappingCheckSuccessful = false;
+            if (!overlapping || attempts == MaxAttempts) {
+                placements.emplace_back(candidate);
+                attempts = 0;
+
+                copyCenters.insert(candidateCenter);
+                for (int i = 0; i < numCells; ++i) {
+                    copyCellPositions.insert(candidateCenter + rotatedRelPositions[i]);
+                }
+                copyCentersOfBatch.emplace_back(candidateCenter);
+
+                if (overlapping) {
+                    overlappingCheckSuccessful = false;  //the remaining copies are placed without check
+                    candidates.resize(1);
+                    break;
+                }
+            }
         }
+    }
 
+    //do multiplication
+    DataDescription result = input;
+    generateNewIds(result);
+    auto inputWithoutMetadata = input;
+    removeMetadata(inputWithoutMetadata);
+    for (auto const& placement : placements) {
+        auto copy = inputWithoutMetadata;
+        copy.shift(placement.shift);
+        copy.rotate(placement.angle);
+        copy.accelerate(placement.velDelta, placement.angularVelDelta);
         generateNewIds(copy);
         generateNewCreatureIds(copy);
         result.add(copy);
-
-        //add copy to existentData for overlapping check
-        if (parameters._overlappingCheck) {
-            for (auto const& cell : copy.cells) {
-                auto index = toInt(existentData.cells.size());
-                existentData.cells.emplace_back(cell);
-                auto intPos = toIntVector2D(spaceCalculator.getCorrectedPosition(cell.pos));
-                cellPosBySlot[intPos].emplace_back(cell.pos);
-            }
-        }
     }
 
     return result;
@@ -343,41 +508,130 @@ void DescriptionEditService::addIfSpaceAvailable(
     float distance,
     IntVector2D const& worldSize)
 {
-    SpaceCalculator space(worldSize);
-
+    if (cellOccupancy.getWorldSize() != worldSize) {
+        cellOccupancy.setWorldSize(worldSize);
+    }
     for (auto const& cell : toAdd.cells) {
-        if (!isCellPresent(cellOccupancy, space, cell.pos, distance)) {
+        if (!cellOccupancy.isOccupied(cell.pos, distance)) {
             result.addCell(cell);
-            cellOccupancy[toIntVector2D(cell.pos)].emplace_back(cell.pos);
+            cellOccupancy.insert(cell.pos);
         }
     }
 }
 
-void DescriptionEditService::reconnectCells(DataDescription& data, float maxDistance)
+namespace
+{
+    struct NearbyCell
+    {
+        int index;
+        RealVector2D delta;  //nearest image, relative to the cell
+        float distanceSquared;
+    };
+}
+
+void DescriptionEditService::reconnectCells(DataDescription& data, float maxDistance, std::optional<IntVector2D> const& worldSize)
 {
-    std::unordered_map<int, std::unordered_map<int, std::vector<int>>> cellIndicesBySlot;
+    auto numCells = toInt(data.cells.size());
+    if (numCells == 0) {
+        return;
+    }
 
-    int index = 0;
+    //index positions, without world size a padded bounding box is used so that no connections across its borders can arise
+    std::vector<RealVector2D> positions;
+    positions.reserve(numCells);
     for (auto& cell : data.cells) {
         cell.connections.clear();
-        cellIndicesBySlot[toInt(cell.pos.x)][toInt(cell.pos.y)].emplace_back(toInt(index));
-        ++index;
+        positions.emplace_back(cell.pos);
+    }
+    auto gridWorldSize = worldSize.value_or(IntVector2D{1, 1});
+    if (!worldSize) {
+        RealVector2D minPos = positions.front();
+        RealVector2D maxPos = positions.front();
+        for (auto const& pos : positions) {
+            minPos = RealVector2D{std::min(minPos.x, pos.x), std::min(minPos.y, pos.y)};
+            maxPos = RealVector2D{std::max(maxPos.x, pos.x), std::max(maxPos.y, pos.y)};
+        }
+        for (auto& pos : positions) {
+            pos = RealVector2D{pos.x - minPos.x + maxDistance, pos.y - minPos.y + maxDistance};
+        }
+        gridWorldSize = {toInt(maxPos.x - minPos.x + maxDistance * 3) + 1, toInt(maxPos.y - minPos.y + maxDistance * 3) + 1};
+    }
+    SpatialHashGrid grid(gridWorldSize, std::max(1.0f, maxDistance));
+    grid.build(positions);
+
+    //candidate pass: nearby cells with higher index sorted by distance, stored in candidates[candidateOffsets[i]], ...
+    auto forEachCandidate = [&](int index, auto const& func) {
+        auto const& cell = data.cells[index];
+        grid.forEachInRadius(positions[index], maxDistance, [&](int otherIndex, RealVector2D const& delta, float distanceSquared) {
+            if (otherIndex > index && data.cells[otherIndex].id != cell.id) {
+                func(NearbyCell{otherIndex, delta, distanceSquared});
+            }
+        });
+    };
+    std::vector<int> candidateOffsets(numCells + 1, 0);
+    ThreadPool::getInstance().parallelFor(0, numCells, [&](size_t index) {
+        forEachCandidate(toInt(index), [&](NearbyCell const&) { ++candidateOffsets[index + 1]; });
+    });
+    for (int i = 0; i < numCells; ++i) {
+        candidateOffsets[i + 1] += candidateOffsets[i];
+    }
+    std::vector<NearbyCell> candidates(candidateOffsets.back());
+    ThreadPool::getInstance().parallelFor(0, numCells, [&](size_t index) {
+        auto candidateIndex = candidateOffsets[index];
+        forEachCandidate(toInt(index), [&](NearbyCell const& nearbyCell) { candidates[candidateIndex++] = nearbyCell; });
+        std::sort(candidates.begin() + candidateOffsets[index], candidates.begin() + candidateOffsets[index + 1], [](auto const& left, auto const& right) {
+            return left.distanceSquared < right.distanceSquared || (left.distanceSquared == right.distanceSquared && left.index < right.index);
+        });
+    });
+
+    //conflict resolution pass: candidates are accepted in the order of the cells as long as both cells have free connections
+    std::vector<int> connectionOffsets(numCells + 1, 0);
+    std::vector<bool> accepted(candidates.size(), false);
+    for (int index = 0; index < numCells; ++index) {
+        for (int candidateIndex = candidateOffsets[index]; candidateIndex < candidateOffsets[index + 1]; ++candidateIndex) {
+            auto otherIndex = candidates[candidateIndex].index;
+            if (connectionOffsets[index + 1] < data.cells[index].maxConnections && connectionOffsets[otherIndex + 1] < data.cells[otherIndex].maxConnections) {
+                accepted[candidateIndex] = true;
+                ++connectionOffsets[index + 1];
+                ++connectionOffsets[otherIndex + 1];
+            }
+        }
     }
-
-    std::unordered_map<uint64_t, int> cache;
-    for (auto const& [index, cell] : data.cells | boost::adaptors::indexed(0)) {
-        cache.emplace(cell.id, static_cast<int>(index));
+    for (int i = 0; i < numCells; ++i) {
+        connectionOffsets[i + 1] += connectionOffsets[i];
     }
-    for (auto& cell : data.cells) {
-        auto nearbyCellIndices = getCellIndicesWithinRadius(data, cellIndicesBySlot, cell.pos, maxDistance);
-        for (auto const& nearbyCellIndex : nearbyCellIndices) {
-            auto const& nearbyCell = data.cells.at(nearbyCellIndex);
-            if (cell.id != nearbyCell.id && cell.connections.size() < cell.maxConnections && nearbyCell.connections.size() < nearbyCell.maxConnections
-                && !cell.isConnectedTo(nearbyCell.id)) {
-                data.addConnection(cell.id, nearbyCell.id, &cache);
+    std::vector<NearbyCell> connectedCells(connectionOffsets.back());
+    auto connectionIndices = std::vector<int>(connectionOffsets.begin(), connectionOffsets.end() - 1);
+    for (int index = 0; index < numCells; ++index) {
+        for (int candidateIndex = candidateOffsets[index]; candidateIndex < candidateOffsets[index + 1]; ++candidateIndex) {
+            if (accepted[candidateIndex]) {
+                auto const& candidate = candidates[candidateIndex];
+                connectedCells[connectionIndices[index]++] = candidate;
+                connectedCells[connectionIndices[candidate.index]++] =
+                    NearbyCell{index, RealVector2D{-candidate.delta.x, -candidate.delta.y}, candidate.distanceSquared};
             }
         }
     }
+
+    //create connections ordered by angle
+    ThreadPool::getInstance().parallelFor(0, numCells, [&](size_t index) {
+        auto& cell = data.cells[index];
+        std::vector<std::pair<float, NearbyCell const*>> connectedCellsByAngle;
+        connectedCellsByAngle.reserve(connectionOffsets[index + 1] - connectionOffsets[index]);
+        for (int i = connectionOffsets[index]; i < connectionOffsets[index + 1]; ++i) {
+            connectedCellsByAngle.emplace_back(Math::angleOfVector(connectedCells[i].delta), &connectedCells[i]);
+        }
+        std::sort(connectedCellsByAngle.begin(), connectedCellsByAngle.end(), [](auto const& left, auto const& right) {
+            return left.first < right.first || (left.first == right.first && left.second->index < right.second->index);
+        });
+        for (auto const& [angle, connectedCell] : connectedCellsByAngle) {
+            ConnectionDescription connection;
+            connection.cellId = data.cells[connectedCell->index].id;
+            connection.distance = std::sqrt(connectedCell->distanceSquared);
+            connection.angleFromPrevious = cell.connections.empty() ? 360.0f - (connectedCellsByAngle.back().first - angle) : angle - connectedCellsByAngle[cell.connections.size() - 1].first;
+            cell.connections.emplace_back(connection);
+        }
+    });
 }
 
 void DescriptionEditService::removeStickiness(DataDescription& data)
@@ -387,22 +641,39 @@ void DescriptionEditService::removeStickiness(DataDescription& data)
     }
 }
 
-void DescriptionEditService::correctConnections(ClusteredDataDescription& data, IntVector2D const& worldSize)
+void DescriptionEditService::correctConnections(ClusteredDataDescription& data, IntVector2D const& origWorldSize, IntVector2D const& worldSize)
 {
     auto threshold = std::min(worldSize.x, worldSize.y) /3;
-    std::unordered_map<uint64_t, CellDescription&> cellById;
-    for (auto& cluster : data.clusters) {
-        for (auto& cell : cluster.cells) {
-            cellById.emplace(cell.id, cell);
+    SpaceCalculator origSpaceCalculator(origWorldSize);
+    SpaceCalculator spaceCalculator(worldSize);
+    auto isConnectionValid = [&](RealVector2D const& pos, RealVector2D const& connectingPos) {
+        auto delta = spaceCalculator.getCorrectedDirection(connectingPos - pos);
+        if (Math::length(delta) > threshold) {
+            return false;
+        }
+
+        //world sizes are integral, so a bond across a moved border differs by at least one unit
+        auto origDelta = origSpaceCalculator.getCorrectedDirection(connectingPos - pos);
+        return Math::length(delta - origDelta) < 0.5f;
+    };
+
+    std::vector<std::pair<uint64_t, RealVector2D>> posById;
+    for (auto const& cluster : data.clusters) {
+        for (auto const& cell : cluster.cells) {
+            posById.emplace_back(cell.id, cell.pos);
         }
     }
-    for (auto& cluster : data.clusters) {
-        for (auto& cell: cluster.cells) {
+    std::sort(posById.begin(), posById.end(), [](auto const& left, auto const& right) { return left.first < right.first; });
+
+    WorkStealingScheduler().run(toInt(data.clusters.size()), [&](int clusterIndex) {
+        for (auto& cell : data.clusters[clusterIndex].cells) {
             std::vector<ConnectionDescription> newConnections;
             float angleToAdd = 0;
             for (auto connection : cell.connections) {
-                auto& connectingCell = cellById.at(connection.cellId);
-                if (/*spaceCalculator.distance*/Math::length(cell.pos - connectingCell.pos) > threshold) {
+                auto connectingCellIt = std::lower_bound(
+                    posById.begin(), posById.end(), connection.cellId, [](auto const& element, uint64_t id) { return element.first < id; });
+                if (connectingCellIt == posById.end() || connectingCellIt->first != connection.cellId
+                    || !isConnectionValid(cell.pos, connectingCellIt->second)) {
                     angleToAdd += connection.angleFromPrevious;
                 } else {
                     connection.angleFromPrevious += angleToAdd;
@@ -415,7 +686,7 @@ void DescriptionEditService::correctConnections(ClusteredDataDescription& data,
             }
             cell.connections = newConnections;
         }
-    }
+    });
 }
 
 void DescriptionEditService::randomizeCellColors(ClusteredDataDescription& data, std::vector<int> const& colorCodes)
@@ -614,39 +885,6 @@ void DescriptionEditService::removeMetadata(CellDescription& cell)
     cell.metadata.name.clear();
 }
 
-bool DescriptionEditService::isCellPresent(Occupancy const& cellPosBySlot, SpaceCalculator const& spaceCalculator, RealVector2D const& posToCheck, float distance)
-{
-    auto intPos = toIntVector2D(posToCheck);
-
-    auto getMatchingSlots = [&cellPosBySlot](IntVector2D const& intPos) {
-        auto findResult = cellPosBySlot.find(intPos);
-        if (findResult != cellPosBySlot.end()) {
-            return findResult->second;
-        }
-        return std::vector<RealVector2D>{};
-    };
-
-    auto isOccupied = [&](std::vector<RealVector2D> const& cellPositions) {
-        for (auto const& cellPos : cellPositions) {
-            auto otherPos = spaceCalculator.getCorrectedPosition(cellPos);
-            if (Math::length(posToCheck - otherPos) < distance) {
-                return true;
-            }
-        }
-        return false;
-    };
-
-    auto distanceInt = toInt(ceilf(distance));
-    for (int dx = -distanceInt; dx <= distanceInt; ++dx) {
-        for (int dy = -distanceInt; dy <= distanceInt; ++dy) {
-            if (isOccupied(getMatchingSlots({intPos.x + dx, intPos.y + dy}))) {
-                return true;
-            }
-        }
-    }
-    return false;
-}
-
 uint64_t DescriptionEditService::getId(CellOrParticleDescription const& entity)
 {
     if (std::holds_alternative<CellDescription>(entity)) {
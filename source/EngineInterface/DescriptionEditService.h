@@ -1,7 +1,10 @@
 #pragma once
 
+#include <optional>
+
 #include "Base/Definitions.h"
 #include "Descriptions.h"
+#include "SpatialHashGrid.h"
 
 class DescriptionEditService
 {
@@ -53,6 +56,35 @@ public:
     };
     static DataDescription createUnconnectedCircle(CreateUnconnectedCircleParameters const& parameters);
 
+    //tiling of a world into a larger world with new ids, computed in advance so that the tiles can be filled in parallel
+    struct DuplicationPlan
+    {
+        std::vector<RealVector2D> tileOffsets;
+
+        //source data
+        std::vector<uint64_t> sourceCellOffsets;  //index of the first cell of each source cluster, ends with the number of cells
+        std::vector<std::pair<uint64_t, uint64_t>> sourceCellIndexById;  //sorted by id
+        std::vector<int> sourceCreatureIds;  //sorted
+
+        //output clusters in tile order
+        std::vector<int> sourceClusterIndices;
+        std::vector<int> clusterTileIndices;
+        std::vector<uint64_t> cellOffsets;  //index of the first cell of each output cluster, ends with the number of cells
+
+        //output particles in tile order
+        std::vector<int> sourceParticleIndices;
+        std::vector<int> particleTileIndices;
+
+        //new ids: consecutive for the output cells followed by the output particles
+        uint64_t firstId = 0;
+        std::vector<int> newCreatureIds;  //sourceCreatureIds.size() entries per tile
+
+        uint64_t getNumCells() const;
+        int getOutputClusterIndex(uint64_t cellIndex) const;
+        uint64_t getSourceCellIndex(uint64_t cellId) const;
+        int getNewCreatureId(int tileIndex, int creatureId) const;
+    };
+    static DuplicationPlan createDuplicationPlan(ClusteredDataDescription const& data, IntVector2D const& origWorldSize, IntVector2D const& worldSize);
     static void duplicate(ClusteredDataDescription& data, IntVector2D const& origWorldSize, IntVector2D const& worldSize);
 
     struct GridMultiplyParameters
@@ -92,13 +124,15 @@ public:
         DataDescription&& existentData,
         bool& overlappingCheckSuccessful);
 
-    using Occupancy = std::unordered_map<IntVector2D, std::vector<RealVector2D>>;
+    using Occupancy = SpatialHashGrid;
     static void
     addIfSpaceAvailable(DataDescription& result, Occupancy& cellOccupancy, DataDescription const& toAdd, float distance, IntVector2D const& worldSize);
 
-    static void reconnectCells(DataDescription& data, float maxDistance);
+    //worldSize: connections across the borders of the toroidal world are created if specified
+    static void reconnectCells(DataDescription& data, float maxDistance, std::optional<IntVector2D> const& worldSize = std::nullopt);
     static void removeStickiness(DataDescription& data);
-    static void correctConnections(ClusteredDataDescription& data, IntVector2D const& worldSize);
+    //removes connections which are too long in the new world or span a border which has been moved by resizing
+    static void correctConnections(ClusteredDataDescription& data, IntVector2D const& origWorldSize, IntVector2D const& worldSize);
 
     static void randomizeCellColors(ClusteredDataDescription& data, std::vector<int> const& colorCodes);
     static void randomizeGenomeColors(ClusteredDataDescription& data, std::vector<int> const& colorCodes);
@@ -120,9 +154,4 @@ public:
 
 private:
     static void removeMetadata(CellDescription& cell);
-    static bool isCellPresent(
-        Occupancy const& cellPosBySlot,
-        SpaceCalculator const& spaceCalculator,
-        RealVector2D const& posToCheck,
-        float distance);
 };
@@ -1,8 +1,11 @@
 #include "Descriptions.h"
 
+#include <unordered_map>
+
 #include <boost/range/adaptors.hpp>
 
 #include "GenomeDescriptionService.h"
+#include "Base/ClusterLabeling.h"
 #include "Base/Math.h"
 #include "Base/Physics.h"
 
@@ -93,6 +96,39 @@ RealVector2D ClusterDescription::getClusterPosFromCells() const
     return result;
 }
 
+ClusteredDataDescription::ClusteredDataDescription(DataDescription const& data)
+{
+    std::unordered_map<uint64_t, int> cellIndexById;
+    cellIndexById.reserve(data.cells.size());
+    for (auto const& [index, cell] : data.cells | boost::adaptors::indexed(0)) {
+        cellIndexById.emplace(cell.id, toInt(index));
+    }
+    ClusterLabeling labeling(toInt(data.cells.size()));
+    for (auto const& [index, cell] : data.cells | boost::adaptors::indexed(0)) {
+        for (auto const& connection : cell.connections) {
+            auto findResult = cellIndexById.find(connection.cellId);
+            if (findResult != cellIndexById.end()) {
+                labeling.connect(toInt(index), findResult->second);
+            }
+        }
+    }
+    std::vector<int> labels;
+    auto numClusters = labeling.calcLabels(labels);
+    std::vector<int> sortedCellIndices;
+    std::vector<int> offsets;
+    ClusterLabeling::groupByLabel(labels, numClusters, sortedCellIndices, offsets);
+
+    clusters.resize(numClusters);
+    for (int i = 0; i < numClusters; ++i) {
+        auto& cells = clusters[i].cells;
+        cells.reserve(offsets[i + 1] - offsets[i]);
+        for (int j = offsets[i]; j < offsets[i + 1]; ++j) {
+            cells.emplace_back(data.cells[sortedCellIndices[j]]);
+        }
+    }
+    particles = data.particles;
+}
+
 void ClusteredDataDescription::setCenter(RealVector2D const& center)
 {
     auto origCenter = calcCenter();
@@ -590,12 +590,15 @@ struct ParticleDescription
     }
 };
 
+struct DataDescription;
+
 struct ClusteredDataDescription
 {
     std::vector<ClusterDescription> clusters;
     std::vector<ParticleDescription> particles;
 
     ClusteredDataDescription() = default;
+    explicit ClusteredDataDescription(DataDescription const& data);  //clusters are the connected components of the cells
     auto operator<=>(ClusteredDataDescription const&) const = default;
 
     ClusteredDataDescription& addClusters(std::vector<ClusterDescription> const& value)
@@ -0,0 +1,8 @@
+#pragma once
+
+using EngineBackend = int;
+enum EngineBackend_
+{
+    EngineBackend_Gpu,
+    EngineBackend_Cpu
+};
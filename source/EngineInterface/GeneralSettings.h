@@ -1,7 +1,11 @@
 #pragma once
 
+#include <cstdint>
+
 struct GeneralSettings
 {
     int worldSizeX;
     int worldSizeY;
+    uint64_t seed = 0;  //seed of the random numbers on the host and the GPU
+    bool deterministic = false;  //bit-reproducible time steps on the CPU backend at the cost of parallelism (GPU time steps are not fully reproducible, see PhiloxRandom)
 };
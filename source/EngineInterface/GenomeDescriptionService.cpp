@@ -3,34 +3,36 @@
 #include <variant>
 
 #include "Base/Definitions.h"
+#include "Base/ThreadPool.h"
 
 #include "GenomeConstants.h"
 
 namespace
 {
-    void writeByte(std::vector<uint8_t>& data, int value)
+    //the encoding writes into a buffer presized by getEncodedSize
+    void writeByte(uint8_t*& data, int value)
     {
-        data.emplace_back(static_cast<uint8_t>(value));
+        *data++ = static_cast<uint8_t>(value);
     }
-    void writeOptionalByte(std::vector<uint8_t>& data, std::optional<int> value)
+    void writeOptionalByte(uint8_t*& data, std::optional<int> value)
     {
-        data.emplace_back(static_cast<uint8_t>(value.value_or(-1)));
+        *data++ = static_cast<uint8_t>(value.value_or(-1));
     }
-    void writeByteWithInfinity(std::vector<uint8_t>& data, int value)
+    void writeByteWithInfinity(uint8_t*& data, int value)
     {
-        data.emplace_back(static_cast<uint8_t>(std::min(255, value)));
+        *data++ = static_cast<uint8_t>(std::min(255, value));
     }
-    void writeBool(std::vector<uint8_t>& data, bool value)
+    void writeBool(uint8_t*& data, bool value)
     {
-        data.emplace_back(value ? 1 : 0);
+        *data++ = value ? 1 : 0;
     }
-    void writeFloat(std::vector<uint8_t>& data, float value) { data.emplace_back(static_cast<uint8_t>(static_cast<int8_t>(value * 128))); }
-    void writeWord(std::vector<uint8_t>& data, int value)
+    void writeFloat(uint8_t*& data, float value) { *data++ = static_cast<uint8_t>(static_cast<int8_t>(value * 128)); }
+    void writeWord(uint8_t*& data, int value)
     {
-        data.emplace_back(static_cast<uint8_t>(value & 0xff));
-        data.emplace_back(static_cast<uint8_t>((value >> 8) % 0xff));
+        *data++ = static_cast<uint8_t>(value & 0xff);
+        *data++ = static_cast<uint8_t>((value >> 8) % 0xff);
     }
-    void writeAngle(std::vector<uint8_t>& data, float value)
+    void writeAngle(uint8_t*& data, float value)
     {
         if (value > 180.0f) {
             value -= 360.0f;
@@ -38,38 +40,38 @@ namespace
         if (value < -180.0f) {
             value += 360.0f;
         }
-        data.emplace_back(static_cast<uint8_t>(static_cast<int8_t>(value / 180 * 120)));
+        *data++ = static_cast<uint8_t>(static_cast<int8_t>(value / 180 * 120));
     }
-    void writeDensity(std::vector<uint8_t>& data, float value)
+    void writeDensity(uint8_t*& data, float value)
     {
-        data.emplace_back(static_cast<uint8_t>(static_cast<int8_t>((value * 2 - 1) * 128)));
+        *data++ = static_cast<uint8_t>(static_cast<int8_t>((value * 2 - 1) * 128));
     }
-    void writeEnergy(std::vector<uint8_t>& data, float value)
+    void writeEnergy(uint8_t*& data, float value)
     {
         writeFloat(data, (value - 150.0f) / 100);
     }
-    void writeNeuronProperty(std::vector<uint8_t>& data, float value)
+    void writeNeuronProperty(uint8_t*& data, float value)
     {
         value = std::max(-3.9f, std::min(3.9f, value));
         writeFloat(data, value / 4);
     }
-    void writeDistance(std::vector<uint8_t>& data, float value)
+    void writeDistance(uint8_t*& data, float value)
     {
-        data.emplace_back(static_cast<uint8_t>((value - 0.5f) * 255));
+        *data++ = static_cast<uint8_t>((value - 0.5f) * 255);
     }
-    void writeStiffness(std::vector<uint8_t>& data, float value) { data.emplace_back(static_cast<uint8_t>(value * 255)); }
-    void writeGenome(std::vector<uint8_t>& data, std::variant<MakeGenomeCopy, std::vector<uint8_t>> const& value)
+    void writeStiffness(uint8_t*& data, float value) { *data++ = static_cast<uint8_t>(value * 255); }
+    void writeGenome(uint8_t*& data, std::variant<MakeGenomeCopy, std::vector<uint8_t>> const& value)
     {
         auto makeGenomeCopy = std::holds_alternative<MakeGenomeCopy>(value);
         writeBool(data, makeGenomeCopy);
         if (!makeGenomeCopy) {
-            auto genome = std::get<std::vector<uint8_t>>(value);
+            auto const& genome = std::get<std::vector<uint8_t>>(value);
             writeWord(data, static_cast<int>(genome.size()));
-            data.insert(data.end(), genome.begin(), genome.end());
+            data = std::copy(genome.begin(), genome.end(), data);
         }
     }
 
-    uint8_t readByte(std::vector<uint8_t> const& data, int& pos)
+    uint8_t readByte(std::span<uint8_t const> data, int& pos)
     {
         if (pos >= data.size()) {
             return 0;
@@ -77,12 +79,12 @@ namespace
         uint8_t result = data[pos++];
         return result;
     }
-    std::optional<int> readOptionalByte(std::vector<uint8_t> const& data, int& pos)
+    std::optional<int> readOptionalByte(std::span<uint8_t const> data, int& pos)
     {
         auto value = static_cast<int>(readByte(data, pos));
         return value > 127 ? std::nullopt : std::make_optional(value);
     }
-    std::optional<int> readOptionalByte(std::vector<uint8_t> const& data, int& pos, int moduloValue)
+    std::optional<int> readOptionalByte(std::span<uint8_t const> data, int& pos, int moduloValue)
     {
         auto value = static_cast<int>(readByte(data, pos));
         return value > 127 ? std::nullopt : std::make_optional(value % moduloValue);
@@ -93,340 +95,504 @@ namespace
         return b == 255 ? std::numeric_limits<int>::max() : b;
 
     }
-    int readByteWithInfinity(std::vector<uint8_t> const& data, int& pos)
+    int readByteWithInfinity(std::span<uint8_t const> data, int& pos)
     {
         return convertByteToByteWithInfinity(readByte(data, pos));
     }
-    bool readBool(std::vector<uint8_t> const& data, int& pos)
+    bool readBool(std::span<uint8_t const> data, int& pos)
     {
         return static_cast<int8_t>(readByte(data, pos)) > 0;
     }
-    int readWord(std::vector<uint8_t> const& data, int& pos)
+    int readWord(std::span<uint8_t const> data, int& pos)
     {
         return static_cast<int>(readByte(data, pos)) | (static_cast<int>(readByte(data, pos) << 8));
     }
     //between -1 and 1
-    float readFloat(std::vector<uint8_t> const& data, int& pos)
+    float readFloat(std::span<uint8_t const> data, int& pos)
     {
         return static_cast<float>(static_cast<int8_t>(readByte(data, pos))) / 128;
     }
     //between -180 and 180
-    float readAngle(std::vector<uint8_t> const& data, int& pos)
+    float readAngle(std::span<uint8_t const> data, int& pos)
     {
         return static_cast<float>(static_cast<int8_t>(readByte(data, pos))) / 120 * 180;
     }
     //between 36 and 1060
-    float readEnergy(std::vector<uint8_t> const& data, int& pos)
+    float readEnergy(std::span<uint8_t const> data, int& pos)
     {
-        return readFloat(data, pos) * 100 + 150.0f; 
+        return readFloat(data, pos) * 100 + 150.0f;
     }
     //between 0 and 1
-    float readDensity(std::vector<uint8_t> const& data, int& pos)
+    float readDensity(std::span<uint8_t const> data, int& pos)
     {
         return (readFloat(data, pos) + 1.0f) / 2;
     }
-    float readNeuronProperty(std::vector<uint8_t> const& data, int& pos) { return readFloat(data, pos) * 4; }
-    float readDistance(std::vector<uint8_t> const& data, int& pos)
+    float readNeuronProperty(std::span<uint8_t const> data, int& pos) { return readFloat(data, pos) * 4; }
+    float readDistance(std::span<uint8_t const> data, int& pos)
     {
         return toFloat(readByte(data, pos)) / 255 + 0.5f;
     }
-    float readStiffness(std::vector<uint8_t> const& data, int& pos)
+    float readStiffness(std::span<uint8_t const> data, int& pos)
     {
         return toFloat(readByte(data, pos)) / 255;
     }
 
-    std::variant<MakeGenomeCopy, std::vector<uint8_t>> readGenome(std::vector<uint8_t> const& data, int& pos)
+    //returns nullopt if a genome copy is made
+    std::optional<std::span<uint8_t const>> readGenomeView(std::span<uint8_t const> data, int& pos)
     {
-        std::variant<MakeGenomeCopy, std::vector<uint8_t>> result;
-
         bool makeGenomeCopy = readBool(data, pos);
         if (makeGenomeCopy) {
-            result = MakeGenomeCopy();
-        } else {
-            auto size = readWord(data, pos);
-            size = std::min(size, toInt(data.size()) - pos);
-            std::vector<uint8_t> copiedGenome;
-            copiedGenome.reserve(size);
-            for (int i = 0; i < size; ++i) {
-                copiedGenome.emplace_back(readByte(data, pos));
-            }
-            result = copiedGenome;
+            return std::nullopt;
+        }
+        auto size = readWord(data, pos);
+        size = std::max(0, std::min(size, toInt(data.size()) - pos));
+        auto result = data.subspan(pos, size);
+        pos += size;
+        return result;
+    }
+
+    std::variant<MakeGenomeCopy, std::vector<uint8_t>> readGenome(std::span<uint8_t const> data, int& pos)
+    {
+        auto genome = readGenomeView(data, pos);
+        if (!genome) {
+            return MakeGenomeCopy();
+        }
+        return std::vector<uint8_t>(genome->begin(), genome->end());
+    }
+
+    int getHeaderSize(GenomeEncodingSpecification const& spec)
+    {
+        auto result = Const::GenomeHeaderNumRepetitionsPos;
+        if (spec._numRepetitions) {
+            ++result;
+        }
+        if (spec._concatenationAngle1) {
+            ++result;
+        }
+        if (spec._concatenationAngle2) {
+            ++result;
+        }
+        return result;
+    }
+
+    //without the encoded genome of constructors and injectors
+    int getCellFunctionBytes(CellFunction cellFunction)
+    {
+        switch (cellFunction) {
+        case CellFunction_Neuron:
+            return Const::NeuronBytes;
+        case CellFunction_Transmitter:
+            return Const::TransmitterBytes;
+        case CellFunction_Constructor:
+            return Const::ConstructorFixedBytes;
+        case CellFunction_Sensor:
+            return Const::SensorBytes;
+        case CellFunction_Nerve:
+            return Const::NerveBytes;
+        case CellFunction_Attacker:
+            return Const::AttackerBytes;
+        case CellFunction_Injector:
+            return Const::InjectorFixedBytes;
+        case CellFunction_Muscle:
+            return Const::MuscleBytes;
+        case CellFunction_Defender:
+            return Const::DefenderBytes;
+        case CellFunction_Reconnector:
+            return Const::ReconnectorBytes;
+        case CellFunction_Detonator:
+            return Const::DetonatorBytes;
+        default:
+            return 0;
+        }
+    }
+
+    int getEncodedGenomeSize(std::variant<MakeGenomeCopy, std::vector<uint8_t>> const& value)
+    {
+        return std::holds_alternative<MakeGenomeCopy>(value) ? 1 : 3 + toInt(std::get<std::vector<uint8_t>>(value).size());
+    }
+
+    GenomeHeaderDescription readHeader(std::span<uint8_t const> data, int& pos, GenomeEncodingSpecification const& spec)
+    {
+        GenomeHeaderDescription result;
+        result.shape = readByte(data, pos) % ConstructionShape_Count;
+        result.numBranches = (readByte(data, pos) + 5) % 6 + 1;
+        result.separateConstruction = readBool(data, pos);
+        result.angleAlignment = readByte(data, pos) % ConstructorAngleAlignment_Count;
+        result.stiffness = readStiffness(data, pos);
+        result.connectionDistance = readDistance(data, pos);
+        if (spec._numRepetitions) {
+            result.numRepetitions = readByteWithInfinity(data, pos);
+        }
+        if (spec._concatenationAngle1) {
+            result.concatenationAngle1 = readAngle(data, pos);
+        }
+        if (spec._concatenationAngle2) {
+            result.concatenationAngle2 = readAngle(data, pos);
         }
         return result;
     }
+
+    //reads over the node with the same semantics as the decoding, i.e. missing bytes at the end are treated as zeros
+    GenomeNodeView readNodeView(std::span<uint8_t const> data, int pos)
+    {
+        GenomeNodeView result;
+        result.address = pos;
+        result.cellFunction = readByte(data, pos) % CellFunction_Count;
+        pos = std::min(pos + Const::CellBasicBytes - 1 + getCellFunctionBytes(result.cellFunction), toInt(data.size()));
+        if (result.cellFunction == CellFunction_Constructor || result.cellFunction == CellFunction_Injector) {
+            result.subGenome = readGenomeView(data, pos);
+        }
+        result.size = pos - result.address;
+        return result;
+    }
+}
+
+GenomeView::Iterator::Iterator(std::span<uint8_t const> data, int address)
+    : _data(data)
+{
+    if (address < toInt(data.size())) {
+        _node = readNodeView(data, address);
+    } else {
+        _node.address = toInt(data.size());
+    }
+}
+
+auto GenomeView::Iterator::operator++() -> Iterator&
+{
+    *this = Iterator(_data, _node.address + _node.size);
+    return *this;
+}
+
+auto GenomeView::Iterator::operator++(int) -> Iterator
+{
+    auto result = *this;
+    ++*this;
+    return result;
+}
+
+GenomeView::GenomeView(std::span<uint8_t const> data, GenomeEncodingSpecification const& spec)
+    : _data(data)
+    , _spec(spec)
+{}
+
+GenomeHeaderDescription GenomeView::getHeader() const
+{
+    int pos = 0;
+    return readHeader(_data, pos, _spec);
+}
+
+auto GenomeView::begin() const -> Iterator
+{
+    return Iterator(_data, std::min(getHeaderSize(_spec), toInt(_data.size())));
+}
+
+auto GenomeView::end() const -> Iterator
+{
+    return Iterator(_data, toInt(_data.size()));
+}
+
+int GenomeView::getNumNodes() const
+{
+    return toInt(std::distance(begin(), end()));
+}
+
+std::optional<GenomeView> GenomeView::getSubGenome(GenomeNodeView const& node) const
+{
+    if (!node.subGenome) {
+        return std::nullopt;
+    }
+    return GenomeView(*node.subGenome, _spec);
 }
 
 std::vector<uint8_t> GenomeDescriptionService::convertDescriptionToBytes(GenomeDescription const& genome, GenomeEncodingSpecification const& spec)
 {
     auto const& cells = genome.cells;
-    std::vector<uint8_t> result;
-    result.reserve(cells.size() * (Const::CellBasicBytes + Const::ConstructorFixedBytes) + Const::GenomeHeaderSize);
-    writeByte(result, genome.header.shape);
-    writeByte(result, genome.header.numBranches);
-    writeBool(result, genome.header.separateConstruction);
-    writeByte(result, genome.header.angleAlignment);
-    writeStiffness(result, genome.header.stiffness);
-    writeDistance(result, genome.header.connectionDistance);
+    std::vector<uint8_t> result(getEncodedSize(genome, spec));
+    auto data = result.data();
+    writeByte(data, genome.header.shape);
+    writeByte(data, genome.header.numBranches);
+    writeBool(data, genome.header.separateConstruction);
+    writeByte(data, genome.header.angleAlignment);
+    writeStiffness(data, genome.header.stiffness);
+    writeDistance(data, genome.header.connectionDistance);
     if (spec._numRepetitions) {
-        writeByteWithInfinity(result, genome.header.numRepetitions);
+        writeByteWithInfinity(data, genome.header.numRepetitions);
     }
     if (spec._concatenationAngle1) {
-        writeAngle(result, genome.header.concatenationAngle1);
+        writeAngle(data, genome.header.concatenationAngle1);
     }
     if (spec._concatenationAngle2) {
-        writeAngle(result, genome.header.concatenationAngle2);
+        writeAngle(data, genome.header.concatenationAngle2);
     }
 
     for (auto const& cell : cells) {
-        writeByte(result, cell.getCellFunctionType());
-        writeAngle(result, cell.referenceAngle);
-        writeEnergy(result, cell.energy);
-        writeOptionalByte(result, cell.numRequiredAdditionalConnections);
-        writeByte(result, cell.executionOrderNumber);
-        writeByte(result, cell.color);
-        writeOptionalByte(result, cell.inputExecutionOrderNumber);
-        writeBool(result, cell.outputBlocked);
+        writeByte(data, cell.getCellFunctionType());
+        writeAngle(data, cell.referenceAngle);
+        writeEnergy(data, cell.energy);
+        writeOptionalByte(data, cell.numRequiredAdditionalConnections);
+        writeByte(data, cell.executionOrderNumber);
+        writeByte(data, cell.color);
+        writeOptionalByte(data, cell.inputExecutionOrderNumber);
+        writeBool(data, cell.outputBlocked);
         switch (cell.getCellFunctionType()) {
         case CellFunction_Neuron: {
             auto const& neuron = std::get<NeuronGenomeDescription>(*cell.cellFunction);
             for (int row = 0; row < MAX_CHANNELS; ++row) {
                 for (int col = 0; col < MAX_CHANNELS; ++col) {
-                    writeNeuronProperty(result, neuron.weights[row][col]);
+                    writeNeuronProperty(data, neuron.weights[row][col]);
                 }
             }
             for (int i = 0; i < MAX_CHANNELS; ++i) {
-                writeNeuronProperty(result, neuron.biases[i]);
+                writeNeuronProperty(data, neuron.biases[i]);
             }
             for (int i = 0; i < MAX_CHANNELS; ++i) {
-                writeByte(result, neuron.activationFunctions[i]);
+                writeByte(data, neuron.activationFunctions[i]);
             }
         } break;
         case CellFunction_Transmitter: {
             auto const& transmitter = std::get<TransmitterGenomeDescription>(*cell.cellFunction);
-            writeByte(result, transmitter.mode);
+            writeByte(data, transmitter.mode);
         } break;
         case CellFunction_Constructor: {
             auto const& constructor = std::get<ConstructorGenomeDescription>(*cell.cellFunction);
-            writeByte(result, constructor.mode);
-            writeWord(result, constructor.constructionActivationTime);
-            writeAngle(result, constructor.constructionAngle1);
-            writeAngle(result, constructor.constructionAngle2);
-            writeGenome(result, constructor.genome);
+            writeByte(data, constructor.mode);
+            writeWord(data, constructor.constructionActivationTime);
+            writeAngle(data, constructor.constructionAngle1);
+            writeAngle(data, constructor.constructionAngle2);
+            writeGenome(data, constructor.genome);
         } break;
         case CellFunction_Sensor: {
             auto const& sensor = std::get<SensorGenomeDescription>(*cell.cellFunction);
-            writeByte(result, sensor.fixedAngle.has_value() ? SensorMode_FixedAngle : SensorMode_Neighborhood);
-            writeAngle(result, sensor.fixedAngle.has_value() ? *sensor.fixedAngle : 0.0f);
-            writeDensity(result, sensor.minDensity);
-            writeOptionalByte(result, sensor.restrictToColor);
-            writeByte(result, sensor.restrictToMutants);
-            writeOptionalByte(result, sensor.minRange);
-            writeOptionalByte(result, sensor.maxRange);
+            writeByte(data, sensor.fixedAngle.has_value() ? SensorMode_FixedAngle : SensorMode_Neighborhood);
+            writeAngle(data, sensor.fixedAngle.has_value() ? *sensor.fixedAngle : 0.0f);
+            writeDensity(data, sensor.minDensity);
+            writeOptionalByte(data, sensor.restrictToColor);
+            writeByte(data, sensor.restrictToMutants);
+            writeOptionalByte(data, sensor.minRange);
+            writeOptionalByte(data, sensor.maxRange);
         } break;
         case CellFunction_Nerve: {
             auto const& nerve = std::get<NerveGenomeDescription>(*cell.cellFunction);
-            writeByte(result, nerve.pulseMode);
-            writeByte(result, nerve.alternationMode);
+            writeByte(data, nerve.pulseMode);
+            writeByte(data, nerve.alternationMode);
         } break;
         case CellFunction_Attacker: {
             auto const& attacker = std::get<AttackerGenomeDescription>(*cell.cellFunction);
-            writeByte(result, attacker.mode);
+            writeByte(data, attacker.mode);
         } break;
         case CellFunction_Injector: {
             auto const& injector = std::get<InjectorGenomeDescription>(*cell.cellFunction);
-            writeByte(result, injector.mode);
-            writeGenome(result, injector.genome);
+            writeByte(data, injector.mode);
+            writeGenome(data, injector.genome);
         } break;
         case CellFunction_Muscle: {
             auto const& muscle = std::get<MuscleGenomeDescription>(*cell.cellFunction);
-            writeByte(result, muscle.mode);
+            writeByte(data, muscle.mode);
         } break;
         case CellFunction_Defender: {
             auto const& defender = std::get<DefenderGenomeDescription>(*cell.cellFunction);
-            writeByte(result, defender.mode);
+            writeByte(data, defender.mode);
         } break;
         case CellFunction_Reconnector: {
             auto const& reconnector = std::get<ReconnectorGenomeDescription>(*cell.cellFunction);
-            writeOptionalByte(result, reconnector.restrictToColor);
-            writeByte(result, reconnector.restrictToMutants);
+            writeOptionalByte(data, reconnector.restrictToColor);
+            writeByte(data, reconnector.restrictToMutants);
         } break;
         case CellFunction_Detonator: {
             auto const& detonator = std::get<DetonatorGenomeDescription>(*cell.cellFunction);
-            writeWord(result, detonator.countdown);
+            writeWord(data, detonator.countdown);
         } break;
         }
     }
     return result;
 }
 
-namespace
+GenomeDescription GenomeDescriptionService::convertBytesToDescription(std::span<uint8_t const> data, GenomeEncodingSpecification const& spec)
 {
-    struct ConversionResult
-    {
-        GenomeDescription genome;
-        int lastBytePosition = 0;
-    };
-    
-    ConversionResult convertBytesToDescriptionIntern(
-        std::vector<uint8_t> const& data,
-        size_t maxBytePosition,
-        size_t maxEntries,
-        GenomeEncodingSpecification const& spec)
-    {
-        SimulationParameters parameters;
-        ConversionResult result;
-
-        int nodeIndex = 0;
-        auto& bytePosition = result.lastBytePosition;
-
-        result.genome.header.shape = readByte(data, bytePosition) % ConstructionShape_Count;
-        result.genome.header.numBranches = (readByte(data, bytePosition) + 5) % 6 + 1;
-        result.genome.header.separateConstruction = readBool(data, bytePosition);
-        result.genome.header.angleAlignment = readByte(data, bytePosition) % ConstructorAngleAlignment_Count;
-        result.genome.header.stiffness = readStiffness(data, bytePosition);
-        result.genome.header.connectionDistance = readDistance(data, bytePosition);
-        if (spec._numRepetitions) {
-            result.genome.header.numRepetitions = readByteWithInfinity(data, bytePosition);
-        }
-        if (spec._concatenationAngle1) {
-            result.genome.header.concatenationAngle1 = readAngle(data, bytePosition);
-        }
-        if (spec._concatenationAngle2) {
-            result.genome.header.concatenationAngle2 = readAngle(data, bytePosition);
-        }
-        
-        while (bytePosition < maxBytePosition && nodeIndex < maxEntries) {
-            CellFunction cellFunction = readByte(data, bytePosition) % CellFunction_Count;
-
-            CellGenomeDescription cell;
-            cell.referenceAngle = readAngle(data, bytePosition);
-            cell.energy = readEnergy(data, bytePosition);
-            cell.numRequiredAdditionalConnections = readOptionalByte(data, bytePosition, MAX_CELL_BONDS + 1);
-            cell.executionOrderNumber = readByte(data, bytePosition) % parameters.cellNumExecutionOrderNumbers;
-            cell.color = readByte(data, bytePosition) % MAX_COLORS;
-            cell.inputExecutionOrderNumber = readOptionalByte(data, bytePosition, parameters.cellNumExecutionOrderNumbers);
-            cell.outputBlocked = readBool(data, bytePosition);
-
-            switch (cellFunction) {
-            case CellFunction_Neuron: {
-                NeuronGenomeDescription neuron;
-                for (int row = 0; row < MAX_CHANNELS; ++row) {
-                    for (int col = 0; col < MAX_CHANNELS; ++col) {
-                        neuron.weights[row][col] = readNeuronProperty(data, bytePosition);
-                    }
-                }
-                for (int i = 0; i < MAX_CHANNELS; ++i) {
-                    neuron.biases[i] = readNeuronProperty(data, bytePosition);
-                }
-                for (int i = 0; i < MAX_CHANNELS; ++i) {
-                    neuron.activationFunctions[i] = readByte(data, bytePosition) % NeuronActivationFunction_Count;
-                }
-                cell.cellFunction = neuron;
-            } break;
-            case CellFunction_Transmitter: {
-                TransmitterGenomeDescription transmitter;
-                transmitter.mode = readByte(data, bytePosition) % EnergyDistributionMode_Count;
-                cell.cellFunction = transmitter;
-            } break;
-            case CellFunction_Constructor: {
-                ConstructorGenomeDescription constructor;
-                constructor.mode = readByte(data, bytePosition);
-                constructor.constructionActivationTime = readWord(data, bytePosition);
-                constructor.constructionAngle1 = readAngle(data, bytePosition);
-                constructor.constructionAngle2 = readAngle(data, bytePosition);
-                constructor.genome = readGenome(data, bytePosition);
-                cell.cellFunction = constructor;
-            } break;
-            case CellFunction_Sensor: {
-                SensorGenomeDescription sensor;
-                auto mode = readByte(data, bytePosition) % SensorMode_Count;
-                auto angle = readAngle(data, bytePosition);
-                if (mode == SensorMode_FixedAngle) {
-                    sensor.fixedAngle = angle;
+    static auto const numExecutionOrderNumbers = SimulationParameters().cellNumExecutionOrderNumbers;
+
+    GenomeDescription result;
+    int bytePosition = 0;
+    result.header = readHeader(data, bytePosition, spec);
+
+    while (bytePosition < data.size()) {
+        CellFunction cellFunction = readByte(data, bytePosition) % CellFunction_Count;
+
+        auto& cell = result.cells.emplace_back();
+        cell.referenceAngle = readAngle(data, bytePosition);
+        cell.energy = readEnergy(data, bytePosition);
+        cell.numRequiredAdditionalConnections = readOptionalByte(data, bytePosition, MAX_CELL_BONDS + 1);
+        cell.executionOrderNumber = readByte(data, bytePosition) % numExecutionOrderNumbers;
+        cell.color = readByte(data, bytePosition) % MAX_COLORS;
+        cell.inputExecutionOrderNumber = readOptionalByte(data, bytePosition, numExecutionOrderNumbers);
+        cell.outputBlocked = readBool(data, bytePosition);
+
+        switch (cellFunction) {
+        case CellFunction_Neuron: {
+            NeuronGenomeDescription neuron;
+            for (int row = 0; row < MAX_CHANNELS; ++row) {
+                for (int col = 0; col < MAX_CHANNELS; ++col) {
+                    neuron.weights[row][col] = readNeuronProperty(data, bytePosition);
                 }
-                sensor.minDensity = readDensity(data, bytePosition);
-                sensor.restrictToColor = readOptionalByte(data, bytePosition, MAX_COLORS);
-                sensor.restrictToMutants = readByte(data, bytePosition) % SensorRestrictToMutants_Count;
-                sensor.minRange = readOptionalByte(data, bytePosition);
-                sensor.maxRange = readOptionalByte(data, bytePosition);
-                cell.cellFunction = sensor;
-            } break;
-            case CellFunction_Nerve: {
-                NerveGenomeDescription nerve;
-                nerve.pulseMode = readByte(data, bytePosition);
-                nerve.alternationMode = readByte(data, bytePosition);
-                cell.cellFunction = nerve;
-            } break;
-            case CellFunction_Attacker: {
-                AttackerGenomeDescription attacker;
-                attacker.mode = readByte(data, bytePosition) % EnergyDistributionMode_Count;
-                cell.cellFunction = attacker;
-            } break;
-            case CellFunction_Injector: {
-                InjectorGenomeDescription injector;
-                injector.mode = readByte(data, bytePosition) % InjectorMode_Count;
-                injector.genome = readGenome(data, bytePosition);
-                cell.cellFunction = injector;
-            } break;
-            case CellFunction_Muscle: {
-                MuscleGenomeDescription muscle;
-                muscle.mode = readByte(data, bytePosition) % MuscleMode_Count;
-                cell.cellFunction = muscle;
-            } break;
-            case CellFunction_Defender: {
-                DefenderGenomeDescription defender;
-                defender.mode = readByte(data, bytePosition) % DefenderMode_Count;
-                cell.cellFunction = defender;
-            } break;
-            case CellFunction_Reconnector: {
-                ReconnectorGenomeDescription reconnector;
-                reconnector.restrictToColor = readOptionalByte(data, bytePosition, MAX_COLORS);
-                reconnector.restrictToMutants = readByte(data, bytePosition) % ReconnectorRestrictToMutants_Count;
-                cell.cellFunction = reconnector;
-            } break;
-            case CellFunction_Detonator: {
-                DetonatorGenomeDescription detonator;
-                detonator.countdown = readWord(data, bytePosition);
-                cell.cellFunction = detonator;
-            } break;
             }
-            result.genome.cells.emplace_back(cell);
-            ++nodeIndex;
+            for (int i = 0; i < MAX_CHANNELS; ++i) {
+                neuron.biases[i] = readNeuronProperty(data, bytePosition);
+            }
+            for (int i = 0; i < MAX_CHANNELS; ++i) {
+                neuron.activationFunctions[i] = readByte(data, bytePosition) % NeuronActivationFunction_Count;
+            }
+            cell.cellFunction = std::move(neuron);
+        } break;
+        case CellFunction_Transmitter: {
+            TransmitterGenomeDescription transmitter;
+            transmitter.mode = readByte(data, bytePosition) % EnergyDistributionMode_Count;
+            cell.cellFunction = transmitter;
+        } break;
+        case CellFunction_Constructor: {
+            ConstructorGenomeDescription constructor;
+            constructor.mode = readByte(data, bytePosition);
+            constructor.constructionActivationTime = readWord(data, bytePosition);
+            constructor.constructionAngle1 = readAngle(data, bytePosition);
+            constructor.constructionAngle2 = readAngle(data, bytePosition);
+            constructor.genome = readGenome(data, bytePosition);
+            cell.cellFunction = std::move(constructor);
+        } break;
+        case CellFunction_Sensor: {
+            SensorGenomeDescription sensor;
+            auto mode = readByte(data, bytePosition) % SensorMode_Count;
+            auto angle = readAngle(data, bytePosition);
+            if (mode == SensorMode_FixedAngle) {
+                sensor.fixedAngle = angle;
+            }
+            sensor.minDensity = readDensity(data, bytePosition);
+            sensor.restrictToColor = readOptionalByte(data, bytePosition, MAX_COLORS);
+            sensor.restrictToMutants = readByte(data, bytePosition) % SensorRestrictToMutants_Count;
+            sensor.minRange = readOptionalByte(data, bytePosition);
+            sensor.maxRange = readOptionalByte(data, bytePosition);
+            cell.cellFunction = sensor;
+        } break;
+        case CellFunction_Nerve: {
+            NerveGenomeDescription nerve;
+            nerve.pulseMode = readByte(data, bytePosition);
+            nerve.alternationMode = readByte(data, bytePosition);
+            cell.cellFunction = nerve;
+        } break;
+        case CellFunction_Attacker: {
+            AttackerGenomeDescription attacker;
+            attacker.mode = readByte(data, bytePosition) % EnergyDistributionMode_Count;
+            cell.cellFunction = attacker;
+        } break;
+        case CellFunction_Injector: {
+            InjectorGenomeDescription injector;
+            injector.mode = readByte(data, bytePosition) % InjectorMode_Count;
+            injector.genome = readGenome(data, bytePosition);
+            cell.cellFunction = std::move(injector);
+        } break;
+        case CellFunction_Muscle: {
+            MuscleGenomeDescription muscle;
+            muscle.mode = readByte(data, bytePosition) % MuscleMode_Count;
+            cell.cellFunction = muscle;
+        } break;
+        case CellFunction_Defender: {
+            DefenderGenomeDescription defender;
+            defender.mode = readByte(data, bytePosition) % DefenderMode_Count;
+            cell.cellFunction = defender;
+        } break;
+        case CellFunction_Reconnector: {
+            ReconnectorGenomeDescription reconnector;
+            reconnector.restrictToColor = readOptionalByte(data, bytePosition, MAX_COLORS);
+            reconnector.restrictToMutants = readByte(data, bytePosition) % ReconnectorRestrictToMutants_Count;
+            cell.cellFunction = reconnector;
+        } break;
+        case CellFunction_Detonator: {
+            DetonatorGenomeDescription detonator;
+            detonator.countdown = readWord(data, bytePosition);
+            cell.cellFunction = detonator;
+        } break;
         }
-        return result;
     }
+    return result;
+}
 
+std::vector<std::vector<uint8_t>> GenomeDescriptionService::convertDescriptionsToBytes(
+    std::vector<GenomeDescription> const& genomes,
+    GenomeEncodingSpecification const& spec)
+{
+    std::vector<std::vector<uint8_t>> result(genomes.size());
+    ThreadPool::getInstance().parallelFor(0, genomes.size(), [&](size_t index) { result.at(index) = convertDescriptionToBytes(genomes.at(index), spec); });
+    return result;
 }
 
-GenomeDescription GenomeDescriptionService::convertBytesToDescription(std::vector<uint8_t> const& data, GenomeEncodingSpecification const& spec)
+std::vector<GenomeDescription> GenomeDescriptionService::convertBytesToDescriptions(
+    std::vector<std::vector<uint8_t>> const& data,
+    GenomeEncodingSpecification const& spec)
 {
-    return convertBytesToDescriptionIntern(data, data.size(), data.size(), spec).genome;
+    std::vector<GenomeDescription> result(data.size());
+    ThreadPool::getInstance().parallelFor(0, data.size(), [&](size_t index) { result.at(index) = convertBytesToDescription(data.at(index), spec); });
+    return result;
 }
 
-int GenomeDescriptionService::convertNodeAddressToNodeIndex(std::vector<uint8_t> const& data, int nodeAddress, GenomeEncodingSpecification const& spec)
+int GenomeDescriptionService::getEncodedSize(GenomeDescription const& genome, GenomeEncodingSpecification const& spec)
 {
-    //wasteful approach but sufficient for GUI
-    return convertBytesToDescriptionIntern(data, nodeAddress, data.size(), spec).genome.cells.size();
+    auto result = getHeaderSize(spec);
+    for (auto const& cell : genome.cells) {
+        auto cellFunction = cell.getCellFunctionType();
+        result += Const::CellBasicBytes + getCellFunctionBytes(cellFunction);
+        if (cellFunction == CellFunction_Constructor) {
+            result += getEncodedGenomeSize(std::get<ConstructorGenomeDescription>(*cell.cellFunction).genome);
+        }
+        if (cellFunction == CellFunction_Injector) {
+            result += getEncodedGenomeSize(std::get<InjectorGenomeDescription>(*cell.cellFunction).genome);
+        }
+    }
+    return result;
+}
+
+int GenomeDescriptionService::convertNodeAddressToNodeIndex(std::span<uint8_t const> data, int nodeAddress, GenomeEncodingSpecification const& spec)
+{
+    int result = 0;
+    for (auto const& node : GenomeView(data, spec)) {
+        if (node.address >= nodeAddress) {
+            break;
+        }
+        ++result;
+    }
+    return result;
 }
 
-int GenomeDescriptionService::convertNodeIndexToNodeAddress(std::vector<uint8_t> const& data, int nodeIndex, GenomeEncodingSpecification const& spec)
+int GenomeDescriptionService::convertNodeIndexToNodeAddress(std::span<uint8_t const> data, int nodeIndex, GenomeEncodingSpecification const& spec)
 {
-    //wasteful approach but sufficient for GUI
-    return convertBytesToDescriptionIntern(data, data.size(), nodeIndex, spec).lastBytePosition;
+    GenomeView genome(data, spec);
+    auto node = genome.begin();
+    for (int i = 0; i != nodeIndex && node != genome.end(); ++i) {
+        ++node;
+    }
+    return node->address;
 }
 
-int GenomeDescriptionService::getNumNodesRecursively(std::vector<uint8_t> const& data, bool includeRepetitions, GenomeEncodingSpecification const& spec)
+namespace
 {
-    auto genome = convertBytesToDescriptionIntern(data, data.size(), data.size(), spec).genome;
-    auto result = toInt(genome.cells.size());
-    for (auto const& node : genome.cells) {
-        if (auto subgenome = node.getGenome()) {
-            result += getNumNodesRecursively(*subgenome, includeRepetitions, spec);
+    int getNumNodesRecursivelyIntern(GenomeView const& genome, bool includeRepetitions)
+    {
+        auto result = 0;
+        for (auto const& node : genome) {
+            ++result;
+            if (auto subGenome = genome.getSubGenome(node)) {
+                result += getNumNodesRecursivelyIntern(*subGenome, includeRepetitions);
+            }
+        }
+        if (!includeRepetitions) {
+            return result;
         }
+        auto header = genome.getHeader();
+        auto numRepetitions = header.numRepetitions == std::numeric_limits<int>::max() ? 1 : header.numRepetitions;
+        return result * numRepetitions * header.getNumBranches();
     }
+}
 
-    auto numRepetitions = genome.header.numRepetitions == std::numeric_limits<int>::max() ? 1 : genome.header.numRepetitions;
-    return includeRepetitions ? result * numRepetitions * genome.header.getNumBranches() : result;
+int GenomeDescriptionService::getNumNodesRecursively(std::span<uint8_t const> data, bool includeRepetitions, GenomeEncodingSpecification const& spec)
+{
+    return getNumNodesRecursivelyIntern(GenomeView(data, spec), includeRepetitions);
 }
 
 int GenomeDescriptionService::getNumRepetitions(std::vector<uint8_t> const& data)
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <iterator>
+#include <optional>
+#include <span>
 #include <vector>
 
 #include "GenomeDescriptions.h"
@@ -12,14 +15,81 @@ struct GenomeEncodingSpecification
     MEMBER_DECLARATION(GenomeEncodingSpecification, bool, concatenationAngle2, true);
 };
 
+struct GenomeNodeView
+{
+    CellFunction cellFunction = CellFunction_None;
+    int address = 0;  //byte position of the node in the genome
+    int size = 0;
+    std::optional<std::span<uint8_t const>> subGenome;  //only for constructors and injectors which do not make a genome copy
+};
+
+/**
+ * Non-owning view of an encoded genome for read access without decoding it. The nodes are parsed lazily during the iteration
+ * and the sub-genomes are views into the same buffer, hence the buffer must outlive the view.
+ */
+class GenomeView
+{
+public:
+    class Iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = GenomeNodeView;
+        using difference_type = std::ptrdiff_t;
+        using pointer = GenomeNodeView const*;
+        using reference = GenomeNodeView const&;
+
+        Iterator() = default;
+
+        GenomeNodeView const& operator*() const { return _node; }
+        GenomeNodeView const* operator->() const { return &_node; }
+        Iterator& operator++();
+        Iterator operator++(int);
+        bool operator==(Iterator const& other) const { return _node.address == other._node.address; }
+
+    private:
+        friend class GenomeView;
+        Iterator(std::span<uint8_t const> data, int address);
+
+        std::span<uint8_t const> _data;
+        GenomeNodeView _node;
+    };
+
+    GenomeView(std::span<uint8_t const> data, GenomeEncodingSpecification const& spec = GenomeEncodingSpecification());
+
+    std::span<uint8_t const> getBytes() const { return _data; }
+    GenomeEncodingSpecification const& getSpec() const { return _spec; }
+    GenomeHeaderDescription getHeader() const;
+
+    Iterator begin() const;
+    Iterator end() const;
+    int getNumNodes() const;
+
+    std::optional<GenomeView> getSubGenome(GenomeNodeView const& node) const;
+
+private:
+    std::span<uint8_t const> _data;
+    GenomeEncodingSpecification _spec;
+};
+
 class GenomeDescriptionService
 {
 public:
     static std::vector<uint8_t> convertDescriptionToBytes(GenomeDescription const& genome, GenomeEncodingSpecification const& spec = GenomeEncodingSpecification());
-    static GenomeDescription convertBytesToDescription(std::vector<uint8_t> const& data, GenomeEncodingSpecification const& spec = GenomeEncodingSpecification());
+    static GenomeDescription convertBytesToDescription(std::span<uint8_t const> data, GenomeEncodingSpecification const& spec = GenomeEncodingSpecification());
+
+    //converts many genomes in parallel, should not be called from a job of the ThreadPool
+    static std::vector<std::vector<uint8_t>> convertDescriptionsToBytes(
+        std::vector<GenomeDescription> const& genomes,
+        GenomeEncodingSpecification const& spec = GenomeEncodingSpecification());
+    static std::vector<GenomeDescription> convertBytesToDescriptions(
+        std::vector<std::vector<uint8_t>> const& data,
+        GenomeEncodingSpecification const& spec = GenomeEncodingSpecification());
+
+    static int getEncodedSize(GenomeDescription const& genome, GenomeEncodingSpecification const& spec = GenomeEncodingSpecification());
 
-    static int convertNodeAddressToNodeIndex(std::vector<uint8_t> const& data, int nodeAddress, GenomeEncodingSpecification const& spec = GenomeEncodingSpecification());
-    static int convertNodeIndexToNodeAddress(std::vector<uint8_t> const& data, int nodeIndex, GenomeEncodingSpecification const& spec = GenomeEncodingSpecification());
-    static int getNumNodesRecursively(std::vector<uint8_t> const& data, bool includeRepetitions, GenomeEncodingSpecification const& spec = GenomeEncodingSpecification());
+    static int convertNodeAddressToNodeIndex(std::span<uint8_t const> data, int nodeAddress, GenomeEncodingSpecification const& spec = GenomeEncodingSpecification());
+    static int convertNodeIndexToNodeAddress(std::span<uint8_t const> data, int nodeIndex, GenomeEncodingSpecification const& spec = GenomeEncodingSpecification());
+    static int getNumNodesRecursively(std::span<uint8_t const> data, bool includeRepetitions, GenomeEncodingSpecification const& spec = GenomeEncodingSpecification());
     static int getNumRepetitions(std::vector<uint8_t> const& data);
 };
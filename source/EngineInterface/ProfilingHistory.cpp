@@ -0,0 +1,30 @@
+#include "ProfilingHistory.h"
+
+ProfilingHistory::ProfilingHistory(std::vector<std::string> const& phaseNames, int capacity)
+    : _phaseNames(phaseNames)
+    , _entries(capacity)
+{}
+
+void ProfilingHistory::add(std::vector<ProfilingEntry> const& entries)
+{
+    std::lock_guard lock(_mutex);
+    for (auto const& entry : entries) {
+        _entries[_nextIndex] = entry;
+        if (++_nextIndex == _entries.size()) {
+            _nextIndex = 0;
+            _isFull = true;
+        }
+    }
+}
+
+ProfilingData ProfilingHistory::getData() const
+{
+    std::lock_guard lock(_mutex);
+    ProfilingData result;
+    result.phaseNames = _phaseNames;
+    if (_isFull) {
+        result.entries.insert(result.entries.end(), _entries.begin() + _nextIndex, _entries.end());
+    }
+    result.entries.insert(result.entries.end(), _entries.begin(), _entries.begin() + _nextIndex);
+    return result;
+}
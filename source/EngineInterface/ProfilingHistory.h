@@ -0,0 +1,45 @@
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Definitions.h"
+
+struct ProfilingEntry
+{
+    int phase = 0;  //index in ProfilingData::phaseNames
+    uint64_t timestep = 0;
+    double startTime = 0;  //in microseconds since profiling has been enabled
+    double duration = 0;  //in microseconds
+    uint64_t numCells = 0;  //at the beginning of the time step
+    uint64_t numParticles = 0;
+};
+
+struct ProfilingData
+{
+    std::vector<std::string> phaseNames;
+    std::vector<ProfilingEntry> entries;  //in chronological order
+};
+
+/**
+ * Ring buffer for the phase durations of the last time steps. Written by the simulation thread and read by other threads.
+ * The memory is allocated on construction, hence a profiling history should only exist while profiling is enabled.
+ */
+class ProfilingHistory
+{
+public:
+    static auto constexpr DefaultCapacity = 100000;
+
+    ProfilingHistory(std::vector<std::string> const& phaseNames, int capacity = DefaultCapacity);
+
+    void add(std::vector<ProfilingEntry> const& entries);  //e.g. all phases of one time step
+    ProfilingData getData() const;
+
+private:
+    mutable std::mutex _mutex;
+    std::vector<std::string> _phaseNames;
+    std::vector<ProfilingEntry> _entries;
+    size_t _nextIndex = 0;
+    bool _isFull = false;
+};
@@ -0,0 +1,59 @@
+#include "ProfilingService.h"
+
+#include <fstream>
+#include <iomanip>
+#include <optional>
+
+#include "Base/Definitions.h"
+
+namespace
+{
+    std::string quoted(std::string const& value)
+    {
+        std::string result = "\"";
+        for (auto const& c : value) {
+            if (c == '"' || c == '\\') {
+                result += '\\';
+            }
+            result += c;
+        }
+        return result + "\"";
+    }
+}
+
+void ProfilingService::writeChromeTrace(ProfilingData const& data, std::ostream& stream)
+{
+    stream << std::fixed << std::setprecision(3);
+    stream << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [" << std::endl;
+    auto separator = "";
+    std::optional<uint64_t> lastTimestep;
+    for (auto const& entry : data.entries) {
+
+        //the object counts are shown as counter tracks, one sample per time step
+        if (entry.timestep != lastTimestep) {
+            stream << separator << "{\"name\": \"objects\", \"ph\": \"C\", \"pid\": 0, \"ts\": " << entry.startTime << ", \"args\": {\"cells\": "
+                   << entry.numCells << ", \"particles\": " << entry.numParticles << "}}";
+            separator = ",\n";
+            lastTimestep = entry.timestep;
+        }
+        auto const& phaseName = entry.phase >= 0 && entry.phase < toInt(data.phaseNames.size()) ? data.phaseNames.at(entry.phase) : std::string("unknown");
+        stream << separator << "{\"name\": " << quoted(phaseName) << ", \"cat\": \"time step\", \"ph\": \"X\", \"pid\": 0, \"tid\": 0, \"ts\": "
+               << entry.startTime << ", \"dur\": " << entry.duration << ", \"args\": {\"time step\": " << entry.timestep << "}}";
+    }
+    stream << std::endl << "]}" << std::endl;
+}
+
+bool ProfilingService::writeChromeTraceToFile(std::string const& filename, ProfilingData const& data)
+{
+    try {
+        std::ofstream stream(filename, std::ios::binary);
+        if (!stream) {
+            return false;
+        }
+        writeChromeTrace(data, stream);
+        stream.close();
+        return !stream.fail();
+    } catch (...) {
+        return false;
+    }
+}
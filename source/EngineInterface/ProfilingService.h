@@ -0,0 +1,14 @@
+#pragma once
+
+#include <ostream>
+#include <string>
+
+#include "ProfilingHistory.h"
+
+class ProfilingService
+{
+public:
+    //format of chrome://tracing and https://ui.perfetto.dev
+    static void writeChromeTrace(ProfilingData const& data, std::ostream& stream);
+    static bool writeChromeTraceToFile(std::string const& filename, ProfilingData const& data);
+};
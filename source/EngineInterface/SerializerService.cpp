@@ -2,6 +2,7 @@
 
 #include <sstream>
 #include <stdexcept>
+#include <string_view>
 #include <filesystem>
 
 #include <optional>
@@ -25,6 +26,8 @@
 #include "Descriptions.h"
 #include "SimulationParameters.h"
 #include "AuxiliaryDataParserService.h"
+#include "ColumnarDataReader.h"
+#include "ColumnarSerializerService.h"
 #include "GenomeConstants.h"
 #include "GenomeDescriptions.h"
 #include "GenomeDescriptionService.h"
@@ -148,6 +151,7 @@ namespace
     auto constexpr Id_Constructor_StateFlags = 18;
     auto constexpr Id_Constructor_NumInheritedGenomeNodes = 19;
     auto constexpr Id_Constructor_CurrentBranch = 20;
+    auto constexpr Id_Constructor_GenomeRef = 21;
 
     auto constexpr Id_Defender_Mode = 0;
 
@@ -161,6 +165,7 @@ namespace
     auto constexpr Id_Injector_Mode = 0;
     auto constexpr Id_Injector_Counter = 1;
     auto constexpr Id_Injector_GenomeHeader = 2;
+    auto constexpr Id_Injector_GenomeRef = 3;
 
     auto constexpr Id_Attacker_Mode = 0;
 
@@ -196,6 +201,59 @@ namespace
         Load,
         Save
     };
+
+    //identical genomes of a data description are written once and afterwards referenced by their index in order of appearance
+    struct GenomeTable
+    {
+        std::unordered_map<std::string_view, int> genomeRefByContent;  //for saving, the views point into the saved genomes
+        std::vector<std::vector<uint8_t>> genomes;  //for loading
+    };
+    thread_local GenomeTable* activeGenomeTable = nullptr;
+
+    class GenomeTableScope
+    {
+    public:
+        GenomeTableScope()
+            : _previousGenomeTable(activeGenomeTable)
+        {
+            activeGenomeTable = &_genomeTable;
+        }
+        ~GenomeTableScope() { activeGenomeTable = _previousGenomeTable; }
+
+        GenomeTableScope(GenomeTableScope const&) = delete;
+        GenomeTableScope& operator=(GenomeTableScope const&) = delete;
+
+    private:
+        GenomeTable _genomeTable;
+        GenomeTable* _previousGenomeTable;
+    };
+
+    //returns the index of an already saved identical genome or registers the genome to be saved
+    std::optional<int> findSavedGenome(std::vector<uint8_t> const& genome)
+    {
+        if (!activeGenomeTable) {
+            return std::nullopt;
+        }
+        auto& genomeRefByContent = activeGenomeTable->genomeRefByContent;
+        auto [genomeRef, inserted] =
+            genomeRefByContent.try_emplace(std::string_view(reinterpret_cast<char const*>(genome.data()), genome.size()), toInt(genomeRefByContent.size()));
+        return inserted ? std::nullopt : std::make_optional(genomeRef->second);
+    }
+
+    void addLoadedGenome(std::vector<uint8_t> const& genome)
+    {
+        if (activeGenomeTable) {
+            activeGenomeTable->genomes.emplace_back(genome);
+        }
+    }
+
+    std::vector<uint8_t> const& getLoadedGenome(int genomeRef)
+    {
+        if (!activeGenomeTable || genomeRef < 0 || genomeRef >= toInt(activeGenomeTable->genomes.size())) {
+            throw std::runtime_error("Invalid genome reference.");
+        }
+        return activeGenomeTable->genomes.at(genomeRef);
+    }
 }
 
 namespace cereal
@@ -582,12 +640,20 @@ namespace cereal
         loadSave<float>(task, auxiliaries, Id_Constructor_ConstructionAngle1, data.constructionAngle1, defaultObject.constructionAngle1);
         loadSave<float>(task, auxiliaries, Id_Constructor_ConstructionAngle2, data.constructionAngle2, defaultObject.constructionAngle2);
         loadSave<int>(task, auxiliaries, Id_Constructor_NumInheritedGenomeNodes, data.numInheritedGenomeNodes, defaultObject.numInheritedGenomeNodes);
+        std::optional<int> genomeRef;
         if (task == SerializationTask::Save) {
-            auxiliaries[Id_Constructor_GenomeHeader] = true;
+            genomeRef = findSavedGenome(data.genome);
+            if (genomeRef) {
+                auxiliaries[Id_Constructor_GenomeRef] = *genomeRef;
+            } else {
+                auxiliaries[Id_Constructor_GenomeHeader] = true;
+            }
         }
         processLoadSaveMap(task, ar, auxiliaries);
 
-        if (task == SerializationTask::Load) {
+        if (task == SerializationTask::Load && auxiliaries.contains(Id_Constructor_GenomeRef)) {
+            data.genome = getLoadedGenome(std::get<int>(auxiliaries.at(Id_Constructor_GenomeRef)));
+        } else if (task == SerializationTask::Load) {
             auto hasGenomeHeader = auxiliaries.contains(Id_Constructor_GenomeHeader);
             auto useNewGenomeIndex = auxiliaries.contains(Id_Constructor_IsConstructionBuilt) || auxiliaries.contains(Id_Constructor_StateFlags)
                 || auxiliaries.contains(Id_Constructor_CurrentBranch);
@@ -633,7 +699,8 @@ namespace cereal
             }
             //<<<
 
-        } else {
+            addLoadedGenome(data.genome);
+        } else if (!genomeRef) {
             GenomeDescription genomeDesc = GenomeDescriptionService::convertBytesToDescription(data.genome);
             ar(genomeDesc);
         }
@@ -701,12 +768,20 @@ namespace cereal
         auto auxiliaries = getLoadSaveMap(task, ar);
         loadSave<int>(task, auxiliaries, Id_Injector_Mode, data.mode, defaultObject.mode);
         loadSave<int>(task, auxiliaries, Id_Injector_Counter, data.counter, defaultObject.counter);
+        std::optional<int> genomeRef;
         if (task == SerializationTask::Save) {
-            auxiliaries[Id_Injector_GenomeHeader] = true;
+            genomeRef = findSavedGenome(data.genome);
+            if (genomeRef) {
+                auxiliaries[Id_Injector_GenomeRef] = *genomeRef;
+            } else {
+                auxiliaries[Id_Injector_GenomeHeader] = true;
+            }
         }
         processLoadSaveMap(task, ar, auxiliaries);
 
-        if (task == SerializationTask::Load) {
+        if (task == SerializationTask::Load && auxiliaries.contains(Id_Injector_GenomeRef)) {
+            data.genome = getLoadedGenome(std::get<int>(auxiliaries.at(Id_Injector_GenomeRef)));
+        } else if (task == SerializationTask::Load) {
             auto hasGenomeHeader = auxiliaries.contains(Id_Injector_GenomeHeader);
             if (hasGenomeHeader) {
                 GenomeDescription genomeDesc;
@@ -717,7 +792,8 @@ namespace cereal
                 ar(genomeDesc.cells);
                 data.genome = GenomeDescriptionService::convertDescriptionToBytes(genomeDesc);
             }
-        } else {
+            addLoadedGenome(data.genome);
+        } else if (!genomeRef) {
             GenomeDescription genomeDesc = GenomeDescriptionService::convertBytesToDescription(data.genome);
             ar(genomeDesc);
         }
@@ -847,26 +923,78 @@ namespace cereal
     template <class Archive>
     void serialize(Archive& ar, ClusteredDataDescription& data)
     {
+        GenomeTableScope genomeTableScope;
         ar(data.clusters, data.particles);
     }
+
+    template <class Archive>
+    void serialize(Archive& ar, CellDelta& data)
+    {
+        auto& cell = data.cell;
+        ar(data.changedFields, cell.id);
+        if (data.changedFields & CellFieldGroups_General) {
+            ar(cell.pos, cell.vel, cell.energy, cell.stiffness, cell.color, cell.maxConnections, cell.barrier, cell.age, cell.livingState);
+            ar(cell.creatureId, cell.mutationId, cell.ancestorMutationId, cell.genomeComplexity, cell.executionOrderNumber);
+            ar(cell.inputExecutionOrderNumber, cell.outputBlocked, cell.activationTime, cell.detectedByCreatureId, cell.cellFunctionUsed);
+        }
+        if (data.changedFields & CellFieldGroups_Connections) {
+            ar(cell.connections);
+        }
+        if (data.changedFields & CellFieldGroups_CellFunction) {
+            ar(cell.cellFunction);
+        }
+        if (data.changedFields & CellFieldGroups_Activity) {
+            ar(cell.activity);
+        }
+        if (data.changedFields & CellFieldGroups_Metadata) {
+            ar(cell.metadata);
+        }
+    }
+
+    template <class Archive>
+    void serialize(Archive& ar, DescriptionDelta& data)
+    {
+        GenomeTableScope genomeTableScope;
+        ar(data.removedCellIds, data.addedCells, data.changedCells, data.removedParticleIds, data.addedOrChangedParticles);
+    }
 }
 
-bool SerializerService::serializeSimulationToFiles(std::string const& filename, DeserializedSimulation const& data)
+bool SerializerService::serializeSimulationToFiles(std::string const& filename, DeserializedSimulation const& data, SerializationSettings const& settings)
 {
     try {
         log(Priority::Important, "save simulation to " + filename);
-        std::filesystem::path settingsFilename(filename);
-        settingsFilename.replace_extension(std::filesystem::path(".settings.json"));
-        std::filesystem::path statisticsFilename(filename);
-        statisticsFilename.replace_extension(std::filesystem::path(".statistics.csv"));
-
         {
-            zstr::ofstream stream(filename, std::ios::binary);
+            std::ofstream stream(filename, std::ios::binary);
             if (!stream) {
                 return false;
             }
-            serializeDataDescription(data.mainData, stream);
+            serializeCompressedDataDescription(data.mainData, stream, settings);
         }
+        removeDeltaCheckpoints(filename);
+        if (!settings._statistics) {
+            std::filesystem::path settingsFilename(filename);
+            settingsFilename.replace_extension(std::filesystem::path(".settings.json"));
+            std::ofstream stream(settingsFilename.string(), std::ios::binary);
+            if (!stream) {
+                return false;
+            }
+            serializeAuxiliaryData(data.auxiliaryData, stream);
+            return true;
+        }
+        return serializeAuxiliaryDataAndStatisticsToFiles(filename, data);
+    } catch (...) {
+        return false;
+    }
+}
+
+bool SerializerService::serializeAuxiliaryDataAndStatisticsToFiles(std::string const& filename, DeserializedSimulation const& data)
+{
+    try {
+        std::filesystem::path settingsFilename(filename);
+        settingsFilename.replace_extension(std::filesystem::path(".settings.json"));
+        std::filesystem::path statisticsFilename(filename);
+        statisticsFilename.replace_extension(std::filesystem::path(".statistics.csv"));
+
         {
             std::ofstream stream(settingsFilename.string(), std::ios::binary);
             if (!stream) {
@@ -891,46 +1019,107 @@ bool SerializerService::deserializeSimulationFromFiles(DeserializedSimulation& d
 {
     try {
         log(Priority::Important, "load simulation from " + filename);
-        std::filesystem::path settingsFilename(filename);
-        settingsFilename.replace_extension(std::filesystem::path(".settings.json"));
-        std::filesystem::path statisticsFilename(filename);
-        statisticsFilename.replace_extension(std::filesystem::path(".statistics.csv"));
-
         if (!deserializeDataDescription(data.mainData, filename)) {
             return false;
         }
+        applyDeltaCheckpoints(data.mainData, filename);
+        return deserializeAuxiliaryDataAndStatisticsFromFiles(data, filename);
+    } catch (...) {
+        return false;
+    }
+}
+
+bool SerializerService::deserializeSimulationFromFiles(DeserializedSimulation& data, ColumnarDataReader& mainDataReader, std::string const& filename)
+{
+    try {
+        mainDataReader.reset();
+        if (!_ColumnarDataReader::isColumnarFile(filename) || getNumDeltaCheckpoints(filename) > 0) {
+            return deserializeSimulationFromFiles(data, filename);
+        }
+        log(Priority::Important, "load simulation from " + filename);
+        mainDataReader = std::make_shared<_ColumnarDataReader>(filename);
+        data.mainData.clear();
+        return deserializeAuxiliaryDataAndStatisticsFromFiles(data, filename);
+    } catch (...) {
+        return false;
+    }
+}
+
+bool SerializerService::serializeDeltaCheckpointToFiles(
+    std::string const& filename,
+    DeserializedSimulation const& data,
+    ClusteredDataDescription const& previousMainData,
+    SerializationSettings const& settings)
+{
+    try {
+        return serializeDeltaCheckpointToFiles(
+            filename, data, previousMainData, DescriptionDeltaService::calcDelta(previousMainData, data.mainData), settings);
+    } catch (...) {
+        return false;
+    }
+}
+
+bool SerializerService::serializeDeltaCheckpointToFiles(
+    std::string const& filename,
+    DeserializedSimulation const& data,
+    ClusteredDataDescription const& previousMainData,
+    DescriptionDelta const& delta,
+    SerializationSettings const& settings)
+{
+    try {
+        auto deltaFilename = getDeltaCheckpointFilename(filename, getNumDeltaCheckpoints(filename) + 1);
+        log(Priority::Important, "save delta checkpoint to " + deltaFilename);
+
+        auto baseFingerprint = DescriptionDeltaService::calcFingerprint(previousMainData);
+        auto targetFingerprint = DescriptionDeltaService::calcFingerprint(data.mainData);
         {
-            std::ifstream stream(settingsFilename.string(), std::ios::binary);
+            std::ofstream stream(deltaFilename, std::ios::binary);
             if (!stream) {
                 return false;
             }
-            deserializeAuxiliaryData(data.auxiliaryData, stream);
+            serializeCompressed(stream, settings, [&](std::ostream& uncompressedStream) {
+                cereal::PortableBinaryOutputArchive archive(uncompressedStream);
+                archive(Const::ProgramVersion, baseFingerprint, targetFingerprint, delta);
+            });
         }
-        {
-            std::ifstream stream(statisticsFilename.string(), std::ios::binary);
-            if (!stream) {
-                return true;
-            }
-            deserializeStatistics(data.statistics, stream);
+        return serializeAuxiliaryDataAndStatisticsToFiles(filename, data);
+    } catch (...) {
+        return false;
+    }
+}
+
+int SerializerService::getNumDeltaCheckpoints(std::string const& filename)
+{
+    auto result = 0;
+    while (std::filesystem::exists(getDeltaCheckpointFilename(filename, result + 1))) {
+        ++result;
+    }
+    return result;
+}
+
+bool SerializerService::compactDeltaCheckpoints(std::string const& filename, SerializationSettings const& settings)
+{
+    try {
+        if (getNumDeltaCheckpoints(filename) == 0) {
+            return true;
         }
-        return true;
+        DeserializedSimulation data;
+        if (!deserializeSimulationFromFiles(data, filename)) {
+            return false;
+        }
+        return serializeSimulationToFiles(filename, data, settings);
     } catch (...) {
         return false;
     }
 }
 
-bool SerializerService::serializeSimulationToStrings(SerializedSimulation& output, DeserializedSimulation const& input)
+bool SerializerService::serializeSimulationToStrings(SerializedSimulation& output, DeserializedSimulation const& input, SerializationSettings const& settings)
 {
     try {
         {
-            std::stringstream stdStream;
-            zstr::ostream stream(stdStream, std::ios::binary);
-            if (!stream) {
-                return false;
-            }
-            serializeDataDescription(input.mainData, stream);
-            stream.flush();
-            output.mainData = stdStream.str();
+            std::stringstream stream;
+            serializeCompressedDataDescription(input.mainData, stream, settings);
+            output.mainData = stream.str();
         }
         {
             std::stringstream stream;
@@ -952,12 +1141,8 @@ bool SerializerService::deserializeSimulationFromStrings(DeserializedSimulation&
 {
     try {
         {
-            std::stringstream stdStream(input.mainData);
-            zstr::istream stream(stdStream, std::ios::binary);
-            if (!stream) {
-                return false;
-            }
-            deserializeDataDescription(output.mainData, stream);
+            std::stringstream stream(input.mainData);
+            deserializeCompressedDataDescription(output.mainData, stream);
         }
         {
             std::stringstream stream(input.auxiliaryData);
@@ -1104,6 +1289,39 @@ bool SerializerService::serializeStatisticsToFile(std::string const& filename, S
     }
 }
 
+bool SerializerService::appendStatisticsToFile(std::string const& filename, StatisticsHistoryData const& statistics)
+{
+    try {
+        auto isNewFile = !std::filesystem::exists(filename) || std::filesystem::file_size(filename) == 0;
+        std::ofstream stream(filename, std::ios::binary | std::ios::app);
+        if (!stream) {
+            return false;
+        }
+        if (isNewFile) {
+            serializeStatisticsHeader(stream);
+        }
+        serializeStatisticsEntries(statistics, stream);
+        stream.close();
+        return !stream.fail();
+    } catch (...) {
+        return false;
+    }
+}
+
+bool SerializerService::deserializeStatisticsFromFile(StatisticsHistoryData& statistics, std::string const& filename)
+{
+    try {
+        std::ifstream stream(filename, std::ios::binary);
+        if (!stream) {
+            return false;
+        }
+        deserializeStatistics(statistics, stream);
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
 bool SerializerService::serializeContentToFile(std::string const& filename, ClusteredDataDescription const& content)
 {
     try {
@@ -1131,25 +1349,70 @@ bool SerializerService::deserializeContentFromFile(ClusteredDataDescription& con
     }
 }
 
-void SerializerService::serializeDataDescription(ClusteredDataDescription const& data, std::ostream& stream)
+void SerializerService::serializeDataDescription(ClusteredDataDescription const& data, std::ostream& stream, SerializationFormat format)
 {
+    if (format == SerializationFormat::Columnar) {
+        ColumnarSerializerService::serialize(data, stream);
+        return;
+    }
     cereal::PortableBinaryOutputArchive archive(stream);
     archive(Const::ProgramVersion);
     archive(data);
 }
 
+void SerializerService::serializeCompressedDataDescription(ClusteredDataDescription const& data, std::ostream& stream, SerializationSettings const& settings)
+{
+    serializeCompressed(stream, settings, [&](std::ostream& uncompressedStream) { serializeDataDescription(data, uncompressedStream, settings._format); });
+}
+
 bool SerializerService::deserializeDataDescription(ClusteredDataDescription& data, std::string const& filename)
 {
-    zstr::ifstream stream(filename, std::ios::binary);
+    std::ifstream stream(filename, std::ios::binary);
     if (!stream) {
         return false;
     }
-    deserializeDataDescription(data, stream);
+    deserializeCompressedDataDescription(data, stream);
     return true;
 }
 
+bool SerializerService::deserializeAuxiliaryDataAndStatisticsFromFiles(DeserializedSimulation& data, std::string const& filename)
+{
+    try {
+        std::filesystem::path settingsFilename(filename);
+        settingsFilename.replace_extension(std::filesystem::path(".settings.json"));
+        std::filesystem::path statisticsFilename(filename);
+        statisticsFilename.replace_extension(std::filesystem::path(".statistics.csv"));
+        {
+            std::ifstream stream(settingsFilename.string(), std::ios::binary);
+            if (!stream) {
+                return false;
+            }
+            deserializeAuxiliaryData(data.auxiliaryData, stream);
+        }
+        {
+            std::ifstream stream(statisticsFilename.string(), std::ios::binary);
+            if (!stream) {
+                return true;
+            }
+            deserializeStatistics(data.statistics, stream);
+        }
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
+void SerializerService::deserializeCompressedDataDescription(ClusteredDataDescription& data, std::istream& stream)
+{
+    deserializeCompressed(stream, [&](std::istream& decompressedStream) { deserializeDataDescription(data, decompressedStream); });
+}
+
 void SerializerService::deserializeDataDescription(ClusteredDataDescription& data, std::istream& stream)
 {
+    if (ColumnarSerializerService::isColumnarFormat(stream)) {
+        ColumnarSerializerService::deserialize(data, stream);
+        return;
+    }
     cereal::PortableBinaryInputArchive archive(stream);
     std::string version;
     archive(version);
@@ -1163,6 +1426,84 @@ void SerializerService::deserializeDataDescription(ClusteredDataDescription& dat
     archive(data);
 }
 
+void SerializerService::serializeCompressed(
+    std::ostream& stream,
+    SerializationSettings const& settings,
+    std::function<void(std::ostream&)> const& serializeFunc)
+{
+    if (settings._parallelCompression) {
+        ChunkedCompressionOutputStream compressedStream(stream, settings._codec);
+        serializeFunc(compressedStream);
+        compressedStream.close();
+    } else {
+        zstr::ostream compressedStream(stream);
+        serializeFunc(compressedStream);
+    }
+}
+
+void SerializerService::deserializeCompressed(std::istream& stream, std::function<void(std::istream&)> const& deserializeFunc)
+{
+    if (ChunkedCompressionService::isChunkedFormat(stream)) {
+        ChunkedCompressionInputStream decompressedStream(stream);
+        deserializeFunc(decompressedStream);
+    } else {
+        zstr::istream decompressedStream(stream);
+        deserializeFunc(decompressedStream);
+    }
+}
+
+std::string SerializerService::getDeltaCheckpointFilename(std::string const& filename, int index)
+{
+    std::filesystem::path result(filename);
+    result.replace_extension(std::filesystem::path(".delta" + std::to_string(index) + std::filesystem::path(filename).extension().string()));
+    return result.string();
+}
+
+void SerializerService::removeDeltaCheckpoints(std::string const& filename)
+{
+    for (int i = 1;; ++i) {
+        auto deltaFilename = getDeltaCheckpointFilename(filename, i);
+        if (!std::filesystem::exists(deltaFilename)) {
+            break;
+        }
+        std::filesystem::remove(deltaFilename);
+    }
+}
+
+void SerializerService::applyDeltaCheckpoints(ClusteredDataDescription& data, std::string const& filename)
+{
+    auto numDeltas = getNumDeltaCheckpoints(filename);
+    for (int i = 1; i <= numDeltas; ++i) {
+        auto deltaFilename = getDeltaCheckpointFilename(filename, i);
+        std::ifstream stream(deltaFilename, std::ios::binary);
+        if (!stream) {
+            throw std::runtime_error("Could not read delta checkpoint.");
+        }
+        std::string version;
+        uint64_t baseFingerprint = 0;
+        uint64_t targetFingerprint = 0;
+        DescriptionDelta delta;
+        deserializeCompressed(stream, [&](std::istream& decompressedStream) {
+            cereal::PortableBinaryInputArchive archive(decompressedStream);
+            archive(version);
+            if (version != Const::ProgramVersion) {
+                throw std::runtime_error("Delta checkpoint has been created by another version.");
+            }
+            archive(baseFingerprint, targetFingerprint, delta);
+        });
+
+        //deltas from an older chain (e.g. left over after a crash) do not match the base
+        if (baseFingerprint != DescriptionDeltaService::calcFingerprint(data)) {
+            log(Priority::Important, "delta checkpoint " + deltaFilename + " does not match and is ignored");
+            return;
+        }
+        data = DescriptionDeltaService::applyDelta(data, delta);
+        if (targetFingerprint != DescriptionDeltaService::calcFingerprint(data)) {
+            throw std::runtime_error("Delta checkpoint is corrupted.");
+        }
+    }
+}
+
 void SerializerService::serializeAuxiliaryData(AuxiliaryData const& auxiliaryData, std::ostream& stream)
 {
     boost::property_tree::json_parser::write_json(stream, AuxiliaryDataParserService::encodeAuxiliaryData(auxiliaryData));
@@ -1259,7 +1600,12 @@ namespace
 
 void SerializerService::serializeStatistics(StatisticsHistoryData const& statistics, std::ostream& stream)
 {
-    //header row
+    serializeStatisticsHeader(stream);
+    serializeStatisticsEntries(statistics, stream);
+}
+
+void SerializerService::serializeStatisticsHeader(std::ostream& stream)
+{
     stream << "Time step";
     auto writeLabelAllColors = [&stream](auto const& name) {
         for (int i = 0; i < MAX_COLORS; ++i) {
@@ -1292,8 +1638,10 @@ void SerializerService::serializeStatistics(StatisticsHistoryData const& statist
     writeLabelAllColors("Average genome complexity");
     writeLabelAllColors("Max colony genome complexity");
     stream << std::endl;
+}
 
-    //content
+void SerializerService::serializeStatisticsEntries(StatisticsHistoryData const& statistics, std::ostream& stream)
+{
     for (auto dataPoints : statistics) {
         std::vector<std::string> entries;
         loadSave(SerializationTask::Save, entries, dataPoints);
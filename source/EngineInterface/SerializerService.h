@@ -1,9 +1,13 @@
 #pragma once
 
+#include <functional>
+
 #include "Base/Definitions.h"
 
 #include "Definitions.h"
 #include "AuxiliaryData.h"
+#include "ChunkedCompressionStreams.h"
+#include "DescriptionDeltaService.h"
 #include "Descriptions.h"
 #include "StatisticsHistory.h"
 
@@ -14,6 +18,20 @@ struct DeserializedSimulation
     StatisticsHistoryData statistics;
 };
 
+enum class SerializationFormat
+{
+    PortableBinary,
+    Columnar
+};
+
+struct SerializationSettings
+{
+    MEMBER_DECLARATION(SerializationSettings, SerializationFormat, format, SerializationFormat::PortableBinary);
+    MEMBER_DECLARATION(SerializationSettings, bool, parallelCompression, false);  //false = single gzip stream
+    MEMBER_DECLARATION(SerializationSettings, CompressionCodec, codec, CompressionCodec::Deflate);  //only used for parallel compression
+    MEMBER_DECLARATION(SerializationSettings, bool, statistics, true);  //false = the statistics file is not written (e.g. if it is appended)
+};
+
 struct SerializedSimulation
 {
     std::string mainData;  //binary
@@ -24,10 +42,42 @@ struct SerializedSimulation
 class SerializerService
 {
 public:
-    static bool serializeSimulationToFiles(std::string const& filename, DeserializedSimulation const& data);
+    //format and compression of the data are detected automatically during deserialization
+    //serialization removes existing delta checkpoints of filename, deserialization applies them
+    static bool serializeSimulationToFiles(
+        std::string const& filename,
+        DeserializedSimulation const& data,
+        SerializationSettings const& settings = SerializationSettings());
     static bool deserializeSimulationFromFiles(DeserializedSimulation& data, std::string const& filename);
 
-    static bool serializeSimulationToStrings(SerializedSimulation& output, DeserializedSimulation const& input);
+    //main data of columnar files is not deserialized into data.mainData but provided by mainDataReader for batch-wise processing
+    //(mainDataReader is set to nullptr for other formats)
+    static bool deserializeSimulationFromFiles(DeserializedSimulation& data, ColumnarDataReader& mainDataReader, std::string const& filename);
+
+    //only the settings and statistics files belonging to filename (e.g. for main data stored in a raw snapshot)
+    static bool serializeAuxiliaryDataAndStatisticsToFiles(std::string const& filename, DeserializedSimulation const& data);
+    static bool deserializeAuxiliaryDataAndStatisticsFromFiles(DeserializedSimulation& data, std::string const& filename);
+
+    //delta checkpoints are stored next to the base file (e.g. sim.delta1.sim, sim.delta2.sim, ...) and only contain the
+    //difference of data.mainData to previousMainData, which must be the state of the last checkpoint
+    static bool serializeDeltaCheckpointToFiles(
+        std::string const& filename,
+        DeserializedSimulation const& data,
+        ClusteredDataDescription const& previousMainData,
+        SerializationSettings const& settings = SerializationSettings());
+    static bool serializeDeltaCheckpointToFiles(
+        std::string const& filename,
+        DeserializedSimulation const& data,
+        ClusteredDataDescription const& previousMainData,
+        DescriptionDelta const& delta,  //from DescriptionDeltaService::calcDelta(previousMainData, data.mainData)
+        SerializationSettings const& settings = SerializationSettings());
+    static int getNumDeltaCheckpoints(std::string const& filename);
+    static bool compactDeltaCheckpoints(std::string const& filename, SerializationSettings const& settings = SerializationSettings());  //folds the deltas into the base file
+
+    static bool serializeSimulationToStrings(
+        SerializedSimulation& output,
+        DeserializedSimulation const& input,
+        SerializationSettings const& settings = SerializationSettings());
     static bool deserializeSimulationFromStrings(DeserializedSimulation& output, SerializedSimulation const& input);
 
     static bool serializeGenomeToFile(std::string const& filename, std::vector<uint8_t> const& genome);
@@ -40,15 +90,29 @@ public:
     static bool deserializeSimulationParametersFromFile(SimulationParameters& parameters, std::string const& filename);
 
     static bool serializeStatisticsToFile(std::string const& filename, StatisticsHistoryData const& statistics);
+    static bool appendStatisticsToFile(std::string const& filename, StatisticsHistoryData const& statistics);  //writes the header row for new files
+    static bool deserializeStatisticsFromFile(StatisticsHistoryData& statistics, std::string const& filename);
 
     static bool serializeContentToFile(std::string const& filename, ClusteredDataDescription const& content);
     static bool deserializeContentFromFile(ClusteredDataDescription& content, std::string const& filename);
 
 private:
-    static void serializeDataDescription(ClusteredDataDescription const& data, std::ostream& stream);
+    static void serializeDataDescription(
+        ClusteredDataDescription const& data,
+        std::ostream& stream,
+        SerializationFormat format = SerializationFormat::PortableBinary);
+    static void serializeCompressedDataDescription(ClusteredDataDescription const& data, std::ostream& stream, SerializationSettings const& settings);
     static bool deserializeDataDescription(ClusteredDataDescription& data, std::string const& filename);
+    static void deserializeCompressedDataDescription(ClusteredDataDescription& data, std::istream& stream);
     static void deserializeDataDescription(ClusteredDataDescription& data, std::istream& stream);
 
+    static void serializeCompressed(std::ostream& stream, SerializationSettings const& settings, std::function<void(std::ostream&)> const& serializeFunc);
+    static void deserializeCompressed(std::istream& stream, std::function<void(std::istream&)> const& deserializeFunc);
+
+    static std::string getDeltaCheckpointFilename(std::string const& filename, int index);
+    static void removeDeltaCheckpoints(std::string const& filename);
+    static void applyDeltaCheckpoints(ClusteredDataDescription& data, std::string const& filename);
+
     static void serializeAuxiliaryData(AuxiliaryData const& auxiliaryData, std::ostream& stream);
     static void deserializeAuxiliaryData(AuxiliaryData& auxiliaryData, std::istream& stream);
 
@@ -56,6 +120,8 @@ private:
     static void deserializeSimulationParameters(SimulationParameters& parameters, std::istream& stream);
 
     static void serializeStatistics(StatisticsHistoryData const& statistics, std::ostream& stream);
+    static void serializeStatisticsHeader(std::ostream& stream);
+    static void serializeStatisticsEntries(StatisticsHistoryData const& statistics, std::ostream& stream);
     static void deserializeStatistics(StatisticsHistoryData& statistics, std::istream& stream);
 
     static bool wrapGenome(ClusteredDataDescription& output, std::vector<uint8_t> const& input);
@@ -1,5 +1,9 @@
 #pragma once
+
+#include <future>
+
 #include "Definitions.h"
+#include "EngineBackend.h"
 #include "OverlayDescriptions.h"
 #include "SelectionShallowData.h"
 #include "Settings.h"
@@ -8,11 +12,17 @@
 #include "MutationType.h"
 #include "DataPointCollection.h"
 #include "StatisticsHistory.h"
+#include "ProfilingHistory.h"
 
 class _SimulationController
 {
 public:
-    virtual void newSimulation(uint64_t timestep, GeneralSettings const& generalSettings, SimulationParameters const& simulationParameters) = 0;
+    virtual void newSimulation(
+        uint64_t timestep,
+        GeneralSettings const& generalSettings,
+        SimulationParameters const& simulationParameters,
+        EngineBackend backend = EngineBackend_Gpu) = 0;
+    virtual EngineBackend getEngineBackend() const = 0;
     virtual int getSessionId() const = 0;
     virtual void clear() = 0;
 
@@ -41,6 +51,10 @@ public:
     virtual void addAndSelectSimulationData(DataDescription const& dataToAdd) = 0;
     virtual void setClusteredSimulationData(ClusteredDataDescription const& dataToUpdate) = 0;
     virtual void setSimulationData(DataDescription const& dataToUpdate) = 0;
+    virtual void setDuplicatedSimulationData(ClusteredDataDescription const& dataToUpdate, IntVector2D const& origWorldSize) = 0;  //tiles the data into the world
+    virtual void setColumnarSimulationData(ColumnarDataReader const& reader) = 0;  //reads the remaining segments batch-wise
+    virtual void saveRawSnapshot(std::string const& filename) = 0;  //memory layout dependent, see _DataTOSnapshot
+    virtual void loadRawSnapshot(std::string const& filename) = 0;  //world size must match, restores the timestep
     virtual void removeSelectedObjects(bool includeClusters) = 0;
     virtual void relaxSelectedObjects(bool includeClusters) = 0;
     virtual void uniformVelocitiesForSelectedObjects(bool includeClusters) = 0;
@@ -53,6 +67,22 @@ public:
     virtual void changeCell(CellDescription const& changedCell) = 0;
     virtual void changeParticle(ParticleDescription const& changedParticle) = 0;
 
+    /**
+     * Queued variants of the edit functions above. The commands are applied together at the next time step boundary
+     * (or before the next blocking access) and the returned futures become ready afterwards.
+     */
+    virtual std::future<void> removeSelectedObjects_async(bool includeClusters) = 0;
+    virtual std::future<void> relaxSelectedObjects_async(bool includeClusters) = 0;
+    virtual std::future<void> uniformVelocitiesForSelectedObjects_async(bool includeClusters) = 0;
+    virtual std::future<void> makeSticky_async(bool includeClusters) = 0;
+    virtual std::future<void> removeStickiness_async(bool includeClusters) = 0;
+    virtual std::future<void> setBarrier_async(bool value, bool includeClusters) = 0;
+    virtual std::future<void> colorSelectedObjects_async(unsigned char color, bool includeClusters) = 0;
+    virtual std::future<void> reconnectSelectedObjects_async() = 0;
+    virtual std::future<void> setDetached_async(bool value) = 0;
+    virtual std::future<void> changeCell_async(CellDescription const& changedCell) = 0;
+    virtual std::future<void> changeParticle_async(ParticleDescription const& changedParticle) = 0;
+
     virtual void calcTimesteps(uint64_t timesteps) = 0;
     virtual void runSimulation() = 0;
     virtual void pauseSimulation() = 0;
@@ -93,6 +123,14 @@ public:
     virtual StatisticsHistory const& getStatisticsHistory() const = 0;
     virtual void setStatisticsHistory(StatisticsHistoryData const& data) = 0;
 
+    /**
+     * Per-phase durations and object counts of the last time steps (see ProfilingHistory), e.g. for ProfilingService::writeChromeTrace.
+     * Enabling clears the data of earlier runs. The profiling synchronizes with the device after each time step.
+     */
+    virtual bool isProfilingEnabled() const = 0;
+    virtual void setProfilingEnabled(bool value) = 0;
+    virtual ProfilingData getProfilingData() const = 0;
+
     virtual std::optional<int> getTpsRestriction() const = 0;
     virtual void setTpsRestriction(std::optional<int> const& value) = 0;
 
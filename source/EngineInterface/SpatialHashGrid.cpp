@@ -0,0 +1,237 @@
+#include "SpatialHashGrid.h"
+
+#include <numeric>
+#include <stdexcept>
+
+SpatialHashGrid::SpatialHashGrid(IntVector2D const& worldSize, float minCellSize)
+    : _minCellSize(minCellSize)
+{
+    if (minCellSize <= 0) {
+        throw std::runtime_error("Cell size of spatial grid must be positive.");
+    }
+    setWorldSize(worldSize);
+}
+
+IntVector2D const& SpatialHashGrid::getWorldSize() const
+{
+    return _worldSize;
+}
+
+void SpatialHashGrid::setWorldSize(IntVector2D const& worldSize)
+{
+    if (worldSize.x <= 0 || worldSize.y <= 0) {
+        throw std::runtime_error("World size of spatial grid must be positive.");
+    }
+    _worldSize = worldSize;
+    _worldSizeFloat = {toFloat(worldSize.x), toFloat(worldSize.y)};
+    for (auto& pos : _positions) {
+        pos = getCorrectedPosition(pos);
+    }
+    rebuild();
+}
+
+void SpatialHashGrid::build(std::vector<RealVector2D> const& positions)
+{
+    _positions.resize(positions.size());
+    for (int i = 0; i < toInt(positions.size()); ++i) {
+        _positions[i] = getCorrectedPosition(positions[i]);
+    }
+    rebuild();
+}
+
+int SpatialHashGrid::insert(RealVector2D const& pos)
+{
+    auto result = toInt(_positions.size());
+    _positions.emplace_back(getCorrectedPosition(pos));
+    _pendingIndices.emplace_back(result);
+    if (toInt(_pendingIndices.size()) > std::max(MinPendingSize, toInt(_indices.size()) / 4)) {
+        rebuild();
+    }
+    return result;
+}
+
+void SpatialHashGrid::clear()
+{
+    _positions.clear();
+    rebuild();
+}
+
+int SpatialHashGrid::getNumEntries() const
+{
+    return toInt(_positions.size());
+}
+
+RealVector2D const& SpatialHashGrid::getPosition(int index) const
+{
+    return _positions.at(index);
+}
+
+bool SpatialHashGrid::isOccupied(RealVector2D const& pos, float radius) const
+{
+    return forEachInRadiusIntern(pos, radius, [](int, RealVector2D const&, float) { return true; });
+}
+
+void SpatialHashGrid::getIndicesInRadius(RealVector2D const& pos, float radius, std::vector<int>& result) const
+{
+    forEachInRadius(pos, radius, [&result](int index, RealVector2D const&, float) { result.emplace_back(index); });
+}
+
+void SpatialHashGrid::getIndicesInRect(RealVector2D const& topLeft, RealVector2D const& bottomRight, std::vector<int>& result) const
+{
+    auto left = topLeft.x;
+    auto right = bottomRight.x;
+    auto top = topLeft.y;
+    auto bottom = bottomRight.y;
+    if (right <= left || bottom <= top) {
+        return;
+    }
+
+    //rectangles covering a whole dimension would otherwise contain entries several times
+    if (right - left >= _worldSizeFloat.x) {
+        left = 0;
+        right = _worldSizeFloat.x;
+    }
+    if (bottom - top >= _worldSizeFloat.y) {
+        top = 0;
+        bottom = _worldSizeFloat.y;
+    }
+
+    forEachCellRange(left, right, top, bottom, [&](int begin, int end, float shiftX, float shiftY) {
+        auto relLeft = left - shiftX;
+        auto relRight = right - shiftX;
+        auto relTop = top - shiftY;
+        auto relBottom = bottom - shiftY;
+        bool inside[FilterBlockSize];
+        for (int blockBegin = begin; blockBegin < end; blockBegin += FilterBlockSize) {
+            auto blockSize = std::min(FilterBlockSize, end - blockBegin);
+            auto xs = _xs.data() + blockBegin;
+            auto ys = _ys.data() + blockBegin;
+            for (int i = 0; i < blockSize; ++i) {
+                inside[i] = (xs[i] >= relLeft) & (xs[i] < relRight) & (ys[i] >= relTop) & (ys[i] < relBottom);
+            }
+            for (int i = 0; i < blockSize; ++i) {
+                if (inside[i]) {
+                    result.emplace_back(_indices[blockBegin + i]);
+                }
+            }
+        }
+        return false;
+    });
+
+    auto correctedLeft = std::fmod(std::fmod(left, _worldSizeFloat.x) + _worldSizeFloat.x, _worldSizeFloat.x);
+    auto correctedTop = std::fmod(std::fmod(top, _worldSizeFloat.y) + _worldSizeFloat.y, _worldSizeFloat.y);
+    for (auto const& index : _pendingIndices) {
+        auto const& pos = _positions[index];
+        auto relX = pos.x >= correctedLeft ? pos.x - correctedLeft : pos.x - correctedLeft + _worldSizeFloat.x;
+        auto relY = pos.y >= correctedTop ? pos.y - correctedTop : pos.y - correctedTop + _worldSizeFloat.y;
+        if (relX < right - left && relY < bottom - top) {
+            result.emplace_back(index);
+        }
+    }
+}
+
+void SpatialHashGrid::areOccupied(std::vector<RealVector2D> const& positions, float radius, std::vector<bool>& result) const
+{
+    result.assign(positions.size(), false);
+    for (auto const& i : getIndicesSortedByCell(positions)) {
+        result[i] = isOccupied(positions[i], radius);
+    }
+}
+
+void SpatialHashGrid::getIndicesInRadius(std::vector<RealVector2D> const& positions, float radius, std::vector<int>& indices, std::vector<int>& offsets)
+    const
+{
+    //query in cell order and reorder the results afterwards
+    std::vector<int> unorderedIndices;
+    std::vector<int> unorderedBegins(positions.size());
+    std::vector<int> counts(positions.size());
+    for (auto const& i : getIndicesSortedByCell(positions)) {
+        unorderedBegins[i] = toInt(unorderedIndices.size());
+        getIndicesInRadius(positions[i], radius, unorderedIndices);
+        counts[i] = toInt(unorderedIndices.size()) - unorderedBegins[i];
+    }
+
+    offsets.resize(positions.size() + 1);
+    offsets[0] = 0;
+    std::partial_sum(counts.begin(), counts.end(), offsets.begin() + 1);
+    indices.resize(unorderedIndices.size());
+    for (int i = 0; i < toInt(positions.size()); ++i) {
+        std::copy_n(unorderedIndices.begin() + unorderedBegins[i], counts[i], indices.begin() + offsets[i]);
+    }
+}
+
+void SpatialHashGrid::rebuild()
+{
+    auto numEntries = toInt(_positions.size());
+
+    //cell size: at least _minCellSize, coarser if the number of cells would exceed twice the number of entries
+    auto cellSize = _minCellSize;
+    auto maxNumCells = toDouble(std::max(MinNumCells, 2 * numEntries));
+    auto numCellsWithMinSize = toDouble(_worldSizeFloat.x / cellSize) * toDouble(_worldSizeFloat.y / cellSize);
+    if (numCellsWithMinSize > maxNumCells) {
+        cellSize *= toFloat(std::sqrt(numCellsWithMinSize / maxNumCells));
+    }
+    _numCells = {std::max(1, toInt(_worldSizeFloat.x / cellSize)), std::max(1, toInt(_worldSizeFloat.y / cellSize))};
+    _cellSize = {_worldSizeFloat.x / toFloat(_numCells.x), _worldSizeFloat.y / toFloat(_numCells.y)};
+
+    //counting sort of the entries by cell
+    std::vector<int> cellIndices(numEntries);
+    _cellOffsets.assign(_numCells.x * _numCells.y + 1, 0);
+    for (int i = 0; i < numEntries; ++i) {
+        cellIndices[i] = getCellIndex(_positions[i]);
+        ++_cellOffsets[cellIndices[i] + 1];
+    }
+    std::partial_sum(_cellOffsets.begin(), _cellOffsets.end(), _cellOffsets.begin());
+
+    _xs.resize(numEntries);
+    _ys.resize(numEntries);
+    _indices.resize(numEntries);
+    std::vector<int> fillLevels(_cellOffsets.begin(), _cellOffsets.end() - 1);
+    for (int i = 0; i < numEntries; ++i) {
+        auto target = fillLevels[cellIndices[i]]++;
+        _xs[target] = _positions[i].x;
+        _ys[target] = _positions[i].y;
+        _indices[target] = i;
+    }
+    _pendingIndices.clear();
+}
+
+RealVector2D SpatialHashGrid::getCorrectedPosition(RealVector2D const& pos) const
+{
+    auto correct = [](float value, float size) {
+        auto result = std::fmod(value, size);
+        if (result < 0) {
+            result += size;
+        }
+        if (result >= size) {  //rounding of small negative values
+            result -= size;
+        }
+        return result;
+    };
+    return {correct(pos.x, _worldSizeFloat.x), correct(pos.y, _worldSizeFloat.y)};
+}
+
+void SpatialHashGrid::correctDirection(RealVector2D& direction) const
+{
+    direction.x = std::remainder(direction.x, _worldSizeFloat.x);
+    direction.y = std::remainder(direction.y, _worldSizeFloat.y);
+}
+
+int SpatialHashGrid::getCellIndex(RealVector2D const& correctedPos) const
+{
+    auto cellX = std::min(toInt(correctedPos.x / _cellSize.x), _numCells.x - 1);
+    auto cellY = std::min(toInt(correctedPos.y / _cellSize.y), _numCells.y - 1);
+    return cellX + cellY * _numCells.x;
+}
+
+std::vector<int> SpatialHashGrid::getIndicesSortedByCell(std::vector<RealVector2D> const& positions) const
+{
+    std::vector<int> cellIndices(positions.size());
+    for (int i = 0; i < toInt(positions.size()); ++i) {
+        cellIndices[i] = getCellIndex(getCorrectedPosition(positions[i]));
+    }
+    std::vector<int> result(positions.size());
+    std::iota(result.begin(), result.end(), 0);
+    std::stable_sort(result.begin(), result.end(), [&cellIndices](int i1, int i2) { return cellIndices[i1] < cellIndices[i2]; });
+    return result;
+}
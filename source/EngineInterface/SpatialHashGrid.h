@@ -0,0 +1,187 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "Base/Definitions.h"
+#include "Base/Vector2D.h"
+
+/**
+ * Spatial index for points in the toroidal world on the host (counterpart of CellMap/ParticleMap in Map.cuh).
+ *
+ * Entries are stored as a structure of arrays sorted by grid cell, so that the cells of a row in a query range form one
+ * contiguous memory range. The distance filter processes such ranges in fixed-size blocks without branches, which allows the
+ * compiler to vectorize it. The cell size is at least minCellSize and grows if necessary to keep the number of grid cells
+ * proportional to the number of entries.
+ *
+ * Positions are corrected to [0, worldSize) like BaseMap::correctPosition and distances are measured to the nearest image.
+ * Entries added by insert are kept in an unsorted buffer which is merged into the sorted arrays once it becomes too large.
+ */
+class SpatialHashGrid
+{
+public:
+    SpatialHashGrid(IntVector2D const& worldSize = {1, 1}, float minCellSize = 1.0f);
+
+    IntVector2D const& getWorldSize() const;
+    void setWorldSize(IntVector2D const& worldSize);  //positions of existing entries are corrected to the new world size
+
+    void build(std::vector<RealVector2D> const& positions);  //replaces all entries, the entry of positions[i] has index i
+    int insert(RealVector2D const& pos);                     //returns the index of the new entry
+    void clear();
+
+    int getNumEntries() const;
+    RealVector2D const& getPosition(int index) const;  //corrected position
+
+    //calls func(int index, RealVector2D const& delta, float distanceSquared) for all entries with distance <= radius, delta = entry - pos
+    template <typename Func>
+    void forEachInRadius(RealVector2D const& pos, float radius, Func const& func) const;
+
+    bool isOccupied(RealVector2D const& pos, float radius) const;  //true if there is an entry with distance <= radius
+    void getIndicesInRadius(RealVector2D const& pos, float radius, std::vector<int>& result) const;  //appends to result
+
+    //appends all entries with topLeft <= pos < bottomRight (taking the world as a torus) to result
+    void getIndicesInRect(RealVector2D const& topLeft, RealVector2D const& bottomRight, std::vector<int>& result) const;
+
+    //batched queries, the positions are processed in the order of their grid cells to improve cache locality
+    void areOccupied(std::vector<RealVector2D> const& positions, float radius, std::vector<bool>& result) const;
+    //indices in radius of positions[i] are stored in indices[offsets[i]], ..., indices[offsets[i + 1] - 1]
+    void getIndicesInRadius(std::vector<RealVector2D> const& positions, float radius, std::vector<int>& indices, std::vector<int>& offsets) const;
+
+private:
+    static int constexpr FilterBlockSize = 16;
+    static int constexpr MinNumCells = 64;
+    static int constexpr MinPendingSize = 64;
+
+    void rebuild();
+    RealVector2D getCorrectedPosition(RealVector2D const& pos) const;
+    void correctDirection(RealVector2D& direction) const;
+    int getCellIndex(RealVector2D const& correctedPos) const;
+    std::vector<int> getIndicesSortedByCell(std::vector<RealVector2D> const& positions) const;
+
+    //returns true if func requested to stop
+    template <typename Func>
+    bool forEachInRadiusIntern(RealVector2D const& pos, float radius, Func const& func) const;
+
+    //calls func(int begin, int end, float shiftX, float shiftY) for the sorted entries of the cells intersecting [minX, maxX] x [minY, maxY]
+    //(unbounded coordinates), an entry at x in such a range has the position x + shiftX in the coordinates of the query
+    template <typename Func>
+    bool forEachCellRange(float minX, float maxX, float minY, float maxY, Func const& func) const;
+
+    IntVector2D _worldSize;
+    RealVector2D _worldSizeFloat;
+    float _minCellSize = 1.0f;
+
+    std::vector<RealVector2D> _positions;  //indexed by entry index
+
+    //sorted part
+    IntVector2D _numCells;
+    RealVector2D _cellSize;
+    std::vector<int> _cellOffsets;  //entries of cell i are stored in [_cellOffsets[i], _cellOffsets[i + 1])
+    std::vector<float> _xs;
+    std::vector<float> _ys;
+    std::vector<int> _indices;
+
+    std::vector<int> _pendingIndices;
+};
+
+/************************************************************************/
+/* Implementation                                                       */
+/************************************************************************/
+
+template <typename Func>
+void SpatialHashGrid::forEachInRadius(RealVector2D const& pos, float radius, Func const& func) const
+{
+    forEachInRadiusIntern(pos, radius, [&func](int index, RealVector2D const& delta, float distanceSquared) {
+        func(index, delta, distanceSquared);
+        return false;
+    });
+}
+
+template <typename Func>
+bool SpatialHashGrid::forEachInRadiusIntern(RealVector2D const& pos, float radius, Func const& func) const
+{
+    auto radiusSquared = radius * radius;
+    auto correctedPos = getCorrectedPosition(pos);
+
+    //a grid cell could be visited with different shifts for large radii => nearest images of all entries are checked
+    if (2 * radius >= _worldSizeFloat.x || 2 * radius >= _worldSizeFloat.y) {
+        for (int index = 0; index < toInt(_positions.size()); ++index) {
+            auto delta = _positions[index] - correctedPos;
+            correctDirection(delta);
+            auto distanceSquared = delta.x * delta.x + delta.y * delta.y;
+            if (distanceSquared <= radiusSquared && func(index, delta, distanceSquared)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    auto stopped = forEachCellRange(
+        correctedPos.x - radius, correctedPos.x + radius, correctedPos.y - radius, correctedPos.y + radius, [&](int begin, int end, float shiftX, float shiftY) {
+            auto relPosX = correctedPos.x - shiftX;
+            auto relPosY = correctedPos.y - shiftY;
+            float distancesSquared[FilterBlockSize];
+            for (int blockBegin = begin; blockBegin < end; blockBegin += FilterBlockSize) {
+                auto blockSize = std::min(FilterBlockSize, end - blockBegin);
+                auto xs = _xs.data() + blockBegin;
+                auto ys = _ys.data() + blockBegin;
+                for (int i = 0; i < blockSize; ++i) {
+                    auto dx = xs[i] - relPosX;
+                    auto dy = ys[i] - relPosY;
+                    distancesSquared[i] = dx * dx + dy * dy;
+                }
+                for (int i = 0; i < blockSize; ++i) {
+                    if (distancesSquared[i] <= radiusSquared && func(_indices[blockBegin + i], RealVector2D{xs[i] - relPosX, ys[i] - relPosY}, distancesSquared[i])) {
+                        return true;
+                    }
+                }
+            }
+            return false;
+        });
+    if (stopped) {
+        return true;
+    }
+
+    for (auto const& index : _pendingIndices) {
+        auto delta = _positions[index] - correctedPos;
+        correctDirection(delta);
+        auto distanceSquared = delta.x * delta.x + delta.y * delta.y;
+        if (distanceSquared <= radiusSquared && func(index, delta, distanceSquared)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename Func>
+bool SpatialHashGrid::forEachCellRange(float minX, float maxX, float minY, float maxY, Func const& func) const
+{
+    auto floorMod = [](int value, int divisor) { return (value % divisor + divisor) % divisor; };
+
+    auto minCellX = toInt(std::floor(minX / _cellSize.x));
+    auto maxCellX = toInt(std::floor(maxX / _cellSize.x));
+    auto minCellY = toInt(std::floor(minY / _cellSize.y));
+    auto maxCellY = toInt(std::floor(maxY / _cellSize.y));
+
+    for (int unboundedCellY = minCellY; unboundedCellY <= maxCellY; ++unboundedCellY) {
+        auto cellY = floorMod(unboundedCellY, _numCells.y);
+        auto shiftY = toFloat((unboundedCellY - cellY) / _numCells.y) * _worldSizeFloat.y;
+        auto rowOffset = cellY * _numCells.x;
+
+        //split the row into segments without wrap-around
+        auto unboundedCellX = minCellX;
+        while (unboundedCellX <= maxCellX) {
+            auto cellX = floorMod(unboundedCellX, _numCells.x);
+            auto segmentLength = std::min(maxCellX - unboundedCellX + 1, _numCells.x - cellX);
+            auto shiftX = toFloat((unboundedCellX - cellX) / _numCells.x) * _worldSizeFloat.x;
+            auto begin = _cellOffsets[rowOffset + cellX];
+            auto end = _cellOffsets[rowOffset + cellX + segmentLength];
+            if (begin < end && func(begin, end, shiftX, shiftY)) {
+                return true;
+            }
+            unboundedCellX += segmentLength;
+        }
+    }
+    return false;
+}
@@ -1,24 +1,227 @@
 #include "StatisticsHistory.h"
 
+#include <algorithm>
+#include <cmath>
+
+#include "Base/Definitions.h"
+
+namespace
+{
+    StatisticsHistoryData mergePairs(StatisticsHistoryData const& data)
+    {
+        StatisticsHistoryData result;
+        result.reserve(data.size() / 2 + 1);
+        for (size_t i = 0; i + 1 < data.size(); i += 2) {
+            result.emplace_back((data.at(i) + data.at(i + 1)) / 2.0);
+        }
+        if (data.size() % 2 == 1) {
+            result.emplace_back(data.back());
+        }
+        return result;
+    }
+}
+
+StatisticsHistoryData StatisticsHistorySnapshot::getData() const
+{
+    std::vector<std::optional<double>> startTimeByTier;
+    for (auto const& chunks : chunksByTier) {
+        startTimeByTier.emplace_back(chunks.empty() ? std::nullopt : std::optional<double>(chunks.front()->front().time));
+    }
+
+    StatisticsHistoryData result;
+    for (int tier = toInt(chunksByTier.size()) - 1; tier >= 0; --tier) {
+        std::optional<double> endTime;
+        for (int finerTier = 0; finerTier < tier; ++finerTier) {
+            if (startTimeByTier.at(finerTier) && (!endTime || *startTimeByTier.at(finerTier) < *endTime)) {
+                endTime = startTimeByTier.at(finerTier);
+            }
+        }
+        for (auto const& chunk : chunksByTier.at(tier)) {
+            for (auto const& dataPoint : *chunk) {
+                if (!endTime || dataPoint.time < *endTime) {
+                    result.emplace_back(dataPoint);
+                }
+            }
+        }
+    }
+    return result;
+}
+
+bool StatisticsHistorySnapshot::isEmpty() const
+{
+    for (auto const& chunks : chunksByTier) {
+        if (!chunks.empty()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+StatisticsHistory::StatisticsHistory()
+    : _tiers(NumTiers)
+{
+    publish();
+}
+
+std::shared_ptr<StatisticsHistorySnapshot const> StatisticsHistory::getSnapshot() const
+{
+    return _snapshot.load();
+}
 
 StatisticsHistoryData StatisticsHistory::getCopiedData() const
 {
-    std::lock_guard lock(_mutex);
-    auto copy = _data;
-    return copy;
+    return getSnapshot()->getData();
+}
+
+std::optional<DataPointCollection> StatisticsHistory::getLastDataPoint() const
+{
+    std::lock_guard lock(_writerMutex);
+
+    //the finest tier with data contains the latest data point
+    for (auto const& tier : _tiers) {
+        if (!tier.openChunk.empty()) {
+            return tier.openChunk.back();
+        }
+        if (!tier.sealedChunks.empty()) {
+            return tier.sealedChunks.back()->back();
+        }
+    }
+    return std::nullopt;
+}
+
+void StatisticsHistory::addDataPoint(DataPointCollection const& dataPoint)
+{
+    std::lock_guard lock(_writerMutex);
+
+    auto& tier = _tiers.front();
+    if (!tier.openChunk.empty() && std::abs(tier.openChunk.back().time - dataPoint.time) < NEAR_ZERO) {
+        tier.openChunk.back() = dataPoint;
+        tier.publishedOpenChunk.reset();
+    } else {
+        addDataPointIntern(0, dataPoint);
+    }
+    publish();
+}
+
+void StatisticsHistory::setData(StatisticsHistoryData const& data)
+{
+    std::lock_guard lock(_writerMutex);
+
+    //the data is assigned to the coarsest tier, the finer tiers are filled by the following time steps
+    auto tierData = data;
+    while (tierData.size() > (MaxChunksPerTier - 1) * ChunkSize) {
+        tierData = mergePairs(tierData);
+    }
+    for (int i = 0; i < NumTiers; ++i) {
+        setTierData(i, i == NumTiers - 1 ? tierData : StatisticsHistoryData());
+    }
+    publish();
+}
+
+void StatisticsHistory::removeDataPointsFrom(double time)
+{
+    std::lock_guard lock(_writerMutex);
+
+    for (int i = 0; i < NumTiers; ++i) {
+        auto tierData = getTierData(i);
+        std::erase_if(tierData, [&](auto const& dataPoint) { return dataPoint.time >= time; });
+        setTierData(i, tierData);
+    }
+    publish();
 }
 
-std::mutex& StatisticsHistory::getMutex() const
+void StatisticsHistory::clear()
 {
-    return _mutex;
+    std::lock_guard lock(_writerMutex);
+
+    for (int i = 0; i < NumTiers; ++i) {
+        setTierData(i, {});
+    }
+    publish();
 }
 
-StatisticsHistoryData& StatisticsHistory::getDataRef()
+void StatisticsHistory::addDataPointIntern(int tierIndex, DataPointCollection const& dataPoint)
 {
-    return _data;
+    auto& tier = _tiers.at(tierIndex);
+    if (tier.openChunk.size() == ChunkSize) {
+        tier.sealedChunks.emplace_back(std::make_shared<StatisticsHistoryData const>(std::move(tier.openChunk)));
+        tier.openChunk = StatisticsHistoryData();
+        tier.openChunk.reserve(ChunkSize);
+    }
+    tier.openChunk.emplace_back(dataPoint);
+    tier.publishedOpenChunk.reset();
+
+    if (tierIndex == NumTiers - 1) {
+        if (tier.sealedChunks.size() == MaxChunksPerTier) {
+            mergeLastTier();
+        }
+        return;
+    }
+
+    //the finer tiers are rings, their old data points are covered by the coarser tiers
+    if (tier.sealedChunks.size() == MaxChunksPerTier) {
+        tier.sealedChunks.pop_front();
+    }
+    tier.accumulatedDataPoint = tier.accumulatedDataPoint ? *tier.accumulatedDataPoint + dataPoint : dataPoint;
+    if (++tier.numAccumulatedDataPoints == tier.aggregationFactor) {
+        auto coarseDataPoint = *tier.accumulatedDataPoint / tier.numAccumulatedDataPoints;
+        tier.accumulatedDataPoint.reset();
+        tier.numAccumulatedDataPoints = 0;
+        addDataPointIntern(tierIndex + 1, coarseDataPoint);
+    }
+}
+
+void StatisticsHistory::mergeLastTier()
+{
+    //happens after (MaxChunksPerTier / 2) * ChunkSize new data points of the last tier, hence the costs are amortized
+    setTierData(NumTiers - 1, mergePairs(getTierData(NumTiers - 1)));
+    _tiers.at(NumTiers - 2).aggregationFactor *= 2;
+}
+
+StatisticsHistoryData StatisticsHistory::getTierData(int tierIndex) const
+{
+    auto const& tier = _tiers.at(tierIndex);
+    StatisticsHistoryData result;
+    for (auto const& chunk : tier.sealedChunks) {
+        result.insert(result.end(), chunk->begin(), chunk->end());
+    }
+    result.insert(result.end(), tier.openChunk.begin(), tier.openChunk.end());
+    return result;
+}
+
+void StatisticsHistory::setTierData(int tierIndex, StatisticsHistoryData const& data)
+{
+    auto& tier = _tiers.at(tierIndex);
+    tier.sealedChunks.clear();
+    tier.openChunk.clear();
+    tier.publishedOpenChunk.reset();
+    tier.accumulatedDataPoint.reset();
+    tier.numAccumulatedDataPoints = 0;
+    if (data.empty()) {
+        tier.aggregationFactor = TierFactor;
+    }
+
+    for (size_t i = 0; i < data.size(); i += ChunkSize) {
+        auto chunkEnd = std::min(data.size(), i + ChunkSize);
+        if (chunkEnd - i == ChunkSize && chunkEnd < data.size()) {
+            tier.sealedChunks.emplace_back(std::make_shared<StatisticsHistoryData const>(data.begin() + i, data.begin() + chunkEnd));
+        } else {
+            tier.openChunk.assign(data.begin() + i, data.begin() + chunkEnd);
+        }
+    }
 }
 
-StatisticsHistoryData const& StatisticsHistory::getDataRef() const
+void StatisticsHistory::publish()
 {
-    return _data;
+    auto snapshot = std::make_shared<StatisticsHistorySnapshot>();
+    for (auto& tier : _tiers) {
+        auto& chunks = snapshot->chunksByTier.emplace_back(tier.sealedChunks.begin(), tier.sealedChunks.end());
+        if (!tier.openChunk.empty()) {
+            if (!tier.publishedOpenChunk) {
+                tier.publishedOpenChunk = std::make_shared<StatisticsHistoryData const>(tier.openChunk);
+            }
+            chunks.emplace_back(tier.publishedOpenChunk);
+        }
+    }
+    _snapshot.store(std::move(snapshot));
 }
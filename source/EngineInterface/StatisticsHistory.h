@@ -1,6 +1,10 @@
 #pragma once
 
+#include <atomic>
+#include <deque>
+#include <memory>
 #include <mutex>
+#include <optional>
 #include <vector>
 
 #include "DataPointCollection.h"
@@ -8,16 +12,69 @@
 
 using StatisticsHistoryData = std::vector<DataPointCollection>;
 
+/**
+ * Immutable state of a StatisticsHistory. The samples are stored per tier in chunks which are shared between snapshots.
+ */
+struct StatisticsHistorySnapshot
+{
+    using Chunk = std::shared_ptr<StatisticsHistoryData const>;
+
+    std::vector<std::vector<Chunk>> chunksByTier;  //tier 0 = finest resolution
+
+    //merged chronological view: the coarser tiers cover the time before the first sample of the finer tiers
+    StatisticsHistoryData getData() const;
+    bool isEmpty() const;
+};
+
+/**
+ * Multi-resolution history of the statistics for long runs.
+ * Tier 0 holds the latest samples and each further tier averages TierFactor samples of the tier below. The tiers are rings of
+ * chunks, only the last tier keeps the full time range by merging pairs of its samples when it is full.
+ *
+ * Single writer, multiple readers: the writer publishes a new snapshot after each change, which only copies the chunk in
+ * progress. Readers never block the writer.
+ */
 class StatisticsHistory
 {
 public:
+    static auto constexpr NumTiers = 3;
+    static auto constexpr TierFactor = 10;
+    static auto constexpr ChunkSize = 50;
+    static auto constexpr MaxChunksPerTier = 20;
+
+    StatisticsHistory();
+
+    //reader methods
+    std::shared_ptr<StatisticsHistorySnapshot const> getSnapshot() const;
     StatisticsHistoryData getCopiedData() const;
 
-    std::mutex& getMutex() const;
-    StatisticsHistoryData& getDataRef();
-    StatisticsHistoryData const& getDataRef() const;
+    //writer methods
+    std::optional<DataPointCollection> getLastDataPoint() const;
+    void addDataPoint(DataPointCollection const& dataPoint);  //replaces the last data point if the time is equal
+    void setData(StatisticsHistoryData const& data);
+    void removeDataPointsFrom(double time);
+    void clear();
 
 private:
-    mutable std::mutex _mutex;
-    StatisticsHistoryData _data;
+    struct Tier
+    {
+        std::deque<StatisticsHistorySnapshot::Chunk> sealedChunks;
+        StatisticsHistoryData openChunk;
+        StatisticsHistorySnapshot::Chunk publishedOpenChunk;  //copy of openChunk, reset on change
+
+        //for the next tier
+        int aggregationFactor = TierFactor;
+        std::optional<DataPointCollection> accumulatedDataPoint;
+        int numAccumulatedDataPoints = 0;
+    };
+
+    void addDataPointIntern(int tierIndex, DataPointCollection const& dataPoint);
+    void mergeLastTier();
+    StatisticsHistoryData getTierData(int tierIndex) const;
+    void setTierData(int tierIndex, StatisticsHistoryData const& data);
+    void publish();
+
+    mutable std::mutex _writerMutex;
+    std::vector<Tier> _tiers;
+    std::atomic<std::shared_ptr<StatisticsHistorySnapshot const>> _snapshot;
 };
@@ -0,0 +1,367 @@
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include "Base/Math.h"
+#include "EngineImpl/AccessDataTOCache.h"
+#include "EngineImpl/DescriptionConverter.h"
+#include "EngineImpl/SimulationCpuFacade.h"
+#include "EngineInterface/DescriptionEditService.h"
+#include "EngineInterface/Descriptions.h"
+#include "EngineInterface/GeneralSettings.h"
+#include "EngineInterface/Settings.h"
+#include "EngineInterface/SimulationController.h"
+#include "EngineImpl/SimulationControllerImpl.h"
+#include "IntegrationTestFramework.h"
+
+class CpuEngineTests : public IntegrationTestFramework
+{
+public:
+    CpuEngineTests()
+        : IntegrationTestFramework(std::nullopt, IntVector2D{100, 100}, EngineBackend_Cpu)
+    {}
+
+    ~CpuEngineTests() = default;
+
+protected:
+    float getDistance(DataDescription const& data, uint64_t id, uint64_t otherId) const
+    {
+        return Math::length(getCell(data, id).pos - getCell(data, otherId).pos);
+    }
+};
+
+TEST_F(CpuEngineTests, backend)
+{
+    EXPECT_EQ(EngineBackend_Cpu, _simController->getEngineBackend());
+}
+
+TEST_F(CpuEngineTests, unsupportedOperationsThrow)
+{
+    EXPECT_THROW(_simController->applyCataclysm(1), std::runtime_error);
+    EXPECT_THROW(_simController->reconnectSelectedObjects(), std::runtime_error);
+    EXPECT_THROW(_simController->setDetached(true), std::runtime_error);
+}
+
+TEST_F(CpuEngineTests, dataTransfer)
+{
+    auto data = DescriptionEditService::createRect(DescriptionEditService::CreateRectParameters().width(5).height(4).center({50.0f, 50.0f}));
+    data.addParticle(ParticleDescription().setId(1000).setPos({10.0f, 20.0f}).setVel({0.5f, 1.0f}).setEnergy(100.0f).setColor(2));
+
+    _simController->setSimulationData(data);
+    auto actualData = _simController->getSimulationData();
+
+    EXPECT_TRUE(compare(data, actualData));
+}
+
+TEST_F(CpuEngineTests, particleMovement)
+{
+    DataDescription data;
+    data.addParticle(ParticleDescription().setId(1).setPos({10.0f, 20.0f}).setVel({0.5f, -0.25f}).setEnergy(100.0f));
+    _simController->setSimulationData(data);
+
+    _simController->calcTimesteps(100);
+
+    auto actualData = _simController->getSimulationData();
+    ASSERT_EQ(1, actualData.particles.size());
+    EXPECT_TRUE(approxCompare(RealVector2D{60.0f, 95.0f}, actualData.particles.front().pos));
+}
+
+TEST_F(CpuEngineTests, connectedCellsRelaxToBondDistance)
+{
+    _parameters.baseValues.friction = 0.01f;
+    _simController->setSimulationParameters(_parameters);
+
+    DataDescription data;
+    data.addCells({
+        CellDescription().setId(1).setPos({50.0f, 50.0f}).setMaxConnections(1),
+        CellDescription().setId(2).setPos({52.0f, 50.0f}).setMaxConnections(1),
+    });
+    data.addConnection(1, 2);
+    data.cells.at(0).connections.at(0).distance = 1.0f;
+    data.cells.at(1).connections.at(0).distance = 1.0f;
+    _simController->setSimulationData(data);
+
+    _simController->calcTimesteps(1000);
+
+    auto actualData = _simController->getSimulationData();
+    EXPECT_TRUE(approxCompare(1.0f, getDistance(actualData, 1, 2), 0.1f));
+    EXPECT_TRUE(hasConnection(actualData, 1, 2));
+}
+
+TEST_F(CpuEngineTests, collidingCellsRepel)
+{
+    _parameters.motionType = MotionType_Collision;
+    _simController->setSimulationParameters(_parameters);
+
+    DataDescription data;
+    data.addCells({
+        CellDescription().setId(1).setPos({50.0f, 50.0f}),
+        CellDescription().setId(2).setPos({50.8f, 50.0f}),
+    });
+    _simController->setSimulationData(data);
+
+    _simController->calcTimesteps(100);
+
+    auto actualData = _simController->getSimulationData();
+    EXPECT_GT(getDistance(actualData, 1, 2), 0.8f);
+    EXPECT_LT(getCell(actualData, 1).pos.x, getCell(actualData, 2).pos.x);
+}
+
+TEST_F(CpuEngineTests, collisionAcrossWorldBoundary)
+{
+    _parameters.motionType = MotionType_Collision;
+    _simController->setSimulationParameters(_parameters);
+
+    DataDescription data;
+    data.addCells({
+        CellDescription().setId(1).setPos({99.8f, 50.0f}),
+        CellDescription().setId(2).setPos({0.4f, 50.0f}),
+    });
+    _simController->setSimulationData(data);
+
+    _simController->calcTimesteps(100);
+
+    auto actualData = _simController->getSimulationData();
+    auto cell1 = getCell(actualData, 1);
+    auto cell2 = getCell(actualData, 2);
+    EXPECT_LT(cell1.pos.x, 99.8f);
+    EXPECT_GT(cell2.pos.x, 0.4f);
+    EXPECT_LT(cell2.pos.x, 50.0f);
+}
+
+TEST_F(CpuEngineTests, selection)
+{
+    auto data = DescriptionEditService::createRect(DescriptionEditService::CreateRectParameters().width(3).height(3).center({20.0f, 20.0f}));
+    data.add(DescriptionEditService::createRect(DescriptionEditService::CreateRectParameters().width(2).height(2).center({70.0f, 70.0f})));
+    data.addParticle(ParticleDescription().setId(1000).setPos({40.0f, 40.0f}).setEnergy(10.0f));
+    _simController->setSimulationData(data);
+
+    _simController->setSelection({19.5f, 19.5f}, {20.5f, 20.5f});
+    auto selectionData = _simController->getSelectionShallowData();
+    EXPECT_EQ(1, selectionData.numCells);
+    EXPECT_EQ(9, selectionData.numClusterCells);
+    EXPECT_EQ(0, selectionData.numParticles);
+
+    _simController->removeSelectedObjects(true);
+    auto actualData = _simController->getSimulationData();
+    EXPECT_EQ(4, actualData.cells.size());
+    EXPECT_EQ(1, actualData.particles.size());
+    for (auto const& cell : actualData.cells) {
+        EXPECT_EQ(2, cell.connections.size());
+    }
+}
+
+TEST_F(CpuEngineTests, fluidPressureSpreadsCells)
+{
+    DataDescription data;
+    for (int x = 0; x < 5; ++x) {
+        for (int y = 0; y < 5; ++y) {
+            data.addCell(CellDescription().setId(x * 5 + y + 1).setPos({50.0f + toFloat(x) * 0.5f, 50.0f + toFloat(y) * 0.5f}));
+        }
+    }
+    _simController->setSimulationData(data);
+
+    _simController->calcTimesteps(100);
+
+    auto actualData = _simController->getSimulationData();
+    ASSERT_EQ(25, actualData.cells.size());
+    for (auto const& cell : actualData.cells) {
+        EXPECT_TRUE(std::isfinite(cell.pos.x) && std::isfinite(cell.pos.y));
+    }
+    EXPECT_GT(getDistance(actualData, 1, 25), getDistance(data, 1, 25));
+}
+
+TEST_F(CpuEngineTests, nerveTransfer)
+{
+    ActivityDescription activity;
+    activity.channels = {1, 0, -1, 0, 0, 0, 0, 0};
+
+    auto data = DataDescription().addCells({
+        CellDescription().setId(1).setPos({1.0f, 1.0f}).setCellFunction(NerveDescription()).setMaxConnections(2).setExecutionOrderNumber(5).setActivity(activity),
+        CellDescription()
+            .setId(2)
+            .setPos({2.0f, 1.0f})
+            .setCellFunction(NerveDescription())
+            .setMaxConnections(2)
+            .setExecutionOrderNumber(0)
+            .setInputExecutionOrderNumber(5),
+        CellDescription()
+            .setId(3)
+            .setPos({3.0f, 1.0f})
+            .setCellFunction(NerveDescription())
+            .setMaxConnections(2)
+            .setExecutionOrderNumber(1)
+            .setInputExecutionOrderNumber(0),
+    });
+    data.addConnection(1, 2);
+    data.addConnection(2, 3);
+
+    _simController->setSimulationData(data);
+    _simController->calcTimesteps(1);
+    {
+        auto actualCellById = getCellById(_simController->getSimulationData());
+        EXPECT_EQ(ActivityDescription(), actualCellById.at(1).activity);
+        EXPECT_EQ(activity, actualCellById.at(2).activity);
+        EXPECT_EQ(ActivityDescription(), actualCellById.at(3).activity);
+    }
+
+    _simController->calcTimesteps(1);
+    {
+        auto actualCellById = getCellById(_simController->getSimulationData());
+        EXPECT_EQ(ActivityDescription(), actualCellById.at(1).activity);
+        EXPECT_EQ(ActivityDescription(), actualCellById.at(2).activity);
+        EXPECT_EQ(activity, actualCellById.at(3).activity);
+    }
+}
+
+TEST_F(CpuEngineTests, nerveConstantPulse)
+{
+    auto data = DataDescription().addCells({
+        CellDescription()
+            .setId(1)
+            .setPos({1.0f, 1.0f})
+            .setCellFunction(NerveDescription().setPulseMode(3).setAlternationMode(0))
+            .setMaxConnections(2)
+            .setExecutionOrderNumber(0),
+        CellDescription()
+            .setId(2)
+            .setPos({2.0f, 1.0f})
+            .setCellFunction(NerveDescription())
+            .setMaxConnections(2)
+            .setExecutionOrderNumber(1)
+            .setInputExecutionOrderNumber(0)
+            .setOutputBlocked(true),
+    });
+    data.addConnection(1, 2);
+
+    _simController->setSimulationData(data);
+    for (int i = 0; i <= 18; ++i) {
+        _simController->calcTimesteps(1);
+
+        auto actualCellById = getCellById(_simController->getSimulationData());
+        ActivityDescription activity;
+        if (i % 18 == 0) {
+            activity.channels = {1, 0, 0, 0, 0, 0, 0, 0};
+        }
+        EXPECT_EQ(activity, actualCellById.at(1).activity);
+    }
+}
+
+TEST_F(CpuEngineTests, neuronBias)
+{
+    NeuronDescription neuron;
+    neuron.biases = {0, 0, 1, 0, 0, 0, 0, -1};
+
+    auto data = DataDescription().addCells({CellDescription().setId(1).setCellFunction(neuron).setMaxConnections(2).setExecutionOrderNumber(0)});
+    _simController->setSimulationData(data);
+    _simController->calcTimesteps(1);
+
+    auto actualCellById = getCellById(_simController->getSimulationData());
+    auto scaledSigmoid = [](float value) { return 2.0f / (1.0f + std::exp(-value)) - 1.0f; };
+    EXPECT_TRUE(approxCompare({0, 0, scaledSigmoid(1), 0, 0, 0, 0, scaledSigmoid(-1)}, actualCellById.at(1).activity.channels));
+}
+
+TEST_F(CpuEngineTests, neuronAfterActivationTime)
+{
+    NeuronDescription neuron;
+    neuron.biases = {1, 0, 0, 0, 0, 0, 0, 0};
+
+    auto data = DataDescription().addCells(
+        {CellDescription().setId(1).setCellFunction(neuron).setMaxConnections(2).setExecutionOrderNumber(0).setActivationTime(3)});
+    _simController->setSimulationData(data);
+
+    //neuron is not executed in the first cycle of execution order numbers since it is not activated yet
+    _simController->calcTimesteps(_parameters.cellNumExecutionOrderNumbers);
+    EXPECT_EQ(ActivityDescription(), getCellById(_simController->getSimulationData()).at(1).activity);
+
+    _simController->calcTimesteps(1);
+    auto scaledSigmoid = [](float value) { return 2.0f / (1.0f + std::exp(-value)) - 1.0f; };
+    auto actualCell = getCellById(_simController->getSimulationData()).at(1);
+    EXPECT_EQ(0, actualCell.activationTime);
+    EXPECT_TRUE(approxCompare(scaledSigmoid(1), actualCell.activity.channels[0]));
+}
+
+TEST_F(CpuEngineTests, changedCellsDoNotAccumulateAuxiliaryData)
+{
+    Settings settings;
+    settings.generalSettings = GeneralSettings{100, 100};
+    _SimulationCpuFacade facade(0, settings);
+    DescriptionConverter converter(settings.simulationParameters);
+    _AccessDataTOCache dataTOCache;
+    _AccessDataTOCache changeDataTOCache;
+
+    auto data = DataDescription().addCells({CellDescription().setId(1).setCellFunction(NeuronDescription()).setMetadata(CellMetadataDescription().setName("neuron"))});
+    auto dataTO = dataTOCache.getDataTO(converter.getArraySizes(data));
+    converter.convertDescriptionToTO(dataTO, data);
+    facade.setSimulationData(dataTO);
+
+    uint64_t numAuxiliaryData = 0;
+    for (int i = 0; i < 10; ++i) {
+        data.cells.front().metadata.name = "neuron " + std::to_string(i);
+        auto changeDataTO = changeDataTOCache.getDataTO(converter.getArraySizes(data));
+        converter.convertDescriptionToTO(changeDataTO, data);
+        facade.changeInspectedSimulationData(changeDataTO);
+        numAuxiliaryData = *changeDataTO.numAuxiliaryData;
+    }
+
+    auto actualDataTO = dataTOCache.getDataTO(facade.getArraySizes());
+    facade.getSimulationData({0, 0}, {100, 100}, actualDataTO);
+    EXPECT_EQ(numAuxiliaryData, *actualDataTO.numAuxiliaryData);
+    EXPECT_TRUE(compare(data, converter.convertTOtoDataDescription(actualDataTO)));
+}
+
+TEST_F(CpuEngineTests, deterministicTimestepsAreReproducible)
+{
+    auto data = DescriptionEditService::createRect(
+        DescriptionEditService::CreateRectParameters().width(10).height(10).center({50.0f, 50.0f}).cellDistance(0.9f));
+    data.addCells({CellDescription().setId(1000).setPos({40.0f, 50.0f}).setVel({0.3f, 0.0f})});
+
+    auto calcPositions = [&] {
+        auto simController = std::make_shared<_SimulationControllerImpl>();
+        GeneralSettings generalSettings{100, 100, 42, true};
+        simController->newSimulation(0, generalSettings, _parameters, EngineBackend_Cpu);
+        simController->setSimulationData(data);
+        simController->calcTimesteps(200);
+        std::vector<RealVector2D> result;
+        for (auto const& cell : simController->getSimulationData().cells) {
+            result.emplace_back(cell.pos);
+        }
+        simController->closeSimulation();
+        return result;
+    };
+    auto positions = calcPositions();
+    auto otherPositions = calcPositions();
+
+    ASSERT_EQ(positions.size(), otherPositions.size());
+    for (int i = 0; i < toInt(positions.size()); ++i) {
+        EXPECT_EQ(positions[i].x, otherPositions[i].x);
+        EXPECT_EQ(positions[i].y, otherPositions[i].y);
+    }
+}
+
+TEST_F(CpuEngineTests, profilingRecordsPhasesOfLastTimesteps)
+{
+    auto data = DescriptionEditService::createRect(DescriptionEditService::CreateRectParameters().width(5).height(4).center({50.0f, 50.0f}));
+    _simController->setSimulationData(data);
+    _simController->calcTimesteps(5);
+    EXPECT_TRUE(_simController->getProfilingData().entries.empty());
+
+    _simController->setProfilingEnabled(true);
+    _simController->calcTimesteps(10);
+    _simController->setProfilingEnabled(false);
+    _simController->calcTimesteps(5);
+
+    auto profilingData = _simController->getProfilingData();
+    ASSERT_EQ(10 * CpuPhase_Count, profilingData.entries.size());
+    EXPECT_EQ(CpuPhase_Count, profilingData.phaseNames.size());
+    for (int i = 0; i < toInt(profilingData.entries.size()); ++i) {
+        auto const& entry = profilingData.entries.at(i);
+        EXPECT_EQ(5 + i / CpuPhase_Count, entry.timestep);
+        EXPECT_EQ(i % CpuPhase_Count, entry.phase);
+        EXPECT_EQ(20, entry.numCells);
+        EXPECT_GE(entry.duration, 0);
+        if (i > 0) {
+            EXPECT_GE(entry.startTime, profilingData.entries.at(i - 1).startTime);
+        }
+    }
+}
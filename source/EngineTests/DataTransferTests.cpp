@@ -58,6 +58,49 @@ TEST_F(DataTransferTests, singleParticle)
     EXPECT_TRUE(compare(data, actualData));
 }
 
+TEST_F(DataTransferTests, queuedCellChanges)
+{
+    DataDescription data;
+    for (int i = 0; i < 10; ++i) {
+        data.addCell(CellDescription().setId(i + 1).setPos({toFloat(i) * 3.0f, 10.0f}).setEnergy(100.0f));
+    }
+    _simController->setSimulationData(data);
+
+    std::vector<std::future<void>> futures;
+    for (auto cell : data.cells) {
+        cell.setEnergy(50.0f).setColor(3);
+        futures.emplace_back(_simController->changeCell_async(cell));
+    }
+    futures.back().wait();
+    for (auto& future : futures) {
+        EXPECT_EQ(std::future_status::ready, future.wait_for(std::chrono::seconds(0)));
+        EXPECT_NO_THROW(future.get());
+    }
+
+    auto actualData = _simController->getSimulationData();
+    ASSERT_EQ(data.cells.size(), actualData.cells.size());
+    for (auto const& cell : actualData.cells) {
+        EXPECT_TRUE(approxCompare(50.0f, cell.energy));
+        EXPECT_EQ(3, cell.color);
+    }
+}
+
+TEST_F(DataTransferTests, queuedChangesAreVisibleToSubsequentAccess)
+{
+    DataDescription data;
+    data.addCell(CellDescription().setId(1).setPos({2.0f, 4.0f}).setEnergy(100.0f));
+    _simController->setSimulationData(data);
+
+    auto cell = data.cells.front();
+    cell.setEnergy(70.0f);
+    auto future = _simController->changeCell_async(cell);
+
+    auto actualData = _simController->getSimulationData();
+    ASSERT_EQ(1, actualData.cells.size());
+    EXPECT_TRUE(approxCompare(70.0f, actualData.cells.front().energy));
+    EXPECT_EQ(std::future_status::ready, future.wait_for(std::chrono::seconds(0)));
+}
+
 TEST_F(DataTransferTests, cellCluster)
 {
     NeuronDescription neuron1;
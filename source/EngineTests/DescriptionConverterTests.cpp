@@ -0,0 +1,155 @@
+#include <set>
+
+#include <gtest/gtest.h>
+
+#include "Base/Math.h"
+#include "Base/NumberGenerator.h"
+#include "EngineInterface/DescriptionEditService.h"
+#include "EngineInterface/Descriptions.h"
+#include "EngineInterface/GenomeDescriptionService.h"
+#include "EngineImpl/AccessDataTOCache.h"
+#include "EngineImpl/DescriptionConverter.h"
+
+class DescriptionConverterTests : public ::testing::Test
+{
+public:
+    DescriptionConverterTests()
+        : _converter(SimulationParameters())
+        , _dataTOCache(std::make_shared<_AccessDataTOCache>())
+    {}
+
+    ~DescriptionConverterTests() = default;
+
+protected:
+    //numRects x numRects separated rectangles of connected cells
+    DataDescription createRects(int numRects, int rectSize) const
+    {
+        DataDescription result;
+        for (int x = 0; x < numRects; ++x) {
+            for (int y = 0; y < numRects; ++y) {
+                result.add(DescriptionEditService::createRect(DescriptionEditService::CreateRectParameters()
+                                                                  .width(rectSize)
+                                                                  .height(rectSize)
+                                                                  .center({toFloat(x * (rectSize + 5)), toFloat(y * (rectSize + 5))})));
+            }
+        }
+        result.addParticle(ParticleDescription().setId(1).setEnergy(10.0f));
+        return result;
+    }
+
+    DataTO convertToTO(DataDescription const& data)
+    {
+        auto dataTO = _dataTOCache->getDataTO(_converter.getArraySizes(data));
+        _converter.convertDescriptionToTO(dataTO, data);
+        return dataTO;
+    }
+
+    DescriptionConverter _converter;
+    AccessDataTOCache _dataTOCache;
+};
+
+TEST_F(DescriptionConverterTests, clustersAreConnectedComponents)
+{
+    auto data = createRects(3, 4);
+    auto dataTO = convertToTO(data);
+
+    auto clusteredData = _converter.convertTOtoClusteredDataDescription(dataTO);
+
+    ASSERT_EQ(9, clusteredData.clusters.size());
+    for (auto const& cluster : clusteredData.clusters) {
+        EXPECT_EQ(16, cluster.cells.size());
+        std::unordered_set<uint64_t> cellIds;
+        for (auto const& cell : cluster.cells) {
+            cellIds.insert(cell.id);
+        }
+        for (auto const& cell : cluster.cells) {
+            for (auto const& connection : cell.connections) {
+                EXPECT_TRUE(cellIds.contains(connection.cellId));
+            }
+        }
+    }
+    EXPECT_EQ(1, clusteredData.particles.size());
+}
+
+TEST_F(DescriptionConverterTests, clusteredAndFlatConversionMatch)
+{
+    auto data = createRects(4, 5);
+    auto dataTO = convertToTO(data);
+
+    auto flatData = _converter.convertTOtoDataDescription(dataTO);
+    auto clusteredData = DataDescription(_converter.convertTOtoClusteredDataDescription(dataTO));
+
+    auto lessById = [](auto const& left, auto const& right) { return left.id < right.id; };
+    std::sort(flatData.cells.begin(), flatData.cells.end(), lessById);
+    std::sort(clusteredData.cells.begin(), clusteredData.cells.end(), lessById);
+    EXPECT_EQ(flatData, clusteredData);
+}
+
+TEST_F(DescriptionConverterTests, clusteringOfDescriptionsMatchesConversion)
+{
+    auto data = createRects(3, 6);
+    auto dataTO = convertToTO(data);
+
+    auto clusteredData = _converter.convertTOtoClusteredDataDescription(dataTO);
+    auto clusteredFromFlatData = ClusteredDataDescription(_converter.convertTOtoDataDescription(dataTO));
+
+    EXPECT_EQ(clusteredData, clusteredFromFlatData);
+}
+
+TEST_F(DescriptionConverterTests, duplicatedConversionEqualsDuplicatedDescription)
+{
+    auto rect = DescriptionEditService::createRect(DescriptionEditService::CreateRectParameters().width(4).height(3).center({20.0f, 20.0f}));
+    rect.addParticle(ParticleDescription().setId(NumberGenerator::getInstance().getId()).setPos({30.0f, 10.0f}).setEnergy(1.0f));
+    ClusteredDataDescription data(rect);
+
+    auto plan = DescriptionEditService::createDuplicationPlan(data, {50, 50}, {100, 100});
+    auto dataTO = _dataTOCache->getDataTO(_converter.getArraySizes(data, plan));
+    _converter.convertDuplicatedDescriptionToTO(dataTO, data, plan);
+    auto actualData = _converter.convertTOtoDataDescription(dataTO);
+
+    auto expectedData = data;
+    DescriptionEditService::duplicate(expectedData, {50, 50}, {100, 100});
+    DataDescription expectedFlatData(expectedData);
+
+    ASSERT_EQ(expectedFlatData.cells.size(), actualData.cells.size());
+    ASSERT_EQ(expectedFlatData.particles.size(), actualData.particles.size());
+    std::set<uint64_t> ids;
+    for (auto const& expectedCell : expectedFlatData.cells) {
+        auto actualCellIt = std::find_if(actualData.cells.begin(), actualData.cells.end(), [&](auto const& cell) {
+            return Math::length(expectedCell.pos - cell.pos) < NEAR_ZERO;
+        });
+        ASSERT_TRUE(actualCellIt != actualData.cells.end());
+        EXPECT_EQ(expectedCell.connections.size(), actualCellIt->connections.size());
+        ids.insert(actualCellIt->id);
+    }
+    EXPECT_EQ(expectedFlatData.cells.size(), ids.size());
+    for (auto const& cell : actualData.cells) {
+        for (auto const& connection : cell.connections) {
+            EXPECT_TRUE(ids.contains(connection.cellId));
+        }
+    }
+}
+
+TEST_F(DescriptionConverterTests, identicalGenomesAreStoredOnce)
+{
+    auto genome1 = GenomeDescriptionService::convertDescriptionToBytes(GenomeDescription().setCells({CellGenomeDescription(), CellGenomeDescription()}));
+    auto genome2 = GenomeDescriptionService::convertDescriptionToBytes(GenomeDescription().setCells({CellGenomeDescription().setColor(3)}));
+
+    auto data = DescriptionEditService::createRect(DescriptionEditService::CreateRectParameters().width(5).height(4).center({50.0f, 50.0f}));
+    for (size_t i = 0; i < data.cells.size(); ++i) {
+        auto const& genome = i % 3 == 2 ? genome2 : genome1;
+        if (i % 4 == 3) {
+            data.cells.at(i).setCellFunction(InjectorDescription().setGenome(genome));
+        } else {
+            data.cells.at(i).setCellFunction(ConstructorDescription().setGenome(genome));
+        }
+    }
+    auto dataTO = convertToTO(data);
+    EXPECT_EQ(genome1.size() + genome2.size(), *dataTO.numAuxiliaryData);
+
+    auto actualData = _converter.convertTOtoDataDescription(dataTO);
+    ASSERT_EQ(data.cells.size(), actualData.cells.size());
+    for (size_t i = 0; i < data.cells.size(); ++i) {
+        EXPECT_EQ(data.cells.at(i).cellFunction, actualData.cells.at(i).cellFunction);
+    }
+}
@@ -1,9 +1,13 @@
+#include <set>
+
 #include <gtest/gtest.h>
 
 #include "Base/Definitions.h"
+#include "Base/NumberGenerator.h"
 #include "EngineInterface/Descriptions.h"
 #include "EngineInterface/DescriptionEditService.h"
 #include "EngineInterface/SimulationController.h"
+#include "EngineInterface/SpaceCalculator.h"
 #include "IntegrationTestFramework.h"
 
 class DescriptionHelperTests 
@@ -42,7 +46,159 @@ TEST_F(DescriptionHelperTests, correctConnections)
     _simController->setSimulationData(data);
     auto clusteredData = _simController->getClusteredSimulationData();
 
-    DescriptionEditService::correctConnections(clusteredData, {100, 100});
+    DescriptionEditService::correctConnections(clusteredData, {100, 100}, {100, 100});
+
+    EXPECT_TRUE(areAngelsCorrect(clusteredData));
+}
+
+TEST_F(DescriptionHelperTests, duplicate)
+{
+    auto rect = DescriptionEditService::createRect(DescriptionEditService::CreateRectParameters().width(5).height(5).center({20.0f, 30.0f}));
+    rect.cells.front().metadata.name = "name";
+    rect.addParticle(ParticleDescription().setId(NumberGenerator::getInstance().getId()).setPos({40.0f, 10.0f}));
+    ClusteredDataDescription data(rect);
+
+    DescriptionEditService::duplicate(data, {50, 50}, {100, 75});
+
+    ASSERT_EQ(2, data.clusters.size());
+    EXPECT_EQ(4, data.particles.size());
+
+    std::set<uint64_t> ids;
+    std::set<int> creatureIds;
+    for (size_t clusterIndex = 0; clusterIndex < data.clusters.size(); ++clusterIndex) {
+        auto const& cluster = data.clusters.at(clusterIndex);
+        ASSERT_EQ(25, cluster.cells.size());
+        std::set<uint64_t> clusterIds;
+        for (auto const& cell : cluster.cells) {
+            clusterIds.insert(cell.id);
+            creatureIds.insert(cell.creatureId);
+            EXPECT_EQ(clusterIndex == 0 && cell.pos == rect.cells.front().pos, !cell.metadata.name.empty());
+        }
+        for (auto const& cell : cluster.cells) {
+            for (auto const& connection : cell.connections) {
+                EXPECT_TRUE(clusterIds.contains(connection.cellId));
+            }
+        }
+        ids.insert(clusterIds.begin(), clusterIds.end());
+    }
+    for (auto const& particle : data.particles) {
+        ids.insert(particle.id);
+    }
+    EXPECT_EQ(54, ids.size());
+    EXPECT_EQ(2, creatureIds.size());
+}
+
+TEST_F(DescriptionHelperTests, reconnectCells)
+{
+    auto data = DescriptionEditService::createRect(DescriptionEditService::CreateRectParameters().width(4).height(3));
+
+    std::vector<int> numConnections;
+    for (auto const& cell : data.cells) {
+        numConnections.emplace_back(toInt(cell.connections.size()));
+    }
+    std::sort(numConnections.begin(), numConnections.end());
+    EXPECT_EQ((std::vector<int>{2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 4, 4}), numConnections);
+    EXPECT_TRUE(areAngelsCorrect(ClusteredDataDescription(data)));
+}
+
+TEST_F(DescriptionHelperTests, reconnectCellsRespectsMaxConnections)
+{
+    DataDescription data;
+    data.addCells({
+        CellDescription().setId(1).setPos({10.0f, 10.0f}).setMaxConnections(2),
+        CellDescription().setId(2).setPos({11.0f, 10.0f}).setMaxConnections(1),
+        CellDescription().setId(3).setPos({11.5f, 10.0f}).setMaxConnections(2),
+    });
+
+    DescriptionEditService::reconnectCells(data, 1.1f);
+
+    EXPECT_TRUE(hasConnection(data, 1, 2));
+    EXPECT_FALSE(hasConnection(data, 2, 3));
+    EXPECT_FALSE(hasConnection(data, 1, 3));
+}
+
+TEST_F(DescriptionHelperTests, reconnectCellsAcrossWorldBorder)
+{
+    DataDescription data;
+    data.addCells({
+        CellDescription().setId(1).setPos({0.25f, 50.0f}).setMaxConnections(2),
+        CellDescription().setId(2).setPos({99.75f, 50.0f}).setMaxConnections(2),
+    });
+
+    auto localData = data;
+    DescriptionEditService::reconnectCells(localData, 1.0f);
+    EXPECT_FALSE(hasConnection(localData, 1, 2));
+
+    DescriptionEditService::reconnectCells(data, 1.0f, IntVector2D{100, 100});
+    ASSERT_TRUE(hasConnection(data, 1, 2));
+    EXPECT_TRUE(approxCompare(0.5f, getConnection(data, 1, 2).distance));
+}
+
+TEST_F(DescriptionHelperTests, correctConnectionsAcrossWorldBorder)
+{
+    DataDescription data;
+    data.addCells({
+        CellDescription().setId(1).setPos({0.5f, 50.0f}).setMaxConnections(2),
+        CellDescription().setId(2).setPos({99.5f, 50.0f}).setMaxConnections(2),
+        CellDescription().setId(3).setPos({50.0f, 50.0f}).setMaxConnections(2),
+    });
+    data.addConnection(1, 2);
+    data.addConnection(1, 3);
+    ClusteredDataDescription clusteredData(data);
+
+    DescriptionEditService::correctConnections(clusteredData, {100, 100}, {100, 100});
+
+    DataDescription correctedData(clusteredData);
+    EXPECT_TRUE(hasConnection(correctedData, 1, 2));
+    EXPECT_FALSE(hasConnection(correctedData, 1, 3));
+    EXPECT_TRUE(areAngelsCorrect(clusteredData));
+}
 
+TEST_F(DescriptionHelperTests, correctConnectionsAfterEnlargement)
+{
+    DataDescription data;
+    data.addCells({
+        CellDescription().setId(1).setPos({0.5f, 50.0f}).setMaxConnections(2),
+        CellDescription().setId(2).setPos({99.5f, 50.0f}).setMaxConnections(2),
+        CellDescription().setId(3).setPos({1.5f, 50.0f}).setMaxConnections(2),
+    });
+    data.addConnection(1, 2);
+    data.addConnection(1, 3);
+    ClusteredDataDescription clusteredData(data);
+
+    DescriptionEditService::correctConnections(clusteredData, {100, 100}, {120, 120});
+
+    DataDescription correctedData(clusteredData);
+    EXPECT_FALSE(hasConnection(correctedData, 1, 2));
+    EXPECT_TRUE(hasConnection(correctedData, 1, 3));
     EXPECT_TRUE(areAngelsCorrect(clusteredData));
 }
+
+TEST_F(DescriptionHelperTests, randomMultiplyWithOverlappingCheck)
+{
+    auto input = DescriptionEditService::createRect(DescriptionEditService::CreateRectParameters().width(3).height(3));
+    auto existentData = DescriptionEditService::createRect(DescriptionEditService::CreateRectParameters().width(10).height(10).center({50.0f, 50.0f}));
+
+    bool overlappingCheckSuccessful;
+    auto data = DescriptionEditService::randomMultiply(
+        input,
+        DescriptionEditService::RandomMultiplyParameters().number(30).overlappingCheck(true),
+        {100, 100},
+        DataDescription(existentData),
+        overlappingCheckSuccessful);
+
+    EXPECT_TRUE(overlappingCheckSuccessful);
+    ASSERT_EQ(31 * 9, data.cells.size());
+
+    //the copies (after the input) must keep their distance to each other and to the existent data
+    SpaceCalculator spaceCalculator({100, 100});
+    auto copies = std::vector<CellDescription>(data.cells.begin() + 9, data.cells.end());
+    for (size_t i = 0; i < copies.size(); ++i) {
+        for (size_t j = i / 9 * 9 + 9; j < copies.size(); ++j) {
+            EXPECT_LT(2.0f, spaceCalculator.distance(copies.at(i).pos, copies.at(j).pos));
+        }
+        for (auto const& existentCell : existentData.cells) {
+            EXPECT_LT(2.0f, spaceCalculator.distance(copies.at(i).pos, existentCell.pos));
+        }
+    }
+}
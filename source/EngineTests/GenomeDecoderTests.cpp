@@ -0,0 +1,103 @@
+#include <set>
+
+#include <gtest/gtest.h>
+
+#include "EngineInterface/GenomeDescriptionService.h"
+#include "EngineGpuKernels/GenomeDecoder.cuh"
+#include "EngineGpuKernels/PhiloxRandom.cuh"
+
+//GenomeDecoder is shared by the device and the host, these tests run it on the host
+class GenomeDecoderTests : public ::testing::Test
+{
+public:
+    GenomeDecoderTests() = default;
+    ~GenomeDecoderTests() = default;
+
+protected:
+    struct TestConstructor
+    {
+        uint8_t* genome;
+        int genomeSize;
+        int genomeCurrentNodeIndex = 0;
+        int genomeCurrentRepetition = 0;
+        int currentBranch = 0;
+    };
+
+    std::vector<uint8_t> createGenome() const
+    {
+        auto subGenome = GenomeDescriptionService::convertDescriptionToBytes(GenomeDescription().setCells({
+            CellGenomeDescription().setCellFunction(NerveGenomeDescription().setPulseMode(2)),
+            CellGenomeDescription().setColor(3),
+        }));
+        return GenomeDescriptionService::convertDescriptionToBytes(GenomeDescription().setHeader(GenomeHeaderDescription().setNumRepetitions(2)).setCells({
+            CellGenomeDescription().setCellFunction(NeuronGenomeDescription()),
+            CellGenomeDescription().setCellFunction(ConstructorGenomeDescription().setGenome(subGenome)),
+            CellGenomeDescription().setCellFunction(SensorGenomeDescription().setFixedAngle(45.0f)),
+            CellGenomeDescription().setCellFunction(InjectorGenomeDescription().setGenome(subGenome)),
+            CellGenomeDescription().setCellFunction(DetonatorGenomeDescription().setCountDown(10)),
+        }));
+    }
+};
+
+TEST_F(GenomeDecoderTests, matchesGenomeDescriptionService)
+{
+    auto bytes = createGenome();
+    auto genomeSize = toInt(bytes.size());
+
+    EXPECT_EQ(5, GenomeDecoder::getNumNodes(bytes.data(), genomeSize));
+    for (int nodeIndex = 0; nodeIndex <= 5; ++nodeIndex) {
+        EXPECT_EQ(
+            GenomeDescriptionService::convertNodeIndexToNodeAddress(bytes, nodeIndex), GenomeDecoder::getNodeAddress(bytes.data(), genomeSize, nodeIndex));
+    }
+    EXPECT_EQ(GenomeDescriptionService::getNumNodesRecursively(bytes, false), GenomeDecoder::getNumNodesRecursively(bytes.data(), genomeSize, false, true));
+    EXPECT_EQ(GenomeDescriptionService::getNumNodesRecursively(bytes, true), GenomeDecoder::getNumNodesRecursively(bytes.data(), genomeSize, true, true));
+    EXPECT_EQ(1, GenomeDecoder::getGenomeDepth(bytes.data(), genomeSize));
+
+    TestConstructor constructor{bytes.data(), genomeSize};
+    auto header = GenomeDecoder::readGenomeHeader(constructor);
+    EXPECT_EQ(2, header.numRepetitions);
+    EXPECT_FALSE(header.hasInfiniteRepetitions());
+    EXPECT_FALSE(GenomeDecoder::hasEmptyGenome(constructor));
+    EXPECT_FALSE(GenomeDecoder::containsSelfReplication(constructor));
+
+    int genomeBytePosition = GenomeDescriptionService::convertNodeIndexToNodeAddress(bytes, 1);
+    EXPECT_EQ(CellFunction_Constructor, GenomeDecoder::readByte(constructor, genomeBytePosition) % CellFunction_Count);
+}
+
+TEST_F(GenomeDecoderTests, randomNodeAddress)
+{
+    auto bytes = createGenome();
+    auto genomeSize = toInt(bytes.size());
+
+    std::set<int> nodeAddresses;
+    GenomeDecoder::executeForEachNodeRecursively(
+        bytes.data(), genomeSize, true, false, [&](int depth, int nodeAddress, int repetition) { nodeAddresses.insert(nodeAddress); });
+    EXPECT_EQ(9, toInt(nodeAddresses.size()));
+
+    PhiloxRandom random1(42, 100, 7, RandomPurpose_Mutation);
+    PhiloxRandom random2(42, 100, 7, RandomPurpose_Mutation);
+    for (int i = 0; i < 100; ++i) {
+        auto nodeAddress = GenomeDecoder::getRandomGenomeNodeAddress(random1, bytes.data(), genomeSize, false);
+        EXPECT_TRUE(nodeAddresses.contains(nodeAddress));
+        EXPECT_EQ(nodeAddress, GenomeDecoder::getRandomGenomeNodeAddress(random2, bytes.data(), genomeSize, false));
+    }
+}
+
+TEST_F(GenomeDecoderTests, randomCellFunctionData)
+{
+    auto bytes = createGenome();
+    auto nodeAddress = GenomeDescriptionService::convertNodeIndexToNodeAddress(bytes, 1);
+    auto origSize = Const::CellBasicBytes + GenomeDecoder::getNextCellFunctionDataSize(bytes.data(), toInt(bytes.size()), nodeAddress);
+
+    //a self-copying constructor is never longer than one with a sub-genome
+    PhiloxRandom random(42, 100, 7, RandomPurpose_Mutation);
+    GenomeDecoder::setRandomCellFunctionData(random, bytes.data(), nodeAddress + Const::CellBasicBytes, CellFunction_Constructor, true, 0);
+    bytes.erase(bytes.begin() + nodeAddress + Const::CellBasicBytes + Const::ConstructorFixedBytes + 1, bytes.begin() + nodeAddress + origSize);
+
+    auto genomeSize = toInt(bytes.size());
+    EXPECT_TRUE(GenomeDecoder::isNextCellSelfReplication(bytes.data(), nodeAddress));
+    EXPECT_EQ(5, GenomeDecoder::getNumNodes(bytes.data(), genomeSize));
+    TestConstructor constructor{bytes.data(), genomeSize};
+    EXPECT_TRUE(GenomeDecoder::containsSelfReplication(constructor));
+    EXPECT_EQ(5, toInt(GenomeDescriptionService::convertBytesToDescription(bytes).cells.size()));
+}
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+
+#include "EngineInterface/GenomeDescriptionService.h"
+
+class GenomeDescriptionServiceTests : public ::testing::Test
+{
+public:
+    GenomeDescriptionServiceTests() = default;
+    ~GenomeDescriptionServiceTests() = default;
+
+protected:
+    GenomeDescription createGenome() const
+    {
+        auto subGenome = GenomeDescriptionService::convertDescriptionToBytes(GenomeDescription().setCells({
+            CellGenomeDescription().setCellFunction(NerveGenomeDescription().setPulseMode(2)),
+            CellGenomeDescription().setColor(3),
+        }));
+        return GenomeDescription().setHeader(GenomeHeaderDescription().setNumRepetitions(2)).setCells({
+            CellGenomeDescription().setCellFunction(ConstructorGenomeDescription().setMakeSelfCopy()),
+            CellGenomeDescription().setCellFunction(NeuronGenomeDescription()),
+            CellGenomeDescription().setCellFunction(ConstructorGenomeDescription().setGenome(subGenome)),
+            CellGenomeDescription().setCellFunction(SensorGenomeDescription().setFixedAngle(45.0f)),
+            CellGenomeDescription().setCellFunction(InjectorGenomeDescription().setGenome(subGenome)),
+            CellGenomeDescription().setCellFunction(DetonatorGenomeDescription().setCountDown(10)),
+        });
+    }
+};
+
+TEST_F(GenomeDescriptionServiceTests, roundtrip)
+{
+    auto genome = createGenome();
+    auto bytes = GenomeDescriptionService::convertDescriptionToBytes(genome);
+    EXPECT_EQ(GenomeDescriptionService::getEncodedSize(genome), toInt(bytes.size()));
+
+    auto decodedGenome = GenomeDescriptionService::convertBytesToDescription(bytes);
+    EXPECT_EQ(genome.cells.size(), decodedGenome.cells.size());
+    EXPECT_EQ(bytes, GenomeDescriptionService::convertDescriptionToBytes(decodedGenome));
+}
+
+TEST_F(GenomeDescriptionServiceTests, view)
+{
+    auto genome = createGenome();
+    auto bytes = GenomeDescriptionService::convertDescriptionToBytes(genome);
+
+    GenomeView view(bytes);
+    EXPECT_EQ(genome.header.numRepetitions, view.getHeader().numRepetitions);
+    ASSERT_EQ(toInt(genome.cells.size()), view.getNumNodes());
+
+    int nodeIndex = 0;
+    for (auto const& node : view) {
+        EXPECT_EQ(genome.cells.at(nodeIndex).getCellFunctionType(), node.cellFunction);
+        EXPECT_EQ(GenomeDescriptionService::convertNodeIndexToNodeAddress(bytes, nodeIndex), node.address);
+        EXPECT_EQ(nodeIndex, GenomeDescriptionService::convertNodeAddressToNodeIndex(bytes, node.address));
+
+        auto subGenome = view.getSubGenome(node);
+        auto expectedSubGenome = genome.cells.at(nodeIndex).getGenome();
+        ASSERT_EQ(expectedSubGenome.has_value(), subGenome.has_value());
+        if (subGenome) {
+            auto subGenomeBytes = subGenome->getBytes();
+            EXPECT_TRUE(std::equal(subGenomeBytes.begin(), subGenomeBytes.end(), expectedSubGenome->begin(), expectedSubGenome->end()));
+
+            //the sub-genome is not copied
+            EXPECT_GE(subGenomeBytes.data(), bytes.data() + node.address);
+            EXPECT_LE(subGenomeBytes.data() + subGenomeBytes.size(), bytes.data() + node.address + node.size);
+            EXPECT_EQ(2, subGenome->getNumNodes());
+        }
+        ++nodeIndex;
+    }
+    EXPECT_EQ(toInt(bytes.size()), GenomeDescriptionService::convertNodeIndexToNodeAddress(bytes, nodeIndex));
+
+    //6 nodes and 2 sub-genomes with 2 nodes each, all repeated twice
+    EXPECT_EQ(10, GenomeDescriptionService::getNumNodesRecursively(bytes, false));
+    EXPECT_EQ(20, GenomeDescriptionService::getNumNodesRecursively(bytes, true));
+}
+
+TEST_F(GenomeDescriptionServiceTests, viewOfTruncatedGenome)
+{
+    auto bytes = GenomeDescriptionService::convertDescriptionToBytes(createGenome());
+    bytes.resize(bytes.size() - 3);
+
+    GenomeView view(bytes);
+    EXPECT_EQ(toInt(GenomeDescriptionService::convertBytesToDescription(bytes).cells.size()), view.getNumNodes());
+    for (auto const& node : view) {
+        EXPECT_LE(node.address + node.size, toInt(bytes.size()));
+    }
+}
+
+TEST_F(GenomeDescriptionServiceTests, parallelConversion)
+{
+    std::vector<GenomeDescription> genomes;
+    for (int i = 0; i < 100; ++i) {
+        auto genome = createGenome();
+        genome.cells.at(1).setColor(i % MAX_COLORS);
+        genome.cells.resize(1 + i % genome.cells.size());
+        genomes.emplace_back(genome);
+    }
+
+    auto bytes = GenomeDescriptionService::convertDescriptionsToBytes(genomes);
+    ASSERT_EQ(genomes.size(), bytes.size());
+    for (size_t i = 0; i < genomes.size(); ++i) {
+        EXPECT_EQ(GenomeDescriptionService::convertDescriptionToBytes(genomes.at(i)), bytes.at(i));
+    }
+
+    auto decodedGenomes = GenomeDescriptionService::convertBytesToDescriptions(bytes);
+    ASSERT_EQ(genomes.size(), decodedGenomes.size());
+    for (size_t i = 0; i < genomes.size(); ++i) {
+        EXPECT_EQ(GenomeDescriptionService::convertBytesToDescription(bytes.at(i)), decodedGenomes.at(i));
+    }
+}
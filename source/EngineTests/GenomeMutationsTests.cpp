@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+
+#include "EngineInterface/GenomeDescriptionService.h"
+#include "EngineGpuKernels/GenomeMutations.cuh"
+#include "EngineGpuKernels/PhiloxRandom.cuh"
+
+//GenomeMutations is shared by the device and the host, these tests run it on the host
+class GenomeMutationsTests : public ::testing::Test
+{
+public:
+    GenomeMutationsTests() = default;
+    ~GenomeMutationsTests() = default;
+
+protected:
+    std::vector<uint8_t> createGenome() const
+    {
+        auto subGenome = GenomeDescriptionService::convertDescriptionToBytes(GenomeDescription().setCells({
+            CellGenomeDescription().setCellFunction(NeuronGenomeDescription()).setColor(2),
+            CellGenomeDescription().setColor(2),
+        }));
+        return GenomeDescriptionService::convertDescriptionToBytes(GenomeDescription().setCells({
+            CellGenomeDescription().setCellFunction(NeuronGenomeDescription()).setColor(1),
+            CellGenomeDescription().setCellFunction(ConstructorGenomeDescription().setGenome(subGenome)).setColor(1),
+            CellGenomeDescription().setCellFunction(SensorGenomeDescription()).setColor(1),
+        }));
+    }
+
+    std::vector<CellFunction> getCellFunctions(std::vector<uint8_t> bytes) const
+    {
+        std::vector<CellFunction> result;
+        GenomeDecoder::executeForEachNodeRecursively(bytes.data(), toInt(bytes.size()), true, false, [&](int depth, int nodeAddress, int repetition) {
+            result.emplace_back(GenomeDecoder::getNextCellFunctionType(bytes.data(), nodeAddress));
+        });
+        return result;
+    }
+};
+
+TEST_F(GenomeMutationsTests, inPlaceMutationsPreserveStructure)
+{
+    auto origBytes = createGenome();
+    auto bytes = origBytes;
+    auto genomeSize = toInt(bytes.size());
+
+    ColorMatrix<bool> colorTransitions{};
+    PhiloxRandom random(42, 100, 7, RandomPurpose_Mutation);
+    for (int i = 0; i < 1000; ++i) {
+        GenomeMutations::neuronDataMutation(random, bytes.data(), genomeSize);
+        GenomeMutations::propertiesMutation(random, bytes.data(), genomeSize, 6);
+        GenomeMutations::customGeometryMutation(random, bytes.data(), genomeSize);
+        GenomeMutations::cellColorMutation(random, bytes.data(), genomeSize, colorTransitions);
+    }
+    EXPECT_NE(origBytes, bytes);
+    EXPECT_EQ(getCellFunctions(origBytes), getCellFunctions(bytes));
+    EXPECT_EQ(5, GenomeDecoder::getNumNodesRecursively(bytes.data(), genomeSize, false, true));
+}
+
+TEST_F(GenomeMutationsTests, genomeColorMutation)
+{
+    auto bytes = createGenome();
+    auto genomeSize = toInt(bytes.size());
+
+    ColorMatrix<bool> colorTransitions{};
+    PhiloxRandom random(42, 100, 7, RandomPurpose_Mutation);
+    EXPECT_FALSE(GenomeMutations::genomeColorMutation(random, bytes.data(), genomeSize, colorTransitions));
+    EXPECT_EQ(1, GenomeDecoder::getNextCellColor(bytes.data(), Const::GenomeHeaderSize));
+
+    colorTransitions[1][4] = true;
+    EXPECT_TRUE(GenomeMutations::genomeColorMutation(random, bytes.data(), genomeSize, colorTransitions));
+    GenomeDecoder::executeForEachNodeRecursively(bytes.data(), genomeSize, true, false, [&](int depth, int nodeAddress, int repetition) {
+        EXPECT_EQ(4, GenomeDecoder::getNextCellColor(bytes.data(), nodeAddress));
+    });
+}
@@ -6,7 +6,10 @@
 #include "EngineInterface/SimulationParameters.h"
 #include "EngineImpl/SimulationControllerImpl.h"
 
-IntegrationTestFramework::IntegrationTestFramework(std::optional<SimulationParameters> const& parameters_, IntVector2D const& universeSize)
+IntegrationTestFramework::IntegrationTestFramework(
+    std::optional<SimulationParameters> const& parameters_,
+    IntVector2D const& universeSize,
+    EngineBackend backend)
 {
     _simController = std::make_shared<_SimulationControllerImpl>();
     GeneralSettings generalSettings{universeSize.x, universeSize.y};
@@ -18,7 +21,7 @@ IntegrationTestFramework::IntegrationTestFramework(std::optional<SimulationParam
             parameters.baseValues.radiationCellAgeStrength[i] = 0;
         }
     }
-    _simController->newSimulation(0, generalSettings, parameters);
+    _simController->newSimulation(0, generalSettings, parameters, backend);
     _parameters = _simController->getSimulationParameters();
 }
 
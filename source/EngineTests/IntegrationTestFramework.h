@@ -5,12 +5,16 @@
 #include "Base/Definitions.h"
 #include "EngineInterface/Definitions.h"
 #include "EngineInterface/Descriptions.h"
+#include "EngineInterface/EngineBackend.h"
 #include "EngineInterface/SimulationParameters.h"
 
 class IntegrationTestFramework : public ::testing::Test
 {
 public:
-    IntegrationTestFramework(std::optional<SimulationParameters> const& parameters = std::nullopt, IntVector2D const& universeSize = IntVector2D{1000, 1000});
+    IntegrationTestFramework(
+        std::optional<SimulationParameters> const& parameters = std::nullopt,
+        IntVector2D const& universeSize = IntVector2D{1000, 1000},
+        EngineBackend backend = EngineBackend_Gpu);
     virtual ~IntegrationTestFramework();
 
 protected:
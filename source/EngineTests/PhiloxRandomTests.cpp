@@ -0,0 +1,52 @@
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "EngineGpuKernels/PhiloxRandom.cuh"
+
+class PhiloxRandomTests : public ::testing::Test
+{
+public:
+    PhiloxRandomTests() = default;
+    ~PhiloxRandomTests() = default;
+};
+
+TEST_F(PhiloxRandomTests, knownAnswer)
+{
+    //test vector of the Random123 reference implementation
+    uint32_t key[2] = {0, 0};
+    uint32_t counter[4] = {0, 0, 0, 0};
+    uint32_t result[4];
+    PhiloxRandom::generateBlock(key, counter, result);
+    EXPECT_EQ(0x6627e8d5u, result[0]);
+    EXPECT_EQ(0xe169c58du, result[1]);
+    EXPECT_EQ(0xbc57ac4cu, result[2]);
+    EXPECT_EQ(0x9b00dbd8u, result[3]);
+}
+
+TEST_F(PhiloxRandomTests, streams)
+{
+    auto createSequence = [](uint64_t seed, uint64_t timestep, uint64_t objectId, RandomPurpose purpose) {
+        PhiloxRandom generator(seed, timestep, objectId, purpose);
+        std::vector<uint32_t> result;
+        for (int i = 0; i < 10; ++i) {
+            result.emplace_back(generator.randomUInt32());
+        }
+        return result;
+    };
+    auto sequence = createSequence(42, 100, 7, RandomPurpose_Mutation);
+    EXPECT_EQ(sequence, createSequence(42, 100, 7, RandomPurpose_Mutation));
+    EXPECT_NE(sequence, createSequence(43, 100, 7, RandomPurpose_Mutation));
+    EXPECT_NE(sequence, createSequence(42, 101, 7, RandomPurpose_Mutation));
+    EXPECT_NE(sequence, createSequence(42, 100, 8, RandomPurpose_Mutation));
+    EXPECT_NE(sequence, createSequence(42, 100, 7ull << 32, RandomPurpose_Mutation));
+    EXPECT_NE(sequence, createSequence(42, 100, 7, RandomPurpose_CellFunction));
+
+    PhiloxRandom generator(42, 100, 7, RandomPurpose_Mutation);
+    for (int i = 0; i < 1000; ++i) {
+        auto value = generator.random();
+        EXPECT_TRUE(value >= 0.0f && value < 1.0f);
+        auto intValue = generator.random(5);
+        EXPECT_TRUE(intValue >= 0 && intValue <= 5);
+    }
+}
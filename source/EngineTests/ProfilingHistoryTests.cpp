@@ -0,0 +1,25 @@
+#include <gtest/gtest.h>
+
+#include "EngineInterface/ProfilingHistory.h"
+
+class ProfilingHistoryTests : public ::testing::Test
+{
+public:
+    ProfilingHistoryTests() = default;
+    ~ProfilingHistoryTests() = default;
+};
+
+TEST_F(ProfilingHistoryTests, keepsLatestEntries)
+{
+    ProfilingHistory history({"phase"}, 5);
+    for (int i = 0; i < 12; ++i) {
+        ProfilingEntry entry;
+        entry.timestep = i;
+        history.add({entry});
+    }
+    auto entries = history.getData().entries;
+    ASSERT_EQ(5, entries.size());
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_EQ(7 + i, entries.at(i).timestep);
+    }
+}
@@ -0,0 +1,290 @@
+#include <filesystem>
+#include <optional>
+
+#include <gtest/gtest.h>
+
+#include "EngineInterface/AuxiliaryDataParserService.h"
+#include "EngineInterface/CheckpointService.h"
+#include "EngineInterface/DescriptionEditService.h"
+#include "EngineInterface/Descriptions.h"
+#include "EngineInterface/GenomeDescriptionService.h"
+#include "EngineInterface/SerializerService.h"
+#include "EngineInterface/SimulationController.h"
+#include "IntegrationTestFramework.h"
+
+class SerializerTests : public IntegrationTestFramework
+{
+public:
+    SerializerTests()
+        : IntegrationTestFramework()
+    {}
+
+    ~SerializerTests() = default;
+
+protected:
+    std::vector<uint8_t> createGenome(int numNodes) const
+    {
+        GenomeDescription genome;
+        for (int i = 0; i < numNodes; ++i) {
+            genome.cells.emplace_back(CellGenomeDescription().setColor(i % MAX_COLORS));
+        }
+        return GenomeDescriptionService::convertDescriptionToBytes(genome);
+    }
+
+    //sharedGenomeNodes: all cells become constructors and injectors sharing two distinct genomes in interleaved order
+    DeserializedSimulation createSimulation(int rectSize = 10, std::optional<int> sharedGenomeNodes = std::nullopt) const
+    {
+        auto data = DescriptionEditService::createRect(
+            DescriptionEditService::CreateRectParameters().width(rectSize).height(rectSize).center({100.0f, 100.0f}));
+        if (sharedGenomeNodes) {
+            auto genome1 = createGenome(*sharedGenomeNodes);
+            auto genome2 = createGenome(1);
+            for (size_t i = 0; i < data.cells.size(); ++i) {
+                auto const& genome = i % 3 == 2 ? genome2 : genome1;
+                if (i % 4 == 3) {
+                    data.cells.at(i).setCellFunction(InjectorDescription().setGenome(genome));
+                } else {
+                    data.cells.at(i).setCellFunction(ConstructorDescription().setGenome(genome));
+                }
+            }
+        } else {
+            NeuronDescription neuron;
+            neuron.weights[2][1] = 1.0f;
+            data.cells.at(0).setCellFunction(neuron).setMetadata(CellMetadataDescription().setName("neuron"));
+            data.cells.at(1).setCellFunction(ConstructorDescription().setGenome(createGenome(2)));
+            data.cells.at(2).setCellFunction(SensorDescription().setFixedAngle(30.0f).setColor(2));
+            data.cells.at(3).setCellFunction(InjectorDescription().setGenome(createGenome(1)));
+            data.cells.at(4).setCellFunction(MuscleDescription()).setActivity({1, 0, -1, 0, 0, 0, 0, 0});
+            data.addParticle(ParticleDescription().setId(10000).setPos({20.0f, 30.0f}).setEnergy(50.0f));
+        }
+
+        DeserializedSimulation result;
+        _simController->setSimulationData(data);
+        result.mainData = _simController->getClusteredSimulationData();
+        result.auxiliaryData.generalSettings = _simController->getGeneralSettings();
+        result.auxiliaryData.simulationParameters = _simController->getSimulationParameters();
+        return result;
+    }
+};
+
+TEST_F(SerializerTests, columnarRoundtrip)
+{
+    auto origSimulation = createSimulation();
+
+    SerializedSimulation serializedSimulation;
+    ASSERT_TRUE(SerializerService::serializeSimulationToStrings(
+        serializedSimulation, origSimulation, SerializationSettings().format(SerializationFormat::Columnar)));
+
+    DeserializedSimulation simulation;
+    ASSERT_TRUE(SerializerService::deserializeSimulationFromStrings(simulation, serializedSimulation));
+
+    EXPECT_TRUE(compare(DataDescription(origSimulation.mainData), DataDescription(simulation.mainData)));
+}
+
+TEST_F(SerializerTests, portableBinaryRoundtrip)
+{
+    auto origSimulation = createSimulation();
+
+    SerializedSimulation serializedSimulation;
+    ASSERT_TRUE(SerializerService::serializeSimulationToStrings(serializedSimulation, origSimulation));
+
+    DeserializedSimulation simulation;
+    ASSERT_TRUE(SerializerService::deserializeSimulationFromStrings(simulation, serializedSimulation));
+
+    EXPECT_TRUE(compare(DataDescription(origSimulation.mainData), DataDescription(simulation.mainData)));
+}
+
+TEST_F(SerializerTests, parallelCompressionRoundtrip)
+{
+    auto origSimulation = createSimulation();
+
+    for (auto codec : {CompressionCodec::Deflate, CompressionCodec::DeflateFast, CompressionCodec::None}) {
+        SerializedSimulation serializedSimulation;
+        ASSERT_TRUE(SerializerService::serializeSimulationToStrings(
+            serializedSimulation,
+            origSimulation,
+            SerializationSettings().format(SerializationFormat::Columnar).parallelCompression(true).codec(codec)));
+
+        DeserializedSimulation simulation;
+        ASSERT_TRUE(SerializerService::deserializeSimulationFromStrings(simulation, serializedSimulation));
+
+        EXPECT_TRUE(compare(DataDescription(origSimulation.mainData), DataDescription(simulation.mainData)));
+    }
+}
+
+TEST_F(SerializerTests, columnarStreamingLoad)
+{
+    auto origSimulation = createSimulation();
+    auto filename = (std::filesystem::temp_directory_path() / "columnarStreamingLoad.sim").string();
+    ASSERT_TRUE(SerializerService::serializeSimulationToFiles(
+        filename, origSimulation, SerializationSettings().format(SerializationFormat::Columnar).parallelCompression(true)));
+
+    DeserializedSimulation simulation;
+    ColumnarDataReader mainDataReader;
+    ASSERT_TRUE(SerializerService::deserializeSimulationFromFiles(simulation, mainDataReader, filename));
+    ASSERT_TRUE(mainDataReader);
+
+    _simController->setColumnarSimulationData(mainDataReader);
+    auto actualData = _simController->getClusteredSimulationData();
+
+    EXPECT_TRUE(compare(DataDescription(origSimulation.mainData), DataDescription(actualData)));
+}
+
+TEST_F(SerializerTests, identicalGenomesRoundtrip)
+{
+    auto origSimulation = createSimulation(10, 2);
+
+    for (auto format : {SerializationFormat::PortableBinary, SerializationFormat::Columnar}) {
+        SerializedSimulation serializedSimulation;
+        ASSERT_TRUE(SerializerService::serializeSimulationToStrings(serializedSimulation, origSimulation, SerializationSettings().format(format)));
+
+        DeserializedSimulation simulation;
+        ASSERT_TRUE(SerializerService::deserializeSimulationFromStrings(simulation, serializedSimulation));
+        EXPECT_TRUE(compare(DataDescription(origSimulation.mainData), DataDescription(simulation.mainData)));
+
+        _simController->setClusteredSimulationData(simulation.mainData);
+        EXPECT_TRUE(compare(DataDescription(origSimulation.mainData), DataDescription(_simController->getClusteredSimulationData())));
+    }
+
+    auto filename = (std::filesystem::temp_directory_path() / "identicalGenomesRoundtrip.sim").string();
+    ASSERT_TRUE(SerializerService::serializeSimulationToFiles(filename, origSimulation, SerializationSettings().format(SerializationFormat::Columnar)));
+
+    DeserializedSimulation simulation;
+    ColumnarDataReader mainDataReader;
+    ASSERT_TRUE(SerializerService::deserializeSimulationFromFiles(simulation, mainDataReader, filename));
+    _simController->setColumnarSimulationData(mainDataReader);
+    EXPECT_TRUE(compare(DataDescription(origSimulation.mainData), DataDescription(_simController->getClusteredSimulationData())));
+}
+
+//the device needs a copy of the genome for each cell although the file stores it once per segment
+TEST_F(SerializerTests, identicalLargeGenomesColumnarLoad)
+{
+    auto origSimulation = createSimulation(50, 300);
+    auto filename = (std::filesystem::temp_directory_path() / "identicalLargeGenomesColumnarLoad.sim").string();
+    ASSERT_TRUE(SerializerService::serializeSimulationToFiles(filename, origSimulation, SerializationSettings().format(SerializationFormat::Columnar)));
+
+    //start with array sizes which are not yet increased by the original data
+    _simController->closeSimulation();
+    _simController->newSimulation(
+        0, origSimulation.auxiliaryData.generalSettings, origSimulation.auxiliaryData.simulationParameters, EngineBackend_Gpu);
+
+    DeserializedSimulation simulation;
+    ColumnarDataReader mainDataReader;
+    ASSERT_TRUE(SerializerService::deserializeSimulationFromFiles(simulation, mainDataReader, filename));
+    _simController->setColumnarSimulationData(mainDataReader);
+    EXPECT_TRUE(compare(DataDescription(origSimulation.mainData), DataDescription(_simController->getClusteredSimulationData())));
+}
+
+TEST_F(SerializerTests, rawSnapshotRoundtrip)
+{
+    auto origSimulation = createSimulation();
+    auto filename = (std::filesystem::temp_directory_path() / "rawSnapshotRoundtrip.sim").string();
+    _simController->saveRawSnapshot(filename);
+
+    _simController->clear();
+    _simController->loadRawSnapshot(filename);
+    auto actualData = _simController->getClusteredSimulationData();
+
+    EXPECT_TRUE(compare(DataDescription(origSimulation.mainData), DataDescription(actualData)));
+}
+
+TEST_F(SerializerTests, deltaCheckpoints)
+{
+    auto origSimulation = createSimulation();
+    auto filename = (std::filesystem::temp_directory_path() / "deltaCheckpoints.sim").string();
+    ASSERT_TRUE(SerializerService::serializeSimulationToFiles(filename, origSimulation));
+
+    auto changedSimulation = origSimulation;
+    auto& cells = changedSimulation.mainData.clusters.front().cells;
+    cells.at(0).pos.x += 1.0f;
+    cells.at(1).setCellFunction(ConstructorDescription().setGenome(createGenome(3)));
+    cells.at(2).metadata.setName("sensor");
+    changedSimulation.mainData.particles.front().energy = 25.0f;
+    changedSimulation.mainData.addParticle(ParticleDescription().setId(10001).setPos({40.0f, 30.0f}).setEnergy(10.0f));
+    ASSERT_TRUE(SerializerService::serializeDeltaCheckpointToFiles(filename, changedSimulation, origSimulation.mainData));
+
+    auto changedSimulation2 = changedSimulation;
+    changedSimulation2.mainData.particles.erase(changedSimulation2.mainData.particles.begin());
+    ASSERT_TRUE(SerializerService::serializeDeltaCheckpointToFiles(filename, changedSimulation2, changedSimulation.mainData));
+    EXPECT_EQ(2, SerializerService::getNumDeltaCheckpoints(filename));
+
+    DeserializedSimulation simulation;
+    ASSERT_TRUE(SerializerService::deserializeSimulationFromFiles(simulation, filename));
+    EXPECT_TRUE(compare(DataDescription(changedSimulation2.mainData), DataDescription(simulation.mainData)));
+
+    ASSERT_TRUE(SerializerService::compactDeltaCheckpoints(filename));
+    EXPECT_EQ(0, SerializerService::getNumDeltaCheckpoints(filename));
+
+    DeserializedSimulation compactedSimulation;
+    ASSERT_TRUE(SerializerService::deserializeSimulationFromFiles(compactedSimulation, filename));
+    EXPECT_TRUE(compare(DataDescription(changedSimulation2.mainData), DataDescription(compactedSimulation.mainData)));
+}
+
+TEST_F(SerializerTests, rotatingCheckpoints)
+{
+    auto origSimulation = createSimulation();
+    auto filename = (std::filesystem::temp_directory_path() / "rotatingCheckpoints.sim").string();
+    CheckpointService::removeCheckpoints(filename);
+    EXPECT_TRUE(CheckpointService::getCheckpoints(filename).empty());
+
+    for (uint64_t timestep = 1; timestep <= 4; ++timestep) {
+        origSimulation.auxiliaryData.timestep = timestep;
+        ASSERT_TRUE(CheckpointService::saveCheckpoint(filename, 3, origSimulation));
+    }
+    auto checkpoints = CheckpointService::getCheckpoints(filename);
+    ASSERT_EQ(3, checkpoints.size());
+
+    //latest checkpoint first
+    for (int i = 0; i < 3; ++i) {
+        DeserializedSimulation simulation;
+        ASSERT_TRUE(SerializerService::deserializeSimulationFromFiles(simulation, checkpoints.at(i)));
+        EXPECT_EQ(4 - i, simulation.auxiliaryData.timestep);
+        EXPECT_TRUE(compare(DataDescription(origSimulation.mainData), DataDescription(simulation.mainData)));
+    }
+
+    CheckpointService::removeCheckpoints(filename);
+    EXPECT_TRUE(CheckpointService::getCheckpoints(filename).empty());
+}
+
+TEST_F(SerializerTests, appendStatistics)
+{
+    auto filename = (std::filesystem::temp_directory_path() / "appendStatistics.statistics.csv").string();
+    std::filesystem::remove(filename);
+
+    StatisticsHistoryData statistics(3);
+    for (int i = 0; i < 3; ++i) {
+        statistics.at(i).time = toDouble(i * 100);
+        statistics.at(i).numCells.values[0] = toDouble(i + 1);
+    }
+    ASSERT_TRUE(SerializerService::appendStatisticsToFile(filename, {statistics.at(0)}));
+    ASSERT_TRUE(SerializerService::appendStatisticsToFile(filename, {statistics.at(1), statistics.at(2)}));
+
+    StatisticsHistoryData actualStatistics;
+    ASSERT_TRUE(SerializerService::deserializeStatisticsFromFile(actualStatistics, filename));
+    ASSERT_EQ(3, actualStatistics.size());
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_EQ(statistics.at(i).time, actualStatistics.at(i).time);
+        EXPECT_EQ(statistics.at(i).numCells.values[0], actualStatistics.at(i).numCells.values[0]);
+    }
+}
+
+TEST_F(SerializerTests, settingsPatch)
+{
+    AuxiliaryData data;
+    data.generalSettings = _simController->getGeneralSettings();
+    data.simulationParameters = _simController->getSimulationParameters();
+
+    boost::property_tree::ptree patch;
+    patch.put("simulation parameters.friction", "0.125");
+    patch.put(boost::property_tree::ptree::path_type("simulation parameters.radiation.factor[1]", '|'), "0.5");
+    auto patchedData = AuxiliaryDataParserService::applyPatch(data, patch);
+
+    EXPECT_EQ(0.125f, patchedData.simulationParameters.baseValues.friction);
+    EXPECT_EQ(0.5f, patchedData.simulationParameters.baseValues.radiationCellAgeStrength[1]);
+    EXPECT_EQ(data.simulationParameters.baseValues.radiationCellAgeStrength[0], patchedData.simulationParameters.baseValues.radiationCellAgeStrength[0]);
+    EXPECT_EQ(data.generalSettings.worldSizeX, patchedData.generalSettings.worldSizeX);
+
+    boost::property_tree::ptree invalidPatch;
+    invalidPatch.put("simulation parameters.unknown parameter", "1");
+    EXPECT_THROW(AuxiliaryDataParserService::applyPatch(data, invalidPatch), std::runtime_error);
+}
@@ -0,0 +1,148 @@
+#include <algorithm>
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include "Base/NumberGenerator.h"
+#include "EngineInterface/SpaceCalculator.h"
+#include "EngineInterface/SpatialHashGrid.h"
+
+class SpatialHashGridTests : public ::testing::Test
+{
+public:
+    SpatialHashGridTests() = default;
+    ~SpatialHashGridTests() = default;
+
+protected:
+    std::vector<RealVector2D> createRandomPositions(int number, IntVector2D const& worldSize) const
+    {
+        auto& numberGen = NumberGenerator::getInstance();
+        std::vector<RealVector2D> result;
+        for (int i = 0; i < number; ++i) {
+            result.emplace_back(toFloat(numberGen.getRandomReal(0, worldSize.x)), toFloat(numberGen.getRandomReal(0, worldSize.y)));
+        }
+        return result;
+    }
+
+    std::vector<int> getIndicesInRadiusBruteForce(std::vector<RealVector2D> const& positions, IntVector2D const& worldSize, RealVector2D const& pos, float radius)
+        const
+    {
+        SpaceCalculator space(worldSize);
+        std::vector<int> result;
+        for (int i = 0; i < toInt(positions.size()); ++i) {
+            if (space.distance(positions[i], pos) <= radius) {
+                result.emplace_back(i);
+            }
+        }
+        return result;
+    }
+
+    std::vector<int> sorted(std::vector<int> values) const
+    {
+        std::sort(values.begin(), values.end());
+        return values;
+    }
+};
+
+TEST_F(SpatialHashGridTests, radiusQuery)
+{
+    IntVector2D worldSize{100, 80};
+    auto positions = createRandomPositions(2000, worldSize);
+    SpatialHashGrid grid(worldSize);
+    grid.build(positions);
+
+    for (auto const& pos : createRandomPositions(50, worldSize)) {
+        std::vector<int> actual;
+        grid.getIndicesInRadius(pos, 3.5f, actual);
+        EXPECT_EQ(getIndicesInRadiusBruteForce(positions, worldSize, pos, 3.5f), sorted(actual));
+    }
+}
+
+TEST_F(SpatialHashGridTests, radiusQueryAcrossWorldBoundary)
+{
+    SpatialHashGrid grid({100, 100});
+    grid.build({{99.5f, 0.5f}, {0.5f, 99.5f}, {50.0f, 50.0f}, {-0.5f, 100.5f}});
+
+    std::vector<int> actual;
+    grid.getIndicesInRadius({0.0f, 0.0f}, 1.0f, actual);
+    EXPECT_EQ((std::vector<int>{0, 1, 3}), sorted(actual));
+
+    grid.forEachInRadius({0.0f, 0.0f}, 1.0f, [](int index, RealVector2D const& delta, float distanceSquared) {
+        EXPECT_NEAR(0.5f, distanceSquared, 0.001f);
+        EXPECT_NEAR(0.5f, std::abs(delta.x), 0.001f);
+        EXPECT_NEAR(0.5f, std::abs(delta.y), 0.001f);
+    });
+}
+
+TEST_F(SpatialHashGridTests, radiusQueryLargeRadius)
+{
+    IntVector2D worldSize{20, 30};
+    auto positions = createRandomPositions(500, worldSize);
+    SpatialHashGrid grid(worldSize);
+    grid.build(positions);
+
+    std::vector<int> actual;
+    grid.getIndicesInRadius({3.0f, 4.0f}, 12.0f, actual);
+    EXPECT_EQ(getIndicesInRadiusBruteForce(positions, worldSize, {3.0f, 4.0f}, 12.0f), sorted(actual));
+}
+
+TEST_F(SpatialHashGridTests, rectQuery)
+{
+    IntVector2D worldSize{100, 100};
+    auto positions = createRandomPositions(3000, worldSize);
+    SpatialHashGrid grid(worldSize);
+    grid.build(positions);
+
+    std::vector<int> actual;
+    grid.getIndicesInRect({90.0f, -10.0f}, {115.0f, 5.0f}, actual);
+
+    std::vector<int> expected;
+    for (int i = 0; i < toInt(positions.size()); ++i) {
+        auto const& pos = positions[i];
+        if ((pos.x >= 90.0f || pos.x < 15.0f) && (pos.y >= 90.0f || pos.y < 5.0f)) {
+            expected.emplace_back(i);
+        }
+    }
+    EXPECT_EQ(expected, sorted(actual));
+}
+
+TEST_F(SpatialHashGridTests, insert)
+{
+    IntVector2D worldSize{50, 50};
+    auto positions = createRandomPositions(1000, worldSize);
+    SpatialHashGrid grid(worldSize);
+    for (auto const& pos : positions) {
+        grid.insert(pos);
+    }
+    EXPECT_EQ(1000, grid.getNumEntries());
+
+    for (auto const& pos : createRandomPositions(50, worldSize)) {
+        std::vector<int> actual;
+        grid.getIndicesInRadius(pos, 2.0f, actual);
+        EXPECT_EQ(getIndicesInRadiusBruteForce(positions, worldSize, pos, 2.0f), sorted(actual));
+        EXPECT_EQ(!actual.empty(), grid.isOccupied(pos, 2.0f));
+    }
+}
+
+TEST_F(SpatialHashGridTests, batchedQueries)
+{
+    IntVector2D worldSize{100, 100};
+    auto positions = createRandomPositions(2000, worldSize);
+    SpatialHashGrid grid(worldSize);
+    grid.build(positions);
+
+    auto queryPositions = createRandomPositions(200, worldSize);
+    std::vector<int> indices;
+    std::vector<int> offsets;
+    grid.getIndicesInRadius(queryPositions, 2.5f, indices, offsets);
+    std::vector<bool> occupied;
+    grid.areOccupied(queryPositions, 2.5f, occupied);
+
+    ASSERT_EQ(queryPositions.size() + 1, offsets.size());
+    ASSERT_EQ(queryPositions.size(), occupied.size());
+    for (int i = 0; i < toInt(queryPositions.size()); ++i) {
+        auto expected = getIndicesInRadiusBruteForce(positions, worldSize, queryPositions[i], 2.5f);
+        EXPECT_EQ(expected, sorted(std::vector<int>(indices.begin() + offsets[i], indices.begin() + offsets[i + 1])));
+        EXPECT_EQ(!expected.empty(), occupied[i]);
+    }
+}
@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+
+#include "Base/Definitions.h"
+#include "EngineInterface/StatisticsHistory.h"
+
+class StatisticsHistoryTests : public ::testing::Test
+{
+public:
+    StatisticsHistoryTests() = default;
+    ~StatisticsHistoryTests() = default;
+};
+
+TEST_F(StatisticsHistoryTests, keepsRecentDetailAndFullRange)
+{
+    StatisticsHistory history;
+    auto numDataPoints = 100000;
+    for (int i = 0; i < numDataPoints; ++i) {
+        DataPointCollection dataPoint;
+        dataPoint.time = toDouble(i);
+        history.addDataPoint(dataPoint);
+    }
+    auto data = history.getCopiedData();
+    auto maxSize = StatisticsHistory::NumTiers * StatisticsHistory::MaxChunksPerTier * StatisticsHistory::ChunkSize;
+    ASSERT_LE(data.size(), maxSize);
+    for (size_t i = 1; i < data.size(); ++i) {
+        EXPECT_LT(data.at(i - 1).time, data.at(i).time);
+    }
+    EXPECT_LT(data.front().time, toDouble(numDataPoints) / 100);
+
+    //latest data points in full resolution
+    for (int i = 0; i < StatisticsHistory::ChunkSize; ++i) {
+        EXPECT_EQ(toDouble(numDataPoints - 1 - i), data.at(data.size() - 1 - i).time);
+    }
+}
+
+TEST_F(StatisticsHistoryTests, snapshotIsUnaffectedByLaterChanges)
+{
+    StatisticsHistory history;
+    for (int i = 0; i < 10; ++i) {
+        DataPointCollection dataPoint;
+        dataPoint.time = toDouble(i);
+        history.addDataPoint(dataPoint);
+    }
+    auto snapshot = history.getSnapshot();
+
+    DataPointCollection dataPoint;
+    dataPoint.time = 10.0;
+    history.addDataPoint(dataPoint);
+    history.removeDataPointsFrom(5.0);
+
+    EXPECT_EQ(10, snapshot->getData().size());
+    EXPECT_EQ(5, history.getCopiedData().size());
+    history.clear();
+    EXPECT_TRUE(history.getSnapshot()->isEmpty());
+    EXPECT_FALSE(snapshot->isEmpty());
+}
@@ -0,0 +1,52 @@
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "Base/WorkStealingScheduler.h"
+
+class WorkStealingSchedulerTests : public ::testing::Test
+{
+public:
+    WorkStealingSchedulerTests() = default;
+    ~WorkStealingSchedulerTests() = default;
+};
+
+TEST_F(WorkStealingSchedulerTests, skewedTasksAreProcessedOnce)
+{
+    std::vector<std::atomic<int>> invocations(1000);
+    ThreadPool threadPool(4);
+    WorkStealingScheduler scheduler(threadPool, 1);
+    scheduler.run(toInt(invocations.size()), [&](int task) {
+        //few expensive tasks at the beginning
+        if (task < 10) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        ++invocations[task];
+    });
+    for (auto const& numInvocations : invocations) {
+        EXPECT_EQ(1, numInvocations);
+    }
+    EXPECT_GT(scheduler.getNumStealsOfLastRun(), 0);
+}
+
+TEST_F(WorkStealingSchedulerTests, exceptionIsRethrownAfterAllWorkersFinished)
+{
+    std::atomic<int> numFinishedTasks = 0;
+    ThreadPool threadPool(4);
+    WorkStealingScheduler scheduler(threadPool, 1);
+    EXPECT_THROW(
+        scheduler.run(
+            100,
+            [&](int task) {
+                if (task == 0) {
+                    throw std::runtime_error("task failed");
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                ++numFinishedTasks;
+            }),
+        std::runtime_error);
+    EXPECT_EQ(99, numFinishedTasks);
+}
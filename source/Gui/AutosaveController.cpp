@@ -15,6 +15,21 @@
 namespace
 {
     auto constexpr MinutesForAutosave = 40;
+    auto constexpr MaxDeltaCheckpoints = 5;
+
+    //a delta checkpoint needs a copy of the last saved simulation in memory and only pays off if few objects have changed,
+    //which is rarely the case for a running simulation since the cells move
+    auto constexpr MaxObjectsForDeltaCheckpoints = 500000;
+    auto constexpr MaxChangedObjectsRatioForDeltaCheckpoints = 0.25;
+
+    int getNumObjects(ClusteredDataDescription const& data)
+    {
+        auto result = toInt(data.particles.size());
+        for (auto const& cluster : data.clusters) {
+            result += toInt(cluster.cells.size());
+        }
+        return result;
+    }
 }
 
 _AutosaveController::_AutosaveController(SimulationController const& simController)
@@ -34,7 +49,7 @@ void _AutosaveController::shutdown()
     if (!_on) {
         return;
     }
-    onSave();
+    onSave(true);
 }
 
 bool _AutosaveController::isOn() const
@@ -56,7 +71,7 @@ void _AutosaveController::process()
     auto durationSinceStart = std::chrono::duration_cast<std::chrono::minutes>(std::chrono::steady_clock::now() - *_startTimePoint).count();
     if (durationSinceStart > 0 && durationSinceStart % MinutesForAutosave == 0 && !_alreadySaved) {
         printOverlayMessage("Auto saving ...");
-        delayedExecution([=, this] { onSave(); });
+        delayedExecution([=, this] { onSave(false); });
         _alreadySaved = true;
     }
     if (durationSinceStart > 0 && durationSinceStart % MinutesForAutosave == 1 && _alreadySaved) {
@@ -64,8 +79,30 @@ void _AutosaveController::process()
     }
 }
 
-void _AutosaveController::onSave()
+void _AutosaveController::onSave(bool compact)
 {
     DeserializedSimulation sim = SerializationHelperService::getDeserializedSerialization(_simController);
-    SerializerService::serializeSimulationToFiles(Const::AutosaveFile, sim);
+    auto settings = SerializationSettings().format(SerializationFormat::Columnar).parallelCompression(true).codec(CompressionCodec::DeflateFast);
+
+    //only the changes since the last save are written unless the delta chain becomes too long or the changes are too large
+    auto numObjects = getNumObjects(sim.mainData);
+    bool deltaSaved = false;
+    if (!compact && _lastSavedMainData && _numDeltaCheckpoints < MaxDeltaCheckpoints) {
+        auto delta = DescriptionDeltaService::calcDelta(*_lastSavedMainData, sim.mainData);
+        if (delta.getNumberOfEntries() <= MaxChangedObjectsRatioForDeltaCheckpoints * numObjects) {
+            deltaSaved = SerializerService::serializeDeltaCheckpointToFiles(Const::AutosaveFile, sim, *_lastSavedMainData, delta, settings);
+        }
+    }
+    if (deltaSaved) {
+        ++_numDeltaCheckpoints;
+    } else {
+        SerializerService::serializeSimulationToFiles(Const::AutosaveFile, sim, settings);
+        _numDeltaCheckpoints = 0;
+    }
+
+    if (numObjects <= MaxObjectsForDeltaCheckpoints) {
+        _lastSavedMainData = std::move(sim.mainData);
+    } else {
+        _lastSavedMainData.reset();
+    }
 }
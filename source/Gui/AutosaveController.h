@@ -3,6 +3,7 @@
 #include <chrono>
 
 #include "EngineInterface/Definitions.h"
+#include "EngineInterface/Descriptions.h"
 #include "Definitions.h"
 
 class _AutosaveController
@@ -19,11 +20,15 @@ public:
     void process();
 
 private:
-    void onSave();
+    void onSave(bool compact);
 
     SimulationController _simController;
 
     bool _on = true;
     std::optional<std::chrono::steady_clock::time_point> _startTimePoint;
     bool _alreadySaved = false;
+
+    //base for the next delta checkpoint, only kept for simulations up to MaxObjectsForDeltaCheckpoints since it is a full copy
+    std::optional<ClusteredDataDescription> _lastSavedMainData;
+    int _numDeltaCheckpoints = 0;
 };
\ No newline at end of file
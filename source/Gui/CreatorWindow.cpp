@@ -216,7 +216,7 @@ void _CreatorWindow::onDrawing()
             }
         }
     }
-    DescriptionEditService::reconnectCells(_drawingDataDescription, 1.5f);
+    DescriptionEditService::reconnectCells(_drawingDataDescription, 1.5f, _simController->getWorldSize());
     if (!_makeSticky) {
         auto origDrawing = _drawingDataDescription;
         DescriptionEditService::removeStickiness(_drawingDataDescription);
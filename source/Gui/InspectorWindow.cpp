@@ -149,7 +149,7 @@ void _InspectorWindow::processCell(CellDescription cell)
         ImGui::EndTabBar();
 
         if (cell != origCell) {
-            _simController->changeCell(cell);
+            _simController->changeCell_async(cell);
         }
     }
 }
@@ -748,7 +748,7 @@ void _InspectorWindow::processParticle(ParticleDescription particle)
 
     particle.energy = energy;
     if (particle != origParticle) {
-        _simController->changeParticle(particle);
+        _simController->changeParticle_async(particle);
     }
 }
 
@@ -775,7 +775,7 @@ void _InspectorWindow::validationAndCorrection(CellDescription& cell) const
     switch (cell.getCellFunctionType()) {
     case CellFunction_Constructor: {
         auto& constructor = std::get<ConstructorDescription>(*cell.cellFunction);
-        auto numNodes = GenomeDescriptionService::convertNodeAddressToNodeIndex(constructor.genome, toInt(constructor.genome.size()));
+        auto numNodes = GenomeView(constructor.genome).getNumNodes();
         if (numNodes > 0) {
             constructor.genomeCurrentNodeIndex = ((constructor.genomeCurrentNodeIndex % numNodes) + numNodes) % numNodes;
         } else {
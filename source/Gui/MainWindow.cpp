@@ -761,7 +761,8 @@ void _MainWindow::onOpenSimulation()
             printOverlayMessage("Loading ...");
             delayedExecution([firstFilename = firstFilename, this] {
                 DeserializedSimulation deserializedData;
-                if (SerializerService::deserializeSimulationFromFiles(deserializedData, firstFilename.string())) {
+                ColumnarDataReader mainDataReader;
+                if (SerializerService::deserializeSimulationFromFiles(deserializedData, mainDataReader, firstFilename.string())) {
                     _simController->closeSimulation();
 
                     std::optional<std::string> errorMessage;
@@ -770,7 +771,11 @@ void _MainWindow::onOpenSimulation()
                             deserializedData.auxiliaryData.timestep,
                             deserializedData.auxiliaryData.generalSettings,
                             deserializedData.auxiliaryData.simulationParameters);
-                        _simController->setClusteredSimulationData(deserializedData.mainData);
+                        if (mainDataReader) {
+                            _simController->setColumnarSimulationData(mainDataReader);
+                        } else {
+                            _simController->setClusteredSimulationData(deserializedData.mainData);
+                        }
                         _simController->setStatisticsHistory(deserializedData.statistics);
                         _simController->setRealTime(deserializedData.auxiliaryData.realTime);
                     } catch (CudaMemoryAllocationException const& exception) {
@@ -86,11 +86,12 @@ void _ResizeWorldDialog::onResizing()
 
     _simController->newSimulation(timestep, generalSettings, parameters);
 
-    DescriptionEditService::correctConnections(content, {_width, _height});
+    DescriptionEditService::correctConnections(content, origWorldSize, {_width, _height});
     if (_scaleContent) {
-        DescriptionEditService::duplicate(content, origWorldSize, {_width, _height});
+        _simController->setDuplicatedSimulationData(content, origWorldSize);
+    } else {
+        _simController->setClusteredSimulationData(content);
     }
-    _simController->setClusteredSimulationData(content);
     _simController->setStatisticsHistory(statistics);
     _simController->setRealTime(realtime);
     _temporalControlWindow->onSnapshot();
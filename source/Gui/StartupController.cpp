@@ -3,6 +3,7 @@
 #include <imgui.h>
 
 #include "Base/Definitions.h"
+#include "Base/Exceptions.h"
 #include "Base/GlobalSettings.h"
 #include "Base/Resources.h"
 #include "Base/LoggingService.h"
@@ -50,8 +51,8 @@ void _StartupController::process()
 
     if (_state == State::LoadSimulation) {
         DeserializedSimulation deserializedSim;
-        if (!SerializerService::deserializeSimulationFromFiles(deserializedSim, Const::AutosaveFile)) {
-            MessageDialog::getInstance().information("Error", "The default simulation file could not be read.\nAn empty simulation will be created.");
+        ColumnarDataReader mainDataReader;
+        auto setEmptySimulation = [&] {
             deserializedSim.auxiliaryData.generalSettings.worldSizeX = 1000;
             deserializedSim.auxiliaryData.generalSettings.worldSizeY = 500;
             deserializedSim.auxiliaryData.timestep = 0;
@@ -59,13 +60,39 @@ void _StartupController::process()
             deserializedSim.auxiliaryData.center = {500.0f, 250.0f};
             deserializedSim.auxiliaryData.realTime = std::chrono::milliseconds(0);
             deserializedSim.mainData = ClusteredDataDescription();
+            deserializedSim.statistics = StatisticsHistoryData();
+            mainDataReader.reset();
+        };
+        if (!SerializerService::deserializeSimulationFromFiles(deserializedSim, mainDataReader, Const::AutosaveFile)) {
+            MessageDialog::getInstance().information("Error", "The default simulation file could not be read.\nAn empty simulation will be created.");
+            setEmptySimulation();
+        }
+
+        //segments of columnar data are only decoded and checked here
+        std::optional<std::string> errorMessage;
+        try {
+            _simController->newSimulation(
+                deserializedSim.auxiliaryData.timestep, deserializedSim.auxiliaryData.generalSettings, deserializedSim.auxiliaryData.simulationParameters);
+            if (mainDataReader) {
+                _simController->setColumnarSimulationData(mainDataReader);
+            } else {
+                _simController->setClusteredSimulationData(deserializedSim.mainData);
+            }
+            _simController->setStatisticsHistory(deserializedSim.statistics);
+            _simController->setRealTime(deserializedSim.auxiliaryData.realTime);
+        } catch (CudaMemoryAllocationException const& exception) {
+            errorMessage = exception.what();
+        } catch (...) {
+            errorMessage = "The default simulation file could not be read.";
         }
 
-        _simController->newSimulation(
-            deserializedSim.auxiliaryData.timestep, deserializedSim.auxiliaryData.generalSettings, deserializedSim.auxiliaryData.simulationParameters);
-        _simController->setClusteredSimulationData(deserializedSim.mainData);
-        _simController->setStatisticsHistory(deserializedSim.statistics);
-        _simController->setRealTime(deserializedSim.auxiliaryData.realTime);
+        if (errorMessage) {
+            MessageDialog::getInstance().information("Error", *errorMessage + "\nAn empty simulation will be created.");
+            _simController->closeSimulation();
+            setEmptySimulation();
+            _simController->newSimulation(
+                deserializedSim.auxiliaryData.timestep, deserializedSim.auxiliaryData.generalSettings, deserializedSim.auxiliaryData.simulationParameters);
+        }
         Viewport::setCenterInWorldPos(deserializedSim.auxiliaryData.center);
         Viewport::setZoomFactor(deserializedSim.auxiliaryData.zoom);
         _temporalControlWindow->onSnapshot();
@@ -454,10 +454,7 @@ void _StatisticsWindow::processPlot(int row, DataPoint DataPointCollection::*val
     ImGui::PopID();
     ImGui::SameLine();
 
-    auto const& statisticsHistory = _simController->getStatisticsHistory();
-
-    std::lock_guard lock(statisticsHistory.getMutex());
-    auto longtermStatistics = &statisticsHistory.getDataRef();
+    auto longtermStatistics = &getLongtermStatistics();
 
     //create dummy history if empty
     std::vector dummy = {DataPointCollection()};
@@ -486,6 +483,16 @@ void _StatisticsWindow::processPlot(int row, DataPoint DataPointCollection::*val
     ImGui::Spacing();
 }
 
+StatisticsHistoryData const& _StatisticsWindow::getLongtermStatistics()
+{
+    auto snapshot = _simController->getStatisticsHistory().getSnapshot();
+    if (snapshot != _longtermStatisticsSnapshot) {
+        _longtermStatistics = snapshot->getData();
+        _longtermStatisticsSnapshot = snapshot;
+    }
+    return _longtermStatistics;
+}
+
 void _StatisticsWindow::processBackground()
 {
     auto timepoint = std::chrono::steady_clock::now();
@@ -4,6 +4,7 @@
 
 #include "EngineInterface/Definitions.h"
 #include "EngineInterface/RawStatisticsData.h"
+#include "EngineInterface/StatisticsHistory.h"
 
 #include "Definitions.h"
 #include "AlienWindow.h"
@@ -29,6 +30,7 @@ private:
     void processTimelineStatistics();
 
     void processPlot(int row, DataPoint DataPointCollection::*valuesPtr, int fracPartDecimals = 0);
+    StatisticsHistoryData const& getLongtermStatistics();
 
     void processBackground() override;
 
@@ -64,5 +66,9 @@ private:
     TimelineLiveStatistics _timelineLiveStatistics;
     HistogramLiveStatistics _histogramLiveStatistics;
     TableLiveStatistics _tableLiveStatistics;
+
+    //merged view of the last snapshot of the statistics history
+    std::shared_ptr<StatisticsHistorySnapshot const> _longtermStatisticsSnapshot;
+    StatisticsHistoryData _longtermStatistics;
 };
 